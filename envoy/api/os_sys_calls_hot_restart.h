@@ -24,6 +24,11 @@ public:
    * @see shm_unlink (man 3 shm_unlink)
    */
   virtual SysCallIntResult shmUnlink(const char* name) PURE;
+
+  /**
+   * @see munmap (man 2 munmap)
+   */
+  virtual SysCallIntResult munmap(void* addr, size_t length) PURE;
 };
 
 using HotRestartOsSysCallsPtr = std::unique_ptr<HotRestartOsSysCalls>;
@@ -60,6 +60,12 @@ public:
    */
   virtual void start() PURE;
 
+  /**
+   * Called once the server has finished initializing, at which point every subscription of the
+   * initial configuration has been added.
+   */
+  virtual void onServerInitialized() PURE;
+
   /**
    * Pause discovery requests for a given API type. This is useful when we're processing an update
    * for LDS or CDS and don't want a flood of updates for RDS or EDS respectively. Discovery
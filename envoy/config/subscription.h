@@ -64,6 +64,17 @@ public:
 using DecodedResourcePtr = std::unique_ptr<DecodedResource>;
 using DecodedResourceRef = std::reference_wrapper<DecodedResource>;
 
+/**
+ * A resource that OpaqueResourceDecoder::prepareResource() has done the thread-safe part of
+ * decoding for. Its contents are specific to the decoder that prepared it.
+ */
+class PreparedResource {
+public:
+  virtual ~PreparedResource() = default;
+};
+
+using PreparedResourcePtr = std::unique_ptr<PreparedResource>;
+
 class OpaqueResourceDecoder {
 public:
   virtual ~OpaqueResourceDecoder() = default;
@@ -75,6 +86,25 @@ public:
    */
   virtual ProtobufTypes::MessagePtr decodeResource(const ProtobufWkt::Any& resource) PURE;
 
+  /**
+   * Performs the part of decodeResource() that does not depend on state owned by the thread the
+   * decoder is used from, such as parsing the resource and checking its protoc-gen-validate
+   * constraints. This may be called concurrently from any thread, and does not throw: any error
+   * is reported by finishResource().
+   * @param resource some opaque resource (ProtobufWkt::Any).
+   * @return PreparedResourcePtr the prepared resource, to be passed to finishResource().
+   */
+  virtual PreparedResourcePtr prepareResource(const ProtobufWkt::Any& resource) PURE;
+
+  /**
+   * Completes decoding a resource prepared by prepareResource(), on the thread the decoder is used
+   * from. Together, the two calls return the same message and throw the same exceptions as
+   * decodeResource().
+   * @param prepared a resource returned by prepareResource() on this decoder.
+   * @return ProtobufTypes::MessagePtr decoded protobuf message in the opaque resource.
+   */
+  virtual ProtobufTypes::MessagePtr finishResource(PreparedResourcePtr&& prepared) PURE;
+
   /**
    * @param resource some opaque resource (Protobuf::Message).
    * @return std::String the resource name in a Protobuf::Message returned by decodeResource(), e.g.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -48,6 +49,15 @@ struct DispatcherStats {
 
 using DispatcherStatsPtr = std::unique_ptr<DispatcherStats>;
 
+/**
+ * Cumulative time an event loop has spent running callbacks (busy) and blocked waiting for events
+ * (polling). Comparing two samples gives the loop utilization over the interval between them.
+ */
+struct EventLoopTimes {
+  std::chrono::microseconds busy_{};
+  std::chrono::microseconds polling_{};
+};
+
 /**
  * Callback invoked when a dispatcher post() runs.
  */
@@ -173,6 +183,21 @@ public:
    */
   virtual MonotonicTime approximateMonotonicTime() const PURE;
 
+  /**
+   * Starts measuring the time returned by eventLoopTimes(). The measurement runs on every event
+   * loop iteration, so it is only enabled for the dispatchers which need it, or once stats are
+   * initialized.
+   */
+  virtual void enableEventLoopTimes() PURE;
+
+  /**
+   * Returns the cumulative time this dispatcher's event loop has spent running callbacks and
+   * polling for events, including the loop iteration currently in progress, since
+   * enableEventLoopTimes() or initializeStats() was first called. Must be called from the
+   * dispatcher's thread.
+   */
+  virtual EventLoopTimes eventLoopTimes() const PURE;
+
   /**
    * Initializes stats for this dispatcher. Note that this can't generally be done at construction
    * time, since the main and worker thread dispatchers are constructed before
@@ -46,6 +46,16 @@ public:
    */
   virtual void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) PURE;
 
+  /**
+   * Send a request message that has already been compressed with the message encoding advertised
+   * in the grpc-encoding initial metadata. The message is framed with the compressed flag set.
+   * @param request compressed serialized message.
+   * @param end_stream close the stream locally, as for sendMessageRaw().
+   * @return false if this stream cannot send pre-compressed messages, in which case nothing was
+   *         sent and request is left untouched.
+   */
+  virtual bool sendCompressedMessageRaw(Buffer::InstancePtr& request, bool end_stream) PURE;
+
   /**
    * Close the stream locally and send an empty DATA frame to the remote. No further methods may be
    * invoked on the stream object, but callbacks may still be received until the stream is closed
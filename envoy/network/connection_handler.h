@@ -99,6 +99,12 @@ public:
    */
   virtual void setListenerRejectFraction(UnitFloat reject_fraction) PURE;
 
+  /**
+   * Scale the per connection buffer limits of new and existing stream connections.
+   * @param scale a value between 0 (shrink limits to their floor) and 1 (configured limits).
+   */
+  virtual void setConnectionBufferLimitScale(UnitFloat scale) PURE;
+
   /**
    * @return the stat prefix used for per-handler stats.
    */
@@ -309,6 +309,8 @@ public:
 
 using UpstreamTransportSocketFactoryPtr = std::unique_ptr<UpstreamTransportSocketFactory>;
 using DownstreamTransportSocketFactoryPtr = std::unique_ptr<DownstreamTransportSocketFactory>;
+using DownstreamTransportSocketFactorySharedPtr =
+    std::shared_ptr<DownstreamTransportSocketFactory>;
 
 } // namespace Network
 } // namespace Envoy
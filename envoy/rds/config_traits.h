@@ -64,6 +64,22 @@ public:
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
                                             bool validate_clusters_default) const PURE;
+
+  /**
+   * Create a config object based on a new version of a route configuration. Implementations may
+   * share the parts of the previous config object that are unchanged by the new version with the
+   * new config object, rather than building them again.
+   * @param rc supplies the new version of the RouteConfiguration.
+   * @param context supplies the context of the server factory.
+   * @param validate_clusters_default see createConfig().
+   * @param previous_config supplies the config object created for the previous version, as
+   *    returned by createNullConfig(), createConfig() or updateConfig() of these traits.
+   * @throw EnvoyException if the new config can't be applied of.
+   */
+  virtual ConfigConstSharedPtr updateConfig(const Protobuf::Message& rc,
+                                            Server::Configuration::ServerFactoryContext& context,
+                                            bool validate_clusters_default,
+                                            const ConfigConstSharedPtr& previous_config) const PURE;
 };
 
 } // namespace Rds
@@ -6,6 +6,8 @@
 #include "envoy/extensions/transport_sockets/tls/v3/cert.pb.h"
 #include "envoy/secret/secret_provider.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 
 namespace Server {
@@ -154,6 +156,12 @@ public:
   virtual GenericSecretConfigProviderSharedPtr findOrCreateGenericSecretProvider(
       const envoy::config::core::v3::ConfigSource& config_source, const std::string& config_name,
       Server::Configuration::TransportSocketFactoryContext& secret_provider_context) PURE;
+
+  /**
+   * @return the in-memory size in bytes of each static and dynamic secret which has been received,
+   * keyed by secret name. Used by the /memory/config admin endpoint.
+   */
+  virtual absl::flat_hash_map<std::string, uint64_t> secretsAllocatedBytes() PURE;
 };
 
 using SecretManagerPtr = std::unique_ptr<SecretManager>;
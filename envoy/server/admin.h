@@ -10,6 +10,7 @@
 #include "envoy/http/header_map.h"
 #include "envoy/http/query_params.h"
 #include "envoy/network/listen_socket.h"
+#include "envoy/server/config_memory_tracker.h"
 #include "envoy/server/config_tracker.h"
 
 #include "absl/strings/string_view.h"
@@ -192,6 +193,11 @@ public:
    */
   virtual ConfigTracker& getConfigTracker() PURE;
 
+  /**
+   * @return ConfigMemoryTracker& tracker for /memory/config endpoint.
+   */
+  virtual ConfigMemoryTracker& getConfigMemoryTracker() PURE;
+
   /**
    * Expose this Admin console as an HTTP server.
    * @param access_logs access_logs list of file loggers to write the HTTP request log to.
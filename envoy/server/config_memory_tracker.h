@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "envoy/common/pure.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * ConfigMemoryTracker is used by the `/memory/config` admin endpoint to record the approximate
+ * memory footprint of xDS resources, so that the resources which dominate memory usage can be
+ * found. The footprint of a resource is sampled when it is built, as the number of bytes allocated
+ * by the process while building it, which is cheap enough to always do. The wall time it took to
+ * build the resource is recorded alongside, to find the resources which dominate startup time.
+ * ConfigMemoryTracker is *not* threadsafe, and is only used on the main thread.
+ */
+class ConfigMemoryTracker {
+public:
+  enum class ResourceType { Listener, Cluster, RouteConfiguration, Regex, TlsContext };
+
+  virtual ~ConfigMemoryTracker() = default;
+
+  /**
+   * Record the cost of building a resource, replacing the cost of any previous version of it.
+   * @param type the type of the resource.
+   * @param name the name of the resource.
+   * @param allocated_bytes the number of bytes allocated while building the resource.
+   * @param build_time the wall time it took to build the resource.
+   */
+  virtual void setBuildCost(ResourceType type, const std::string& name, uint64_t allocated_bytes,
+                            std::chrono::microseconds build_time) PURE;
+
+  /**
+   * Add to the cost of a resource which may be built several times, such as a regex which is used
+   * by several routes.
+   * @param type the type of the resource.
+   * @param name the name of the resource.
+   * @param allocated_bytes the number of bytes allocated while building the resource once more.
+   * @param build_time the wall time it took to build the resource once more.
+   */
+  virtual void addBuildCost(ResourceType type, const std::string& name, uint64_t allocated_bytes,
+                            std::chrono::microseconds build_time) PURE;
+
+  /**
+   * Forget a resource which has been removed.
+   * @param type the type of the resource.
+   * @param name the name of the resource.
+   */
+  virtual void removeResource(ResourceType type, const std::string& name) PURE;
+};
+
+} // namespace Server
+} // namespace Envoy
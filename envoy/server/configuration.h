@@ -84,6 +84,16 @@ public:
    * @return bool indicator to flush stats on-demand via the admin interface instead of on a timer.
    */
   virtual bool flushOnAdmin() const PURE;
+
+  /**
+   * @return bool indicator to only flush the metrics that changed since the previous flush.
+   */
+  virtual bool flushChangedOnly() const PURE;
+
+  /**
+   * @return bool indicator to flush the sinks that support it on a dedicated thread.
+   */
+  virtual bool flushOnDedicatedThread() const PURE;
 };
 
 /**
@@ -202,6 +202,17 @@ public:
     return nullptr;
   }
 
+  /**
+   * @param config supplies the route specific config proto, as returned by
+   *        createEmptyRouteConfigProto().
+   * @return bool true if the route specific config may be dropped after it was created when the
+   * route configuration is loaded, and created again when it is first used. Only worth it for
+   * configs which take much more memory than their proto. Filters returning true must make
+   * createRouteSpecificFilterConfig() safe to call on any thread, and its result must only
+   * depend on the config proto, so that creating it again cannot fail.
+   */
+  virtual bool isRouteSpecificFilterConfigLazy(const Protobuf::Message&) const { return false; }
+
   std::string category() const override { return "envoy.filters.http"; }
 
   /**
@@ -266,6 +266,18 @@ public:
    * responsibility of the caller to handle the duplicates.
    */
   virtual const Stats::TagVector& statsTags() const PURE;
+
+  /**
+   * @return const std::string& the path to which the cost of building each resource is written in
+   *         validate mode, or empty if it is not written.
+   */
+  virtual const std::string& configProfilePath() const PURE;
+
+  /**
+   * @return const std::string& the directory of DiscoveryResponse files from which the xDS
+   *         subscriptions are served in validate mode, or empty if they are not served.
+   */
+  virtual const std::string& configProfileSnapshotDir() const PURE;
 };
 
 } // namespace Server
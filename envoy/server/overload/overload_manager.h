@@ -37,6 +37,9 @@ public:
 
   // Overload action to reset streams using excessive memory.
   const std::string ResetStreams = "envoy.overload_actions.reset_high_memory_stream";
+
+  // Overload action to shrink the per connection buffer limits of downstream connections.
+  const std::string ShrinkBufferLimits = "envoy.overload_actions.shrink_buffer_limits";
 };
 
 using OverloadActionNames = ConstSingleton<OverloadActionNameValues>;
@@ -52,6 +55,20 @@ public:
 
 using OverloadActionStatsNames = ConstSingleton<OverloadActionStatsNameValues>;
 
+/**
+ * Well-known resource monitors that are built into the overload manager and evaluated separately
+ * on each worker thread. Overload actions triggered by these resources only take effect on the
+ * workers whose own usage crosses the trigger.
+ */
+class OverloadWorkerResourceNameValues {
+public:
+  // Fraction of time the worker's event loop spent running callbacks rather than waiting for
+  // events during the last refresh interval.
+  const std::string EventLoopUtilization = "envoy.resource_monitors.worker_event_loop_utilization";
+};
+
+using OverloadWorkerResourceNames = ConstSingleton<OverloadWorkerResourceNameValues>;
+
 /**
  * The OverloadManager protects the Envoy instance from being overwhelmed by client
  * requests. It monitors a set of resources and notifies registered listeners if
@@ -156,6 +156,11 @@ public:
     MustStaple,
   };
 
+  struct SessionStoreConfig {
+    std::string path_;
+    uint32_t max_sessions_;
+  };
+
   /**
    * @return True if client certificate is required, false otherwise.
    */
@@ -184,6 +189,17 @@ public:
    * @return True if stateless TLS session resumption is disabled, false otherwise.
    */
   virtual bool disableStatelessSessionResumption() const PURE;
+
+  /**
+   * @return the configuration of the session store shared across workers and hot restarts, if
+   * any.
+   */
+  virtual const absl::optional<SessionStoreConfig>& sessionStore() const PURE;
+
+  /**
+   * @return True if record protection of established connections is offloaded to the kernel.
+   */
+  virtual bool kernelTlsOffload() const PURE;
 };
 
 using ServerContextConfigPtr = std::unique_ptr<ServerContextConfig>;
@@ -91,6 +91,14 @@ public:
    * @param value the value of the sample.
    */
   virtual void onHistogramComplete(const Histogram& histogram, uint64_t value) PURE;
+
+  /**
+   * @return whether flush() may be called on the dedicated stats flush thread rather than the
+   * main thread. Such sinks must not use thread local storage in flush(), and must post any work
+   * that requires the main thread to the main thread's dispatcher. The snapshot stays valid for
+   * the duration of the flush() call only.
+   */
+  virtual bool supportsDedicatedFlushThread() const { return false; }
 };
 
 using SinkPtr = std::unique_ptr<Sink>;
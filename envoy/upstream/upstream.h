@@ -923,6 +923,15 @@ public:
    */
   virtual ResourceManager& resourceManager(ResourcePriority priority) const PURE;
 
+  /**
+   * Updates the limits of the resource managers returned by resourceManager() in place, without
+   * affecting the resources currently in use. Only the limits of the thresholds are applied; the
+   * other circuit breaker settings, such as retry budgets and track_remaining, are kept.
+   * @param circuit_breakers supplies the new circuit breaker configuration of the cluster.
+   */
+  virtual void updateResourceLimits(
+      const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers) const PURE;
+
   /**
    * @return TransportSocketMatcher& the transport socket matcher associated
    * factory.
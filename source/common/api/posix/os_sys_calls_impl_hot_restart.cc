@@ -15,5 +15,10 @@ SysCallIntResult HotRestartOsSysCallsImpl::shmUnlink(const char* name) {
   return {rc, errno};
 }
 
+SysCallIntResult HotRestartOsSysCallsImpl::munmap(void* addr, size_t length) {
+  const int rc = ::munmap(addr, length);
+  return {rc, errno};
+}
+
 } // namespace Api
 } // namespace Envoy
@@ -12,6 +12,7 @@ public:
   // Api::HotRestartOsSysCalls
   SysCallIntResult shmOpen(const char* name, int oflag, mode_t mode) override;
   SysCallIntResult shmUnlink(const char* name) override;
+  SysCallIntResult munmap(void* addr, size_t length) override;
 };
 
 using HotRestartOsSysCallsSingleton = ThreadSafeSingleton<HotRestartOsSysCallsImpl>;
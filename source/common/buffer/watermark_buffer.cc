@@ -1,8 +1,10 @@
 #include "source/common/buffer/watermark_buffer.h"
 #include "watermark_buffer.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 
@@ -206,29 +208,36 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
   uint32_t last_bucket_to_clear = BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_ - buckets_to_clear;
   ENVOY_LOG_MISC(warn, "resetting streams in buckets >= {}", last_bucket_to_clear);
 
-  // Clear buckets, prioritizing the buckets with larger streams.
-  uint32_t num_streams_reset = 0;
-  for (uint32_t buckets_cleared = 0; buckets_cleared < buckets_to_clear; ++buckets_cleared) {
-    const uint32_t bucket_to_clear =
-        BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_ - buckets_cleared - 1;
-    ENVOY_LOG_MISC(warn, "resetting {} streams in bucket {}.",
-                   size_class_account_sets_[bucket_to_clear].size(), bucket_to_clear);
-
-    auto it = size_class_account_sets_[bucket_to_clear].begin();
-    while (it != size_class_account_sets_[bucket_to_clear].end()) {
-      if (num_streams_reset >= kMaxNumberOfStreamsToResetPerInvocation) {
-        return num_streams_reset;
-      }
-      auto next = std::next(it);
-      // This will trigger an erase, which avoids rehashing and invalidates the
-      // iterator *it*. *next* is still valid.
-      (*it)->resetDownstream();
-      it = next;
-      ++num_streams_reset;
+  // Take the victims from the buckets with larger streams first. Accounts are
+  // only ordered by their exact balance here, within the one bucket that has
+  // more candidates than resets left, so that charging and crediting accounts
+  // never pays for it. Victims are collected before resetting any, since
+  // resetting a stream unregisters its account from its bucket.
+  std::vector<BufferMemoryAccountSharedPtr> victims;
+  for (uint32_t bucket = BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_;
+       bucket-- > last_bucket_to_clear &&
+       victims.size() < kMaxNumberOfStreamsToResetPerInvocation;) {
+    const auto& accounts = size_class_account_sets_[bucket];
+    const size_t resets_left = kMaxNumberOfStreamsToResetPerInvocation - victims.size();
+    const auto first = victims.insert(victims.end(), accounts.begin(), accounts.end());
+    if (accounts.size() > resets_left) {
+      std::partial_sort(first, first + resets_left, victims.end(),
+                        [](const BufferMemoryAccountSharedPtr& a,
+                           const BufferMemoryAccountSharedPtr& b) {
+                          return static_cast<BufferMemoryAccountImpl*>(a.get())->balance() >
+                                 static_cast<BufferMemoryAccountImpl*>(b.get())->balance();
+                        });
+      victims.resize(kMaxNumberOfStreamsToResetPerInvocation);
     }
   }
 
-  return num_streams_reset;
+  for (const auto& victim : victims) {
+    ENVOY_LOG_MISC(warn, "resetting stream using {} bytes in buffers.",
+                   static_cast<BufferMemoryAccountImpl*>(victim.get())->balance());
+    victim->resetDownstream();
+  }
+
+  return victims.size();
 }
 
 WatermarkBufferFactory::WatermarkBufferFactory(
@@ -181,6 +181,11 @@ private:
  *    *BufferMemoryAccountImpl::balanceToClassIndex()* for details on the memory
  *    class for a given account balance.
  *
+ * 3) Accounts only move when their memory class changes. When resetting
+ *    streams, the accounts of the last memory class which has more candidates
+ *    than resets left are ordered by their exact balance, so the fewest,
+ *    largest streams in the eligible memory classes are reset first.
+ *
  * TODO(kbaichoo): Update this documentation when we make the minimum account
  * threshold configurable.
  *
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <limits>
 
 #include "envoy/common/resource.h"
@@ -38,9 +39,10 @@ public:
   }
 
   uint64_t max() override {
+    const uint64_t max = max_.load();
     return (runtime_ != nullptr && runtime_key_.has_value())
-               ? runtime_->snapshot().getInteger(runtime_key_.value(), max_)
-               : max_;
+               ? runtime_->snapshot().getInteger(runtime_key_.value(), max)
+               : max;
   }
 
   uint64_t count() const override { return current_.load(); }
@@ -52,7 +54,8 @@ protected:
   std::atomic<uint64_t> current_{};
 
 private:
-  uint64_t max_;
+  // Atomic so that the limit can be changed while other threads use the resource.
+  std::atomic<uint64_t> max_;
   Runtime::Loader* runtime_{nullptr};
   const absl::optional<std::string> runtime_key_;
 };
@@ -43,6 +43,20 @@ public:
         version, absl::nullopt));
   }
 
+  /**
+   * Builds a decoded resource from a resource that was not wrapped in an
+   * envoy.service.discovery.v3.Resource, and that resource_decoder.prepareResource() prepared.
+   * This is equivalent to fromResource() for the same resource.
+   */
+  static DecodedResourceImplPtr fromPreparedResource(OpaqueResourceDecoder& resource_decoder,
+                                                     PreparedResourcePtr&& prepared,
+                                                     const std::string& version) {
+    ProtobufTypes::MessagePtr message = resource_decoder.finishResource(std::move(prepared));
+    const std::string name = resource_decoder.resourceName(*message);
+    return std::make_unique<DecodedResourceImpl>(std::move(message), name,
+                                                 std::vector<std::string>(), version);
+  }
+
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder,
                       const envoy::service::discovery::v3::Resource& resource)
       : DecodedResourceImpl(resource_decoder, resource.name(), resource.aliases(),
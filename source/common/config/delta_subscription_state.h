@@ -7,6 +7,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/config/new_delta_subscription_state.h"
 #include "source/common/config/old_delta_subscription_state.h"
+#include "source/common/config/resource_name_pool.h"
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/types/variant.h"
@@ -20,7 +21,8 @@ using DeltaSubscriptionStateVariant =
 class DeltaSubscriptionState : public Logger::Loggable<Logger::Id::config> {
 public:
   DeltaSubscriptionState(std::string type_url, UntypedConfigUpdateCallbacks& watch_map,
-                         const LocalInfo::LocalInfo& local_info, Event::Dispatcher& dispatcher);
+                         const LocalInfo::LocalInfo& local_info, Event::Dispatcher& dispatcher,
+                         ResourceNamePool& resource_names);
 
   void updateSubscriptionInterest(const absl::flat_hash_set<std::string>& cur_added,
                                   const absl::flat_hash_set<std::string>& cur_removed);
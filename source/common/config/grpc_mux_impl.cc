@@ -1,11 +1,15 @@
 #include "source/common/config/grpc_mux_impl.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/config/decoded_resource_impl.h"
 #include "source/common/config/utility.h"
 #include "source/common/memory/utils.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/btree_map.h"
 #include "absl/container/node_hash_set.h"
@@ -30,6 +34,16 @@ private:
   absl::flat_hash_set<GrpcMuxImpl*> muxes_;
 };
 using AllMuxes = ThreadSafeSingleton<AllMuxesState>;
+
+// Responses are prepared on up to this many threads, including the main thread, when they have
+// at least MinResourcesPerThread resources per thread. Below that, handing the resources to the
+// pool costs more than it saves.
+constexpr uint32_t MaxResourcePreparerThreads = 8;
+constexpr uint32_t MinResourcesPerThread = 256;
+
+uint32_t maxResourcePreparerThreads() {
+  return std::min(MaxResourcePreparerThreads, std::max(std::thread::hardware_concurrency(), 1U));
+}
 } // namespace
 
 GrpcMuxImpl::GrpcMuxImpl(const LocalInfo::LocalInfo& local_info,
@@ -37,12 +51,14 @@ GrpcMuxImpl::GrpcMuxImpl(const LocalInfo::LocalInfo& local_info,
                          const Protobuf::MethodDescriptor& service_method,
                          Random::RandomGenerator& random, Stats::Scope& scope,
                          const RateLimitSettings& rate_limit_settings, bool skip_subsequent_node,
-                         CustomConfigValidatorsPtr&& config_validators)
+                         CustomConfigValidatorsPtr&& config_validators,
+                         Thread::ThreadFactory& thread_factory)
     : grpc_stream_(this, std::move(async_client), service_method, random, dispatcher, scope,
                    rate_limit_settings),
       local_info_(local_info), skip_subsequent_node_(skip_subsequent_node),
-      config_validators_(std::move(config_validators)), first_stream_request_(true),
-      dispatcher_(dispatcher),
+      config_validators_(std::move(config_validators)),
+      resource_preparer_(thread_factory, maxResourcePreparerThreads(), MinResourcesPerThread),
+      first_stream_request_(true), dispatcher_(dispatcher),
       dynamic_update_callback_handle_(local_info.contextProvider().addDynamicContextUpdateCallback(
           [this](absl::string_view resource_type_url) {
             onDynamicContextUpdate(resource_type_url);
@@ -220,7 +236,17 @@ void GrpcMuxImpl::onDiscoveryResponse(
 
     const auto scoped_ttl_update = api_state.ttl_.scopedTtlUpdate();
 
-    for (const auto& resource : message->resources()) {
+    // Parsing and validating the resources of a large response dominates its cost, so do the
+    // thread-safe part of it on several threads up front. The resources are still finished, and
+    // any error is thrown, in order below.
+    std::vector<PreparedResourcePtr> prepared_resources;
+    if (Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.parallel_xds_resource_decoding")) {
+      prepared_resources = resource_preparer_.prepare(resource_decoder, message->resources());
+    }
+
+    for (int i = 0; i < message->resources().size(); ++i) {
+      const auto& resource = message->resources(i);
       // TODO(snowp): Check the underlying type when the resource is a Resource.
       if (!resource.Is<envoy::service::discovery::v3::Resource>() &&
           type_url != resource.type_url()) {
@@ -230,7 +256,11 @@ void GrpcMuxImpl::onDiscoveryResponse(
       }
 
       auto decoded_resource =
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info());
+          !prepared_resources.empty() && prepared_resources[i] != nullptr
+              ? DecodedResourceImpl::fromPreparedResource(
+                    resource_decoder, std::move(prepared_resources[i]), message->version_info())
+              : DecodedResourceImpl::fromResource(resource_decoder, resource,
+                                                  message->version_info());
 
       if (decoded_resource->ttl()) {
         api_state.ttl_.add(*decoded_resource->ttl(), decoded_resource->name());
@@ -19,6 +19,7 @@
 #include "source/common/config/api_version.h"
 #include "source/common/config/custom_config_validators.h"
 #include "source/common/config/grpc_stream.h"
+#include "source/common/config/parallel_resource_preparer.h"
 #include "source/common/config/ttl.h"
 #include "source/common/config/utility.h"
 
@@ -37,7 +38,7 @@ public:
               Event::Dispatcher& dispatcher, const Protobuf::MethodDescriptor& service_method,
               Random::RandomGenerator& random, Stats::Scope& scope,
               const RateLimitSettings& rate_limit_settings, bool skip_subsequent_node,
-              CustomConfigValidatorsPtr&& config_validators);
+              CustomConfigValidatorsPtr&& config_validators, Thread::ThreadFactory& thread_factory);
 
   ~GrpcMuxImpl() override;
 
@@ -64,6 +65,7 @@ public:
 
   void requestOnDemandUpdate(const std::string&, const absl::flat_hash_set<std::string>&) override {
   }
+  void onServerInitialized() override {}
 
   void handleDiscoveryResponse(
       std::unique_ptr<envoy::service::discovery::v3::DiscoveryResponse>&& message);
@@ -133,7 +135,7 @@ private:
   struct ApiState {
     ApiState(Event::Dispatcher& dispatcher,
              std::function<void(const std::vector<std::string>&)> callback)
-        : ttl_(callback, dispatcher, dispatcher.timeSource()) {}
+        : ttl_(callback, dispatcher, dispatcher.timeSource(), resource_names_) {}
 
     bool paused() const { return pauses_ > 0; }
 
@@ -149,6 +151,8 @@ private:
     bool subscribed_{};
     // This resource type must have a Node sent at next request.
     bool must_send_node_{};
+    // Must outlive ttl_.
+    ResourceNamePool resource_names_;
     TtlManager ttl_;
     // The identifier for the server that sent the most recent response, or
     // empty if there is none.
@@ -171,6 +175,8 @@ private:
   const LocalInfo::LocalInfo& local_info_;
   const bool skip_subsequent_node_;
   CustomConfigValidatorsPtr config_validators_;
+  // Prepares the resources of large responses on several threads.
+  ParallelResourcePreparer resource_preparer_;
   bool first_stream_request_;
 
   // Helper function for looking up and potentially allocating a new ApiState.
@@ -202,6 +208,7 @@ class NullGrpcMuxImpl : public GrpcMux,
                         GrpcStreamCallbacks<envoy::service::discovery::v3::DiscoveryResponse> {
 public:
   void start() override {}
+  void onServerInitialized() override {}
   ScopedResume pause(const std::string&) override {
     return std::make_unique<Cleanup>([] {});
   }
@@ -14,10 +14,12 @@ namespace Config {
 NewDeltaSubscriptionState::NewDeltaSubscriptionState(std::string type_url,
                                                      UntypedConfigUpdateCallbacks& watch_map,
                                                      const LocalInfo::LocalInfo& local_info,
-                                                     Event::Dispatcher& dispatcher)
+                                                     Event::Dispatcher& dispatcher,
+                                                     ResourceNamePool& resource_names)
     // TODO(snowp): Hard coding VHDS here is temporary until we can move it away from relying on
     // empty resources as updates.
     : supports_heartbeats_(type_url != "envoy.config.route.v3.VirtualHost"),
+      resource_names_(resource_names),
       ttl_(
           [this](const auto& expired) {
             Protobuf::RepeatedPtrField<std::string> removed_resources;
@@ -35,7 +37,7 @@ NewDeltaSubscriptionState::NewDeltaSubscriptionState(std::string type_url,
 
             watch_map_.onConfigUpdate({}, removed_resources, "");
           },
-          dispatcher, dispatcher.timeSource()),
+          dispatcher, dispatcher.timeSource(), resource_names_),
       type_url_(std::move(type_url)), watch_map_(watch_map), local_info_(local_info) {}
 
 void NewDeltaSubscriptionState::updateSubscriptionInterest(
@@ -49,13 +51,14 @@ void NewDeltaSubscriptionState::updateSubscriptionInterest(
     // transition it to requested. Otherwise mark it as a resource
     // waiting for the server to receive the version.
     if (auto it = wildcard_resource_state_.find(a); it != wildcard_resource_state_.end()) {
-      requested_resource_state_.insert_or_assign(a, ResourceState::withVersion(it->second));
+      requested_resource_state_.insert_or_assign(it->first, ResourceState::withVersion(it->second));
       wildcard_resource_state_.erase(it);
     } else if (it = ambiguous_resource_state_.find(a); it != ambiguous_resource_state_.end()) {
-      requested_resource_state_.insert_or_assign(a, ResourceState::withVersion(it->second));
+      requested_resource_state_.insert_or_assign(it->first, ResourceState::withVersion(it->second));
       ambiguous_resource_state_.erase(it);
     } else {
-      requested_resource_state_.insert_or_assign(a, ResourceState::waitingForServer());
+      requested_resource_state_.insert_or_assign(resource_names_.intern(a),
+                                                 ResourceState::waitingForServer());
     }
     ASSERT(requested_resource_state_.contains(a));
     ASSERT(!wildcard_resource_state_.contains(a));
@@ -282,17 +285,18 @@ NewDeltaSubscriptionState::getNextRequestAckless() {
       // Resources we are interested in, but are still waiting to get any version of from the
       // server, do not belong in initial_resource_versions. (But do belong in new subscriptions!)
       if (!resource_state.isWaitingForServer()) {
-        (*request.mutable_initial_resource_versions())[resource_name] = resource_state.version();
+        (*request.mutable_initial_resource_versions())[resource_name.name()] =
+            resource_state.version();
       }
       // We are going over a list of resources that we are interested in, so add them to
       // resource_names_subscribe.
-      names_added_.insert(resource_name);
+      names_added_.insert(resource_name.name());
     }
     for (auto const& [resource_name, resource_version] : wildcard_resource_state_) {
-      (*request.mutable_initial_resource_versions())[resource_name] = resource_version;
+      (*request.mutable_initial_resource_versions())[resource_name.name()] = resource_version;
     }
     for (auto const& [resource_name, resource_version] : ambiguous_resource_state_) {
-      (*request.mutable_initial_resource_versions())[resource_name] = resource_version;
+      (*request.mutable_initial_resource_versions())[resource_name.name()] = resource_version;
     }
     // If this is a legacy wildcard request, then make sure that the resource_names_subscribe is
     // empty.
@@ -315,7 +319,8 @@ NewDeltaSubscriptionState::getNextRequestAckless() {
 
 bool NewDeltaSubscriptionState::isInitialRequestForLegacyWildcard() {
   if (in_initial_legacy_wildcard_) {
-    requested_resource_state_.insert_or_assign(Wildcard, ResourceState::waitingForServer());
+    requested_resource_state_.insert_or_assign(resource_names_.intern(Wildcard),
+                                               ResourceState::waitingForServer());
     ASSERT(requested_resource_state_.contains(Wildcard));
     ASSERT(!wildcard_resource_state_.contains(Wildcard));
     ASSERT(!ambiguous_resource_state_.contains(Wildcard));
@@ -343,7 +348,7 @@ bool NewDeltaSubscriptionState::isInitialRequestForLegacyWildcard() {
   // If we requested only a wildcard resource then the second condition for using legacy wildcard
   // condition is met.
   return requested_resource_state_.size() == 1 &&
-         requested_resource_state_.begin()->first == Wildcard;
+         requested_resource_state_.begin()->first.name() == Wildcard;
 }
 
 envoy::service::discovery::v3::DeltaDiscoveryRequest
@@ -374,11 +379,19 @@ void NewDeltaSubscriptionState::addResourceStateFromServer(
     ASSERT(!wildcard_resource_state_.contains(resource.name()));
     ASSERT(!ambiguous_resource_state_.contains(resource.name()));
   } else {
-    // It is a resource that is a part of our wildcard request.
-    wildcard_resource_state_.insert_or_assign(resource.name(), resource.version());
-    // The resource could be ambiguous before, but now the ambiguity
-    // is resolved.
-    ambiguous_resource_state_.erase(resource.name());
+    // It is a resource that is a part of our wildcard request. The resource could be ambiguous
+    // before, but now the ambiguity is resolved, so reuse its interned name.
+    if (auto it = ambiguous_resource_state_.find(resource.name());
+        it != ambiguous_resource_state_.end()) {
+      wildcard_resource_state_.insert_or_assign(it->first, resource.version());
+      ambiguous_resource_state_.erase(it);
+    } else if (it = wildcard_resource_state_.find(resource.name());
+               it != wildcard_resource_state_.end()) {
+      it->second = resource.version();
+    } else {
+      wildcard_resource_state_.emplace(resource_names_.intern(resource.name()),
+                                       resource.version());
+    }
     ASSERT(!requested_resource_state_.contains(resource.name()));
     ASSERT(wildcard_resource_state_.contains(resource.name()));
     ASSERT(!ambiguous_resource_state_.contains(resource.name()));
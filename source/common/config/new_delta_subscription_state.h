@@ -10,11 +10,10 @@
 #include "source/common/common/logger.h"
 #include "source/common/config/api_version.h"
 #include "source/common/config/pausable_ack_queue.h"
+#include "source/common/config/resource_name_pool.h"
 #include "source/common/config/ttl.h"
 #include "source/common/config/watch_map.h"
 
-#include "absl/container/node_hash_map.h"
-
 namespace Envoy {
 namespace Config {
 
@@ -77,7 +76,8 @@ namespace Config {
 class NewDeltaSubscriptionState : public Logger::Loggable<Logger::Id::config> {
 public:
   NewDeltaSubscriptionState(std::string type_url, UntypedConfigUpdateCallbacks& watch_map,
-                            const LocalInfo::LocalInfo& local_info, Event::Dispatcher& dispatcher);
+                            const LocalInfo::LocalInfo& local_info, Event::Dispatcher& dispatcher,
+                            ResourceNamePool& resource_names);
 
   // Update which resources we're interested in subscribing to.
   void updateSubscriptionInterest(const absl::flat_hash_set<std::string>& cur_added,
@@ -146,18 +146,20 @@ private:
   // names we are currently interested in. Those in the waitingForServer state currently don't have
   // any version for that resource: we need to inform the server if we lose interest in them, but we
   // also need to *not* include them in the initial_resource_versions map upon a reconnect.
-  absl::node_hash_map<std::string, ResourceState> requested_resource_state_;
+  // The keys of all three maps are interned in resource_names_, which is shared with the WatchMap.
+  InternedResourceNameNodeMap<ResourceState> requested_resource_state_;
   // A map from resource name to per-resource version. The keys of this map are resource names we
   // have received as a part of the wildcard subscription.
-  absl::node_hash_map<std::string, std::string> wildcard_resource_state_;
+  InternedResourceNameNodeMap<std::string> wildcard_resource_state_;
   // Used for storing resources that we lost interest in, but could
   // also be a part of wildcard subscription.
-  absl::node_hash_map<std::string, std::string> ambiguous_resource_state_;
+  InternedResourceNameNodeMap<std::string> ambiguous_resource_state_;
 
   // Not all xDS resources supports heartbeats due to there being specific information encoded in
   // an empty response, which is indistinguishable from a heartbeat in some cases. For now we just
   // disable heartbeats for these resources (currently only VHDS).
   const bool supports_heartbeats_;
+  ResourceNamePool& resource_names_;
   TtlManager ttl_;
 
   const std::string type_url_;
@@ -12,6 +12,9 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Config {
 
@@ -32,6 +35,11 @@ private:
   absl::flat_hash_set<NewGrpcMuxImpl*> muxes_;
 };
 using AllMuxes = ThreadSafeSingleton<AllMuxesState>;
+
+// Type URLs never contain a newline, so keys of different types cannot collide.
+std::string snapshotKey(absl::string_view type_url, absl::string_view resource_name) {
+  return absl::StrCat(type_url, "\n", resource_name);
+}
 } // namespace
 
 NewGrpcMuxImpl::NewGrpcMuxImpl(Grpc::RawAsyncClientPtr&& async_client,
@@ -40,7 +48,8 @@ NewGrpcMuxImpl::NewGrpcMuxImpl(Grpc::RawAsyncClientPtr&& async_client,
                                Random::RandomGenerator& random, Stats::Scope& scope,
                                const RateLimitSettings& rate_limit_settings,
                                const LocalInfo::LocalInfo& local_info,
-                               CustomConfigValidatorsPtr&& config_validators)
+                               CustomConfigValidatorsPtr&& config_validators,
+                               KeyValueStorePtr&& snapshot_store)
     : grpc_stream_(this, std::move(async_client), service_method, random, dispatcher, scope,
                    rate_limit_settings),
       local_info_(local_info), config_validators_(std::move(config_validators)),
@@ -48,8 +57,13 @@ NewGrpcMuxImpl::NewGrpcMuxImpl(Grpc::RawAsyncClientPtr&& async_client,
           [this](absl::string_view resource_type_url) {
             onDynamicContextUpdate(resource_type_url);
           })),
-      dispatcher_(dispatcher) {
+      dispatcher_(dispatcher), snapshot_store_(std::move(snapshot_store)) {
   AllMuxes::get().insert(this);
+  if (snapshot_store_ != nullptr) {
+    replay_callback_ =
+        dispatcher_.createSchedulableCallback([this]() { replayRestoredResources(); });
+    loadSnapshot();
+  }
 }
 
 NewGrpcMuxImpl::~NewGrpcMuxImpl() { AllMuxes::get().erase(this); }
@@ -108,7 +122,24 @@ void NewGrpcMuxImpl::onDiscoveryResponse(
     }
   }
 
-  kickOffAck(sub->second->sub_state_.handleResponse(*message));
+  // The server is authoritative from its first response on, so restored resources that have not
+  // been delivered yet are stale. Their versions were not sent to the server, which will therefore
+  // never report them removed: forget them now, or they would be restored on every start.
+  if (!sub->second->restored_resources_.empty()) {
+    forgetRestoredResources(message->type_url(), sub->second->restored_resources_);
+    sub->second->restored_resources_.clear();
+  }
+  for (const auto& resource : sub->second->resources_to_replay_) {
+    snapshot_store_->remove(snapshotKey(message->type_url(), resource.name()));
+  }
+  sub->second->resources_to_replay_.Clear();
+
+  UpdateAck ack = sub->second->sub_state_.handleResponse(*message);
+  if (snapshot_store_ != nullptr &&
+      ack.error_detail_.code() == Grpc::Status::WellKnownGrpcStatus::Ok) {
+    updateSnapshot(*message);
+  }
+  kickOffAck(std::move(ack));
   Memory::Utils::tryShrinkHeap();
 }
 
@@ -164,6 +195,11 @@ GrpcMuxWatchPtr NewGrpcMuxImpl::addWatch(const std::string& type_url,
   }
 
   Watch* watch = entry->second->watch_map_.addWatch(callbacks, resource_decoder);
+  // A wildcard watch is interested in every restored resource of the type. Queue them before
+  // updateWatch() tries to send the initial request, so that it waits for their versions.
+  if (resources.empty() && !options.use_namespace_matching_) {
+    queueRestoredResources(*entry->second, {}, true);
+  }
   // updateWatch() queues a discovery request if any of 'resources' are not yet subscribed.
   updateWatch(type_url, watch, resources, options);
   return std::make_unique<WatchImpl>(type_url, watch, *this, options);
@@ -204,6 +240,7 @@ void NewGrpcMuxImpl::updateWatch(const std::string& type_url, Watch* watch,
   } else {
     sub->second->sub_state_.updateSubscriptionInterest(added_removed.added_,
                                                        added_removed.removed_);
+    queueRestoredResources(*sub->second, added_removed.added_, false);
   }
   // Tell the server about our change in interest, if any.
   if (sub->second->sub_state_.subscriptionUpdatePending()) {
@@ -233,12 +270,119 @@ void NewGrpcMuxImpl::removeWatch(const std::string& type_url, Watch* watch) {
 
 void NewGrpcMuxImpl::addSubscription(const std::string& type_url,
                                      const bool use_namespace_matching) {
-  subscriptions_.emplace(
-      type_url, std::make_unique<SubscriptionStuff>(type_url, local_info_, use_namespace_matching,
-                                                    dispatcher_, *config_validators_.get()));
+  auto subscription = std::make_unique<SubscriptionStuff>(
+      type_url, local_info_, use_namespace_matching, dispatcher_, *config_validators_.get());
+  if (auto restored = snapshot_resources_.extract(type_url); !restored.empty()) {
+    subscription->restored_resources_ = std::move(restored.mapped());
+  }
+  subscriptions_.emplace(type_url, std::move(subscription));
   subscription_ordering_.emplace_back(type_url);
 }
 
+void NewGrpcMuxImpl::loadSnapshot() {
+  uint64_t num_resources = 0;
+  snapshot_store_->iterate([this, &num_resources](const std::string& key,
+                                                  const std::string& value) {
+    envoy::service::discovery::v3::Resource resource;
+    if (!resource.ParseFromString(value) || !resource.has_resource()) {
+      ENVOY_LOG(warn, "Ignoring unparsable xDS snapshot entry {}", absl::CEscape(key));
+      return KeyValueStore::Iterate::Continue;
+    }
+    const std::string type_url = resource.resource().type_url();
+    const std::string name = resource.name();
+    snapshot_resources_[type_url][name] = std::move(resource);
+    ++num_resources;
+    return KeyValueStore::Iterate::Continue;
+  });
+  ENVOY_LOG(info, "Loaded {} resources of {} types from the xDS snapshot", num_resources,
+            snapshot_resources_.size());
+}
+
+void NewGrpcMuxImpl::queueRestoredResources(SubscriptionStuff& subscription,
+                                            const absl::flat_hash_set<std::string>& resource_names,
+                                            bool wildcard) {
+  if (subscription.restored_resources_.empty()) {
+    return;
+  }
+  if (wildcard) {
+    for (auto& [name, resource] : subscription.restored_resources_) {
+      UNREFERENCED_PARAMETER(name);
+      *subscription.resources_to_replay_.Add() = std::move(resource);
+    }
+    subscription.restored_resources_.clear();
+  } else {
+    for (const auto& name : resource_names) {
+      auto restored = subscription.restored_resources_.extract(name);
+      if (!restored.empty()) {
+        *subscription.resources_to_replay_.Add() = std::move(restored.mapped());
+      }
+    }
+  }
+  if (!subscription.resources_to_replay_.empty()) {
+    replay_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void NewGrpcMuxImpl::replayRestoredResources() {
+  // Replay in the order the subscriptions were added, so that e.g. restored clusters are
+  // delivered before their endpoints. Subscriptions added by the replayed updates are appended to
+  // the ordering and are replayed in the same pass.
+  for (const auto& type_url : subscription_ordering_) {
+    auto sub = subscriptions_.find(type_url);
+    if (sub == subscriptions_.end() || sub->second->resources_to_replay_.empty()) {
+      continue;
+    }
+    envoy::service::discovery::v3::DeltaDiscoveryResponse message;
+    message.set_type_url(type_url);
+    message.mutable_resources()->Swap(&sub->second->resources_to_replay_);
+    ENVOY_LOG(debug, "Restoring {} {} resources from the xDS snapshot", message.resources_size(),
+              type_url);
+    // The callbacks may add subscriptions, which invalidates 'sub'.
+    const UpdateAck ack = sub->second->sub_state_.handleResponse(message);
+    if (ack.error_detail_.code() != Grpc::Status::WellKnownGrpcStatus::Ok) {
+      // Forget the rejected resources, so that they are not restored again on the next start.
+      for (const auto& resource : message.resources()) {
+        snapshot_store_->remove(snapshotKey(type_url, resource.name()));
+      }
+    }
+  }
+  // The restored resource versions are now known, send the requests that were held back.
+  trySendDiscoveryRequests();
+}
+
+void NewGrpcMuxImpl::onServerInitialized() {
+  // No subscription of the initial configuration asked for these types, so their resources will
+  // not be delivered.
+  for (const auto& [type_url, resources] : snapshot_resources_) {
+    forgetRestoredResources(type_url, resources);
+  }
+  snapshot_resources_.clear();
+}
+
+void NewGrpcMuxImpl::forgetRestoredResources(const std::string& type_url,
+                                             const RestoredResources& resources) {
+  ENVOY_LOG(debug, "Forgetting {} undelivered {} resources from the xDS snapshot",
+            resources.size(), type_url);
+  for (const auto& [name, resource] : resources) {
+    UNREFERENCED_PARAMETER(resource);
+    snapshot_store_->remove(snapshotKey(type_url, name));
+  }
+}
+
+void NewGrpcMuxImpl::updateSnapshot(
+    const envoy::service::discovery::v3::DeltaDiscoveryResponse& message) {
+  for (const auto& resource : message.resources()) {
+    // Heartbeats and unresolved aliases carry no resource, the persisted one is still current.
+    if (resource.has_resource()) {
+      snapshot_store_->addOrUpdate(snapshotKey(message.type_url(), resource.name()),
+                                   resource.SerializeAsString());
+    }
+  }
+  for (const auto& name : message.removed_resources()) {
+    snapshot_store_->remove(snapshotKey(message.type_url(), name));
+  }
+}
+
 void NewGrpcMuxImpl::trySendDiscoveryRequests() {
   if (shutdown_) {
     return;
@@ -312,7 +456,7 @@ absl::optional<std::string> NewGrpcMuxImpl::whoWantsToSendDiscoveryRequest() {
   for (const auto& sub_type : subscription_ordering_) {
     auto sub = subscriptions_.find(sub_type);
     if (sub != subscriptions_.end() && sub->second->sub_state_.subscriptionUpdatePending() &&
-        !pausable_ack_queue_.paused(sub_type)) {
+        sub->second->resources_to_replay_.empty() && !pausable_ack_queue_.paused(sub_type)) {
       return sub->first;
     }
   }
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "envoy/common/key_value_store.h"
 #include "envoy/common/random_generator.h"
 #include "envoy/common/token_bucket.h"
 #include "envoy/config/grpc_mux.h"
@@ -34,7 +35,7 @@ public:
                  const Protobuf::MethodDescriptor& service_method, Random::RandomGenerator& random,
                  Stats::Scope& scope, const RateLimitSettings& rate_limit_settings,
                  const LocalInfo::LocalInfo& local_info,
-                 CustomConfigValidatorsPtr&& config_validators);
+                 CustomConfigValidatorsPtr&& config_validators, KeyValueStorePtr&& snapshot_store);
 
   ~NewGrpcMuxImpl() override;
 
@@ -74,22 +75,35 @@ public:
   // TODO(fredlas) remove this from the GrpcMux interface.
   void start() override;
 
+  // Forgets the snapshotted resources of the types that are still not subscribed to.
+  void onServerInitialized() override;
+
   GrpcStream<envoy::service::discovery::v3::DeltaDiscoveryRequest,
              envoy::service::discovery::v3::DeltaDiscoveryResponse>&
   grpcStreamForTest() {
     return grpc_stream_;
   }
 
+  // Resources restored from the snapshot store, by name.
+  using RestoredResources =
+      absl::flat_hash_map<std::string, envoy::service::discovery::v3::Resource>;
+
   struct SubscriptionStuff {
     SubscriptionStuff(const std::string& type_url, const LocalInfo::LocalInfo& local_info,
                       const bool use_namespace_matching, Event::Dispatcher& dispatcher,
                       CustomConfigValidators& config_validators)
         : watch_map_(use_namespace_matching, type_url, config_validators),
-          sub_state_(type_url, watch_map_, local_info, dispatcher) {}
+          sub_state_(type_url, watch_map_, local_info, dispatcher, watch_map_.resourceNames()) {}
 
     WatchMap watch_map_;
     DeltaSubscriptionState sub_state_;
     std::string control_plane_identifier_{};
+    // Resources restored from the snapshot store that no watch has asked for yet, by name. Cleared,
+    // and removed from the store, once the server sends the first response for the type.
+    RestoredResources restored_resources_;
+    // Restored resources waiting to be delivered to the watches. No discovery request is sent for
+    // the type until they are, so that the first request carries their versions.
+    Protobuf::RepeatedPtrField<envoy::service::discovery::v3::Resource> resources_to_replay_;
 
     SubscriptionStuff(const SubscriptionStuff&) = delete;
     SubscriptionStuff& operator=(const SubscriptionStuff&) = delete;
@@ -158,6 +172,26 @@ private:
   // Invoked when dynamic context parameters change for a resource type.
   void onDynamicContextUpdate(absl::string_view resource_type_url);
 
+  // Loads the resources persisted in snapshot_store_ into snapshot_resources_.
+  void loadSnapshot();
+
+  // Queues the restored resources of the subscription which are named in 'resource_names', or
+  // all of them if 'wildcard' is true, to be delivered to the watches by
+  // replayRestoredResources().
+  void queueRestoredResources(SubscriptionStuff& subscription,
+                              const absl::flat_hash_set<std::string>& resource_names,
+                              bool wildcard);
+
+  // Delivers the queued restored resources to the watches as if the server had sent them, without
+  // ACKing them.
+  void replayRestoredResources();
+
+  // Persists the resources added and removed by an accepted response in snapshot_store_.
+  void updateSnapshot(const envoy::service::discovery::v3::DeltaDiscoveryResponse& message);
+
+  // Removes restored resources that will never be delivered from snapshot_store_.
+  void forgetRestoredResources(const std::string& type_url, const RestoredResources& resources);
+
   // Resource (N)ACKs we're waiting to send, stored in the order that they should be sent in. All
   // of our different resource types' ACKs are mixed together in this queue. See class for
   // description of how it interacts with pause() and resume().
@@ -179,6 +213,13 @@ private:
   Common::CallbackHandlePtr dynamic_update_callback_handle_;
   Event::Dispatcher& dispatcher_;
 
+  // Persists the accepted resources across restarts, if configured.
+  KeyValueStorePtr snapshot_store_;
+  // Resources loaded from snapshot_store_ for types that have no subscription yet, by type_url
+  // and then by name. Removed from the store once the server is initialized.
+  absl::flat_hash_map<std::string, RestoredResources> snapshot_resources_;
+  Event::SchedulableCallbackPtr replay_callback_;
+
   // True iff Envoy is shutting down; no messages should be sent on the `grpc_stream_` when this is
   // true because it may contain dangling pointers.
   std::atomic<bool> shutdown_{false};
@@ -14,10 +14,12 @@ namespace Config {
 OldDeltaSubscriptionState::OldDeltaSubscriptionState(std::string type_url,
                                                      UntypedConfigUpdateCallbacks& watch_map,
                                                      const LocalInfo::LocalInfo& local_info,
-                                                     Event::Dispatcher& dispatcher)
+                                                     Event::Dispatcher& dispatcher,
+                                                     ResourceNamePool& resource_names)
     // TODO(snowp): Hard coding VHDS here is temporary until we can move it away from relying on
     // empty resources as updates.
     : supports_heartbeats_(type_url != "envoy.config.route.v3.VirtualHost"),
+      resource_names_(resource_names),
       ttl_(
           [this](const auto& expired) {
             Protobuf::RepeatedPtrField<std::string> removed_resources;
@@ -28,7 +30,7 @@ OldDeltaSubscriptionState::OldDeltaSubscriptionState(std::string type_url,
 
             watch_map_.onConfigUpdate({}, removed_resources, "");
           },
-          dispatcher, dispatcher.timeSource()),
+          dispatcher, dispatcher.timeSource(), resource_names_),
       type_url_(std::move(type_url)), watch_map_(watch_map), local_info_(local_info),
       dispatcher_(dispatcher) {}
 
@@ -147,7 +149,7 @@ void OldDeltaSubscriptionState::handleGoodResponse(
   // initial_resource_versions messages, but will remind us to explicitly tell the server "I'm
   // cancelling my subscription" when we lose interest.
   for (const auto& resource_name : message.removed_resources()) {
-    if (resource_names_.find(resource_name) != resource_names_.end()) {
+    if (resource_state_.contains(resource_name)) {
       setResourceWaitingForServer(resource_name);
     }
   }
@@ -182,13 +184,14 @@ OldDeltaSubscriptionState::getNextRequestAckless() {
       // Resources we are interested in, but are still waiting to get any version of from the
       // server, do not belong in initial_resource_versions. (But do belong in new subscriptions!)
       if (!resource_state.waitingForServer()) {
-        (*request.mutable_initial_resource_versions())[resource_name] = resource_state.version();
+        (*request.mutable_initial_resource_versions())[resource_name.name()] =
+            resource_state.version();
       }
       // As mentioned above, fill resource_names_subscribe with everything, including names we
       // have yet to receive any resource for unless this is a wildcard subscription, for which
       // the first request on a stream must be without any resource names.
       if (!wildcard_) {
-        names_added_.insert(resource_name);
+        names_added_.insert(resource_name.name());
       }
     }
     // Wildcard subscription initial requests must have no resource_names_subscribe.
@@ -229,18 +232,25 @@ void OldDeltaSubscriptionState::addResourceState(
     ttl_.clear(resource.name());
   }
 
-  resource_state_[resource.name()] = ResourceState(resource);
-  resource_names_.insert(resource.name());
+  setResourceState(resource.name(), ResourceState(resource));
 }
 
 void OldDeltaSubscriptionState::setResourceWaitingForServer(const std::string& resource_name) {
-  resource_state_[resource_name] = ResourceState();
-  resource_names_.insert(resource_name);
+  setResourceState(resource_name, ResourceState());
+}
+
+void OldDeltaSubscriptionState::setResourceState(const std::string& resource_name,
+                                                 ResourceState&& state) {
+  // Only intern the name of resources we don't track yet.
+  if (auto it = resource_state_.find(resource_name); it != resource_state_.end()) {
+    it->second = std::move(state);
+  } else {
+    resource_state_.emplace(resource_names_.intern(resource_name), std::move(state));
+  }
 }
 
 void OldDeltaSubscriptionState::removeResourceState(const std::string& resource_name) {
   resource_state_.erase(resource_name);
-  resource_names_.erase(resource_name);
 }
 
 } // namespace Config
@@ -10,11 +10,10 @@
 #include "source/common/common/logger.h"
 #include "source/common/config/api_version.h"
 #include "source/common/config/pausable_ack_queue.h"
+#include "source/common/config/resource_name_pool.h"
 #include "source/common/config/ttl.h"
 #include "source/common/config/watch_map.h"
 
-#include "absl/container/node_hash_map.h"
-
 namespace Envoy {
 namespace Config {
 
@@ -25,7 +24,8 @@ namespace Config {
 class OldDeltaSubscriptionState : public Logger::Loggable<Logger::Id::config> {
 public:
   OldDeltaSubscriptionState(std::string type_url, UntypedConfigUpdateCallbacks& watch_map,
-                            const LocalInfo::LocalInfo& local_info, Event::Dispatcher& dispatcher);
+                            const LocalInfo::LocalInfo& local_info, Event::Dispatcher& dispatcher,
+                            ResourceNamePool& resource_names);
 
   // Update which resources we're interested in subscribing to.
   void updateSubscriptionInterest(const absl::flat_hash_set<std::string>& cur_added,
@@ -78,27 +78,27 @@ private:
     absl::optional<std::string> version_;
   };
 
-  // Use these helpers to ensure resource_state_ and resource_names_ get updated together.
+  // Use these helpers to ensure resource_state_ and the TtlManager get updated together.
   void addResourceState(const envoy::service::discovery::v3::Resource& resource);
   void setResourceWaitingForServer(const std::string& resource_name);
   void removeResourceState(const std::string& resource_name);
+  void setResourceState(const std::string& resource_name, ResourceState&& state);
 
   void populateDiscoveryRequest(envoy::service::discovery::v3::DeltaDiscoveryResponse& request);
 
   // A map from resource name to per-resource version. The keys of this map are exactly the resource
   // names we are currently interested in. Those in the waitingForServer state currently don't have
   // any version for that resource: we need to inform the server if we lose interest in them, but we
-  // also need to *not* include them in the initial_resource_versions map upon a reconnect.
-  absl::node_hash_map<std::string, ResourceState> resource_state_;
+  // also need to *not* include them in the initial_resource_versions map upon a reconnect. The keys
+  // are interned in resource_names_, which is shared with the WatchMap.
+  InternedResourceNameNodeMap<ResourceState> resource_state_;
 
   // Not all xDS resources supports heartbeats due to there being specific information encoded in
   // an empty response, which is indistinguishable from a heartbeat in some cases. For now we just
   // disable heartbeats for these resources (currently only VHDS).
   const bool supports_heartbeats_;
+  ResourceNamePool& resource_names_;
   TtlManager ttl_;
-  // The keys of resource_versions_. Only tracked separately because std::map does not provide an
-  // iterator into just its keys.
-  absl::flat_hash_set<std::string> resource_names_;
 
   const std::string type_url_;
   // Is the subscription is for a wildcard request.
@@ -24,11 +24,54 @@ public:
     return typed_message;
   }
 
+  PreparedResourcePtr prepareResource(const ProtobufWkt::Any& resource) override {
+    auto prepared = std::make_unique<PreparedResourceImpl>();
+    if (resource.type_url().empty()) {
+      return prepared;
+    }
+    prepared->has_payload_ = true;
+    prepared->unpack_status_ = MessageUtil::unpackToNoThrow(resource, *prepared->typed_message_);
+    if (prepared->unpack_status_.ok()) {
+      // The protoc-gen-validate check is the same one MessageUtil::validate() makes, but does
+      // not involve the validation visitor, so it can run here.
+      std::string err;
+      if (!Validate(*prepared->typed_message_, &err)) {
+        prepared->validation_error_ = std::move(err);
+      }
+    }
+    return prepared;
+  }
+
+  ProtobufTypes::MessagePtr finishResource(PreparedResourcePtr&& prepared_resource) override {
+    auto& prepared = dynamic_cast<PreparedResourceImpl&>(*prepared_resource);
+    if (prepared.has_payload_) {
+      // Report errors in the order MessageUtil::anyConvertAndValidate() finds them.
+      if (!prepared.unpack_status_.ok()) {
+        throw EnvoyException(std::string(prepared.unpack_status_.message()));
+      }
+      if (!validation_visitor_.skipValidation()) {
+        MessageUtil::checkForUnexpectedFields(*prepared.typed_message_, validation_visitor_);
+      }
+      if (prepared.validation_error_.has_value()) {
+        ProtoExceptionUtil::throwProtoValidationException(prepared.validation_error_.value(),
+                                                          *prepared.typed_message_);
+      }
+    }
+    return std::move(prepared.typed_message_);
+  }
+
   std::string resourceName(const Protobuf::Message& resource) override {
     return MessageUtil::getStringField(resource, name_field_);
   }
 
 private:
+  struct PreparedResourceImpl : public PreparedResource {
+    std::unique_ptr<Current> typed_message_{std::make_unique<Current>()};
+    bool has_payload_{};
+    absl::Status unpack_status_;
+    absl::optional<std::string> validation_error_;
+  };
+
   ProtobufMessage::ValidationVisitor& validation_visitor_;
   const std::string name_field_;
 };
@@ -0,0 +1,123 @@
+#include "source/common/config/parallel_resource_preparer.h"
+
+#include <algorithm>
+
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/common/fmt.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+// Resources are handed out to threads in batches, so that threads do not contend on the shared
+// index for every resource, while still balancing resources of uneven size.
+constexpr int ResourcesPerBatch = 64;
+
+} // namespace
+
+ParallelResourcePreparer::ParallelResourcePreparer(Thread::ThreadFactory& thread_factory,
+                                                   uint32_t max_threads,
+                                                   uint32_t min_resources_per_thread)
+    : thread_factory_(thread_factory), max_threads_(std::max<uint32_t>(max_threads, 1)),
+      min_resources_per_thread_(std::max<uint32_t>(min_resources_per_thread, 1)) {}
+
+ParallelResourcePreparer::~ParallelResourcePreparer() {
+  {
+    Thread::LockGuard guard(mutex_);
+    shutdown_ = true;
+  }
+  job_started_.notifyAll();
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+std::vector<PreparedResourcePtr>
+ParallelResourcePreparer::prepare(OpaqueResourceDecoder& resource_decoder,
+                                  const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources) {
+  const int num_resources = resources.size();
+  const uint32_t num_threads =
+      std::min<uint32_t>(max_threads_, num_resources / min_resources_per_thread_);
+  if (num_threads < 2) {
+    return {};
+  }
+  if (threads_.empty()) {
+    startThreads();
+  }
+
+  // Each slot of 'prepared' is written by exactly one thread, and read once every pool thread is
+  // done with the job.
+  std::vector<PreparedResourcePtr> prepared(num_resources);
+  Job job(resource_decoder, resources, prepared);
+  {
+    Thread::LockGuard guard(mutex_);
+    job_ = &job;
+    ++job_generation_;
+    busy_threads_ = threads_.size();
+  }
+  job_started_.notifyAll();
+  prepareBatches(job);
+  {
+    Thread::LockGuard guard(mutex_);
+    while (busy_threads_ > 0) {
+      job_done_.wait(mutex_);
+    }
+    job_ = nullptr;
+  }
+  return prepared;
+}
+
+void ParallelResourcePreparer::startThreads() {
+  threads_.reserve(max_threads_ - 1);
+  for (uint32_t i = 1; i < max_threads_; ++i) {
+    threads_.push_back(thread_factory_.createThread(
+        [this]() { threadRoutine(); }, Thread::Options{fmt::format("xds_decode:{}", i)}));
+  }
+}
+
+void ParallelResourcePreparer::threadRoutine() {
+  uint64_t last_generation = 0;
+  while (true) {
+    Job* job;
+    {
+      Thread::LockGuard guard(mutex_);
+      while (!shutdown_ && job_generation_ == last_generation) {
+        job_started_.wait(mutex_);
+      }
+      if (shutdown_) {
+        return;
+      }
+      last_generation = job_generation_;
+      job = job_;
+    }
+
+    prepareBatches(*job);
+
+    bool last_done;
+    {
+      Thread::LockGuard guard(mutex_);
+      last_done = --busy_threads_ == 0;
+    }
+    if (last_done) {
+      job_done_.notifyOne();
+    }
+  }
+}
+
+void ParallelResourcePreparer::prepareBatches(Job& job) {
+  const int num_resources = job.resources_.size();
+  for (int begin = job.next_batch_.fetch_add(ResourcesPerBatch); begin < num_resources;
+       begin = job.next_batch_.fetch_add(ResourcesPerBatch)) {
+    const int end = std::min(begin + ResourcesPerBatch, num_resources);
+    for (int i = begin; i < end; ++i) {
+      const ProtobufWkt::Any& resource = job.resources_[i];
+      if (!resource.Is<envoy::service::discovery::v3::Resource>()) {
+        job.prepared_[i] = job.resource_decoder_.prepareResource(resource);
+      }
+    }
+  }
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "envoy/config/subscription.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/thread.h"
+#include "source/common/protobuf/protobuf.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * Runs OpaqueResourceDecoder::prepareResource(), which parses and checks the protoc-gen-validate
+ * constraints of a resource, for the resources of a large discovery response on several threads.
+ * Parsing dominates the cost of decoding a large response (e.g. a CDS response with tens of
+ * thousands of clusters), so this shortens the time the calling thread spends on it. The calling
+ * thread takes part in the work, helped by a pool of threads that is started by the first
+ * response large enough to need it and lives as long as the preparer. prepare() must only be called
+ * from one thread at a time.
+ */
+class ParallelResourcePreparer {
+public:
+  /**
+   * @param thread_factory creates the pool of threads that help the calling thread.
+   * @param max_threads the maximum number of threads preparing resources, including the calling
+   *        thread.
+   * @param min_resources_per_thread the minimum number of resources per thread. Responses with
+   *        fewer than twice this many resources are not worth spreading over threads.
+   */
+  ParallelResourcePreparer(Thread::ThreadFactory& thread_factory, uint32_t max_threads,
+                           uint32_t min_resources_per_thread);
+  ~ParallelResourcePreparer();
+
+  /**
+   * @param resource_decoder the decoder for the resources.
+   * @param resources the resources of a discovery response.
+   * @return one prepared resource per resource, in order. Resources wrapped in an
+   *         envoy.service.discovery.v3.Resource are not prepared, and have a nullptr entry. If
+   *         there are too few resources to be worth spreading over threads, the result is empty.
+   */
+  std::vector<PreparedResourcePtr>
+  prepare(OpaqueResourceDecoder& resource_decoder,
+          const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources);
+
+private:
+  // The resources of the response being prepared, shared by the calling thread and the pool.
+  struct Job {
+    Job(OpaqueResourceDecoder& resource_decoder,
+        const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
+        std::vector<PreparedResourcePtr>& prepared)
+        : resource_decoder_(resource_decoder), resources_(resources), prepared_(prepared) {}
+
+    OpaqueResourceDecoder& resource_decoder_;
+    const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources_;
+    std::vector<PreparedResourcePtr>& prepared_;
+    std::atomic<int> next_batch_{0};
+  };
+
+  void startThreads();
+  void threadRoutine();
+  static void prepareBatches(Job& job);
+
+  Thread::ThreadFactory& thread_factory_;
+  const uint32_t max_threads_;
+  const uint32_t min_resources_per_thread_;
+  Thread::MutexBasicLockable mutex_;
+  // Signaled when a job is started or the pool is shut down.
+  Thread::CondVar job_started_;
+  // Signaled when the last pool thread is done with the current job.
+  Thread::CondVar job_done_;
+  Job* job_ ABSL_GUARDED_BY(mutex_){};
+  // Incremented for every job, so that a pool thread takes part in each job once.
+  uint64_t job_generation_ ABSL_GUARDED_BY(mutex_){};
+  uint32_t busy_threads_ ABSL_GUARDED_BY(mutex_){};
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using ParallelResourcePreparerPtr = std::unique_ptr<ParallelResourcePreparer>;
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,24 @@
+#include "source/common/config/resource_name_pool.h"
+
+namespace Envoy {
+namespace Config {
+
+InternedResourceName ResourceNamePool::intern(absl::string_view name) {
+  auto it = names_.find(name);
+  if (it == names_.end()) {
+    auto entry = std::make_unique<InternedResourceName::Entry>(name, *this);
+    const absl::string_view key = entry->name_;
+    it = names_.emplace(key, std::move(entry)).first;
+  }
+  return InternedResourceName(*it->second);
+}
+
+void ResourceNamePool::release(InternedResourceName::Entry& entry) {
+  auto it = names_.find(absl::string_view(entry.name_));
+  ASSERT(it != names_.end() && it->second.get() == &entry);
+  // Destroys the entry, so it must not be used past this point.
+  names_.erase(it);
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "source/common/common/assert.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Config {
+
+class ResourceNamePool;
+
+/**
+ * A reference counted handle to a resource name interned in a ResourceNamePool. A handle is the
+ * size of a pointer, and all the handles to a name share a single copy of it. The name is dropped
+ * from the pool when its last handle is destroyed, so handles must not outlive their pool. Like
+ * the rest of the xDS machinery, handles and pools are not thread safe.
+ */
+class InternedResourceName {
+public:
+  InternedResourceName(const InternedResourceName& other) : entry_(other.entry_) {
+    if (entry_ != nullptr) {
+      ++entry_->ref_count_;
+    }
+  }
+  InternedResourceName(InternedResourceName&& other) noexcept : entry_(other.entry_) {
+    other.entry_ = nullptr;
+  }
+  InternedResourceName& operator=(InternedResourceName other) noexcept {
+    std::swap(entry_, other.entry_);
+    return *this;
+  }
+  ~InternedResourceName();
+
+  const std::string& name() const {
+    ASSERT(entry_ != nullptr);
+    return entry_->name_;
+  }
+
+  // Names interned in the same pool share their entry, so the comparison of the entries is a fast
+  // path for the common case.
+  bool operator==(const InternedResourceName& other) const {
+    return entry_ == other.entry_ || name() == other.name();
+  }
+  bool operator!=(const InternedResourceName& other) const { return !(*this == other); }
+  bool operator<(const InternedResourceName& other) const { return name() < other.name(); }
+
+private:
+  friend class ResourceNamePool;
+
+  struct Entry {
+    Entry(absl::string_view name, ResourceNamePool& pool) : name_(name), pool_(pool) {}
+
+    const std::string name_;
+    ResourceNamePool& pool_;
+    uint32_t ref_count_{};
+  };
+
+  explicit InternedResourceName(Entry& entry) : entry_(&entry) { ++entry_->ref_count_; }
+
+  Entry* entry_;
+};
+
+/**
+ * Interns the resource names of a single xDS type, so that the WatchMap, the subscription state
+ * and the TtlManager of the type share a single copy of each name, however many of them track it.
+ */
+class ResourceNamePool {
+public:
+  ResourceNamePool() = default;
+  ~ResourceNamePool() { ASSERT(names_.empty()); }
+
+  // Returns a handle to the pooled copy of 'name', adding it to the pool if needed.
+  InternedResourceName intern(absl::string_view name);
+
+  // Returns the number of distinct names currently in the pool.
+  size_t size() const { return names_.size(); }
+
+  ResourceNamePool(const ResourceNamePool&) = delete;
+  ResourceNamePool& operator=(const ResourceNamePool&) = delete;
+
+private:
+  friend class InternedResourceName;
+
+  void release(InternedResourceName::Entry& entry);
+
+  // The keys point into the names of the entries they map to.
+  absl::flat_hash_map<absl::string_view, std::unique_ptr<InternedResourceName::Entry>> names_;
+};
+
+inline InternedResourceName::~InternedResourceName() {
+  if (entry_ != nullptr && --entry_->ref_count_ == 0) {
+    entry_->pool_.release(*entry_);
+  }
+}
+
+/**
+ * Hashes and compares interned names by their contents, so that containers keyed by
+ * InternedResourceName can be looked up by plain names without interning them.
+ */
+struct InternedResourceNameHash {
+  using is_transparent = void;
+
+  size_t operator()(absl::string_view name) const { return absl::Hash<absl::string_view>()(name); }
+  size_t operator()(const InternedResourceName& name) const {
+    return absl::Hash<absl::string_view>()(name.name());
+  }
+};
+
+struct InternedResourceNameEq {
+  using is_transparent = void;
+
+  bool operator()(const InternedResourceName& lhs, const InternedResourceName& rhs) const {
+    return lhs == rhs;
+  }
+  bool operator()(const InternedResourceName& lhs, absl::string_view rhs) const {
+    return lhs.name() == rhs;
+  }
+  bool operator()(absl::string_view lhs, const InternedResourceName& rhs) const {
+    return lhs == rhs.name();
+  }
+  bool operator()(absl::string_view lhs, absl::string_view rhs) const { return lhs == rhs; }
+};
+
+using InternedResourceNameSet =
+    absl::flat_hash_set<InternedResourceName, InternedResourceNameHash, InternedResourceNameEq>;
+
+template <class Value>
+using InternedResourceNameMap =
+    absl::flat_hash_map<InternedResourceName, Value, InternedResourceNameHash,
+                        InternedResourceNameEq>;
+
+template <class Value>
+using InternedResourceNameNodeMap =
+    absl::node_hash_map<InternedResourceName, Value, InternedResourceNameHash,
+                        InternedResourceNameEq>;
+
+} // namespace Config
+} // namespace Envoy
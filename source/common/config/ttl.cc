@@ -4,8 +4,10 @@ namespace Envoy {
 namespace Config {
 
 TtlManager::TtlManager(std::function<void(const std::vector<std::string>&)> callback,
-                       Event::Dispatcher& dispatcher, TimeSource& time_source)
-    : callback_(callback), dispatcher_(dispatcher), time_source_(time_source) {
+                       Event::Dispatcher& dispatcher, TimeSource& time_source,
+                       ResourceNamePool& resource_names)
+    : resource_names_(resource_names), callback_(callback), dispatcher_(dispatcher),
+      time_source_(time_source) {
   timer_ = dispatcher_.createTimer([this]() {
     ScopedTtlUpdate scoped_update(*this);
 
@@ -15,7 +17,7 @@ TtlManager::TtlManager(std::function<void(const std::vector<std::string>&)> call
     const auto now = time_source_.monotonicTime();
     auto itr = ttls_.begin();
     while (itr != ttls_.end() && itr->first <= now) {
-      expired.push_back(itr->second);
+      expired.push_back(itr->second.name());
       ttl_lookup_.erase(itr->second);
       itr++;
     }
@@ -34,8 +36,9 @@ void TtlManager::add(std::chrono::milliseconds ttl, const std::string& name) {
 
   clear(name);
 
-  auto itr_and_inserted = ttls_.insert({time_source_.monotonicTime() + ttl, name});
-  ttl_lookup_[name] = itr_and_inserted.first;
+  InternedResourceName interned_name = resource_names_.intern(name);
+  auto itr_and_inserted = ttls_.insert({time_source_.monotonicTime() + ttl, interned_name});
+  ttl_lookup_.emplace(std::move(interned_name), itr_and_inserted.first);
 }
 
 void TtlManager::clear(const std::string& name) {
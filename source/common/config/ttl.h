@@ -5,6 +5,8 @@
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
 
+#include "source/common/config/resource_name_pool.h"
+
 namespace Envoy {
 namespace Config {
 
@@ -20,12 +22,15 @@ namespace Config {
  *
  * As a result of these two data structures, all lookups and modifications can be performed in
  * O(log (number of TTL entries)). This comes at the cost of a higher memory overhead versus just
- * using a single data structure.
+ * using a single data structure, which is kept down by having both data structures refer to the
+ * resource names interned in a ResourceNamePool rather than holding copies of the names.
  */
 class TtlManager {
 public:
+  // The names of the resources are interned in 'resource_names', which must outlive the manager.
   TtlManager(std::function<void(const std::vector<std::string>&)> callback,
-             Event::Dispatcher& dispatcher, TimeSource& time_source);
+             Event::Dispatcher& dispatcher, TimeSource& time_source,
+             ResourceNamePool& resource_names);
 
   // RAII tracker to simplify managing when we should be running the update callbacks.
   class ScopedTtlUpdate {
@@ -53,9 +58,10 @@ public:
 private:
   void refreshTimer();
 
-  using TtlSet = std::set<std::pair<MonotonicTime, std::string>>;
+  ResourceNamePool& resource_names_;
+  using TtlSet = std::set<std::pair<MonotonicTime, InternedResourceName>>;
   TtlSet ttls_;
-  absl::flat_hash_map<std::string, TtlSet::iterator> ttl_lookup_;
+  InternedResourceNameMap<TtlSet::iterator> ttl_lookup_;
 
   Event::TimerPtr timer_;
   absl::optional<MonotonicTime> last_scheduled_time_;
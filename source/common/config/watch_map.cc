@@ -57,15 +57,31 @@ WatchMap::updateWatchInterest(Watch* watch,
   }
 
   absl::flat_hash_set<std::string> newly_added_to_watch;
-  SetUtil::setDifference(update_to_these_names, watch->resource_names_, newly_added_to_watch);
+  for (const auto& name : update_to_these_names) {
+    if (!watch->resource_names_.contains(name)) {
+      newly_added_to_watch.insert(name);
+    }
+  }
 
   absl::flat_hash_set<std::string> newly_removed_from_watch;
-  SetUtil::setDifference(watch->resource_names_, update_to_these_names, newly_removed_from_watch);
+  for (const auto& name : watch->resource_names_) {
+    if (!update_to_these_names.contains(name.name())) {
+      newly_removed_from_watch.insert(name.name());
+    }
+  }
 
-  watch->resource_names_ = update_to_these_names;
+  AddedRemoved added_removed(findAdditions(newly_added_to_watch, watch),
+                             findRemovals(newly_removed_from_watch, watch));
 
-  return AddedRemoved(findAdditions(newly_added_to_watch, watch),
-                      findRemovals(newly_removed_from_watch, watch));
+  // Only the names which changed are touched, so that the watch keeps sharing the pooled copies of
+  // the names it already had.
+  for (const auto& name : newly_removed_from_watch) {
+    watch->resource_names_.erase(name);
+  }
+  for (const auto& name : newly_added_to_watch) {
+    watch->resource_names_.insert(resource_names_.intern(name));
+  }
+  return added_removed;
 }
 
 absl::flat_hash_set<Watch*> WatchMap::watchesInterestedIn(const std::string& resource_name) {
@@ -258,7 +274,7 @@ WatchMap::findAdditions(const absl::flat_hash_set<std::string>& newly_added_to_w
     auto entry = watch_interest_.find(name);
     if (entry == watch_interest_.end()) {
       newly_added_to_subscription.insert(name);
-      watch_interest_[name] = {watch};
+      watch_interest_.emplace(resource_names_.intern(name), absl::flat_hash_set<Watch*>{watch});
     } else {
       // Add this watch to the already-existing set at watch_interest_[name]
       entry->second.insert(watch);
@@ -10,6 +10,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/custom_config_validators.h"
+#include "source/common/config/resource_name_pool.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -29,7 +30,7 @@ struct Watch {
       : callbacks_(callbacks), resource_decoder_(resource_decoder) {}
   SubscriptionCallbacks& callbacks_;
   OpaqueResourceDecoder& resource_decoder_;
-  absl::flat_hash_set<std::string> resource_names_;
+  InternedResourceNameSet resource_names_;
   // Needed only for state-of-the-world.
   // Whether the most recent update contained any resources this watch cares about.
   // If true, a new update that also contains no resources can skip this watch.
@@ -96,6 +97,10 @@ public:
       const std::string& system_version_info) override;
   void onConfigUpdateFailed(ConfigUpdateFailureReason reason, const EnvoyException* e) override;
 
+  // The pool interning the resource names of this type_url. It is shared with the subscription
+  // state and the TtlManager of the type, so that they all point at a single copy of each name.
+  ResourceNamePool& resourceNames() { return resource_names_; }
+
   WatchMap(const WatchMap&) = delete;
   WatchMap& operator=(const WatchMap&) = delete;
 
@@ -115,6 +120,9 @@ private:
   // Returns the union of watch_interest_[resource_name] and wildcard_watches_.
   absl::flat_hash_set<Watch*> watchesInterestedIn(const std::string& resource_name);
 
+  // Declared first so that it outlives every interned name held by the members below.
+  ResourceNamePool resource_names_;
+
   absl::flat_hash_set<std::unique_ptr<Watch>> watches_;
 
   // Watches whose interest set is currently empty, which is interpreted as "everything".
@@ -128,7 +136,7 @@ private:
   // Maps a resource name to the set of watches interested in that resource. Has two purposes:
   // 1) Acts as a reference count; no watches care anymore ==> the resource can be removed.
   // 2) Enables efficient lookup of all interested watches when a resource has been updated.
-  absl::flat_hash_map<std::string, absl::flat_hash_set<Watch*>> watch_interest_;
+  InternedResourceNameMap<absl::flat_hash_set<Watch*>> watch_interest_;
 
   const bool use_namespace_matching_;
   const std::string type_url_;
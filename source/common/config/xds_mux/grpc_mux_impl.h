@@ -91,6 +91,7 @@ public:
   ScopedResume pause(const std::string& type_url) override;
   ScopedResume pause(const std::vector<std::string> type_urls) override;
   void start() override;
+  void onServerInitialized() override {}
   const absl::flat_hash_map<std::string, std::unique_ptr<S>>& subscriptions() const {
     return subscriptions_;
   }
@@ -243,6 +244,7 @@ public:
 class NullGrpcMuxImpl : public GrpcMux {
 public:
   void start() override {}
+  void onServerInitialized() override {}
 
   ScopedResume pause(const std::string&) override {
     return std::make_unique<Cleanup>([]() {});
@@ -34,7 +34,7 @@ public:
   BaseSubscriptionState(std::string type_url, UntypedConfigUpdateCallbacks& callbacks,
                         Event::Dispatcher& dispatcher)
       : ttl_([this](const std::vector<std::string>& expired) { ttlExpiryCallback(expired); },
-             dispatcher, dispatcher.timeSource()),
+             dispatcher, dispatcher.timeSource(), resource_names_),
         type_url_(std::move(type_url)), callbacks_(callbacks), dispatcher_(dispatcher) {}
 
   virtual ~BaseSubscriptionState() = default;
@@ -108,6 +108,8 @@ protected:
   std::string typeUrl() const { return type_url_; }
   UntypedConfigUpdateCallbacks& callbacks() const { return callbacks_; }
 
+  // Must outlive ttl_.
+  ResourceNamePool resource_names_;
   TtlManager ttl_;
   const std::string type_url_;
   // callbacks_ is expected (outside of tests) to be a WatchMap.
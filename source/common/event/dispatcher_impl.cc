@@ -302,6 +302,16 @@ MonotonicTime DispatcherImpl::approximateMonotonicTime() const {
   return approximate_monotonic_time_;
 }
 
+void DispatcherImpl::enableEventLoopTimes() {
+  ASSERT(isThreadSafe());
+  base_scheduler_.enableEventLoopTimes();
+}
+
+EventLoopTimes DispatcherImpl::eventLoopTimes() const {
+  ASSERT(isThreadSafe());
+  return base_scheduler_.eventLoopTimes();
+}
+
 void DispatcherImpl::shutdown() {
   // TODO(lambdai): Resolve https://github.com/envoyproxy/envoy/issues/15072 and loop delete below
   // below 3 lists until all lists are empty. The 3 lists are list of deferred delete objects, post
@@ -96,6 +96,8 @@ public:
   void popTrackedObject(const ScopeTrackedObject* expected_object) override;
   bool trackedObjectStackIsEmpty() const override { return tracked_object_stack_.empty(); }
   MonotonicTime approximateMonotonicTime() const override;
+  void enableEventLoopTimes() override;
+  EventLoopTimes eventLoopTimes() const override;
   void updateApproximateMonotonicTime() override;
   void shutdown() override;
 
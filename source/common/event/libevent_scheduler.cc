@@ -10,8 +10,12 @@ namespace Envoy {
 namespace Event {
 
 namespace {
+std::chrono::microseconds toMicroseconds(const timeval& tv) {
+  return std::chrono::microseconds(tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
 void recordTimeval(Stats::Histogram& histogram, const timeval& tv) {
-  histogram.recordValue(tv.tv_sec * 1000000 + tv.tv_usec);
+  histogram.recordValue(toMicroseconds(tv).count());
 }
 } // namespace
 
@@ -72,11 +76,32 @@ void LibeventScheduler::registerOnPrepareCallback(OnPrepareCallback&& callback)
 
 void LibeventScheduler::initializeStats(DispatcherStats* stats) {
   stats_ = stats;
+  enableEventLoopTimes();
+}
+
+void LibeventScheduler::enableEventLoopTimes() {
+  if (timing_enabled_) {
+    return;
+  }
+  timing_enabled_ = true;
   // These are thread safe.
   evwatch_prepare_new(libevent_.get(), &onPrepareForStats, this);
   evwatch_check_new(libevent_.get(), &onCheckForStats, this);
 }
 
+EventLoopTimes LibeventScheduler::eventLoopTimes() const {
+  EventLoopTimes times{busy_time_, polling_time_};
+  // Account for the callbacks of the current iteration, which have not reached the next prepare
+  // watcher yet.
+  if (!polling_ && check_time_.tv_sec != 0) {
+    timeval now, delta;
+    evutil_gettimeofday(&now, nullptr);
+    evutil_timersub(&now, &check_time_, &delta);
+    times.busy_ += toMicroseconds(delta);
+  }
+  return times;
+}
+
 void LibeventScheduler::onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info*, void* arg) {
   // `self` is `this`, passed in from evwatch_prepare_new.
   auto self = static_cast<LibeventScheduler*>(arg);
@@ -94,13 +119,17 @@ void LibeventScheduler::onPrepareForStats(evwatch*, const evwatch_prepare_cb_inf
   // onCheckForStats to compute the poll_delay stat.
   self->timeout_set_ = evwatch_prepare_get_timeout(info, &self->timeout_);
   evutil_gettimeofday(&self->prepare_time_, nullptr);
+  self->polling_ = true;
 
   // If we have a check time available from a previous iteration of the event loop (that is, all but
   // the first), compute the loop_duration stat.
   if (self->check_time_.tv_sec != 0) {
     timeval delta;
     evutil_timersub(&self->prepare_time_, &self->check_time_, &delta);
-    recordTimeval(self->stats_->loop_duration_us_, delta);
+    self->busy_time_ += toMicroseconds(delta);
+    if (self->stats_ != nullptr) {
+      recordTimeval(self->stats_->loop_duration_us_, delta);
+    }
   }
 }
 
@@ -112,9 +141,12 @@ void LibeventScheduler::onCheckForStats(evwatch*, const evwatch_check_cb_info*,
   // from above to compute the actual polling duration, and store it for the next iteration of the
   // event loop to compute the loop duration.
   evutil_gettimeofday(&self->check_time_, nullptr);
-  if (self->timeout_set_) {
-    timeval delta, delay;
-    evutil_timersub(&self->check_time_, &self->prepare_time_, &delta);
+  self->polling_ = false;
+  timeval delta;
+  evutil_timersub(&self->check_time_, &self->prepare_time_, &delta);
+  self->polling_time_ += toMicroseconds(delta);
+  if (self->timeout_set_ && self->stats_ != nullptr) {
+    timeval delay;
     evutil_timersub(&delta, &self->timeout_, &delay);
 
     // Delay can be negative, meaning polling completed early. This happens in normal operation,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 
 #include "envoy/event/dispatcher.h"
@@ -99,6 +100,17 @@ public:
    */
   void initializeStats(DispatcherStats* stats);
 
+  /**
+   * Start measuring the busy and polling time of the event loop, if not already measured.
+   */
+  void enableEventLoopTimes();
+
+  /**
+   * @return the cumulative busy and polling time of the event loop. The busy time includes the
+   * iteration currently in progress, so this must be called from the event loop's thread.
+   */
+  EventLoopTimes eventLoopTimes() const;
+
 private:
   static void onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onPrepareForStats(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
@@ -120,7 +132,12 @@ private:
   timeval timeout_{};        // the poll timeout for the current event loop iteration, if available
   timeval prepare_time_{};   // timestamp immediately before polling
   timeval check_time_{};     // timestamp immediately after polling
+  bool polling_{};           // whether the loop is between the prepare and check watchers
+  bool timing_enabled_{};    // whether the prepare and check watchers for stats are installed
   OnPrepareCallback callback_; // callback to be called from onPrepareForCallback()
+  // Cumulative time spent running callbacks (check to prepare) and polling (prepare to check).
+  std::chrono::microseconds busy_time_{};
+  std::chrono::microseconds polling_time_{};
 };
 
 } // namespace Event
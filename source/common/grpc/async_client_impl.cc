@@ -5,6 +5,7 @@
 #include "source/common/buffer/zero_copy_input_stream_impl.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/utility.h"
+#include "source/common/grpc/codec.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
@@ -199,6 +200,12 @@ void AsyncStreamImpl::sendMessageRaw(Buffer::InstancePtr&& buffer, bool end_stre
   stream_->sendData(*buffer, end_stream);
 }
 
+bool AsyncStreamImpl::sendCompressedMessageRaw(Buffer::InstancePtr& buffer, bool end_stream) {
+  Common::prependGrpcFrameHeader(*buffer, GRPC_FH_COMPRESSED);
+  stream_->sendData(*buffer, end_stream);
+  return true;
+}
+
 void AsyncStreamImpl::closeStream() {
   Buffer::OwnedImpl empty_buffer;
   stream_->sendData(empty_buffer, true);
@@ -70,6 +70,7 @@ public:
 
   // Grpc::AsyncStream
   void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) override;
+  bool sendCompressedMessageRaw(Buffer::InstancePtr& request, bool end_stream) override;
   void closeStream() override;
   void resetStream() override;
   bool isAboveWriteBufferHighWatermark() const override {
@@ -301,9 +301,9 @@ std::string Common::typeUrl(const std::string& qualified_name) {
   return typeUrlPrefix() + "/" + qualified_name;
 }
 
-void Common::prependGrpcFrameHeader(Buffer::Instance& buffer) {
+void Common::prependGrpcFrameHeader(Buffer::Instance& buffer, uint8_t flags) {
   std::array<char, 5> header;
-  header[0] = 0; // flags
+  header[0] = flags;
   const uint32_t nsize = htonl(buffer.length());
   safeMemcpyUnsafeDst(&header[1], &nsize);
   buffer.prepend(absl::string_view(&header[0], 5));
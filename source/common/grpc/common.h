@@ -165,8 +165,9 @@ public:
   /**
    * Prepend a gRPC frame header to a Buffer::Instance containing a single gRPC frame.
    * @param buffer containing the frame data which will be modified.
+   * @param flags supplies the frame flags, e.g. GRPC_FH_COMPRESSED.
    */
-  static void prependGrpcFrameHeader(Buffer::Instance& buffer);
+  static void prependGrpcFrameHeader(Buffer::Instance& buffer, uint8_t flags = 0);
 
   /**
    * Parse a Buffer::Instance into a Protobuf::Message.
@@ -223,6 +223,8 @@ public:
 
   // Grpc::RawAsyncStream
   void sendMessageRaw(Buffer::InstancePtr&& request, bool end_stream) override;
+  // Google gRPC applies message compression itself, as configured through the channel arguments.
+  bool sendCompressedMessageRaw(Buffer::InstancePtr&, bool) override { return false; }
   void closeStream() override;
   void resetStream() override;
   // While the Google-gRPC code doesn't use Envoy watermark buffers, the logical
@@ -38,6 +38,9 @@ public:
   void sendMessage(const Protobuf::Message& request, bool end_stream) {
     Internal::sendMessageUntyped(stream_, std::move(request), end_stream);
   }
+  bool sendCompressedMessageRaw(Buffer::InstancePtr& request, bool end_stream) {
+    return stream_->sendCompressedMessageRaw(request, end_stream);
+  }
   void closeStream() { stream_->closeStream(); }
   void resetStream() { stream_->resetStream(); }
   bool isAboveWriteBufferHighWatermark() const {
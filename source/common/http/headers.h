@@ -70,6 +70,7 @@ public:
   const LowerCaseString Etag{"etag"};
   const LowerCaseString Expires{"expires"};
   const LowerCaseString GrpcAcceptEncoding{"grpc-accept-encoding"};
+  const LowerCaseString GrpcEncoding{"grpc-encoding"};
   const LowerCaseString IfMatch{"if-match"};
   const LowerCaseString IfNoneMatch{"if-none-match"};
   const LowerCaseString IfModifiedSince{"if-modified-since"};
@@ -113,6 +114,10 @@ public:
     const std::string Default{"identity"};
   } GrpcAcceptEncodingValues;
 
+  struct {
+    const std::string Gzip{"gzip"};
+  } GrpcEncodingValues;
+
   struct {
     const std::string AcceptEncoding{"Accept-Encoding"};
     const std::string Wildcard{"*"};
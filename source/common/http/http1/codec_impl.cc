@@ -1165,6 +1165,12 @@ Envoy::StatusOr<CallbackResult> ServerConnectionImpl::onHeadersCompleteBase() {
 Status ServerConnectionImpl::onMessageBeginBase() {
   if (!resetStreamCalled()) {
     ASSERT(active_request_ == nullptr);
+    // The connection buffer limit may have been scaled since the previous request, e.g. by the
+    // shrink_buffer_limits overload action.
+    if (const uint32_t limit = connection_.bufferLimit();
+        owned_output_buffer_->highWatermark() != limit) {
+      owned_output_buffer_->setWatermarks(limit);
+    }
     active_request_ = std::make_unique<ActiveRequest>(*this, std::move(bytes_meter_before_stream_));
     if (resetStreamCalled()) {
       return codecClientError("cannot create new streams after calling reset");
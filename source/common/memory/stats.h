@@ -51,5 +51,28 @@ public:
   static void dumpStatsToLog();
 };
 
+/**
+ * Samples the number of bytes allocated by the process since it was constructed, to estimate the
+ * memory used by an object from the allocations made while building it. Allocations and frees made
+ * by other threads in the meantime are counted too, so this is only an estimate. It costs two
+ * reads of the allocator's stats.
+ */
+class AllocatedBytesSampler {
+public:
+  AllocatedBytesSampler() : start_(Stats::totalCurrentlyAllocated()) {}
+
+  /**
+   * @return uint64_t the number of bytes allocated since construction, or 0 if more bytes were
+   *                  freed than allocated.
+   */
+  uint64_t allocatedBytes() const {
+    const uint64_t now = Stats::totalCurrentlyAllocated();
+    return now > start_ ? now - start_ : 0;
+  }
+
+private:
+  const uint64_t start_;
+};
+
 } // namespace Memory
 } // namespace Envoy
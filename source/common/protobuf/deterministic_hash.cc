@@ -0,0 +1,164 @@
+#include "source/common/protobuf/deterministic_hash.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
+
+namespace Envoy {
+namespace DeterministicProtoHash {
+namespace {
+
+uint64_t hashMessage(const Protobuf::Message& message, uint64_t seed);
+
+template <class T> uint64_t hashScalar(T value, uint64_t seed) {
+  static_assert(std::is_trivially_copyable<T>::value, "hashScalar() hashes the raw bytes");
+  return HashUtil::xxHash64(absl::string_view(reinterpret_cast<const char*>(&value), sizeof(T)),
+                            seed);
+}
+
+// Hashes a single value of a field. For repeated fields, index selects the element; for singular
+// fields it is -1.
+uint64_t hashFieldValue(const Protobuf::Message& message, const Protobuf::Reflection& reflection,
+                        const Protobuf::FieldDescriptor& field, int index, uint64_t seed) {
+  const bool repeated = index >= 0;
+  switch (field.cpp_type()) {
+  case Protobuf::FieldDescriptor::CPPTYPE_INT32:
+    return hashScalar(repeated ? reflection.GetRepeatedInt32(message, &field, index)
+                               : reflection.GetInt32(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_INT64:
+    return hashScalar(repeated ? reflection.GetRepeatedInt64(message, &field, index)
+                               : reflection.GetInt64(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_UINT32:
+    return hashScalar(repeated ? reflection.GetRepeatedUInt32(message, &field, index)
+                               : reflection.GetUInt32(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_UINT64:
+    return hashScalar(repeated ? reflection.GetRepeatedUInt64(message, &field, index)
+                               : reflection.GetUInt64(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+    return hashScalar(repeated ? reflection.GetRepeatedDouble(message, &field, index)
+                               : reflection.GetDouble(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+    return hashScalar(repeated ? reflection.GetRepeatedFloat(message, &field, index)
+                               : reflection.GetFloat(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_BOOL:
+    return hashScalar(repeated ? reflection.GetRepeatedBool(message, &field, index)
+                               : reflection.GetBool(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_ENUM:
+    return hashScalar(repeated ? reflection.GetRepeatedEnumValue(message, &field, index)
+                               : reflection.GetEnumValue(message, &field),
+                      seed);
+  case Protobuf::FieldDescriptor::CPPTYPE_STRING: {
+    // The scratch string is only filled in when the field is not stored as a std::string, e.g.
+    // for cords, so the common case does not copy.
+    std::string scratch;
+    const std::string& value =
+        repeated ? reflection.GetRepeatedStringReference(message, &field, index, &scratch)
+                 : reflection.GetStringReference(message, &field, &scratch);
+    return HashUtil::xxHash64(value, hashScalar(value.size(), seed));
+  }
+  case Protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+    return hashMessage(repeated ? reflection.GetRepeatedMessage(message, &field, index)
+                                : reflection.GetMessage(message, &field),
+                       seed);
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+uint64_t hashField(const Protobuf::Message& message, const Protobuf::Reflection& reflection,
+                   const Protobuf::FieldDescriptor& field, uint64_t seed) {
+  seed = hashScalar(field.number(), seed);
+  if (!field.is_repeated()) {
+    return hashFieldValue(message, reflection, field, -1, seed);
+  }
+
+  const int size = reflection.FieldSize(message, &field);
+  seed = hashScalar(size, seed);
+  if (field.is_map()) {
+    // Map entries have no defined order, so hash each entry independently and combine the
+    // entry hashes in sorted order. Keys are unique, so this cannot hide a difference.
+    std::vector<uint64_t> entry_hashes;
+    entry_hashes.reserve(size);
+    for (int i = 0; i < size; ++i) {
+      entry_hashes.push_back(hashFieldValue(message, reflection, field, i, 0));
+    }
+    std::sort(entry_hashes.begin(), entry_hashes.end());
+    for (const uint64_t entry_hash : entry_hashes) {
+      seed = hashScalar(entry_hash, seed);
+    }
+    return seed;
+  }
+  for (int i = 0; i < size; ++i) {
+    seed = hashFieldValue(message, reflection, field, i, seed);
+  }
+  return seed;
+}
+
+// Hashes an Any through its unpacked payload, so that equivalent payloads serialized differently
+// (e.g. with map entries in a different order) hash equally. Returns false if the payload type is
+// unknown or the payload does not parse, in which case the caller hashes the Any's raw fields.
+bool hashAny(const Protobuf::Message& any, uint64_t& seed) {
+  const Protobuf::Descriptor* descriptor = any.GetDescriptor();
+  const Protobuf::Reflection* reflection = any.GetReflection();
+  const Protobuf::FieldDescriptor* type_url_field = descriptor->FindFieldByNumber(1);
+  const Protobuf::FieldDescriptor* value_field = descriptor->FindFieldByNumber(2);
+  if (type_url_field == nullptr || value_field == nullptr) {
+    return false;
+  }
+  const std::string type_url = reflection->GetString(any, type_url_field);
+  const size_t pos = type_url.rfind('/');
+  const std::string type_name = pos == std::string::npos ? type_url : type_url.substr(pos + 1);
+  const Protobuf::Descriptor* payload_descriptor =
+      descriptor->file()->pool()->FindMessageTypeByName(type_name);
+  if (payload_descriptor == nullptr) {
+    return false;
+  }
+  const Protobuf::Message* prototype =
+      reflection->GetMessageFactory()->GetPrototype(payload_descriptor);
+  if (prototype == nullptr) {
+    return false;
+  }
+  std::unique_ptr<Protobuf::Message> payload(prototype->New());
+  std::string scratch;
+  if (!payload->ParseFromString(reflection->GetStringReference(any, value_field, &scratch))) {
+    return false;
+  }
+  seed = hashMessage(*payload, HashUtil::xxHash64(type_url, seed));
+  return true;
+}
+
+uint64_t hashMessage(const Protobuf::Message& message, uint64_t seed) {
+  const Protobuf::Descriptor* descriptor = message.GetDescriptor();
+  seed = HashUtil::xxHash64(descriptor->full_name(), seed);
+  if (descriptor->full_name() == "google.protobuf.Any" && hashAny(message, seed)) {
+    return seed;
+  }
+
+  const Protobuf::Reflection* reflection = message.GetReflection();
+  // ListFields() returns the fields that are set, ordered by field number, and skips unknown
+  // fields.
+  std::vector<const Protobuf::FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const Protobuf::FieldDescriptor* field : fields) {
+    seed = hashField(message, *reflection, *field, seed);
+  }
+  return seed;
+}
+
+} // namespace
+
+uint64_t hash(const Protobuf::Message& message) { return hashMessage(message, 0); }
+
+} // namespace DeterministicProtoHash
+} // namespace Envoy
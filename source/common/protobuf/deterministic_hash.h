@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+#include "source/common/protobuf/protobuf.h"
+
+namespace Envoy {
+namespace DeterministicProtoHash {
+
+/**
+ * Hashes a message by walking its set fields with reflection and feeding their values directly
+ * into xxHash64, without serializing the message. The result is deterministic: it does not depend
+ * on the order in which map entries were inserted, nor on how an Any's payload was serialized, as
+ * Any messages whose type is known to the message's descriptor pool are hashed through their
+ * unpacked contents. Unknown fields are ignored.
+ *
+ * Two messages that compare equal with field presence taken into account hash equally. The hash
+ * is stable across processes running the same build, but is not guaranteed to be stable across
+ * Envoy versions, so it must not be persisted.
+ *
+ * @param message the message to hash.
+ * @return the hash.
+ */
+uint64_t hash(const Protobuf::Message& message);
+
+} // namespace DeterministicProtoHash
+} // namespace Envoy
@@ -14,6 +14,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/singleton/const_singleton.h"
 
+#include "absl/status/status.h"
 #include "absl/strings/str_join.h"
 
 // Obtain the value of a wrapped field (e.g. google.protobuf.UInt32Value) if set. Otherwise, return
@@ -242,8 +243,10 @@ public:
   using FileExtensions = ConstSingleton<FileExtensionValues>;
 
   /**
-   * A hash function uses Protobuf::TextFormat to force deterministic serialization recursively
-   * including known types in google.protobuf.Any. See
+   * A deterministic hash of a message, including the contents of known types in
+   * google.protobuf.Any. By default this walks the message with reflection, see
+   * DeterministicProtoHash::hash(). With envoy.restart_features.use_fast_protobuf_hash disabled,
+   * it instead hashes the message printed by Protobuf::TextFormat. See
    * https://github.com/protocolbuffers/protobuf/issues/5731 for the context.
    * Using this function is discouraged, see discussion in
    * https://github.com/envoyproxy/envoy/issues/8301.
@@ -357,6 +360,17 @@ public:
    */
   static void unpackTo(const ProtobufWkt::Any& any_message, Protobuf::Message& message);
 
+  /**
+   * Same as unpackTo(), but returns an error status instead of throwing, so that it can be used
+   * off the main thread.
+   *
+   * @param any_message source google.protobuf.Any message.
+   * @param message destination to unpack to.
+   * @return absl::Status ok if the message unpacked, otherwise the reason unpackTo() would throw.
+   */
+  static absl::Status unpackToNoThrow(const ProtobufWkt::Any& any_message,
+                                      Protobuf::Message& message);
+
   /**
    * Convert from google.protobuf.Any to bytes as std::string
    * @param any source google.protobuf.Any message.
@@ -26,6 +26,13 @@ public:
     return std::make_shared<const ConfigImpl>(static_cast<const RouteConfiguration&>(rc), context,
                                               validate_clusters_default);
   }
+
+  ConfigConstSharedPtr updateConfig(const Protobuf::Message& rc,
+                                    Server::Configuration::ServerFactoryContext& context,
+                                    bool validate_clusters_default,
+                                    const ConfigConstSharedPtr&) const override {
+    return createConfig(rc, context, validate_clusters_default);
+  }
 };
 
 } // namespace Common
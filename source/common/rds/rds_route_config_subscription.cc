@@ -1,6 +1,7 @@
 #include "source/common/rds/rds_route_config_subscription.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/memory/stats.h"
 #include "source/common/rds/util.h"
 
 namespace Envoy {
@@ -47,6 +48,8 @@ RdsRouteConfigSubscription::~RdsRouteConfigSubscription() {
   // RdsRouteConfigProviders. Therefore, the map entry for the RdsRouteConfigProvider has to get
   // cleaned by the RdsRouteConfigProvider's destructor.
   route_config_provider_manager_.eraseDynamicProvider(manager_identifier_);
+  factory_context_.admin().getConfigMemoryTracker().removeResource(
+      Server::ConfigMemoryTracker::ResourceType::RouteConfiguration, route_config_name_);
 }
 
 absl::optional<RouteConfigProvider*>& RdsRouteConfigSubscription::routeConfigProvider() {
@@ -75,7 +78,15 @@ void RdsRouteConfigSubscription::onConfigUpdate(
   }
   std::unique_ptr<Init::ManagerImpl> noop_init_manager;
   std::unique_ptr<Cleanup> resume_rds;
+  const Memory::AllocatedBytesSampler allocated_bytes;
+  const MonotonicTime build_start_time = factory_context_.timeSource().monotonicTime();
   if (config_update_info_->onRdsUpdate(route_config, version_info)) {
+    // Virtual hosts reused from the previous version of the route configuration are not counted.
+    factory_context_.admin().getConfigMemoryTracker().setBuildCost(
+        Server::ConfigMemoryTracker::ResourceType::RouteConfiguration, route_config_name_,
+        allocated_bytes.allocatedBytes(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            factory_context_.timeSource().monotonicTime() - build_start_time));
     stats_.config_reload_.inc();
     stats_.config_reload_time_ms_.set(DateUtil::nowToMilliseconds(factory_context_.timeSource()));
 
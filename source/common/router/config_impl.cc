@@ -28,6 +28,7 @@
 #include "source/common/common/hash.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/regex.h"
+#include "source/common/common/thread.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/metadata.h"
 #include "source/common/config/utility.h"
@@ -38,6 +39,7 @@
 #include "source/common/http/path_utility.h"
 #include "source/common/http/utility.h"
 #include "source/common/matcher/matcher.h"
+#include "source/common/protobuf/message_validator_impl.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/context_impl.h"
@@ -198,6 +200,23 @@ getClusterSpecifierPluginByTheProto(const envoy::config::route::v3::ClusterSpeci
   return factory->createClusterSpecifierPlugin(*config, factory_context);
 }
 
+// All the fields of a RouteConfiguration except its virtual hosts.
+const ProtobufWkt::FieldMask& commonConfigFields() {
+  CONSTRUCT_ON_FIRST_USE(ProtobufWkt::FieldMask, []() {
+    ProtobufWkt::FieldMask mask;
+    const Protobuf::Descriptor* descriptor =
+        envoy::config::route::v3::RouteConfiguration::descriptor();
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const Protobuf::FieldDescriptor* field = descriptor->field(i);
+      if (field->number() !=
+          envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+        mask.add_paths(field->name());
+      }
+    }
+    return mask;
+  }());
+}
+
 } // namespace
 
 const std::string& OriginalConnectPort::key() {
@@ -1533,7 +1552,8 @@ PathSeparatedPrefixRouteEntryImpl::matches(const Http::RequestHeaderMap& headers
 
 VirtualHostImpl::VirtualHostImpl(
     const envoy::config::route::v3::VirtualHost& virtual_host,
-    const OptionalHttpFilters& optional_http_filters, const ConfigImpl& global_route_config,
+    const OptionalHttpFilters& optional_http_filters,
+    const CommonConfigSharedPtr& global_route_config,
     Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
     ProtobufMessage::ValidationVisitor& validator,
     const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters)
@@ -1583,7 +1603,7 @@ VirtualHostImpl::VirtualHostImpl(
 
   // Inherit policies from the global config.
   if (shadow_policies_.empty()) {
-    shadow_policies_ = global_route_config_.shadowPolicies();
+    shadow_policies_ = global_route_config_->shadowPolicies();
   }
 
   if (virtual_host.has_matcher() && !virtual_host.routes().empty()) {
@@ -1635,7 +1655,7 @@ VirtualHostImpl::VirtualClusterEntry::VirtualClusterEntry(
   headers_ = Http::HeaderUtility::buildHeaderDataVector(virtual_cluster.headers());
 }
 
-const Config& VirtualHostImpl::routeConfig() const { return global_route_config_; }
+const CommonConfig& VirtualHostImpl::routeConfig() const { return *global_route_config_; }
 
 const RouteSpecificFilterConfig* VirtualHostImpl::perFilterConfig(const std::string& name) const {
   return per_filter_configs_.get(name);
@@ -1665,20 +1685,40 @@ const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
 
 RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& route_config,
                            const OptionalHttpFilters& optional_http_filters,
-                           const ConfigImpl& global_route_config,
+                           const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
-                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters)
+                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           const RouteMatcher* previous_matcher)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
   absl::optional<Upstream::ClusterManager::ClusterInfoMaps> validation_clusters;
   if (validate_clusters) {
     validation_clusters = factory_context.clusterManager().clusters();
+    // The clusters referenced by an unchanged virtual host may have been removed since it was
+    // built, so every virtual host is validated again.
+    previous_matcher = nullptr;
   }
+  const bool index_virtual_hosts = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.reuse_unchanged_virtual_hosts");
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, optional_http_filters, global_route_config, factory_context,
-        *vhost_scope_, validator, validation_clusters);
+    VirtualHostSharedPtr virtual_host;
+    const uint64_t hash = index_virtual_hosts ? MessageUtil::hash(virtual_host_config) : 0;
+    if (previous_matcher != nullptr) {
+      const auto previous = previous_matcher->virtual_hosts_by_hash_.find(hash);
+      if (previous != previous_matcher->virtual_hosts_by_hash_.end()) {
+        virtual_host = previous->second;
+        ++reused_virtual_hosts_;
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(
+          virtual_host_config, optional_http_filters, global_route_config, factory_context,
+          *vhost_scope_, validator, validation_clusters);
+    }
+    if (index_virtual_hosts) {
+      virtual_hosts_by_hash_.emplace(hash, virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const std::string domain = Http::LowerCaseString(domain_name).get();
       bool duplicate_found = false;
@@ -1873,18 +1913,28 @@ VirtualHostImpl::virtualClusterFromEntries(const Http::HeaderMap& headers) const
   return nullptr;
 }
 
-ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
-                       const OptionalHttpFilters& optional_http_filters,
-                       Server::Configuration::ServerFactoryContext& factory_context,
-                       ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default)
-    : name_(config.name()), symbol_table_(factory_context.scope().symbolTable()),
-      uses_vhds_(config.has_vhds()),
+uint64_t CommonConfigImpl::hash(const envoy::config::route::v3::RouteConfiguration& config) {
+  // Copy only the fields that are not virtual hosts, which may be much larger than the rest of the
+  // route configuration, and are hashed one by one by RouteMatcher.
+  envoy::config::route::v3::RouteConfiguration common_config;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(config, commonConfigFields(),
+                                              ProtobufUtil::FieldMaskUtil::MergeOptions(),
+                                              &common_config);
+  return MessageUtil::hash(common_config);
+}
+
+CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                                   const OptionalHttpFilters& optional_http_filters,
+                                   Server::Configuration::ServerFactoryContext& factory_context,
+                                   ProtobufMessage::ValidationVisitor& validator,
+                                   uint64_t common_config_hash)
+    : name_(config.name()), uses_vhds_(config.has_vhds()),
       most_specific_header_mutations_wins_(config.most_specific_header_mutations_wins()),
       max_direct_response_body_size_bytes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_direct_response_body_size_bytes,
                                           DEFAULT_MAX_DIRECT_RESPONSE_BODY_SIZE_BYTES)),
-      ignore_path_parameters_in_path_matching_(config.ignore_path_parameters_in_path_matching()) {
+      ignore_path_parameters_in_path_matching_(config.ignore_path_parameters_in_path_matching()),
+      hash_(common_config_hash), optional_http_filters_(optional_http_filters) {
   if (!config.request_mirror_policies().empty()) {
     shadow_policies_.reserve(config.request_mirror_policies().size());
     for (const auto& mirror_policy_config : config.request_mirror_policies()) {
@@ -1899,10 +1949,6 @@ ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& confi
     cluster_specifier_plugins_.emplace(plugin_proto.extension().name(), std::move(plugin));
   }
 
-  route_matcher_ = std::make_unique<RouteMatcher>(
-      config, optional_http_filters, *this, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
-
   for (const std::string& header : config.internal_only_headers()) {
     internal_only_headers_.push_back(Http::LowerCaseString(header));
   }
@@ -1914,7 +1960,7 @@ ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& confi
 }
 
 ClusterSpecifierPluginSharedPtr
-ConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
+CommonConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
   auto iter = cluster_specifier_plugins_.find(provider);
   if (iter == cluster_specifier_plugins_.end() || iter->second == nullptr) {
     throw EnvoyException(
@@ -1923,6 +1969,41 @@ ConfigImpl::clusterSpecifierPlugin(absl::string_view provider) const {
   return iter->second;
 }
 
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       const OptionalHttpFilters& optional_http_filters,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default)
+    : ConfigImpl(config, optional_http_filters, factory_context, validator,
+                 validate_clusters_default, nullptr) {}
+
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       const OptionalHttpFilters& optional_http_filters,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, const ConfigImpl* previous_config) {
+  const bool reuse_virtual_hosts = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.reuse_unchanged_virtual_hosts");
+  const uint64_t common_config_hash = reuse_virtual_hosts ? CommonConfigImpl::hash(config) : 0;
+  // The virtual hosts of the previous config reference its common config, so they can only be
+  // reused along with it.
+  const RouteMatcher* previous_matcher = nullptr;
+  if (reuse_virtual_hosts && previous_config != nullptr &&
+      previous_config->shared_config_->reusableFor(common_config_hash, optional_http_filters)) {
+    shared_config_ = previous_config->shared_config_;
+    previous_matcher = previous_config->route_matcher_.get();
+  } else {
+    shared_config_ = std::make_shared<CommonConfigImpl>(config, optional_http_filters,
+                                                        factory_context, validator,
+                                                        common_config_hash);
+  }
+
+  route_matcher_ = std::make_unique<RouteMatcher>(
+      config, optional_http_filters, shared_config_, factory_context, validator,
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default),
+      previous_matcher);
+}
+
 RouteConstSharedPtr ConfigImpl::route(const RouteCallback& cb,
                                       const Http::RequestHeaderMap& headers,
                                       const StreamInfo::StreamInfo& stream_info,
@@ -1930,7 +2011,7 @@ RouteConstSharedPtr ConfigImpl::route(const RouteCallback& cb,
   return route_matcher_->route(cb, headers, stream_info, random_value);
 }
 
-RouteSpecificFilterConfigConstSharedPtr PerFilterConfigs::createRouteSpecificFilterConfig(
+void PerFilterConfigs::addRouteSpecificFilterConfig(
     const std::string& name, const ProtobufWkt::Any& typed_config,
     const OptionalHttpFilters& optional_http_filters,
     Server::Configuration::ServerFactoryContext& factory_context,
@@ -1947,7 +2028,7 @@ RouteSpecificFilterConfigConstSharedPtr PerFilterConfigs::createRouteSpecificFil
         ENVOY_LOG(warn,
                   "Can't find a registered implementation for http filter '{}' with type URL: '{}'",
                   name, Envoy::Config::Utility::getFactoryType(typed_config));
-        return nullptr;
+        return;
       } else {
         throw EnvoyException(
             fmt::format("Didn't find a registered implementation for '{}' with type URL: '{}'",
@@ -1959,7 +2040,7 @@ RouteSpecificFilterConfigConstSharedPtr PerFilterConfigs::createRouteSpecificFil
         Server::Configuration::NamedHttpFilterConfigFactory>(name, is_optional);
     if (factory == nullptr) {
       ENVOY_LOG(warn, "Can't find a registered implementation for http filter '{}'", name);
-      return nullptr;
+      return;
     }
   }
 
@@ -1976,8 +2057,17 @@ RouteSpecificFilterConfigConstSharedPtr PerFilterConfigs::createRouteSpecificFil
       throw EnvoyException(
           fmt::format("The filter {} doesn't support virtual host-specific configurations", name));
     }
+    return;
+  }
+  if (factory->isRouteSpecificFilterConfigLazy(*proto_config) &&
+      Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.lazy_per_route_filter_configs")) {
+    // The config was created above, so that a config which the filter rejects still fails the
+    // route configuration. It is dropped here and created again when a request first needs it.
+    lazy_configs_.try_emplace(name, *factory, typed_config, factory_context);
+    return;
   }
-  return object;
+  configs_[name] = std::move(object);
 }
 
 PerFilterConfigs::PerFilterConfigs(
@@ -1986,18 +2076,34 @@ PerFilterConfigs::PerFilterConfigs(
     Server::Configuration::ServerFactoryContext& factory_context,
     ProtobufMessage::ValidationVisitor& validator) {
   for (const auto& it : typed_configs) {
-    const auto& name = it.first;
-    auto object = createRouteSpecificFilterConfig(name, it.second, optional_http_filters,
-                                                  factory_context, validator);
-    if (object != nullptr) {
-      configs_[name] = std::move(object);
-    }
+    addRouteSpecificFilterConfig(it.first, it.second, optional_http_filters, factory_context,
+                                 validator);
   }
 }
 
 const RouteSpecificFilterConfig* PerFilterConfigs::get(const std::string& name) const {
   auto it = configs_.find(name);
-  return it == configs_.end() ? nullptr : it->second.get();
+  if (it != configs_.end()) {
+    return it->second.get();
+  }
+  auto lazy_it = lazy_configs_.find(name);
+  return lazy_it == lazy_configs_.end() ? nullptr : lazy_it->second.get();
+}
+
+const RouteSpecificFilterConfig* PerFilterConfigs::LazyConfig::get() const {
+  absl::call_once(create_once_, [this]() { create(); });
+  return config_.get();
+}
+
+void PerFilterConfigs::LazyConfig::create() const {
+  // The same config was already created when the route configuration was loaded, and the configs
+  // of lazy factories only depend on their proto, so this cannot fail.
+  ProtobufTypes::MessagePtr proto_config = factory_.createEmptyRouteConfigProto();
+  Envoy::Config::Utility::translateOpaqueConfig(
+      typed_config_, ProtobufMessage::getNullValidationVisitor(), *proto_config);
+  config_ = factory_.createRouteSpecificFilterConfig(*proto_config, factory_context_,
+                                                     ProtobufMessage::getNullValidationVisitor());
+  ASSERT(config_ != nullptr);
 }
 
 Matcher::ActionFactoryCb RouteMatchActionFactory::createActionFactoryCb(
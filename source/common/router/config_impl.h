@@ -34,6 +34,7 @@
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/base/call_once.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -87,13 +88,37 @@ public:
   const RouteSpecificFilterConfig* get(const std::string& name) const;
 
 private:
-  RouteSpecificFilterConfigConstSharedPtr
-  createRouteSpecificFilterConfig(const std::string& name, const ProtobufWkt::Any& typed_config,
-                                  const OptionalHttpFilters& optional_http_filters,
-                                  Server::Configuration::ServerFactoryContext& factory_context,
-                                  ProtobufMessage::ValidationVisitor& validator);
+  /**
+   * A route specific filter config which is dropped once it has been validated by creating it,
+   * and created again when it is first used, for the filters whose factory supports it. Until
+   * then, only the config proto is kept, serialized in an Any. It may be created on any thread.
+   */
+  class LazyConfig {
+  public:
+    LazyConfig(Server::Configuration::NamedHttpFilterConfigFactory& factory,
+               const ProtobufWkt::Any& typed_config,
+               Server::Configuration::ServerFactoryContext& factory_context)
+        : factory_(factory), typed_config_(typed_config), factory_context_(factory_context) {}
+
+    const RouteSpecificFilterConfig* get() const;
+
+  private:
+    void create() const;
+
+    Server::Configuration::NamedHttpFilterConfigFactory& factory_;
+    const ProtobufWkt::Any typed_config_;
+    Server::Configuration::ServerFactoryContext& factory_context_;
+    mutable absl::once_flag create_once_;
+    mutable RouteSpecificFilterConfigConstSharedPtr config_;
+  };
+
+  void addRouteSpecificFilterConfig(const std::string& name, const ProtobufWkt::Any& typed_config,
+                                    const OptionalHttpFilters& optional_http_filters,
+                                    Server::Configuration::ServerFactoryContext& factory_context,
+                                    ProtobufMessage::ValidationVisitor& validator);
 
   absl::node_hash_map<std::string, RouteSpecificFilterConfigConstSharedPtr> configs_;
+  absl::node_hash_map<std::string, LazyConfig> lazy_configs_;
 };
 
 class RouteEntryImplBase;
@@ -188,7 +213,72 @@ private:
   absl::optional<bool> allow_credentials_{};
 };
 
-class ConfigImpl;
+/**
+ * The parts of a RouteConfiguration which are not specific to a virtual host. They are shared by
+ * all the virtual hosts of a ConfigImpl, and are carried over to the ConfigImpl built for the
+ * next version of the RouteConfiguration when they do not change.
+ */
+class CommonConfigImpl : public CommonConfig {
+public:
+  CommonConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                   const OptionalHttpFilters& optional_http_filters,
+                   Server::Configuration::ServerFactoryContext& factory_context,
+                   ProtobufMessage::ValidationVisitor& validator, uint64_t common_config_hash);
+
+  /**
+   * @return the hash of all the fields of a RouteConfiguration except its virtual hosts.
+   */
+  static uint64_t hash(const envoy::config::route::v3::RouteConfiguration& config);
+
+  /**
+   * @return whether the virtual hosts built with this config can be reused for a
+   *         RouteConfiguration whose fields other than the virtual hosts hash to
+   *         common_config_hash, and that is built with the same optional filters.
+   */
+  bool reusableFor(uint64_t common_config_hash,
+                   const OptionalHttpFilters& optional_http_filters) const {
+    return common_config_hash == hash_ && optional_http_filters == optional_http_filters_;
+  }
+
+  const HeaderParser& requestHeaderParser() const { return *request_headers_parser_; };
+  const HeaderParser& responseHeaderParser() const { return *response_headers_parser_; };
+  const std::vector<ShadowPolicyPtr>& shadowPolicies() const { return shadow_policies_; }
+  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const;
+  bool ignorePathParametersInPathMatching() const {
+    return ignore_path_parameters_in_path_matching_;
+  }
+
+  // Router::CommonConfig
+  const std::list<Http::LowerCaseString>& internalOnlyHeaders() const override {
+    return internal_only_headers_;
+  }
+  const std::string& name() const override { return name_; }
+  bool usesVhds() const override { return uses_vhds_; }
+  bool mostSpecificHeaderMutationsWins() const override {
+    return most_specific_header_mutations_wins_;
+  }
+  uint32_t maxDirectResponseBodySizeBytes() const override {
+    return max_direct_response_body_size_bytes_;
+  }
+
+private:
+  std::list<Http::LowerCaseString> internal_only_headers_;
+  HeaderParserPtr request_headers_parser_;
+  HeaderParserPtr response_headers_parser_;
+  const std::string name_;
+  const bool uses_vhds_;
+  const bool most_specific_header_mutations_wins_;
+  const uint32_t max_direct_response_body_size_bytes_;
+  std::vector<ShadowPolicyPtr> shadow_policies_;
+  // Cluster specifier plugins/providers.
+  absl::flat_hash_map<std::string, ClusterSpecifierPluginSharedPtr> cluster_specifier_plugins_;
+  const bool ignore_path_parameters_in_path_matching_;
+  const uint64_t hash_;
+  const OptionalHttpFilters optional_http_filters_;
+};
+
+using CommonConfigSharedPtr = std::shared_ptr<const CommonConfigImpl>;
+
 /**
  * Holds all routing configuration for an entire virtual host.
  */
@@ -196,7 +286,8 @@ class VirtualHostImpl : public VirtualHost, Logger::Loggable<Logger::Id::router>
 public:
   VirtualHostImpl(
       const envoy::config::route::v3::VirtualHost& virtual_host,
-      const OptionalHttpFilters& optional_http_filters, const ConfigImpl& global_route_config,
+      const OptionalHttpFilters& optional_http_filters,
+      const CommonConfigSharedPtr& global_route_config,
       Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
       ProtobufMessage::ValidationVisitor& validator,
       const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters);
@@ -206,7 +297,7 @@ public:
                                           const StreamInfo::StreamInfo& stream_info,
                                           uint64_t random_value) const;
   const VirtualCluster* virtualClusterFromEntries(const Http::HeaderMap& headers) const;
-  const ConfigImpl& globalRouteConfig() const { return global_route_config_; }
+  const CommonConfigImpl& globalRouteConfig() const { return *global_route_config_; }
   const HeaderParser& requestHeaderParser() const { return *request_headers_parser_; }
   const HeaderParser& responseHeaderParser() const { return *response_headers_parser_; }
 
@@ -214,7 +305,7 @@ public:
   const CorsPolicy* corsPolicy() const override { return cors_policy_.get(); }
   Stats::StatName statName() const override { return stat_name_storage_.statName(); }
   const RateLimitPolicy& rateLimitPolicy() const override { return rate_limit_policy_; }
-  const Config& routeConfig() const override;
+  const CommonConfig& routeConfig() const override;
   const RouteSpecificFilterConfig* perFilterConfig(const std::string&) const;
   bool includeAttemptCountInRequest() const override { return include_attempt_count_in_request_; }
   bool includeAttemptCountInResponse() const override { return include_attempt_count_in_response_; }
@@ -279,8 +370,9 @@ private:
   const RateLimitPolicyImpl rate_limit_policy_;
   std::vector<ShadowPolicyPtr> shadow_policies_;
   std::unique_ptr<const CorsPolicyImpl> cors_policy_;
-  const ConfigImpl& global_route_config_; // See note in RouteEntryImplBase::clusterEntry() on why
-                                          // raw ref to the top level config is currently safe.
+  // Shared with the other virtual hosts of the route configuration, and possibly with the virtual
+  // hosts of the route configurations built before and after this one.
+  const CommonConfigSharedPtr global_route_config_;
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
   PerFilterConfigs per_filter_configs_;
@@ -1194,17 +1286,28 @@ public:
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous_matcher if not nullptr, the matcher of the previous version of the route
+   *        configuration, built with the same global_route_config. Its virtual hosts whose
+   *        configuration has not changed are reused instead of being built again.
+   */
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const OptionalHttpFilters& optional_http_filters,
-               const ConfigImpl& global_http_config,
+               const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
-               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               const RouteMatcher* previous_matcher);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
 
   const VirtualHostImpl* findVirtualHost(const Http::RequestHeaderMap& headers) const;
 
+  /**
+   * @return the number of virtual hosts reused from the previous matcher.
+   */
+  uint32_t reusedVirtualHosts() const { return reused_virtual_hosts_; }
+
 private:
   using WildcardVirtualHosts =
       std::map<int64_t, absl::node_hash_map<std::string, VirtualHostSharedPtr>, std::greater<>>;
@@ -1230,6 +1333,10 @@ private:
 
   VirtualHostSharedPtr default_virtual_host_;
   const bool ignore_port_in_host_matching_{false};
+  // All the virtual hosts by the hash of their configuration, so that the next version of the
+  // route configuration can reuse the ones it does not change.
+  absl::flat_hash_map<uint64_t, VirtualHostSharedPtr> virtual_hosts_by_hash_;
+  uint32_t reused_virtual_hosts_{};
 };
 
 /**
@@ -1242,13 +1349,28 @@ public:
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
 
-  const HeaderParser& requestHeaderParser() const { return *request_headers_parser_; };
-  const HeaderParser& responseHeaderParser() const { return *response_headers_parser_; };
+  /**
+   * Builds the config for a new version of a route configuration, reusing the virtual hosts of
+   * previous_config which the new version does not change. The reused virtual hosts are shared
+   * by both configs, which must therefore have been built with the same factory_context and
+   * validator.
+   * @param previous_config the config built for the previous version, or nullptr.
+   */
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             const OptionalHttpFilters& optional_http_filters,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config);
 
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
 
+  /**
+   * @return the number of virtual hosts reused from the previous config.
+   */
+  uint32_t reusedVirtualHosts() const { return route_matcher_->reusedVirtualHosts(); }
+
   // Router::Config
   RouteConstSharedPtr route(const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info,
@@ -1261,42 +1383,24 @@ public:
                             uint64_t random_value) const override;
 
   const std::list<Http::LowerCaseString>& internalOnlyHeaders() const override {
-    return internal_only_headers_;
+    return shared_config_->internalOnlyHeaders();
   }
 
-  const std::string& name() const override { return name_; }
+  const std::string& name() const override { return shared_config_->name(); }
 
-  bool usesVhds() const override { return uses_vhds_; }
+  bool usesVhds() const override { return shared_config_->usesVhds(); }
 
   bool mostSpecificHeaderMutationsWins() const override {
-    return most_specific_header_mutations_wins_;
+    return shared_config_->mostSpecificHeaderMutationsWins();
   }
 
   uint32_t maxDirectResponseBodySizeBytes() const override {
-    return max_direct_response_body_size_bytes_;
-  }
-
-  const std::vector<ShadowPolicyPtr>& shadowPolicies() const { return shadow_policies_; }
-
-  ClusterSpecifierPluginSharedPtr clusterSpecifierPlugin(absl::string_view provider) const;
-  bool ignorePathParametersInPathMatching() const {
-    return ignore_path_parameters_in_path_matching_;
+    return shared_config_->maxDirectResponseBodySizeBytes();
   }
 
 private:
+  CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
-  std::list<Http::LowerCaseString> internal_only_headers_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
-  const std::string name_;
-  Stats::SymbolTable& symbol_table_;
-  const bool uses_vhds_;
-  const bool most_specific_header_mutations_wins_;
-  const uint32_t max_direct_response_body_size_bytes_;
-  std::vector<ShadowPolicyPtr> shadow_policies_;
-  // Cluster specifier plugins/providers.
-  absl::flat_hash_map<std::string, ClusterSpecifierPluginSharedPtr> cluster_specifier_plugins_;
-  const bool ignore_path_parameters_in_path_matching_;
 };
 
 /**
@@ -49,6 +49,19 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
       factory_context, validator_, validate_clusters_default);
 }
 
+Rds::ConfigConstSharedPtr
+ConfigTraitsImpl::updateConfig(const Protobuf::Message& rc,
+                               Server::Configuration::ServerFactoryContext& factory_context,
+                               bool validate_clusters_default,
+                               const Rds::ConfigConstSharedPtr& previous_config) const {
+  ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
+  // The previous config is a NullConfigImpl until the first update.
+  return std::make_shared<ConfigImpl>(
+      static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc), optional_http_filters_,
+      factory_context, validator_, validate_clusters_default,
+      dynamic_cast<const ConfigImpl*>(previous_config.get()));
+}
+
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
                                                 const std::string& version_info) {
   uint64_t new_hash = base_.getHash(rc);
@@ -28,6 +28,10 @@ public:
   Rds::ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                          Server::Configuration::ServerFactoryContext& context,
                                          bool validate_clusters_default) const override;
+  Rds::ConfigConstSharedPtr
+  updateConfig(const Protobuf::Message& rc, Server::Configuration::ServerFactoryContext& context,
+               bool validate_clusters_default,
+               const Rds::ConfigConstSharedPtr& previous_config) const override;
 
 private:
   const OptionalHttpFilters optional_http_filters_;
@@ -152,6 +152,41 @@ GenericSecretConfigProviderSharedPtr SecretManagerImpl::findOrCreateGenericSecre
                                                 secret_provider_context);
 }
 
+absl::flat_hash_map<std::string, uint64_t> SecretManagerImpl::secretsAllocatedBytes() {
+  absl::flat_hash_map<std::string, uint64_t> secrets;
+  const auto add_secret = [&secrets](const std::string& name, const Protobuf::Message* secret) {
+    // Dynamic secrets which have not been received yet have no secret.
+    if (secret != nullptr) {
+      secrets[name] += secret->SpaceUsedLong();
+    }
+  };
+  for (const auto& [name, provider] : static_tls_certificate_providers_) {
+    add_secret(name, provider->secret());
+  }
+  for (const auto& [name, provider] : static_certificate_validation_context_providers_) {
+    add_secret(name, provider->secret());
+  }
+  for (const auto& [name, provider] : static_session_ticket_keys_providers_) {
+    add_secret(name, provider->secret());
+  }
+  for (const auto& [name, provider] : static_generic_secret_providers_) {
+    add_secret(name, provider->secret());
+  }
+  for (const auto& provider : certificate_providers_.allSecretProviders()) {
+    add_secret(provider->secretData().resource_name_, provider->secret());
+  }
+  for (const auto& provider : validation_context_providers_.allSecretProviders()) {
+    add_secret(provider->secretData().resource_name_, provider->secret());
+  }
+  for (const auto& provider : session_ticket_keys_providers_.allSecretProviders()) {
+    add_secret(provider->secretData().resource_name_, provider->secret());
+  }
+  for (const auto& provider : generic_secret_providers_.allSecretProviders()) {
+    add_secret(provider->secretData().resource_name_, provider->secret());
+  }
+  return secrets;
+}
+
 ProtobufTypes::MessagePtr
 SecretManagerImpl::dumpSecretConfigs(const Matchers::StringMatcher& name_matcher) {
   auto config_dump = std::make_unique<envoy::admin::v3::SecretsConfigDump>();
@@ -67,6 +67,8 @@ public:
       const envoy::config::core::v3::ConfigSource& config_source, const std::string& config_name,
       Server::Configuration::TransportSocketFactoryContext& secret_provider_context) override;
 
+  absl::flat_hash_map<std::string, uint64_t> secretsAllocatedBytes() override;
+
 private:
   ProtobufTypes::MessagePtr dumpSecretConfigs(const Matchers::StringMatcher& name_matcher);
 
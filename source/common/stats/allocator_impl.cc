@@ -195,18 +195,19 @@ public:
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    flags_ |= Flags::Changed;
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
 
@@ -246,7 +247,11 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    flags_ |= Flags::Changed;
+  }
+  bool latchChanged() override { return flags_.fetch_and(~Flags::Changed) & Flags::Changed; }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -270,12 +275,13 @@ public:
     std::string value_copy(value);
     absl::MutexLock lock(&mutex_);
     value_ = std::move(value_copy);
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   std::string value() const override {
     absl::MutexLock lock(&mutex_);
     return value_;
   }
+  bool latchChanged() override { return flags_.fetch_and(~Flags::Changed) & Flags::Changed; }
 
 private:
   mutable absl::Mutex mutex_;
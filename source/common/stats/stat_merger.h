@@ -56,6 +56,23 @@ public:
                   const Protobuf::Map<std::string, uint64_t>& gauges,
                   const DynamicsMap& dynamics = DynamicsMap());
 
+  /**
+   * Merge a counter delta from the parent into the counter with the given name.
+   *
+   * @param stat_name the name of the counter, in the symbol table of the target store.
+   * @param delta the amount added to the counter in the parent since the last merge.
+   */
+  void mergeCounter(StatName stat_name, uint64_t delta);
+
+  /**
+   * Merge the parent's current value of a gauge into the gauge with the given name. See
+   * mergeStats() for how the import mode of the gauge is handled.
+   *
+   * @param stat_name the name of the gauge, in the symbol table of the target store.
+   * @param parent_value the parent's current value of the gauge.
+   */
+  void mergeGauge(StatName stat_name, uint64_t parent_value);
+
   /**
    * Indicates that a gauge's value from the hot-restart parent should be
    * retained, combining it with the child data. By default, data is transferred
@@ -251,7 +251,7 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   Encoding::decodeTokens(
       stat_name,
       [this, &strings](Symbol symbol)
@@ -301,18 +301,34 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   const std::vector<absl::string_view> tokens = absl::StrSplit(name, '.');
   std::vector<Symbol> symbols;
   symbols.reserve(tokens.size());
+  recordLookup(name);
 
-  // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
+  // Most names are made of tokens that already have symbols, which only need
+  // their ref-counts bumped. That is done holding the lock in shared mode, so
+  // that threads encoding such names do not serialize. Tokens without a symbol
+  // are left as 0, which is never a valid symbol.
+  bool missing_symbols = false;
   {
-    Thread::LockGuard lock(lock_);
-    recent_lookups_.lookup(name);
+    absl::ReaderMutexLock lock(&lock_);
     for (auto& token : tokens) {
       // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
       // length below some threshold, say 4 bytes. It might be preferable not to
       // reserve Symbols for every 3 digit number found (for example) in ipv4
       // addresses.
-      symbols.push_back(toSymbol(token));
+      const absl::optional<Symbol> symbol = findSymbol(token);
+      missing_symbols |= !symbol.has_value();
+      symbols.push_back(symbol.value_or(0));
+    }
+  }
+
+  // Then take the lock exclusively to allocate the missing symbols. Another
+  // thread may have added some of them in the meantime, which toSymbol() handles.
+  if (missing_symbols) {
+    absl::MutexLock lock(&lock_);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      if (symbols[i] == 0) {
+        symbols[i] = toSymbol(tokens[i]);
+      }
     }
   }
 
@@ -321,7 +337,7 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
 }
 
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   ASSERT(encode_map_.size() == decode_map_.size());
   return encode_map_.size();
 }
@@ -330,11 +346,38 @@ std::string SymbolTable::toString(const StatName& stat_name) const {
   return absl::StrJoin(decodeStrings(stat_name), ".");
 }
 
+void SymbolTable::appendToString(const StatName& stat_name, std::string& out) const {
+  bool first = true;
+  const auto append = [&out, &first](absl::string_view str) {
+    if (!first) {
+      out.push_back('.');
+    }
+    first = false;
+    out.append(str.data(), str.size());
+  };
+  absl::ReaderMutexLock lock(&lock_);
+  Encoding::decodeTokens(
+      stat_name,
+      [this, &append](Symbol symbol) ABSL_NO_THREAD_SAFETY_ANALYSIS { append(fromSymbol(symbol)); },
+      append);
+}
+
+void SymbolTable::forEachToken(StatName stat_name,
+                               const std::function<void(absl::string_view)>& symbolic_fn,
+                               const std::function<void(absl::string_view)>& dynamic_fn) const {
+  absl::ReaderMutexLock lock(&lock_);
+  Encoding::decodeTokens(
+      stat_name,
+      [this, &symbolic_fn](Symbol symbol)
+          ABSL_NO_THREAD_SAFETY_ANALYSIS { symbolic_fn(fromSymbol(symbol)); },
+      dynamic_fn);
+}
+
 void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
     auto decode_search = decode_map_.find(symbol);
 
@@ -354,26 +397,49 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
 
 void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
-  const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
+  SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
-  for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
+  // Drop the ref-counts holding the lock in shared mode, keeping only the
+  // symbols that were released by this call.
+  size_t num_released = 0;
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    for (Symbol symbol : symbols) {
+      auto decode_search = decode_map_.find(symbol);
+      ASSERT(decode_search != decode_map_.end());
+
+      auto encode_search = encode_map_.find(decode_search->second->toStringView());
+      ASSERT(encode_search != encode_map_.end());
+
+      // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
+      // symbol_table_speed_test.cc, relative to breaking out the decrement into a
+      // separate step, likely due to the non-trivial dereferences in EXPR.
+      if (--encode_search->second.ref_count_ == 0) {
+        symbols[num_released++] = symbol;
+      }
+    }
+  }
+  if (num_released == 0) {
+    return;
+  }
 
+  // If that was the last remaining client usage of a symbol, erase the current
+  // mappings and add the now-unused symbol to the reuse pool. Another thread
+  // may have revived the symbol, or revived, released and erased it, or even
+  // reused its value for a new symbol since the shared lock was dropped, so
+  // only symbols whose count is still zero are erased.
+  absl::MutexLock lock(&lock_);
+  for (size_t i = 0; i < num_released; ++i) {
+    auto decode_search = decode_map_.find(symbols[i]);
+    if (decode_search == decode_map_.end()) {
+      continue;
+    }
     auto encode_search = encode_map_.find(decode_search->second->toStringView());
     ASSERT(encode_search != encode_map_.end());
-
-    // If that was the last remaining client usage of the symbol, erase the
-    // current mappings and add the now-unused symbol to the reuse pool.
-    //
-    // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
-    // symbol_table_speed_test.cc, relative to breaking out the decrement into a
-    // separate step, likely due to the non-trivial dereferences in EXPR.
-    if (--encode_search->second.ref_count_ == 0) {
+    if (encode_search->second.ref_count_ == 0) {
       decode_map_.erase(decode_search);
       encode_map_.erase(encode_search);
-      pool_.push(symbol);
+      pool_.push(symbols[i]);
     }
   }
 }
@@ -382,15 +448,16 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   uint64_t total = 0;
   absl::flat_hash_map<std::string, uint64_t> name_count_map;
 
-  // We don't want to hold lock_ while calling the iterator, but we need it to
-  // access recent_lookups_, so we buffer in name_count_map.
+  // We don't want to hold recent_lookups_lock_ while calling the iterator, but
+  // we need it to access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(&recent_lookups_lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
     total += recent_lookups_.total();
   }
+  total += untracked_lookups_.load(std::memory_order_relaxed);
 
   // Now we have the collated name-count map data: we need to vectorize and
   // sort. We define the pair with the count first as std::pair::operator<
@@ -435,20 +502,31 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&recent_lookups_lock_);
   recent_lookups_.setCapacity(capacity);
+  recent_lookups_enabled_ = capacity > 0;
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&recent_lookups_lock_);
   recent_lookups_.clear();
+  untracked_lookups_ = 0;
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&recent_lookups_lock_);
   return recent_lookups_.capacity();
 }
 
+void SymbolTable::recordLookup(absl::string_view name) {
+  if (recent_lookups_enabled_.load(std::memory_order_relaxed)) {
+    absl::MutexLock lock(&recent_lookups_lock_);
+    recent_lookups_.lookup(name);
+  } else {
+    untracked_lookups_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
 StatNameSetPtr SymbolTable::makeSet(absl::string_view name) {
   // make_unique does not work with private ctor, even though SymbolTable is a friend.
   StatNameSetPtr stat_name_set(new StatNameSet(*this, name));
@@ -481,8 +559,17 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
   return result;
 }
 
+absl::optional<Symbol> SymbolTable::findSymbol(absl::string_view sv) {
+  auto encode_find = encode_map_.find(sv);
+  if (encode_find == encode_map_.end()) {
+    return absl::nullopt;
+  }
+  ++(encode_find->second.ref_count_);
+  return encode_find->second.symbol_;
+}
+
 absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   auto search = decode_map_.find(symbol);
   RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
   return search->second->toStringView();
@@ -503,12 +590,12 @@ bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
   // Proactively take the table lock in anticipation that we'll need to
   // convert at least one symbol to a string_view, and it's easier not to
   // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return lessThanLockHeld(a, b);
 }
 
 bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -538,7 +625,7 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   std::vector<Symbol> symbols;
   for (const auto& p : decode_map_) {
     symbols.push_back(p.first);
@@ -547,7 +634,8 @@ void SymbolTable::debugPrint() const {
   for (Symbol symbol : symbols) {
     const InlineString& token = *decode_map_.find(symbol)->second;
     const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(),
+                   shared_symbol.ref_count_.load());
   }
 }
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,8 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Stats {
@@ -218,6 +221,29 @@ public:
    */
   std::string toString(const StatName& stat_name) const;
 
+  /**
+   * Appends the period-delimited stat name to a string, without building intermediate strings.
+   * This is useful to serialize many stat names into a buffer that is reused.
+   *
+   * @param stat_name the stat name.
+   * @param out the string to append the stat name to.
+   */
+  void appendToString(const StatName& stat_name, std::string& out) const;
+
+  /**
+   * Calls one of the provided functions for each token of a stat name, in order. Symbolic tokens
+   * are passed to symbolic_fn as their string, and tokens created from a StatNameDynamicPool or
+   * StatNameDynamicStorage are passed to dynamic_fn. This lets a stat name be transferred to
+   * another symbol table token by token, without elaborating and re-parsing the whole name. The
+   * symbol table lock is held across the calls, so the functions must not use the symbol table.
+   *
+   * @param stat_name the stat name.
+   * @param symbolic_fn called with the string of each symbolic token.
+   * @param dynamic_fn called with each dynamic token.
+   */
+  void forEachToken(StatName stat_name, const std::function<void(absl::string_view)>& symbolic_fn,
+                    const std::function<void(absl::string_view)>& dynamic_fn) const;
+
   /**
    * @return uint64_t the number of symbols in the symbol table.
    */
@@ -324,7 +350,8 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
-  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
+  bool lessThanLockHeld(const StatName& a, const StatName& b) const
+      ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   template <class GetStatName, class Obj> struct StatNameCompare {
     StatNameCompare(const SymbolTable& symbol_table, GetStatName getter)
@@ -349,7 +376,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +424,23 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol), ref_count_(1) {}
+    // The encode map only moves its values while it is rehashed, which happens
+    // with lock_ held exclusively.
+    SharedSymbol(SharedSymbol&& src) noexcept
+        : symbol_(src.symbol_), ref_count_(src.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_;
+    // Bumped and dropped with lock_ held in shared mode, so that encoding or
+    // freeing names made of existing symbols does not serialize threads. A
+    // symbol whose count drops to zero is only erased after re-checking the
+    // count with lock_ held exclusively, as it may have been revived
+    // meanwhile.
+    std::atomic<uint32_t> ref_count_;
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // Held in shared mode to look up existing symbols and to decode, and
+  // exclusively to add or erase symbols.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -428,18 +465,31 @@ private:
    */
   Symbol toSymbol(absl::string_view sv) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  /**
+   * Bumps the reference count of an existing symbol.
+   *
+   * @param sv the individual string to be looked up.
+   * @return Symbol the symbol, or absl::nullopt if sv has no symbol yet.
+   */
+  absl::optional<Symbol> findSymbol(absl::string_view sv) ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
   /**
    * Convenience function for decode(), decoding one symbol at a time.
    *
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
    */
-  void newSymbol();
+  void newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  /**
+   * Records a lookup of name if recent-lookup tracking is enabled.
+   */
+  void recordLookup(absl::string_view name);
 
   /**
    * Tokenizes name, finds or allocates symbols for each token, and adds them
@@ -451,7 +501,7 @@ private:
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     return monotonic_counter_;
   }
 
@@ -460,7 +510,7 @@ private:
   Symbol next_symbol_ ABSL_GUARDED_BY(lock_);
 
   // If the free pool is exhausted, we monotonically increase this counter.
-  Symbol monotonic_counter_;
+  Symbol monotonic_counter_ ABSL_GUARDED_BY(lock_);
 
   // Bitmap implementation.
   // The encode map stores both the symbol and the ref count of that symbol.
@@ -474,7 +524,14 @@ private:
   // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
   // using an Envoy::IntervalSet.
   std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
-  RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+
+  // Recent lookups have their own lock so that tracking them does not
+  // serialize encodes. While tracking is disabled, lookups are only counted
+  // in untracked_lookups_, which does not need the lock.
+  mutable absl::Mutex recent_lookups_lock_;
+  RecentLookups recent_lookups_ ABSL_GUARDED_BY(recent_lookups_lock_);
+  std::atomic<bool> recent_lookups_enabled_{false};
+  std::atomic<uint64_t> untracked_lookups_{0};
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
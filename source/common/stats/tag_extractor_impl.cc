@@ -1,5 +1,6 @@
 #include "source/common/stats/tag_extractor_impl.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -294,5 +295,153 @@ bool TagExtractorTokensImpl::searchTags(const std::vector<absl::string_view>& in
   return pattern_index == tokens_.size() && input_index == input_tokens.size();
 }
 
+TagExtractorTokenSetImpl::TagExtractorTokenSetImpl() : nodes_(1) {}
+
+bool TagExtractorTokenSetImpl::canAdd(absl::string_view tokens) {
+  for (absl::string_view token : absl::StrSplit(tokens, '.')) {
+    if (token == "$") {
+      return true;
+    }
+    if (token == "**") {
+      return false;
+    }
+  }
+  return false;
+}
+
+void TagExtractorTokenSetImpl::add(absl::string_view name, absl::string_view tokens) {
+  ASSERT(canAdd(tokens));
+  uint32_t node = 0;
+  uint32_t index = 0;
+  bool captured = false;
+  for (absl::string_view token : absl::StrSplit(tokens, '.')) {
+    node = child(node, token, index++, captured);
+    captured |= token == "$";
+  }
+  nodes_[node].patterns_.push_back(names_.size());
+  names_.emplace_back(name);
+}
+
+uint32_t TagExtractorTokenSetImpl::child(uint32_t node, absl::string_view token, uint32_t index,
+                                         bool captured) {
+  // Note that nodes_ may be resized below, invalidating references to its elements.
+  int32_t existing = NoNode;
+  if (token == "*") {
+    existing = nodes_[node].any_child_;
+  } else if (token == "**") {
+    existing = nodes_[node].any_sequence_child_;
+  } else if (token == "$" && !captured) {
+    existing = nodes_[node].capture_child_;
+  } else {
+    const auto iter = nodes_[node].literal_children_.find(token);
+    if (iter != nodes_[node].literal_children_.end()) {
+      existing = iter->second;
+    }
+  }
+  if (existing != NoNode) {
+    return existing;
+  }
+
+  const uint32_t created = nodes_.size();
+  nodes_.emplace_back();
+  Node& parent = nodes_[node];
+  Node& created_node = nodes_.back();
+  created_node.capture_index_ = parent.capture_index_;
+  if (token == "*") {
+    parent.any_child_ = created;
+  } else if (token == "**") {
+    parent.any_sequence_child_ = created;
+    created_node.any_sequence_ = true;
+  } else if (token == "$" && !captured) {
+    parent.capture_child_ = created;
+    created_node.capture_index_ = index;
+  } else {
+    parent.literal_children_.emplace(token, created);
+  }
+  return created;
+}
+
+void TagExtractorTokenSetImpl::addState(uint32_t node, bool consumed,
+                                        absl::InlinedVector<uint32_t, 8>& states) const {
+  const uint32_t state = (node << 1) | (consumed ? 1 : 0);
+  if (std::find(states.begin(), states.end(), state) != states.end()) {
+    return;
+  }
+  states.push_back(state);
+  // A '**' may match no token at all.
+  const int32_t any_sequence_child = nodes_[node].any_sequence_child_;
+  if (any_sequence_child != NoNode) {
+    addState(any_sequence_child, false, states);
+  }
+}
+
+bool TagExtractorTokenSetImpl::extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
+                                          IntervalSet<size_t>& remove_characters) const {
+  PERF_OPERATION(perf);
+  const std::vector<absl::string_view>& input_tokens = context.tokens();
+  absl::InlinedVector<uint32_t, 8> states;
+  absl::InlinedVector<uint32_t, 8> next_states;
+  addState(0, false, states);
+  for (const absl::string_view input_token : input_tokens) {
+    next_states.clear();
+    for (const uint32_t state : states) {
+      const uint32_t node_index = state >> 1;
+      const Node& node = nodes_[node_index];
+      const auto iter = node.literal_children_.find(input_token);
+      if (iter != node.literal_children_.end()) {
+        addState(iter->second, false, next_states);
+      }
+      if (node.any_child_ != NoNode) {
+        addState(node.any_child_, false, next_states);
+      }
+      if (node.capture_child_ != NoNode) {
+        addState(node.capture_child_, false, next_states);
+      }
+      if (node.any_sequence_) {
+        addState(node_index, true, next_states);
+      }
+    }
+    if (next_states.empty()) {
+      PERF_RECORD(perf, "tokens-set-miss", "tokens");
+      return false;
+    }
+    states.swap(next_states);
+  }
+
+  // A trailing '**' must match at least one token, like in TagExtractorTokensImpl.
+  absl::InlinedVector<std::pair<uint32_t, uint32_t>, 8> matches;
+  for (const uint32_t state : states) {
+    const Node& node = nodes_[state >> 1];
+    if (!node.any_sequence_ || (state & 1) != 0) {
+      for (const uint32_t pattern : node.patterns_) {
+        matches.emplace_back(pattern, node.capture_index_);
+      }
+    }
+  }
+  if (matches.empty()) {
+    PERF_RECORD(perf, "tokens-set-miss", "tokens");
+    return false;
+  }
+
+  // Extract the tags in the order the patterns were added. The characters to
+  // remove are chosen as in TagExtractorTokensImpl::extractTag.
+  std::sort(matches.begin(), matches.end());
+  const absl::string_view stat_name = context.name();
+  for (const auto& [pattern, match_input_index] : matches) {
+    const absl::string_view tag_value = input_tokens[match_input_index];
+    uint32_t start = tag_value.data() - stat_name.data();
+    uint32_t end = start + tag_value.size();
+    if (match_input_index < (input_tokens.size() - 1)) {
+      ++end;
+    } else if (start > 0) {
+      --start;
+    }
+    tags.emplace_back(Tag{names_[pattern], std::string(tag_value)});
+    remove_characters.insert(start, end);
+  }
+  PERF_RECORD(perf, "tokens-set-match", "tokens");
+  return true;
+}
+
 } // namespace Stats
 } // namespace Envoy
@@ -12,6 +12,8 @@
 
 #include "source/common/common/regex.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 #include "re2/re2.h"
 
@@ -163,5 +165,71 @@ private:
   const uint32_t match_index_;
 };
 
+/**
+ * Combines a set of tokenized tag extractors, using the same syntax as
+ * TagExtractorTokensImpl, into a single token-matching automaton. Each stat
+ * name is walked once, token by token, against all the patterns at the same
+ * time, rather than once per pattern, and the tags of every matching pattern
+ * are extracted.
+ *
+ * Only patterns whose '$' precedes any '**' can be added, so that the position
+ * of the tag value is fixed by the pattern tokens preceding it. This is the
+ * case for all the default tokenized descriptors.
+ */
+class TagExtractorTokenSetImpl : public TagExtractor {
+public:
+  TagExtractorTokenSetImpl();
+
+  /**
+   * @param tokens a tokenized pattern.
+   * @return whether the pattern can be added to the set.
+   */
+  static bool canAdd(absl::string_view tokens);
+
+  /**
+   * Adds a pattern to the set. canAdd(tokens) must be true.
+   * @param name the name of the tag extracted by the pattern.
+   * @param tokens the tokenized pattern.
+   */
+  void add(absl::string_view name, absl::string_view tokens);
+
+  // TagExtractor
+  std::string name() const override { return ""; }
+  bool extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
+                  IntervalSet<size_t>& remove_characters) const override;
+  absl::string_view prefixToken() const override { return ""; }
+
+private:
+  static constexpr int32_t NoNode = -1;
+
+  struct Node {
+    absl::flat_hash_map<std::string, uint32_t> literal_children_;
+    int32_t any_child_{NoNode};          // '*'
+    int32_t capture_child_{NoNode};      // '$'
+    int32_t any_sequence_child_{NoNode}; // '**'
+    // Whether the node is reached with a '**' token, which can match the
+    // following input tokens.
+    bool any_sequence_{false};
+    // Index of the input token holding the tag value, if the pattern tokens
+    // leading to the node include the '$'.
+    int32_t capture_index_{NoNode};
+    // Patterns ending at this node.
+    std::vector<uint32_t> patterns_;
+  };
+
+  // Returns the index of the child of the node matching the pattern token at
+  // the index, creating it if needed. captured indicates whether the '$' has
+  // already been seen in the pattern, in which case a '$' is matched literally.
+  uint32_t child(uint32_t node, absl::string_view token, uint32_t index, bool captured);
+
+  // Adds the state, and the states reachable from it without consuming an
+  // input token, to states. The low bit of a state indicates whether a '**'
+  // node has matched an input token, the other bits are the node index.
+  void addState(uint32_t node, bool consumed, absl::InlinedVector<uint32_t, 8>& states) const;
+
+  std::vector<Node> nodes_;
+  std::vector<std::string> names_;
+};
+
 } // namespace Stats
 } // namespace Envoy
@@ -65,7 +65,7 @@ int TagProducerImpl::addExtractorsMatching(absl::string_view name) {
   }
   for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
     if (desc.name_ == name) {
-      addExtractor(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
+      addTokenizedExtractor(desc.name_, desc.pattern_);
       ++num_found;
     }
   }
@@ -81,6 +81,19 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
   }
 }
 
+void TagProducerImpl::addTokenizedExtractor(absl::string_view name, absl::string_view tokens) {
+  if (!TagExtractorTokenSetImpl::canAdd(tokens)) {
+    addExtractor(std::make_unique<TagExtractorTokensImpl>(name, tokens));
+    return;
+  }
+  if (token_set_ == nullptr) {
+    auto token_set = std::make_unique<TagExtractorTokenSetImpl>();
+    token_set_ = token_set.get();
+    addExtractor(std::move(token_set));
+  }
+  token_set_->add(name, tokens);
+}
+
 void TagProducerImpl::forEachExtractorMatching(
     absl::string_view stat_name, std::function<void(const TagExtractorPtr&)> f) const {
   IntervalSetImpl<size_t> remove_characters;
@@ -127,7 +140,7 @@ TagProducerImpl::addDefaultExtractors(const envoy::config::metrics::v3::StatsCon
     }
     for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
       names.emplace(desc.name_);
-      addExtractor(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
+      addTokenizedExtractor(desc.name_, desc.pattern_);
     }
   }
   return names;
@@ -14,6 +14,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/tag_extractor_impl.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
@@ -53,6 +54,15 @@ private:
    */
   void addExtractor(TagExtractorPtr extractor);
 
+  /**
+   * Adds a tokenized TagExtractor. Where possible, the pattern is added to
+   * token_set_ so that all the tokenized patterns are matched in a single pass
+   * over the tokens of a stat name.
+   * @param name absl::string_view the name of the tag.
+   * @param tokens absl::string_view the tokenized pattern, see TagExtractorTokensImpl.
+   */
+  void addTokenizedExtractor(absl::string_view name, absl::string_view tokens);
+
   /**
    * Adds all default extractors matching the specified tag name. In this model,
    * more than one TagExtractor can be used to generate a given tag. The default
@@ -103,6 +113,9 @@ private:
   // implementation, may need make a copy of the prefix.
   absl::flat_hash_map<absl::string_view, std::vector<TagExtractorPtr>> tag_extractor_prefix_map_;
   TagVector default_tags_;
+
+  // Combined tokenized extractors, owned by tag_extractors_without_prefix_.
+  TagExtractorTokenSetImpl* token_set_{nullptr};
 };
 
 } // namespace Stats
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "envoy/admin/v3/config_dump.pb.h"
+#include "envoy/common/key_value_store.h"
 #include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/core/v3/config_source.pb.h"
@@ -31,6 +32,7 @@
 #include "source/common/http/http1/conn_pool.h"
 #include "source/common/http/http2/conn_pool.h"
 #include "source/common/http/mixed_conn_pool.h"
+#include "source/common/memory/stats.h"
 #include "source/common/network/resolver_impl.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/utility.h"
@@ -285,7 +287,7 @@ ClusterManagerImpl::ClusterManagerImpl(
     Event::Dispatcher& main_thread_dispatcher, Server::Admin& admin,
     ProtobufMessage::ValidationContext& validation_context, Api::Api& api,
     Http::Context& http_context, Grpc::Context& grpc_context, Router::Context& router_context,
-    const Server::Instance& server)
+    const Server::Instance& server, Config::SubscriptionFactory* subscription_factory)
     : factory_(factory), runtime_(runtime), stats_(stats), tls_(tls),
       random_(api.randomGenerator()),
       bind_config_(bootstrap.cluster_manager().upstream_bind_config()), local_info_(local_info),
@@ -296,6 +298,7 @@ ClusterManagerImpl::ClusterManagerImpl(
                                        [this](const Matchers::StringMatcher& name_matcher) {
                                          return dumpClusterConfigs(name_matcher);
                                        })),
+      config_memory_tracker_(admin.getConfigMemoryTracker()),
       time_source_(main_thread_dispatcher.timeSource()), dispatcher_(main_thread_dispatcher),
       http_context_(http_context), router_context_(router_context),
       cluster_stat_names_(stats.symbolTable()),
@@ -304,7 +307,8 @@ ClusterManagerImpl::ClusterManagerImpl(
       cluster_request_response_size_stat_names_(stats.symbolTable()),
       cluster_timeout_budget_stat_names_(stats.symbolTable()),
       subscription_factory_(local_info, main_thread_dispatcher, *this,
-                            validation_context.dynamicValidationVisitor(), api, server) {
+                            validation_context.dynamicValidationVisitor(), api, server),
+      subscription_factory_override_(subscription_factory) {
   async_client_manager_ = std::make_unique<Grpc::AsyncClientManagerImpl>(
       *this, tls, time_source_, api, grpc_context.statNames());
   const auto& cm_config = bootstrap.cluster_manager();
@@ -361,10 +365,18 @@ ClusterManagerImpl::ClusterManagerImpl(
             validation_context.dynamicValidationVisitor(), server,
             dyn_resources.ads_config().config_validators());
 
+    if (dyn_resources.has_ads_snapshot_config() &&
+        dyn_resources.ads_config().api_type() !=
+            envoy::config::core::v3::ApiConfigSource::DELTA_GRPC) {
+      throw EnvoyException("ads_snapshot_config requires a DELTA_GRPC ads_config");
+    }
     if (dyn_resources.ads_config().api_type() ==
         envoy::config::core::v3::ApiConfigSource::DELTA_GRPC) {
       Config::Utility::checkTransportVersion(dyn_resources.ads_config());
       if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.unified_mux")) {
+        if (dyn_resources.has_ads_snapshot_config()) {
+          ENVOY_LOG(warn, "ads_snapshot_config is not supported with the unified mux, ignoring it");
+        }
         ads_mux_ = std::make_shared<Config::XdsMux::GrpcMuxDelta>(
             Config::Utility::factoryForGrpcApiConfigSource(*async_client_manager_,
                                                            dyn_resources.ads_config(), stats, false)
@@ -378,6 +390,14 @@ ClusterManagerImpl::ClusterManagerImpl(
             dyn_resources.ads_config().set_node_on_first_message_only(),
             std::move(custom_config_validators));
       } else {
+        KeyValueStorePtr snapshot_store;
+        if (dyn_resources.has_ads_snapshot_config()) {
+          auto& factory = Config::Utility::getAndCheckFactory<KeyValueStoreFactory>(
+              dyn_resources.ads_snapshot_config().config());
+          snapshot_store = factory.createStore(dyn_resources.ads_snapshot_config(),
+                                               validation_context.staticValidationVisitor(),
+                                               main_thread_dispatcher, api.fileSystem());
+        }
         ads_mux_ = std::make_shared<Config::NewGrpcMuxImpl>(
             Config::Utility::factoryForGrpcApiConfigSource(*async_client_manager_,
                                                            dyn_resources.ads_config(), stats, false)
@@ -387,7 +407,7 @@ ClusterManagerImpl::ClusterManagerImpl(
                 "envoy.service.discovery.v3.AggregatedDiscoveryService.DeltaAggregatedResources"),
             random_, stats_,
             Envoy::Config::Utility::parseRateLimitSettings(dyn_resources.ads_config()), local_info,
-            std::move(custom_config_validators));
+            std::move(custom_config_validators), std::move(snapshot_store));
       }
     } else {
       Config::Utility::checkTransportVersion(dyn_resources.ads_config());
@@ -416,7 +436,7 @@ ClusterManagerImpl::ClusterManagerImpl(
             random_, stats_,
             Envoy::Config::Utility::parseRateLimitSettings(dyn_resources.ads_config()),
             bootstrap.dynamic_resources().ads_config().set_node_on_first_message_only(),
-            std::move(custom_config_validators));
+            std::move(custom_config_validators), api.threadFactory());
       }
     }
   } else {
@@ -694,11 +714,17 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
     }
     // NB: https://github.com/envoyproxy/envoy/issues/14598
     // Always proceed if the cluster is different from the existing warming cluster.
-  } else if (existing_active_cluster != active_clusters_.end() &&
-             existing_active_cluster->second->blockUpdate(new_hash)) {
-    // If there's no warming cluster of the same name, and if the cluster is the same as the active
-    // cluster of the same name, block the update.
-    return false;
+  } else if (existing_active_cluster != active_clusters_.end()) {
+    if (existing_active_cluster->second->blockUpdate(new_hash)) {
+      // If there's no warming cluster of the same name, and if the cluster is the same as the
+      // active cluster of the same name, block the update.
+      return false;
+    }
+    // Updates that can be applied to the active cluster do not rebuild it, so its hosts, load
+    // balancers and connection pools are kept.
+    if (updateClusterInPlace(*existing_active_cluster->second, cluster, new_hash, version_info)) {
+      return true;
+    }
   }
 
   if (existing_active_cluster != active_clusters_.end() ||
@@ -745,6 +771,28 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
   return true;
 }
 
+bool ClusterManagerImpl::updateClusterInPlace(ClusterData& cluster_data,
+                                              const envoy::config::cluster::v3::Cluster& cluster,
+                                              const uint64_t cluster_hash,
+                                              const std::string& version_info) {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.update_cluster_circuit_breakers_in_place") ||
+      !ClusterMessageUtil::circuitBreakerLimitsOnlyChange(cluster_data.cluster_config_, cluster)) {
+    return false;
+  }
+
+  ENVOY_LOG(debug, "updating circuit breaker limits of cluster {} in place", cluster.name());
+  // The resource managers are shared by all workers, so this takes effect everywhere at once.
+  cluster_data.cluster_->info()->updateResourceLimits(cluster.circuit_breakers());
+  cluster_data.cluster_config_ = cluster;
+  cluster_data.config_hash_ = cluster_hash;
+  cluster_data.version_info_ = version_info;
+  cluster_data.last_updated_ = time_source_.systemTime();
+  cm_stats_.cluster_modified_.inc();
+  cm_stats_.cluster_modified_in_place_.inc();
+  return true;
+}
+
 void ClusterManagerImpl::clusterWarmingToActive(const std::string& cluster_name) {
   auto warming_it = warming_clusters_.find(cluster_name);
   ASSERT(warming_it != warming_clusters_.end());
@@ -787,6 +835,8 @@ bool ClusterManagerImpl::removeCluster(const std::string& cluster_name) {
   }
 
   if (removed) {
+    config_memory_tracker_.removeResource(Server::ConfigMemoryTracker::ResourceType::Cluster,
+                                          cluster_name);
     cm_stats_.cluster_removed_.inc();
     updateClusterCounts();
     // Cancel any pending merged updates.
@@ -800,6 +850,8 @@ ClusterManagerImpl::ClusterDataPtr
 ClusterManagerImpl::loadCluster(const envoy::config::cluster::v3::Cluster& cluster,
                                 const uint64_t cluster_hash, const std::string& version_info,
                                 bool added_via_api, ClusterMap& cluster_map) {
+  const Memory::AllocatedBytesSampler allocated_bytes;
+  const MonotonicTime build_start_time = time_source_.monotonicTime();
   std::pair<ClusterSharedPtr, ThreadAwareLoadBalancerPtr> new_cluster_pair =
       factory_.clusterFromProto(cluster, *this, outlier_event_logger_, added_via_api);
   auto& new_cluster = new_cluster_pair.first;
@@ -890,6 +942,13 @@ ClusterManagerImpl::loadCluster(const envoy::config::cluster::v3::Cluster& clust
                                  cluster_reference.info()->statsScope(), runtime_, random_, policy);
   }
 
+  // The previous version of the cluster, if any, is still alive here, so freeing it does not
+  // offset the allocations of the new version.
+  config_memory_tracker_.setBuildCost(
+      Server::ConfigMemoryTracker::ResourceType::Cluster, cluster.name(),
+      allocated_bytes.allocatedBytes(),
+      std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
+                                                            build_start_time));
   updateClusterCounts();
   return result;
 }
@@ -1966,5 +2025,21 @@ ProdClusterManagerFactory::createCds(const envoy::config::core::v3::ConfigSource
                             validation_context_.dynamicValidationVisitor());
 }
 
+bool ClusterMessageUtil::circuitBreakerLimitsOnlyChange(
+    const envoy::config::cluster::v3::Cluster& lhs,
+    const envoy::config::cluster::v3::Cluster& rhs) {
+  const Protobuf::Descriptor* thresholds =
+      envoy::config::cluster::v3::CircuitBreakers::Thresholds::GetDescriptor();
+  Protobuf::util::MessageDifferencer differencer;
+  differencer.set_message_field_comparison(Protobuf::util::MessageDifferencer::EQUIVALENT);
+  // These apply to thresholds and per_host_thresholds alike. The priorities, retry budgets and
+  // track_remaining of the thresholds are still compared, as they are not updated in place.
+  for (const char* field : {"max_connections", "max_pending_requests", "max_requests",
+                            "max_retries", "max_connection_pools"}) {
+    differencer.IgnoreField(thresholds->FindFieldByName(field));
+  }
+  return differencer.Compare(lhs, rhs);
+}
+
 } // namespace Upstream
 } // namespace Envoy
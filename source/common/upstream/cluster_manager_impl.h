@@ -119,6 +119,17 @@ protected:
   const Server::Instance& server_;
 };
 
+class ClusterMessageUtil {
+public:
+  /**
+   * @return true if cluster messages lhs and rhs are the same if ignoring the limits of their
+   *         circuit breaker thresholds, which ClusterInfo::updateResourceLimits() can apply to an
+   *         existing cluster.
+   */
+  static bool circuitBreakerLimitsOnlyChange(const envoy::config::cluster::v3::Cluster& lhs,
+                                             const envoy::config::cluster::v3::Cluster& rhs);
+};
+
 // For friend declaration in ClusterManagerInitHelper.
 class ClusterManagerImpl;
 
@@ -217,6 +228,7 @@ private:
 #define ALL_CLUSTER_MANAGER_STATS(COUNTER, GAUGE)                                                  \
   COUNTER(cluster_added)                                                                           \
   COUNTER(cluster_modified)                                                                        \
+  COUNTER(cluster_modified_in_place)                                                               \
   COUNTER(cluster_removed)                                                                         \
   COUNTER(cluster_updated)                                                                         \
   COUNTER(cluster_updated_via_merge)                                                               \
@@ -240,6 +252,8 @@ class ClusterManagerImpl : public ClusterManager,
                            public MissingClusterNotifier,
                            Logger::Loggable<Logger::Id::upstream> {
 public:
+  // If subscription_factory is not null, it replaces the factory of the xDS subscriptions of the
+  // cluster manager, including the ones created by the constructor, and must outlive it.
   ClusterManagerImpl(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
                      ClusterManagerFactory& factory, Stats::Store& stats,
                      ThreadLocal::Instance& tls, Runtime::Loader& runtime,
@@ -248,7 +262,8 @@ public:
                      Event::Dispatcher& main_thread_dispatcher, Server::Admin& admin,
                      ProtobufMessage::ValidationContext& validation_context, Api::Api& api,
                      Http::Context& http_context, Grpc::Context& grpc_context,
-                     Router::Context& router_context, const Server::Instance& server);
+                     Router::Context& router_context, const Server::Instance& server,
+                     Config::SubscriptionFactory* subscription_factory = nullptr);
 
   std::size_t warmingClusterCount() const { return warming_clusters_.size(); }
 
@@ -320,7 +335,10 @@ public:
 
   ClusterManagerFactory& clusterManagerFactory() override { return factory_; }
 
-  Config::SubscriptionFactory& subscriptionFactory() override { return subscription_factory_; }
+  Config::SubscriptionFactory& subscriptionFactory() override {
+    return subscription_factory_override_ != nullptr ? *subscription_factory_override_
+                                                     : subscription_factory_;
+  }
 
   void
   initializeSecondaryClusters(const envoy::config::bootstrap::v3::Bootstrap& bootstrap) override;
@@ -620,9 +638,10 @@ private:
       added_or_updated_ = true;
     }
 
-    const envoy::config::cluster::v3::Cluster cluster_config_;
-    const uint64_t config_hash_;
-    const std::string version_info_;
+    // The config, hash and version change when the cluster is updated in place.
+    envoy::config::cluster::v3::Cluster cluster_config_;
+    uint64_t config_hash_;
+    std::string version_info_;
     const bool added_via_api_;
     ClusterSharedPtr cluster_;
     // Optional thread aware LB depending on the LB type. Not all clusters have one.
@@ -708,6 +727,9 @@ private:
   void onClusterInit(ClusterManagerCluster& cluster);
   void postThreadLocalHealthFailure(const HostSharedPtr& host);
   void updateClusterCounts();
+  bool updateClusterInPlace(ClusterData& cluster_data,
+                            const envoy::config::cluster::v3::Cluster& cluster,
+                            const uint64_t cluster_hash, const std::string& version_info);
   void clusterWarmingToActive(const std::string& cluster_name);
   static void maybePreconnect(ThreadLocalClusterManagerImpl::ClusterEntry& cluster_entry,
                               const ClusterConnectivityState& cluster_manager_state,
@@ -748,6 +770,7 @@ private:
   absl::optional<std::string> local_cluster_name_;
   Grpc::AsyncClientManagerPtr async_client_manager_;
   Server::ConfigTracker::EntryOwnerPtr config_tracker_entry_;
+  Server::ConfigMemoryTracker& config_memory_tracker_;
   TimeSource& time_source_;
   ClusterUpdatesMap updates_map_;
   Event::Dispatcher& dispatcher_;
@@ -760,6 +783,7 @@ private:
   ClusterTimeoutBudgetStatNames cluster_timeout_budget_stat_names_;
 
   Config::SubscriptionFactoryImpl subscription_factory_;
+  Config::SubscriptionFactory* const subscription_factory_override_;
   ClusterSet primary_clusters_;
 };
 
@@ -37,6 +37,16 @@ struct ManagedResourceImpl : public BasicResourceLimitImpl {
     open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
   }
 
+  /**
+   * Changes the configured maximum. Resources in use above the new maximum are not released, but
+   * no new ones can be created until enough of them are.
+   */
+  void updateMax(uint64_t max) {
+    setMax(max);
+    updateRemaining();
+    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+  }
+
   /**
    * We set the gauge instead of incrementing and decrementing because,
    * though atomics are used, it is possible for the current resource count
@@ -100,7 +110,22 @@ public:
   ResourceLimit& requests() override { return requests_; }
   ResourceLimit& retries() override { return retries_; }
   ResourceLimit& connectionPools() override { return connection_pools_; }
-  uint64_t maxConnectionsPerHost() override { return max_connections_per_host_; }
+  uint64_t maxConnectionsPerHost() override { return max_connections_per_host_.load(); }
+
+  /**
+   * Changes the configured limits in place. This is safe to call while other threads use the
+   * resources.
+   */
+  void updateLimits(uint64_t max_connections, uint64_t max_pending_requests, uint64_t max_requests,
+                    uint64_t max_retries, uint64_t max_connection_pools,
+                    uint64_t max_connections_per_host) {
+    connections_.updateMax(max_connections);
+    pending_requests_.updateMax(max_pending_requests);
+    requests_.updateMax(max_requests);
+    retries_.updateMaxRetries(max_retries);
+    connection_pools_.updateMax(max_connection_pools);
+    max_connections_per_host_ = max_connections_per_host;
+  }
 
 private:
   class RetryBudgetImpl : public ResourceLimit {
@@ -158,6 +183,11 @@ private:
     }
     uint64_t count() const override { return max_retry_resource_.count(); }
 
+    void updateMaxRetries(uint64_t max_retries) {
+      max_retry_resource_.updateMax(max_retries);
+      clearRemainingGauge();
+    }
+
   private:
     bool useRetryBudget() const {
       return runtime_.snapshot().get(budget_percent_key_).has_value() ||
@@ -191,7 +221,7 @@ private:
   ManagedResourceImpl pending_requests_;
   ManagedResourceImpl requests_;
   ManagedResourceImpl connection_pools_;
-  uint64_t max_connections_per_host_;
+  std::atomic<uint64_t> max_connections_per_host_;
   RetryBudgetImpl retries_;
 };
 
@@ -1200,6 +1200,11 @@ bool ClusterInfoImpl::maintenanceMode() const {
   return runtime_.snapshot().featureEnabled(maintenance_mode_runtime_key_, 0);
 }
 
+void ClusterInfoImpl::updateResourceLimits(
+    const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers) const {
+  resource_managers_.updateLimits(circuit_breakers);
+}
+
 ResourceManager& ClusterInfoImpl::resourceManager(ResourcePriority priority) const {
   ASSERT(enumToInt(priority) < resource_managers_.managers_.size());
   return *resource_managers_.managers_[enumToInt(priority)];
@@ -1424,62 +1429,35 @@ std::pair<absl::optional<double>, absl::optional<uint32_t>> ClusterInfoImpl::get
   return std::make_pair(budget_percent, min_retry_concurrency);
 }
 
-ResourceManagerImplPtr
-ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluster& config,
-                                        Runtime::Loader& runtime, const std::string& cluster_name,
-                                        Stats::Scope& stats_scope,
-                                        const envoy::config::core::v3::RoutingPriority& priority) {
-  uint64_t max_connections = 1024;
-  uint64_t max_pending_requests = 1024;
-  uint64_t max_requests = 1024;
-  uint64_t max_retries = 3;
-  uint64_t max_connection_pools = std::numeric_limits<uint64_t>::max();
-  uint64_t max_connections_per_host = std::numeric_limits<uint64_t>::max();
-
-  bool track_remaining = false;
-
-  Stats::StatName priority_stat_name;
-  std::string priority_name;
-  switch (priority) {
-    PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
-  case envoy::config::core::v3::DEFAULT:
-    priority_stat_name = circuit_breakers_stat_names_.default_;
-    priority_name = "default";
-    break;
-  case envoy::config::core::v3::HIGH:
-    priority_stat_name = circuit_breakers_stat_names_.high_;
-    priority_name = "high";
-    break;
-  }
-
-  const std::string runtime_prefix =
-      fmt::format("circuit_breakers.{}.{}.", cluster_name, priority_name);
-
-  const auto& thresholds = config.circuit_breakers().thresholds();
+ClusterInfoImpl::ResourceManagers::Limits ClusterInfoImpl::ResourceManagers::parseLimits(
+    const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers,
+    const envoy::config::core::v3::RoutingPriority& priority) {
+  Limits limits;
+  const auto& thresholds = circuit_breakers.thresholds();
   const auto it = std::find_if(
       thresholds.cbegin(), thresholds.cend(),
       [priority](const envoy::config::cluster::v3::CircuitBreakers::Thresholds& threshold) {
         return threshold.priority() == priority;
       });
-  const auto& per_host_thresholds = config.circuit_breakers().per_host_thresholds();
+  const auto& per_host_thresholds = circuit_breakers.per_host_thresholds();
   const auto per_host_it = std::find_if(
       per_host_thresholds.cbegin(), per_host_thresholds.cend(),
       [priority](const envoy::config::cluster::v3::CircuitBreakers::Thresholds& threshold) {
         return threshold.priority() == priority;
       });
 
-  absl::optional<double> budget_percent;
-  absl::optional<uint32_t> min_retry_concurrency;
   if (it != thresholds.cend()) {
-    max_connections = PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_connections, max_connections);
-    max_pending_requests =
-        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_pending_requests, max_pending_requests);
-    max_requests = PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_requests, max_requests);
-    max_retries = PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_retries, max_retries);
-    track_remaining = it->track_remaining();
-    max_connection_pools =
-        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_connection_pools, max_connection_pools);
-    std::tie(budget_percent, min_retry_concurrency) = ClusterInfoImpl::getRetryBudgetParams(*it);
+    limits.max_connections =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_connections, limits.max_connections);
+    limits.max_pending_requests =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_pending_requests, limits.max_pending_requests);
+    limits.max_requests = PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_requests, limits.max_requests);
+    limits.max_retries = PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_retries, limits.max_retries);
+    limits.track_remaining = it->track_remaining();
+    limits.max_connection_pools =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(*it, max_connection_pools, limits.max_connection_pools);
+    std::tie(limits.budget_percent, limits.min_retry_concurrency) =
+        ClusterInfoImpl::getRetryBudgetParams(*it);
   }
   if (per_host_it != per_host_thresholds.cend()) {
     if (per_host_it->has_max_pending_requests() || per_host_it->has_max_requests() ||
@@ -1488,15 +1466,56 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
       throw EnvoyException("Unsupported field in per_host_thresholds");
     }
     if (per_host_it->has_max_connections()) {
-      max_connections_per_host = per_host_it->max_connections().value();
+      limits.max_connections_per_host = per_host_it->max_connections().value();
     }
   }
+  return limits;
+}
+
+ResourceManagerImplPtr
+ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluster& config,
+                                        Runtime::Loader& runtime, const std::string& cluster_name,
+                                        Stats::Scope& stats_scope,
+                                        const envoy::config::core::v3::RoutingPriority& priority) {
+  Stats::StatName priority_stat_name;
+  std::string priority_name;
+  switch (priority) {
+    PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
+  case envoy::config::core::v3::DEFAULT:
+    priority_stat_name = circuit_breakers_stat_names_.default_;
+    priority_name = "default";
+    break;
+  case envoy::config::core::v3::HIGH:
+    priority_stat_name = circuit_breakers_stat_names_.high_;
+    priority_name = "high";
+    break;
+  }
+
+  const std::string runtime_prefix =
+      fmt::format("circuit_breakers.{}.{}.", cluster_name, priority_name);
+
+  const Limits limits = parseLimits(config.circuit_breakers(), priority);
   return std::make_unique<ResourceManagerImpl>(
-      runtime, runtime_prefix, max_connections, max_pending_requests, max_requests, max_retries,
-      max_connection_pools, max_connections_per_host,
-      ClusterInfoImpl::generateCircuitBreakersStats(stats_scope, priority_stat_name,
-                                                    track_remaining, circuit_breakers_stat_names_),
-      budget_percent, min_retry_concurrency);
+      runtime, runtime_prefix, limits.max_connections, limits.max_pending_requests,
+      limits.max_requests, limits.max_retries, limits.max_connection_pools,
+      limits.max_connections_per_host,
+      ClusterInfoImpl::generateCircuitBreakersStats(
+          stats_scope, priority_stat_name, limits.track_remaining, circuit_breakers_stat_names_),
+      limits.budget_percent, limits.min_retry_concurrency);
+}
+
+void ClusterInfoImpl::ResourceManagers::updateLimits(
+    const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers) {
+  // Parse both priorities before applying either, so that an invalid config changes nothing.
+  const Limits default_limits = parseLimits(circuit_breakers, envoy::config::core::v3::DEFAULT);
+  const Limits high_limits = parseLimits(circuit_breakers, envoy::config::core::v3::HIGH);
+  auto update = [](ResourceManagerImpl& manager, const Limits& limits) {
+    manager.updateLimits(limits.max_connections, limits.max_pending_requests, limits.max_requests,
+                         limits.max_retries, limits.max_connection_pools,
+                         limits.max_connections_per_host);
+  };
+  update(*managers_[enumToInt(ResourcePriority::Default)], default_limits);
+  update(*managers_[enumToInt(ResourcePriority::High)], high_limits);
 }
 
 PriorityStateManager::PriorityStateManager(ClusterImplBase& cluster,
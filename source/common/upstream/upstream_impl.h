@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <string>
@@ -697,6 +698,8 @@ public:
   const std::string& name() const override { return name_; }
   const std::string& observabilityName() const override { return observability_name_; }
   ResourceManager& resourceManager(ResourcePriority priority) const override;
+  void updateResourceLimits(
+      const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers) const override;
   TransportSocketMatcher& transportSocketMatcher() const override { return *socket_matcher_; }
   ClusterStats& stats() const override { return stats_; }
   Stats::Scope& statsScope() const override { return *stats_scope_; }
@@ -775,6 +778,22 @@ private:
                                 Runtime::Loader& runtime, const std::string& cluster_name,
                                 Stats::Scope& stats_scope,
                                 const envoy::config::core::v3::RoutingPriority& priority);
+    void updateLimits(const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers);
+
+    // The circuit breaker configuration of one priority, with defaults filled in.
+    struct Limits {
+      uint64_t max_connections{1024};
+      uint64_t max_pending_requests{1024};
+      uint64_t max_requests{1024};
+      uint64_t max_retries{3};
+      uint64_t max_connection_pools{std::numeric_limits<uint64_t>::max()};
+      uint64_t max_connections_per_host{std::numeric_limits<uint64_t>::max()};
+      bool track_remaining{};
+      absl::optional<double> budget_percent;
+      absl::optional<uint32_t> min_retry_concurrency;
+    };
+    static Limits parseLimits(const envoy::config::cluster::v3::CircuitBreakers& circuit_breakers,
+                              const envoy::config::core::v3::RoutingPriority& priority);
 
     using Managers = std::array<ResourceManagerImplPtr, NumResourcePriorities>;
 
@@ -0,0 +1,56 @@
+#include "source/extensions/access_loggers/binary_ring/binary_ring_access_log_impl.h"
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/fmt.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+RingFileSharedPtr RingFileManager::getOrCreate(const std::string& path, uint64_t capacity) {
+  RingFileSharedPtr ring_file = ring_files_[path].lock();
+  if (ring_file != nullptr) {
+    if (ring_file->capacity() != capacity) {
+      throw EnvoyException(fmt::format(
+          "binary access log ring file {} is already in use with a ring size of {} bytes", path,
+          ring_file->capacity()));
+    }
+    return ring_file;
+  }
+  ring_file = std::make_shared<RingFile>(path, capacity);
+  ring_files_[path] = ring_file;
+  return ring_file;
+}
+
+BinaryRingAccessLog::BinaryRingAccessLog(AccessLog::FilterPtr&& filter, RecordEncoder&& encoder,
+                                         RingFileSharedPtr ring_file, Stats::Scope& scope)
+    : ImplBase(std::move(filter)), encoder_(std::move(encoder)), ring_file_(std::move(ring_file)),
+      stats_({ALL_BINARY_RING_ACCESS_LOG_STATS(
+          POOL_COUNTER_PREFIX(scope, "access_logs.binary_ring."))}) {}
+
+void BinaryRingAccessLog::emitLog(const Http::RequestHeaderMap&, const Http::ResponseHeaderMap&,
+                                  const Http::ResponseTrailerMap&,
+                                  const StreamInfo::StreamInfo& stream_info) {
+  RecordBuffer record;
+  encoder_.encode(stream_info, record);
+  if (record.empty()) {
+    return;
+  }
+
+  uint64_t overwritten = 0;
+  if (!ring_file_->append(absl::string_view(record.data(), record.size()), overwritten)) {
+    stats_.records_dropped_.inc();
+    return;
+  }
+  stats_.records_written_.inc();
+  if (overwritten > 0) {
+    stats_.records_overwritten_.add(overwritten);
+  }
+}
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/singleton/instance.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/extensions/access_loggers/binary_ring/record_encoder.h"
+#include "source/extensions/access_loggers/binary_ring/ring_file.h"
+#include "source/extensions/access_loggers/common/access_log_base.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+/**
+ * All binary ring access log stats. @see stats_macros.h
+ */
+#define ALL_BINARY_RING_ACCESS_LOG_STATS(COUNTER)                                                  \
+  COUNTER(records_written)                                                                         \
+  COUNTER(records_dropped)                                                                         \
+  COUNTER(records_overwritten)
+
+/**
+ * Struct definition for all binary ring access log stats. @see stats_macros.h
+ */
+struct BinaryRingAccessLogStats {
+  ALL_BINARY_RING_ACCESS_LOG_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Server-wide registry of mapped ring files, so that several access logs configured with the same
+ * path share one mapping and one writer lock.
+ */
+class RingFileManager : public Singleton::Instance {
+public:
+  /**
+   * @return the ring file mapped at path, mapping it if this is the first user. Throws
+   *         EnvoyException if the path is already in use with a different capacity.
+   */
+  RingFileSharedPtr getOrCreate(const std::string& path, uint64_t capacity);
+
+private:
+  absl::flat_hash_map<std::string, std::weak_ptr<RingFile>> ring_files_;
+};
+
+using RingFileManagerSharedPtr = std::shared_ptr<RingFileManager>;
+
+/**
+ * Access log Instance that writes binary records into a memory-mapped ring file.
+ */
+class BinaryRingAccessLog : public Common::ImplBase {
+public:
+  BinaryRingAccessLog(AccessLog::FilterPtr&& filter, RecordEncoder&& encoder,
+                      RingFileSharedPtr ring_file, Stats::Scope& scope);
+
+private:
+  // Common::ImplBase
+  void emitLog(const Http::RequestHeaderMap& request_headers,
+               const Http::ResponseHeaderMap& response_headers,
+               const Http::ResponseTrailerMap& response_trailers,
+               const StreamInfo::StreamInfo& stream_info) override;
+
+  const RecordEncoder encoder_;
+  const RingFileSharedPtr ring_file_;
+  BinaryRingAccessLogStats stats_;
+};
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#include "source/extensions/access_loggers/binary_ring/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/access_loggers/binary_ring/v3/binary_ring.pb.h"
+#include "envoy/extensions/access_loggers/binary_ring/v3/binary_ring.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/binary_ring/binary_ring_access_log_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+// Singleton registration via macro defined in envoy/singleton/manager.h
+SINGLETON_MANAGER_REGISTRATION(binary_ring_file_manager);
+
+namespace {
+constexpr uint64_t DefaultRingSizeBytes = 64 * 1024 * 1024;
+} // namespace
+
+AccessLog::InstanceSharedPtr BinaryRingAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::CommonFactoryContext& context) {
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog&>(
+      config, context.messageValidationVisitor());
+
+  std::vector<Field> fields;
+  for (const int field : proto_config.fields()) {
+    fields.push_back(static_cast<Field>(field));
+  }
+  if (fields.empty()) {
+    fields = RecordEncoder::allFields();
+  }
+
+  RingFileManagerSharedPtr manager =
+      context.singletonManager().getTyped<RingFileManager>(
+          SINGLETON_MANAGER_REGISTERED_NAME(binary_ring_file_manager),
+          [] { return std::make_shared<RingFileManager>(); });
+  RingFileSharedPtr ring_file = manager->getOrCreate(
+      proto_config.path(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, ring_size_bytes, DefaultRingSizeBytes));
+
+  return std::make_shared<BinaryRingAccessLog>(std::move(filter), RecordEncoder(std::move(fields)),
+                                               std::move(ring_file), context.scope());
+}
+
+ProtobufTypes::MessagePtr BinaryRingAccessLogFactory::createEmptyConfigProto() {
+  return std::make_unique<envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog>();
+}
+
+std::string BinaryRingAccessLogFactory::name() const { return "envoy.access_loggers.binary_ring"; }
+
+/**
+ * Static registration for the binary ring file access log. @see RegisterFactory.
+ */
+REGISTER_FACTORY(BinaryRingAccessLogFactory, Server::Configuration::AccessLogInstanceFactory);
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "envoy/server/access_log_config.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+/**
+ * Config registration for the binary ring file access log. @see AccessLogInstanceFactory.
+ */
+class BinaryRingAccessLogFactory : public Server::Configuration::AccessLogInstanceFactory {
+public:
+  AccessLog::InstanceSharedPtr
+  createAccessLogInstance(const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+                          Server::Configuration::CommonFactoryContext& context) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override;
+
+  std::string name() const override;
+};
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
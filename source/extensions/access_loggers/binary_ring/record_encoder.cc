@@ -0,0 +1,177 @@
+#include "source/extensions/access_loggers/binary_ring/record_encoder.h"
+
+#include <chrono>
+
+#include "source/common/common/assert.h"
+#include "source/common/http/utility.h"
+#include "source/extensions/access_loggers/binary_ring/ring_file.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+namespace {
+
+using BinaryRingAccessLog = envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog;
+
+// Protobuf wire types used for record fields.
+constexpr uint32_t WireTypeVarint = 0;
+constexpr uint32_t WireTypeLengthDelimited = 2;
+
+void appendVarint(uint64_t value, RecordBuffer& out) {
+  const size_t offset = out.size();
+  out.resize(offset + RingFraming::varintSize(value));
+  RingFraming::writeVarint(value, reinterpret_cast<uint8_t*>(out.data() + offset));
+}
+
+void appendNumber(Field field, uint64_t value, RecordBuffer& out) {
+  appendVarint((static_cast<uint64_t>(field) << 3) | WireTypeVarint, out);
+  appendVarint(value, out);
+}
+
+void appendString(Field field, absl::string_view value, RecordBuffer& out) {
+  if (value.empty()) {
+    return;
+  }
+  appendVarint((static_cast<uint64_t>(field) << 3) | WireTypeLengthDelimited, out);
+  appendVarint(value.size(), out);
+  out.insert(out.end(), value.begin(), value.end());
+}
+
+} // namespace
+
+RecordEncoder::RecordEncoder(std::vector<Field> fields) : fields_(std::move(fields)) {}
+
+std::vector<Field> RecordEncoder::allFields() {
+  std::vector<Field> fields;
+  for (int field = BinaryRingAccessLog::Field_MIN; field <= BinaryRingAccessLog::Field_MAX;
+       ++field) {
+    if (field != BinaryRingAccessLog::FIELD_UNSPECIFIED &&
+        BinaryRingAccessLog::Field_IsValid(field)) {
+      fields.push_back(static_cast<Field>(field));
+    }
+  }
+  return fields;
+}
+
+bool RecordEncoder::isStringField(Field field) {
+  switch (field) {
+  case BinaryRingAccessLog::PROTOCOL:
+  case BinaryRingAccessLog::DOWNSTREAM_REMOTE_ADDRESS:
+  case BinaryRingAccessLog::UPSTREAM_HOST:
+  case BinaryRingAccessLog::UPSTREAM_CLUSTER:
+  case BinaryRingAccessLog::ROUTE_NAME:
+  case BinaryRingAccessLog::RESPONSE_CODE_DETAILS:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void RecordEncoder::encode(const StreamInfo::StreamInfo& stream_info, RecordBuffer& out) const {
+  for (const Field field : fields_) {
+    switch (field) {
+    case BinaryRingAccessLog::START_TIME:
+      appendNumber(field,
+                   std::chrono::duration_cast<std::chrono::microseconds>(
+                       stream_info.startTime().time_since_epoch())
+                       .count(),
+                   out);
+      break;
+    case BinaryRingAccessLog::DURATION: {
+      const auto duration = stream_info.requestComplete();
+      if (duration.has_value()) {
+        appendNumber(
+            field,
+            std::chrono::duration_cast<std::chrono::microseconds>(duration.value()).count(), out);
+      }
+      break;
+    }
+    case BinaryRingAccessLog::RESPONSE_CODE:
+      if (stream_info.responseCode().has_value()) {
+        appendNumber(field, stream_info.responseCode().value(), out);
+      }
+      break;
+    case BinaryRingAccessLog::RESPONSE_FLAGS:
+      appendNumber(field, stream_info.responseFlags(), out);
+      break;
+    case BinaryRingAccessLog::BYTES_RECEIVED:
+      appendNumber(field, stream_info.bytesReceived(), out);
+      break;
+    case BinaryRingAccessLog::BYTES_SENT:
+      appendNumber(field, stream_info.bytesSent(), out);
+      break;
+    case BinaryRingAccessLog::PROTOCOL:
+      if (stream_info.protocol().has_value()) {
+        appendString(field, Http::Utility::getProtocolString(stream_info.protocol().value()), out);
+      }
+      break;
+    case BinaryRingAccessLog::DOWNSTREAM_REMOTE_ADDRESS:
+      if (stream_info.downstreamAddressProvider().remoteAddress() != nullptr) {
+        appendString(field, stream_info.downstreamAddressProvider().remoteAddress()->asStringView(),
+                     out);
+      }
+      break;
+    case BinaryRingAccessLog::UPSTREAM_HOST:
+      if (stream_info.upstreamInfo() && stream_info.upstreamInfo()->upstreamHost() &&
+          stream_info.upstreamInfo()->upstreamHost()->address() != nullptr) {
+        appendString(field, stream_info.upstreamInfo()->upstreamHost()->address()->asStringView(),
+                     out);
+      }
+      break;
+    case BinaryRingAccessLog::UPSTREAM_CLUSTER:
+      if (stream_info.upstreamClusterInfo().has_value() &&
+          stream_info.upstreamClusterInfo().value() != nullptr) {
+        appendString(field, stream_info.upstreamClusterInfo().value()->observabilityName(), out);
+      }
+      break;
+    case BinaryRingAccessLog::ROUTE_NAME:
+      appendString(field, stream_info.getRouteName(), out);
+      break;
+    case BinaryRingAccessLog::RESPONSE_CODE_DETAILS:
+      if (stream_info.responseCodeDetails().has_value()) {
+        appendString(field, stream_info.responseCodeDetails().value(), out);
+      }
+      break;
+    default:
+      PANIC_DUE_TO_CORRUPT_ENUM;
+    }
+  }
+}
+
+bool RecordEncoder::decode(absl::string_view record, std::vector<DecodedField>& fields) {
+  while (!record.empty()) {
+    uint64_t tag = 0;
+    if (!RingFraming::readVarint(record, tag)) {
+      return false;
+    }
+    DecodedField decoded{static_cast<uint32_t>(tag >> 3), false, 0, {}};
+    switch (tag & 0x7) {
+    case WireTypeVarint:
+      if (!RingFraming::readVarint(record, decoded.number_value_)) {
+        return false;
+      }
+      break;
+    case WireTypeLengthDelimited: {
+      uint64_t length = 0;
+      if (!RingFraming::readVarint(record, length) || length > record.size()) {
+        return false;
+      }
+      decoded.is_string_ = true;
+      decoded.string_value_ = record.substr(0, length);
+      record.remove_prefix(length);
+      break;
+    }
+    default:
+      return false;
+    }
+    fields.push_back(decoded);
+  }
+  return true;
+}
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/extensions/access_loggers/binary_ring/v3/binary_ring.pb.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+using Field = envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog::Field;
+
+// Records are assembled on the stack; only unusually large records spill to the heap.
+using RecordBuffer = absl::InlinedVector<char, 512>;
+
+/**
+ * A single field decoded from a record. string_value_ points into the record it was decoded from.
+ */
+struct DecodedField {
+  uint32_t field_;
+  bool is_string_;
+  uint64_t number_value_;
+  absl::string_view string_value_;
+};
+
+/**
+ * Encodes the selected StreamInfo fields of a request into a record body using the protobuf wire
+ * format, with the Field enum value as the field number.
+ */
+class RecordEncoder {
+public:
+  explicit RecordEncoder(std::vector<Field> fields);
+
+  /**
+   * Append the record for stream_info to out. Fields without a value are omitted.
+   */
+  void encode(const StreamInfo::StreamInfo& stream_info, RecordBuffer& out) const;
+
+  /**
+   * @return true if field is written as a length delimited string rather than a varint.
+   */
+  static bool isStringField(Field field);
+
+  /**
+   * Decode a record body produced by encode().
+   * @param record supplies the record body.
+   * @param fields receives the decoded fields in record order.
+   * @return false if the record is malformed.
+   */
+  static bool decode(absl::string_view record, std::vector<DecodedField>& fields);
+
+  /**
+   * @return all fields, in enum order. This is the default field selection.
+   */
+  static std::vector<Field> allFields();
+
+private:
+  const std::vector<Field> fields_;
+};
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,334 @@
+#include "source/extensions/access_loggers/binary_ring/ring_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "envoy/api/os_sys_calls.h"
+#include "envoy/common/exception.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/common/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+size_t RingFraming::varintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+uint8_t* RingFraming::writeVarint(uint64_t value, uint8_t* out) {
+  while (value >= 0x80) {
+    *out++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(value);
+  return out;
+}
+
+bool RingFraming::readVarint(absl::string_view& data, uint64_t& value) {
+  value = 0;
+  for (size_t i = 0; i < data.size() && i < 10; ++i) {
+    const uint8_t byte = static_cast<uint8_t>(data[i]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      data.remove_prefix(i + 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+
+bool headerMatches(const RingFileHeader& header, uint64_t capacity) {
+  return memcmp(header.magic_, RING_FILE_MAGIC, sizeof(RING_FILE_MAGIC)) == 0 &&
+         header.version_ == RING_FILE_VERSION && header.header_size_ == sizeof(RingFileHeader) &&
+         header.capacity_ == capacity;
+}
+
+} // namespace
+
+RingFile::RingFile(const std::string& path, uint64_t capacity)
+    : path_(path), capacity_(capacity), mapping_size_(sizeof(RingFileHeader) + capacity) {
+  // Resume an existing ring so that tailers keep their position across restarts. Anything else is
+  // replaced by a new ring.
+  if (attach()) {
+    lock();
+    validate();
+    unlock();
+  } else {
+    create();
+  }
+}
+
+RingFile::~RingFile() { ::munmap(mapping_, mapping_size_); }
+
+bool RingFile::attach() {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallIntResult open_result = os_sys_calls.open(path_.c_str(), O_RDWR | O_CLOEXEC);
+  if (open_result.return_value_ == -1) {
+    return false;
+  }
+  const int fd = open_result.return_value_;
+
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0 ||
+      static_cast<uint64_t>(file_stat.st_size) != mapping_size_) {
+    os_sys_calls.close(fd);
+    return false;
+  }
+  map(fd);
+
+  if (!headerMatches(*header_, capacity_)) {
+    ::munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void RingFile::create() {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+
+  // Build the new ring beside the final path and rename it into place once its header and lock are
+  // initialized. Truncating the existing file instead would fault the processes, such as a hot
+  // restart parent, that still map it.
+  const std::string temp_path = fmt::format("{}.{}.tmp", path_, ::getpid());
+  os_sys_calls.unlink(temp_path.c_str());
+  const Api::SysCallIntResult open_result =
+      os_sys_calls.open(temp_path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                        S_IRUSR | S_IWUSR | S_IRGRP);
+  if (open_result.return_value_ == -1) {
+    throw EnvoyException(fmt::format("unable to open binary access log ring file {}: {}", path_,
+                                     errorDetails(open_result.errno_)));
+  }
+  const int fd = open_result.return_value_;
+
+  // A freshly extended file reads as zeros, which is an empty ring.
+  const Api::SysCallIntResult truncate_result = os_sys_calls.ftruncate(fd, mapping_size_);
+  if (truncate_result.return_value_ == -1) {
+    os_sys_calls.close(fd);
+    os_sys_calls.unlink(temp_path.c_str());
+    throw EnvoyException(fmt::format("unable to size binary access log ring file {}: {}", path_,
+                                     errorDetails(truncate_result.errno_)));
+  }
+  map(fd);
+
+  memcpy(header_->magic_, RING_FILE_MAGIC, sizeof(RING_FILE_MAGIC));
+  header_->version_ = RING_FILE_VERSION;
+  header_->header_size_ = sizeof(RingFileHeader);
+  header_->capacity_ = capacity_;
+
+  pthread_mutexattr_t attribute;
+  pthread_mutexattr_init(&attribute);
+  pthread_mutexattr_setpshared(&attribute, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+  pthread_mutexattr_setrobust(&attribute, PTHREAD_MUTEX_ROBUST);
+#endif
+  pthread_mutex_init(&header_->mutex_, &attribute);
+  pthread_mutexattr_destroy(&attribute);
+
+  if (::rename(temp_path.c_str(), path_.c_str()) != 0) {
+    const int error = errno;
+    os_sys_calls.unlink(temp_path.c_str());
+    throw EnvoyException(fmt::format("unable to open binary access log ring file {}: {}", path_,
+                                     errorDetails(error)));
+  }
+}
+
+void RingFile::map(int fd) {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallPtrResult mmap_result =
+      os_sys_calls.mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping keeps the file referenced; the descriptor is no longer needed.
+  os_sys_calls.close(fd);
+  if (mmap_result.return_value_ == MAP_FAILED) {
+    throw EnvoyException(fmt::format("unable to map binary access log ring file {}: {}", path_,
+                                     errorDetails(mmap_result.errno_)));
+  }
+  mapping_ = mmap_result.return_value_;
+  header_ = static_cast<RingFileHeader*>(mapping_);
+  data_ = static_cast<uint8_t*>(mapping_) + sizeof(RingFileHeader);
+}
+
+void RingFile::lock() {
+  const int rc = pthread_mutex_lock(&header_->mutex_);
+#ifdef __linux__
+  if (rc == EOWNERDEAD) {
+    // The previous owner died, possibly half way through an append.
+    pthread_mutex_consistent(&header_->mutex_);
+    validate();
+    return;
+  }
+#endif
+  RELEASE_ASSERT(rc == 0, fmt::format("unable to lock binary access log ring file {}: {}", path_,
+                                      errorDetails(rc)));
+}
+
+void RingFile::unlock() {
+  const int rc = pthread_mutex_unlock(&header_->mutex_);
+  ASSERT(rc == 0);
+}
+
+bool RingFile::append(absl::string_view record, uint64_t& overwritten) {
+  ASSERT(!record.empty());
+  overwritten = 0;
+  if (record.empty() || record.size() > maxRecordSize()) {
+    return false;
+  }
+  const uint64_t framed_size = RingFraming::varintSize(record.size()) + record.size();
+
+  lock();
+  uint64_t head = header_->head_.load(std::memory_order_relaxed);
+  const uint64_t position = head % capacity_;
+  if (capacity_ - position < framed_size) {
+    // Records never straddle the end of the data area; pad to the end and wrap. There is always
+    // room for the single byte padding marker.
+    const uint64_t padding = capacity_ - position;
+    overwritten += reserve(head, padding);
+    data_[position] = 0;
+    head += padding;
+  }
+  overwritten += reserve(head, framed_size);
+
+  uint8_t* out = RingFraming::writeVarint(record.size(), data_ + head % capacity_);
+  memcpy(out, record.data(), record.size());
+  header_->records_.fetch_add(1, std::memory_order_relaxed);
+  header_->head_.store(head + framed_size, std::memory_order_release);
+  unlock();
+  return true;
+}
+
+uint64_t RingFile::reserve(uint64_t head, uint64_t bytes) {
+  const uint64_t old_tail = header_->tail_.load(std::memory_order_relaxed);
+  uint64_t tail = old_tail;
+  uint64_t evicted = 0;
+  while (head + bytes - tail > capacity_) {
+    const uint64_t frame_size = frameSizeAt(tail);
+    if (frame_size == 0 || frame_size > head - tail) {
+      // The framing is corrupt, so the records up to the head cannot be counted or read. Drop them.
+      tail = head;
+      break;
+    }
+    if (data_[tail % capacity_] != 0) {
+      ++evicted;
+    }
+    tail += frame_size;
+  }
+  if (tail != old_tail) {
+    // Publish the new tail before the evicted bytes are overwritten so readers can detect torn
+    // copies, in the same way as a seqlock writer.
+    header_->tail_.store(tail, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  return evicted;
+}
+
+uint64_t RingFile::frameSizeAt(uint64_t offset) const {
+  const uint64_t position = offset % capacity_;
+  if (data_[position] == 0) {
+    return capacity_ - position;
+  }
+  absl::string_view view(reinterpret_cast<const char*>(data_ + position), capacity_ - position);
+  uint64_t length = 0;
+  if (!RingFraming::readVarint(view, length) || length == 0 || length > view.size()) {
+    return 0;
+  }
+  return (capacity_ - position - view.size()) + length;
+}
+
+void RingFile::validate() {
+  const uint64_t head = header_->head_.load(std::memory_order_relaxed);
+  const uint64_t tail = header_->tail_.load(std::memory_order_relaxed);
+  bool valid = tail <= head && head - tail <= capacity_;
+  for (uint64_t offset = tail; valid && offset < head;) {
+    const uint64_t frame_size = frameSizeAt(offset);
+    valid = frame_size != 0 && frame_size <= head - offset;
+    offset += frame_size;
+  }
+  if (!valid) {
+    // Readers whose cursor is past the new head are moved back to the oldest record.
+    header_->tail_.store(0, std::memory_order_relaxed);
+    header_->head_.store(0, std::memory_order_release);
+  }
+}
+
+RingFileReader::RingFileReader(const uint8_t* mapping, size_t size)
+    : header_(reinterpret_cast<const RingFileHeader*>(mapping)),
+      data_(mapping + sizeof(RingFileHeader)) {
+  if (size < sizeof(RingFileHeader) ||
+      memcmp(header_->magic_, RING_FILE_MAGIC, sizeof(RING_FILE_MAGIC)) != 0) {
+    throw EnvoyException("not a binary access log ring file");
+  }
+  if (header_->version_ != RING_FILE_VERSION || header_->header_size_ != sizeof(RingFileHeader)) {
+    throw EnvoyException(
+        fmt::format("unsupported binary access log ring file version {}", header_->version_));
+  }
+  capacity_ = header_->capacity_;
+  if (capacity_ == 0 || size - sizeof(RingFileHeader) < capacity_) {
+    throw EnvoyException("binary access log ring file is truncated");
+  }
+}
+
+RingFileReader::ReadResult RingFileReader::next(uint64_t& cursor, std::string& record) const {
+  while (true) {
+    const uint64_t head = newest();
+    // A cursor past the head means that the writer re-initialized the ring.
+    if (cursor < oldest() || cursor > head) {
+      cursor = oldest();
+      return ReadResult::Overrun;
+    }
+    if (cursor >= head) {
+      return ReadResult::Empty;
+    }
+
+    const uint64_t position = cursor % capacity_;
+    const uint8_t* start = data_ + position;
+    absl::string_view view(reinterpret_cast<const char*>(start),
+                           std::min(head - cursor, capacity_ - position));
+    uint64_t length = 0;
+    const bool framed = RingFraming::readVarint(view, length) && length <= view.size();
+    if (framed && length > 0) {
+      record.assign(view.data(), length);
+    }
+
+    // Anything copied above may have been overwritten concurrently; it is only valid if the tail
+    // has not moved past the cursor since.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (cursor < oldest()) {
+      cursor = oldest();
+      return ReadResult::Overrun;
+    }
+    if (!framed) {
+      throw EnvoyException(fmt::format("corrupt binary access log record at offset {}", cursor));
+    }
+    if (length == 0) {
+      // Padding up to the end of the data area.
+      cursor += capacity_ - position;
+      continue;
+    }
+    cursor += (reinterpret_cast<const uint8_t*>(view.data()) - start) + length;
+    return ReadResult::Record;
+  }
+}
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
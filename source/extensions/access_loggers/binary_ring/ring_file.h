@@ -0,0 +1,197 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+
+// Increment this whenever the on-disk layout changes in a way that existing tailers cannot read.
+constexpr uint32_t RING_FILE_VERSION = 2;
+constexpr char RING_FILE_MAGIC[8] = {'E', 'N', 'V', 'O', 'Y', 'B', 'R', 'L'};
+
+/**
+ * Header laid directly at the start of the memory-mapped ring file. All offsets are logical byte
+ * positions in the (unbounded) stream of framed records; the physical position of an offset in the
+ * data area that follows the header is offset % capacity_.
+ *
+ * The writer only ever advances tail_ before overwriting data and publishes head_ after the data
+ * has been written, so a reader that copies a record starting at offset r can detect that the copy
+ * was torn by re-reading tail_ afterwards and checking that it is still <= r.
+ *
+ * Writers are serialized by mutex_, which is shared by every process mapping the file: during a
+ * hot restart the parent and the child append to the same ring.
+ */
+struct RingFileHeader {
+  char magic_[8];
+  uint32_t version_;
+  uint32_t header_size_;
+  uint64_t capacity_;
+  // Logical offset one past the last fully written record.
+  std::atomic<uint64_t> head_;
+  // Logical offset of the oldest record that has not been overwritten.
+  std::atomic<uint64_t> tail_;
+  // Total number of records ever written, including overwritten ones.
+  std::atomic<uint64_t> records_;
+  // Process shared, and on Linux robust, mutex taken by writers.
+  union {
+    pthread_mutex_t mutex_;
+    uint8_t mutex_storage_[64];
+  };
+  uint8_t reserved_[16];
+};
+static_assert(sizeof(pthread_mutex_t) <= 64, "pthread_mutex_t does not fit in RingFileHeader");
+static_assert(sizeof(RingFileHeader) == 128, "RingFileHeader must be exactly two cache lines");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Ring file cursors must be lock free to be shared across processes");
+
+/**
+ * Helpers for the framing used in the ring: each record is a varint length prefix followed by the
+ * record body. A zero length prefix marks padding up to the end of the data area.
+ */
+class RingFraming {
+public:
+  /**
+   * @return the number of bytes needed to encode value as a varint.
+   */
+  static size_t varintSize(uint64_t value);
+
+  /**
+   * Encode value as a varint at out, which must have room for varintSize(value) bytes.
+   * @return a pointer one past the last byte written.
+   */
+  static uint8_t* writeVarint(uint64_t value, uint8_t* out);
+
+  /**
+   * Decode a varint from the front of data.
+   * @param data supplies the input, and is advanced past the varint on success.
+   * @param value receives the decoded value.
+   * @return false if data does not start with a complete varint of at most 10 bytes.
+   */
+  static bool readVarint(absl::string_view& data, uint64_t& value);
+};
+
+/**
+ * Writer side of a ring file. The backing file is mapped once at construction; append() copies a
+ * record into the mapping under the lock in the file header, which is shared with the other
+ * processes appending to the file, and only makes a system call when that lock is contended.
+ */
+class RingFile {
+public:
+  /**
+   * Map the ring file at path. An existing ring with the same layout is resumed after its cursors
+   * are validated, and re-initialized if they are corrupt. Otherwise a new ring file is created and
+   * atomically replaces any existing file, so that processes still mapping the old file are not
+   * affected. Throws EnvoyException if the file cannot be created or mapped.
+   */
+  RingFile(const std::string& path, uint64_t capacity);
+  ~RingFile();
+
+  /**
+   * Append one record. Records larger than maxRecordSize() are rejected.
+   * @param record supplies the record body, without framing.
+   * @param overwritten receives the number of older records evicted to make room.
+   * @return true if the record was written.
+   */
+  bool append(absl::string_view record, uint64_t& overwritten);
+
+  /**
+   * @return the largest record body accepted by append().
+   */
+  uint64_t maxRecordSize() const { return capacity_ / 4; }
+
+  const std::string& path() const { return path_; }
+  uint64_t capacity() const { return capacity_; }
+  const RingFileHeader& header() const { return *header_; }
+
+private:
+  bool attach();
+  void create();
+  void map(int fd);
+
+  // Take the lock in the header. If its previous owner died while holding it, the ring is
+  // validated before returning.
+  void lock();
+  void unlock();
+
+  // The following must be called with the lock held.
+
+  // Evict records from the tail until bytes more bytes can be written at the head. If the framing
+  // at the tail is corrupt, every record before the head is dropped instead.
+  uint64_t reserve(uint64_t head, uint64_t bytes);
+  // @return the framed size of the record, or padding, at the given tail offset, or zero if the
+  // framing at offset is corrupt.
+  uint64_t frameSizeAt(uint64_t offset) const;
+  // Re-initialize the ring if its cursors or the framing between them are not consistent.
+  void validate();
+
+  const std::string path_;
+  const uint64_t capacity_;
+  const size_t mapping_size_;
+  void* mapping_{};
+  RingFileHeader* header_{};
+  uint8_t* data_{};
+};
+
+using RingFileSharedPtr = std::shared_ptr<RingFile>;
+
+/**
+ * Reader side of a ring file, used by tailers such as the decoder tool. The reader never writes
+ * to the mapping.
+ */
+class RingFileReader {
+public:
+  enum class ReadResult {
+    // A record was copied out and the cursor advanced past it.
+    Record,
+    // The cursor has caught up with the writer.
+    Empty,
+    // The writer overwrote data at the cursor, or re-initialized the ring; the cursor was moved to
+    // the oldest intact record.
+    Overrun,
+  };
+
+  /**
+   * @param mapping supplies a read-only mapping of the whole ring file.
+   * @param size supplies the size of the mapping.
+   * Throws EnvoyException if the mapping does not hold a valid ring file.
+   */
+  RingFileReader(const uint8_t* mapping, size_t size);
+
+  /**
+   * @return the logical offset of the oldest record still in the ring.
+   */
+  uint64_t oldest() const { return header_->tail_.load(std::memory_order_acquire); }
+
+  /**
+   * @return the logical offset one past the newest record in the ring.
+   */
+  uint64_t newest() const { return header_->head_.load(std::memory_order_acquire); }
+
+  /**
+   * Read the record at cursor.
+   * @param cursor supplies the logical offset to read from, and is advanced on success.
+   * @param record receives a copy of the record body.
+   */
+  ReadResult next(uint64_t& cursor, std::string& record) const;
+
+  const RingFileHeader& header() const { return *header_; }
+
+private:
+  const RingFileHeader* header_;
+  const uint8_t* data_;
+  uint64_t capacity_;
+};
+
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
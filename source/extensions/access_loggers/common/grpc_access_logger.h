@@ -4,16 +4,22 @@
 
 #include "envoy/config/core/v3/config_source.pb.h"
 #include "envoy/event/dispatcher.h"
+#include "envoy/event/dispatcher_thread_deletable.h"
 #include "envoy/grpc/async_client_manager.h"
 #include "envoy/singleton/instance.h"
 #include "envoy/stats/scope.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/thread.h"
+#include "source/common/grpc/common.h"
 #include "source/common/grpc/typed_async_client.h"
+#include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger_utils.h"
+#include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
@@ -74,19 +80,30 @@ public:
   getOrCreateLogger(const ConfigProto& config, GrpcAccessLoggerType logger_type) PURE;
 };
 
+using MessageCompression =
+    envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig::MessageCompression;
+
 template <typename LogRequest, typename LogResponse> class GrpcAccessLogClient {
 public:
   GrpcAccessLogClient(const Grpc::RawAsyncClientSharedPtr& client,
                       const Protobuf::MethodDescriptor& service_method,
-                      OptRef<const envoy::config::core::v3::RetryPolicy> retry_policy)
-      : client_(client), service_method_(service_method), grpc_stream_retry_policy_(retry_policy) {}
+                      OptRef<const envoy::config::core::v3::RetryPolicy> retry_policy,
+                      MessageCompression compression)
+      : client_(client), service_method_(service_method), grpc_stream_retry_policy_(retry_policy),
+        compression_(compression) {}
 
 public:
   struct LocalStream : public Grpc::AsyncStreamCallbacks<LogResponse> {
     LocalStream(GrpcAccessLogClient& parent) : parent_(parent) {}
 
     // Grpc::AsyncStreamCallbacks
-    void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
+    void onCreateInitialMetadata(Http::RequestHeaderMap& metadata) override {
+      if (parent_.compression_ == envoy::extensions::access_loggers::grpc::v3::
+                                      CommonGrpcAccessLogConfig::GZIP) {
+        metadata.setReferenceKey(Http::CustomHeaders::get().GrpcEncoding,
+                                 Http::CustomHeaders::get().GrpcEncodingValues.Gzip);
+      }
+    }
     void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
     void onReceiveMessage(std::unique_ptr<LogResponse>&&) override {}
     void onReceiveTrailingMetadata(Http::ResponseTrailerMapPtr&&) override {}
@@ -105,7 +122,20 @@ public:
 
   bool isStreamStarted() { return stream_ != nullptr && stream_->stream_ != nullptr; }
 
-  bool log(const LogRequest& request) {
+  enum class StreamStatus {
+    // A message can be sent.
+    Ready,
+    // The stream is above its high watermark.
+    BackedUp,
+    // The stream could not be created.
+    Failed,
+  };
+
+  /**
+   * Starts the stream if it is not started yet.
+   * @return whether a message can be sent on the stream.
+   */
+  StreamStatus prepareStream() {
     if (!stream_) {
       stream_ = std::make_unique<LocalStream>(*this);
     }
@@ -114,16 +144,15 @@ public:
       stream_->stream_ = client_->start(service_method_, *stream_, createStreamOptionsForRetry());
     }
 
-    if (stream_->stream_ != nullptr) {
-      if (stream_->stream_->isAboveWriteBufferHighWatermark()) {
-        return false;
-      }
-      stream_->stream_->sendMessage(request, false);
-    } else {
+    if (stream_->stream_ == nullptr) {
       // Clear out the stream data due to stream creation failure.
       stream_.reset();
+      return StreamStatus::Failed;
     }
-    return true;
+    if (stream_->stream_->isAboveWriteBufferHighWatermark()) {
+      return StreamStatus::BackedUp;
+    }
+    return StreamStatus::Ready;
   }
 
   Http::AsyncClient::StreamOptions createStreamOptionsForRetry() {
@@ -140,10 +169,41 @@ public:
     return opt;
   }
 
+  // Must only be called after prepareStream() returned StreamStatus::Ready.
+  void sendMessage(const LogRequest& request) {
+    if (compression_ == envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig::
+                            GZIP &&
+        !compression_unsupported_) {
+      Buffer::InstancePtr buffer = Grpc::Common::serializeMessage(request);
+      // A gzip member is self contained, so each message gets a fresh compressor.
+      Compression::Gzip::Compressor::ZlibCompressorImpl compressor(CompressorChunkSize);
+      compressor.init(
+          Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+          Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+          GzipWindowBits, CompressorMemoryLevel);
+      compressor.compress(*buffer, Envoy::Compression::Compressor::State::Finish);
+      if (stream_->stream_->sendCompressedMessageRaw(buffer, false)) {
+        return;
+      }
+      // The grpc-encoding header has already been sent, which is harmless: messages without the
+      // compressed flag are always read as is.
+      compression_unsupported_ = true;
+    }
+    stream_->stream_->sendMessage(request, false);
+  }
+
+  // Window bits of 15, plus 16 to produce the gzip header and trailer.
+  static constexpr int64_t GzipWindowBits = 15 | 16;
+  static constexpr uint64_t CompressorMemoryLevel = 8;
+  static constexpr uint64_t CompressorChunkSize = 4096;
+
   Grpc::AsyncClient<LogRequest, LogResponse> client_;
   std::unique_ptr<LocalStream> stream_;
   const Protobuf::MethodDescriptor& service_method_;
   const absl::optional<envoy::config::core::v3::RetryPolicy> grpc_stream_retry_policy_;
+  const MessageCompression compression_;
+  // Set once the stream is known not to accept pre-compressed messages, i.e. Google gRPC.
+  bool compression_unsupported_{false};
 };
 
 } // namespace Detail
@@ -151,15 +211,18 @@ public:
 /**
  * All stats for the grpc access logger. @see stats_macros.h
  */
-#define ALL_GRPC_ACCESS_LOGGER_STATS(COUNTER)                                                      \
+#define ALL_GRPC_ACCESS_LOGGER_STATS(COUNTER, HISTOGRAM)                                           \
   COUNTER(logs_written)                                                                            \
-  COUNTER(logs_dropped)
+  COUNTER(logs_dropped)                                                                            \
+  COUNTER(logs_sampled_out)                                                                        \
+  HISTOGRAM(batch_entries, Unspecified)                                                            \
+  HISTOGRAM(batch_size_bytes, Bytes)
 
 /**
  * Wrapper struct for the access log stats. @see stats_macros.h
  */
 struct GrpcAccessLoggerStats {
-  ALL_GRPC_ACCESS_LOGGER_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_GRPC_ACCESS_LOGGER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 /**
@@ -178,7 +241,9 @@ public:
       const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config,
       Event::Dispatcher& dispatcher, Stats::Scope& scope, std::string access_log_prefix,
       const Protobuf::MethodDescriptor& service_method)
-      : client_(client, service_method, GrpcCommon::optionalRetryPolicy(config)),
+      : client_(client, service_method, GrpcCommon::optionalRetryPolicy(config),
+                config.message_compression()),
+        dispatcher_(dispatcher),
         buffer_flush_interval_msec_(
             PROTOBUF_GET_MS_OR_DEFAULT(config, buffer_flush_interval, 1000)),
         flush_timer_(dispatcher.createTimer([this]() {
@@ -186,25 +251,53 @@ public:
           flush_timer_->enableTimer(buffer_flush_interval_msec_);
         })),
         max_buffer_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, 16384)),
-        stats_({ALL_GRPC_ACCESS_LOGGER_STATS(POOL_COUNTER_PREFIX(scope, access_log_prefix))}) {
+        shared_lock_(config.aggregate_across_workers()
+                         ? std::make_unique<Thread::MutexBasicLockable>()
+                         : nullptr),
+        stats_({ALL_GRPC_ACCESS_LOGGER_STATS(POOL_COUNTER_PREFIX(scope, access_log_prefix),
+                                             POOL_HISTOGRAM_PREFIX(scope, access_log_prefix))}) {
+    if (config.has_backed_up_sample_rate()) {
+      sample_numerator_ = config.backed_up_sample_rate().numerator();
+      sample_denominator_ = ProtobufPercentHelper::fractionalPercentDenominatorToInt(
+          config.backed_up_sample_rate().denominator());
+    }
     flush_timer_->enableTimer(buffer_flush_interval_msec_);
   }
 
+  // When aggregating across workers, log() may be called from any worker while the stream and the
+  // flush timer stay on the thread that created the logger.
   void log(HttpLogProto&& entry) override {
-    if (!canLogMore()) {
-      return;
+    flushIfFull();
+    bool flush_now = false;
+    {
+      Thread::OptionalLockGuard guard(shared_lock_.get());
+      if (!canLogMore(isHighPriority(entry))) {
+        return;
+      }
+      approximate_message_size_bytes_ += entry.ByteSizeLong();
+      ++batch_entries_;
+      addEntry(std::move(entry));
+      flush_now = approximate_message_size_bytes_ >= max_buffer_size_bytes_ && !scheduleFlush();
     }
-    approximate_message_size_bytes_ += entry.ByteSizeLong();
-    addEntry(std::move(entry));
-    if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
+    if (flush_now) {
       flush();
     }
   }
 
   void log(TcpLogProto&& entry) override {
-    approximate_message_size_bytes_ += entry.ByteSizeLong();
-    addEntry(std::move(entry));
-    if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
+    bool flush_now = false;
+    {
+      Thread::OptionalLockGuard guard(shared_lock_.get());
+      if (backed_up_ && !isHighPriority(entry) && !sampleBackedUpEntry()) {
+        stats_.logs_sampled_out_.inc();
+        return;
+      }
+      approximate_message_size_bytes_ += entry.ByteSizeLong();
+      ++batch_entries_;
+      addEntry(std::move(entry));
+      flush_now = approximate_message_size_bytes_ >= max_buffer_size_bytes_ && !scheduleFlush();
+    }
+    if (flush_now) {
       flush();
     }
   }
@@ -214,36 +307,137 @@ protected:
   LogRequest message_;
 
 private:
+  using StreamStatus = typename Detail::GrpcAccessLogClient<LogRequest, LogResponse>::StreamStatus;
+
   virtual bool isEmpty() PURE;
   virtual void initMessage() PURE;
   virtual void addEntry(HttpLogProto&& entry) PURE;
   virtual void addEntry(TcpLogProto&& entry) PURE;
   virtual void clearMessage() { message_.Clear(); }
+  // Moves the buffered entries into 'message', leaving message_ ready for new entries.
+  virtual void takeMessage(LogRequest& message) {
+    message.Swap(&message_);
+    clearMessage();
+  }
+  // High priority entries are kept while the stream is backed up, rather than sampled.
+  virtual bool isHighPriority(const HttpLogProto&) { return false; }
+  virtual bool isHighPriority(const TcpLogProto&) { return false; }
+
+  bool ownsStream() const { return shared_lock_ == nullptr || dispatcher_.isThreadSafe(); }
 
+  // Must be called on the thread owning the stream, without shared_lock_ held. The lock is only
+  // held to take the buffered message: serializing, compressing and sending it happen outside of
+  // it, so that workers can keep logging into the next message in the meantime.
   void flush() {
-    if (isEmpty()) {
-      // Nothing to flush.
+    {
+      Thread::OptionalLockGuard guard(shared_lock_.get());
+      if (isEmpty()) {
+        // Nothing to flush.
+        return;
+      }
+    }
+
+    const bool stream_started = client_.isStreamStarted();
+    const StreamStatus status = client_.prepareStream();
+    LogRequest message;
+    uint64_t batch_entries;
+    uint64_t batch_size_bytes;
+    {
+      Thread::OptionalLockGuard guard(shared_lock_.get());
+      if (status == StreamStatus::BackedUp) {
+        backed_up_ = true;
+        return;
+      }
+      if (!stream_started) {
+        initMessage();
+      }
+      // The message is dropped if the stream could not be created.
+      if (status == StreamStatus::Ready) {
+        takeMessage(message);
+      } else {
+        clearMessage();
+      }
+      batch_entries = batch_entries_;
+      batch_size_bytes = approximate_message_size_bytes_;
+      approximate_message_size_bytes_ = 0;
+      batch_entries_ = 0;
+      backed_up_ = false;
+    }
+
+    if (status == StreamStatus::Ready) {
+      client_.sendMessage(message);
+      stats_.batch_entries_.recordValue(batch_entries);
+      stats_.batch_size_bytes_.recordValue(batch_size_bytes);
+    }
+  }
+
+  // Retries the flush of a full buffer before logging into it. Must be called without
+  // shared_lock_ held.
+  void flushIfFull() {
+    if (max_buffer_size_bytes_ == 0 || !ownsStream()) {
       return;
     }
+    bool full;
+    {
+      Thread::OptionalLockGuard guard(shared_lock_.get());
+      full = approximate_message_size_bytes_ >= max_buffer_size_bytes_;
+    }
+    if (full) {
+      flush();
+    }
+  }
 
-    if (!client_.isStreamStarted()) {
-      initMessage();
+  // Asks the owning thread to flush. Returns false if this is the owning thread, which must then
+  // flush itself once it released shared_lock_. Must be called with shared_lock_ held, if any.
+  bool scheduleFlush() {
+    if (ownsStream()) {
+      return false;
+    }
+    if (flush_scheduled_) {
+      return true;
     }
+    flush_scheduled_ = true;
+    dispatcher_.post([this, still_alive = std::weak_ptr<bool>(still_alive_)]() {
+      if (still_alive.expired()) {
+        return;
+      }
+      {
+        Thread::OptionalLockGuard guard(shared_lock_.get());
+        flush_scheduled_ = false;
+      }
+      flush();
+    });
+    return true;
+  }
 
-    if (client_.log(message_)) {
-      // Clear the message regardless of the success.
-      approximate_message_size_bytes_ = 0;
-      clearMessage();
+  // Deterministic sampling at sample_numerator_ / sample_denominator_, spreading the kept entries
+  // evenly.
+  bool sampleBackedUpEntry() {
+    if (sample_denominator_ == 0) {
+      return true;
     }
+    sample_credit_ += sample_numerator_;
+    if (sample_credit_ >= sample_denominator_) {
+      sample_credit_ -= sample_denominator_;
+      return true;
+    }
+    return false;
   }
 
-  bool canLogMore() {
+  bool canLogMore(bool high_priority) {
+    if (backed_up_ && !high_priority && !sampleBackedUpEntry()) {
+      stats_.logs_sampled_out_.inc();
+      return false;
+    }
     if (max_buffer_size_bytes_ == 0 || approximate_message_size_bytes_ < max_buffer_size_bytes_) {
       stats_.logs_written_.inc();
       return true;
     }
-    flush();
-    if (approximate_message_size_bytes_ < max_buffer_size_bytes_) {
+    // The owning thread already tried to flush the full buffer in flushIfFull(). Other threads ask
+    // it to flush, and keep buffering up to twice the limit until it did.
+    scheduleFlush();
+    const uint64_t limit = flush_scheduled_ ? 2 * max_buffer_size_bytes_ : max_buffer_size_bytes_;
+    if (approximate_message_size_bytes_ < limit) {
       stats_.logs_written_.inc();
       return true;
     }
@@ -251,10 +445,22 @@ private:
     return false;
   }
 
+  Event::Dispatcher& dispatcher_;
   const std::chrono::milliseconds buffer_flush_interval_msec_;
   const Event::TimerPtr flush_timer_;
   const uint64_t max_buffer_size_bytes_;
+  // Only set when aggregating across workers.
+  const std::unique_ptr<Thread::MutexBasicLockable> shared_lock_;
+  // Guards flushes posted to dispatcher_ against the destruction of the logger.
+  const std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
   uint64_t approximate_message_size_bytes_ = 0;
+  uint64_t batch_entries_ = 0;
+  // Whether the last flush failed because the stream was above its high watermark.
+  bool backed_up_ = false;
+  bool flush_scheduled_ = false;
+  uint64_t sample_numerator_ = 0;
+  uint64_t sample_denominator_ = 0;
+  uint64_t sample_credit_ = 0;
   GrpcAccessLoggerStats stats_;
 };
 
@@ -278,9 +484,15 @@ public:
 
   typename GrpcAccessLogger::SharedPtr
   getOrCreateLogger(const ConfigProto& config, GrpcAccessLoggerType logger_type) override {
-    // TODO(euroelessar): Consider cleaning up loggers.
     auto& cache = tls_slot_->getTyped<ThreadLocalCache>();
     const auto cache_key = std::make_pair(MessageUtil::hash(config), logger_type);
+    if (aggregateAcrossWorkers(config)) {
+      // Not kept in the per-thread caches, so that the logger goes away with the last access log
+      // using it.
+      return getOrCreateSharedLogger(config, cache_key, cache.dispatcher_);
+    }
+
+    // TODO(euroelessar): Consider cleaning up loggers.
     const auto it = cache.access_loggers_.find(cache_key);
     if (it != cache.access_loggers_.end()) {
       return it->second;
@@ -296,6 +508,8 @@ protected:
   Grpc::AsyncClientManager& async_client_manager_;
 
 private:
+  using CacheKey = std::pair<std::size_t, Common::GrpcAccessLoggerType>;
+
   /**
    * Per-thread cache.
    */
@@ -304,16 +518,60 @@ private:
 
     Event::Dispatcher& dispatcher_;
     // Access loggers indexed by the hash of logger's configuration and logger type.
-    absl::flat_hash_map<std::pair<std::size_t, Common::GrpcAccessLoggerType>,
-                        typename GrpcAccessLogger::SharedPtr>
-        access_loggers_;
+    absl::flat_hash_map<CacheKey, typename GrpcAccessLogger::SharedPtr> access_loggers_;
   };
 
+  // Holds a shared logger until it is deleted on the thread owning its stream.
+  struct SharedLoggerHolder : public Event::DispatcherThreadDeletable {
+    explicit SharedLoggerHolder(typename GrpcAccessLogger::SharedPtr logger)
+        : logger_(std::move(logger)) {}
+
+    const typename GrpcAccessLogger::SharedPtr logger_;
+  };
+
+  // A logger shared by all workers is owned by the main thread: its stream and flush timer live
+  // on the main dispatcher. ThreadLocal::Slot::set() runs its callback on the main thread before
+  // the workers, so access logs always request their shared logger there first.
+  //
+  // The cache only keeps a weak reference to a shared logger. Once the last access log using it
+  // is gone, which may happen on a worker, the logger is deleted on the main thread and its entry
+  // is evicted.
+  typename GrpcAccessLogger::SharedPtr getOrCreateSharedLogger(const ConfigProto& config,
+                                                               const CacheKey& cache_key,
+                                                               Event::Dispatcher& dispatcher) {
+    Thread::LockGuard guard(shared_loggers_lock_);
+    const auto it = shared_loggers_.find(cache_key);
+    if (it != shared_loggers_.end()) {
+      if (auto logger = it->second.lock(); logger != nullptr) {
+        return logger;
+      }
+    }
+    auto logger = createLogger(config, dispatcher);
+    if (!Thread::MainThread::isMainOrTestThread()) {
+      // The worker gets a logger of its own, which does not aggregate with the other workers.
+      ENVOY_BUG(false, "shared gRPC access logger first requested on a worker thread");
+      return logger;
+    }
+    absl::erase_if(shared_loggers_, [](const auto& entry) { return entry.second.expired(); });
+    auto* holder = new SharedLoggerHolder(std::move(logger));
+    typename GrpcAccessLogger::SharedPtr shared(
+        holder->logger_.get(), [holder, &dispatcher](typename GrpcAccessLogger::Interface*) {
+          dispatcher.deleteInDispatcherThread(Event::DispatcherThreadDeletableConstPtr(holder));
+        });
+    shared_loggers_[cache_key] = shared;
+    return shared;
+  }
+
   // Create the specific logger type for this cache.
   virtual typename GrpcAccessLogger::SharedPtr createLogger(const ConfigProto& config,
                                                             Event::Dispatcher& dispatcher) PURE;
+  // Whether loggers for this configuration are shared across workers.
+  virtual bool aggregateAcrossWorkers(const ConfigProto& config) PURE;
 
   ThreadLocal::SlotPtr tls_slot_;
+  Thread::MutexBasicLockable shared_loggers_lock_;
+  absl::flat_hash_map<CacheKey, std::weak_ptr<typename GrpcAccessLogger::Interface>>
+      shared_loggers_ ABSL_GUARDED_BY(shared_loggers_lock_);
 };
 
 } // namespace Common
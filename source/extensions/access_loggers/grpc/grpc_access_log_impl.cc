@@ -32,6 +32,26 @@ void GrpcAccessLoggerImpl::addEntry(envoy::data::accesslog::v3::TCPAccessLogEntr
   message_.mutable_tcp_logs()->mutable_log_entry()->Add(std::move(entry));
 }
 
+namespace {
+
+bool hasResponseFlags(const envoy::data::accesslog::v3::AccessLogCommon& common) {
+  return common.has_response_flags() && common.response_flags().ByteSizeLong() > 0;
+}
+
+} // namespace
+
+bool GrpcAccessLoggerImpl::isHighPriority(
+    const envoy::data::accesslog::v3::HTTPAccessLogEntry& entry) {
+  const auto& response_code = entry.response().response_code();
+  return (entry.response().has_response_code() && response_code.value() >= 500) ||
+         hasResponseFlags(entry.common_properties());
+}
+
+bool GrpcAccessLoggerImpl::isHighPriority(
+    const envoy::data::accesslog::v3::TCPAccessLogEntry& entry) {
+  return hasResponseFlags(entry.common_properties());
+}
+
 bool GrpcAccessLoggerImpl::isEmpty() {
   return !message_.has_http_logs() && !message_.has_tcp_logs();
 }
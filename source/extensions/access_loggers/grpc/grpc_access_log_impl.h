@@ -32,6 +32,8 @@ private:
   // Extensions::AccessLoggers::GrpcCommon::GrpcAccessLogger
   void addEntry(envoy::data::accesslog::v3::HTTPAccessLogEntry&& entry) override;
   void addEntry(envoy::data::accesslog::v3::TCPAccessLogEntry&& entry) override;
+  bool isHighPriority(const envoy::data::accesslog::v3::HTTPAccessLogEntry& entry) override;
+  bool isHighPriority(const envoy::data::accesslog::v3::TCPAccessLogEntry& entry) override;
   bool isEmpty() override;
   void initMessage() override;
 
@@ -53,6 +55,10 @@ private:
   GrpcAccessLoggerImpl::SharedPtr
   createLogger(const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config,
                Event::Dispatcher& dispatcher) override;
+  bool aggregateAcrossWorkers(
+      const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config) override {
+    return config.aggregate_across_workers();
+  }
 
   const LocalInfo::LocalInfo& local_info_;
 };
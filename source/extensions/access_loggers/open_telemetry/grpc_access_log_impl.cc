@@ -72,6 +72,18 @@ void GrpcAccessLoggerImpl::initMessage() {}
 
 void GrpcAccessLoggerImpl::clearMessage() { root_->clear_log_records(); }
 
+// Only the log records are moved out, so that message_ and root_ keep the resource attributes.
+void GrpcAccessLoggerImpl::takeMessage(
+    opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest& message) {
+  Protobuf::RepeatedPtrField<opentelemetry::proto::logs::v1::LogRecord> log_records;
+  log_records.Swap(root_->mutable_log_records());
+  message = message_;
+  message.mutable_resource_logs(0)
+      ->mutable_instrumentation_library_logs(0)
+      ->mutable_log_records()
+      ->Swap(&log_records);
+}
+
 GrpcAccessLoggerCacheImpl::GrpcAccessLoggerCacheImpl(Grpc::AsyncClientManager& async_client_manager,
                                                      Stats::Scope& scope,
                                                      ThreadLocal::SlotAllocator& tls,
@@ -54,6 +54,8 @@ private:
   bool isEmpty() override;
   void initMessage() override;
   void clearMessage() override;
+  void takeMessage(opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest& message)
+      override;
 
   opentelemetry::proto::logs::v1::InstrumentationLibraryLogs* root_;
 };
@@ -73,6 +75,11 @@ private:
       const envoy::extensions::access_loggers::open_telemetry::v3::OpenTelemetryAccessLogConfig&
           config,
       Event::Dispatcher& dispatcher) override;
+  bool aggregateAcrossWorkers(
+      const envoy::extensions::access_loggers::open_telemetry::v3::OpenTelemetryAccessLogConfig&
+          config) override {
+    return config.common_config().aggregate_across_workers();
+  }
 
   const LocalInfo::LocalInfo& local_info_;
 };
@@ -32,6 +32,16 @@ GrpcJsonTranscoderFilterConfig::createRouteSpecificFilterConfigTyped(
   return std::make_shared<JsonTranscoderConfig>(proto_config, context.api());
 }
 
+bool GrpcJsonTranscoderFilterConfig::isRouteSpecificFilterConfigLazy(
+    const Protobuf::Message& config) const {
+  using envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder;
+  // The descriptor pool built for a route takes much more memory than the serialized descriptor
+  // set. A descriptor set read from a file is not lazy, as the file may change or be unreadable
+  // by the time the config is needed, and would be read by a worker.
+  return dynamic_cast<const GrpcJsonTranscoder&>(config).descriptor_set_case() ==
+         GrpcJsonTranscoder::kProtoDescriptorBin;
+}
+
 /**
  * Static registration for the grpc transcoding filter. @see RegisterNamedHttpFilterConfigFactory.
  */
@@ -19,6 +19,8 @@ class GrpcJsonTranscoderFilterConfig
 public:
   GrpcJsonTranscoderFilterConfig() : FactoryBase("envoy.filters.http.grpc_json_transcoder") {}
 
+  bool isRouteSpecificFilterConfigLazy(const Protobuf::Message& config) const override;
+
 private:
   Http::FilterFactoryCb createFilterFactoryFromProtoTyped(
       const envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder&
@@ -19,6 +19,10 @@ class RoleBasedAccessControlFilterConfigFactory
 public:
   RoleBasedAccessControlFilterConfigFactory() : FactoryBase("envoy.filters.http.rbac") {}
 
+  // The policies of a per route config are compiled into matchers which take much more memory
+  // than their proto.
+  bool isRouteSpecificFilterConfigLazy(const Protobuf::Message&) const override { return true; }
+
 private:
   Http::FilterFactoryCb createFilterFactoryFromProtoTyped(
       const envoy::extensions::filters::http::rbac::v3::RBAC& proto_config,
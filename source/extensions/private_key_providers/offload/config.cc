@@ -0,0 +1,36 @@
+#include "source/extensions/private_key_providers/offload/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/private_key_providers/offload/v3/offload.pb.h"
+#include "envoy/extensions/private_key_providers/offload/v3/offload.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/transport_socket_config.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/private_key_providers/offload/offload_private_key_provider.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+Ssl::PrivateKeyMethodProviderSharedPtr
+OffloadPrivateKeyMethodFactory::createPrivateKeyMethodProviderInstance(
+    const envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider& proto_config,
+    Server::Configuration::TransportSocketFactoryContext& private_key_provider_context) {
+  envoy::extensions::private_key_providers::offload::v3::OffloadPrivateKeyMethodConfig config;
+  Config::Utility::translateOpaqueConfig(proto_config.typed_config(),
+                                         ProtobufMessage::getNullValidationVisitor(), config);
+  MessageUtil::validate(config, private_key_provider_context.messageValidationVisitor());
+  return std::make_shared<OffloadPrivateKeyMethodProvider>(config, private_key_provider_context);
+}
+
+REGISTER_FACTORY(OffloadPrivateKeyMethodFactory, Ssl::PrivateKeyMethodProviderInstanceFactory);
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
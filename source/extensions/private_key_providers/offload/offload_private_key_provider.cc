@@ -0,0 +1,237 @@
+#include "source/extensions/private_key_providers/offload/offload_private_key_provider.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "envoy/common/exception.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/pem.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+SINGLETON_MANAGER_REGISTRATION(offload_private_key_thread_pool);
+
+namespace {
+
+OffloadPrivateKeyConnection* getConnection(SSL* ssl) {
+  return static_cast<OffloadPrivateKeyConnection*>(
+      SSL_get_ex_data(ssl, OffloadPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  OffloadPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return ops->start(PrivateKeyOperation::Type::Sign, out, out_len, max_out, signature_algorithm,
+                    in, in_len);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t* out, size_t* out_len,
+                                           size_t max_out, const uint8_t* in, size_t in_len) {
+  OffloadPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return ops->start(PrivateKeyOperation::Type::Decrypt, out, out_len, max_out, 0, in, in_len);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  OffloadPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return ops->complete(out, out_len, max_out);
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+OffloadPrivateKeyConnection::OffloadPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                                                         Event::Dispatcher& dispatcher,
+                                                         bssl::UniquePtr<EVP_PKEY> pkey,
+                                                         OffloadThreadPool& pool,
+                                                         uint32_t max_pending_operations,
+                                                         OffloadPrivateKeyStats& stats,
+                                                         TimeSource& time_source)
+    : cb_(cb), dispatcher_(dispatcher), pkey_(std::move(pkey)), pool_(pool),
+      max_pending_operations_(max_pending_operations), stats_(stats), time_source_(time_source) {}
+
+OffloadPrivateKeyConnection::~OffloadPrivateKeyConnection() {
+  if (operation_ != nullptr && !operation_complete_) {
+    pool_.cancel(operation_);
+  }
+}
+
+ssl_private_key_result_t OffloadPrivateKeyConnection::start(PrivateKeyOperation::Type type,
+                                                            uint8_t* out, size_t* out_len,
+                                                            size_t max_out,
+                                                            uint16_t signature_algorithm,
+                                                            const uint8_t* in, size_t in_len) {
+  if (operation_ != nullptr) {
+    // BoringSSL never starts a second operation before the first one completed.
+    return ssl_private_key_failure;
+  }
+  if (type == PrivateKeyOperation::Type::Sign) {
+    stats_.sign_requests_.inc();
+  } else {
+    stats_.decrypt_requests_.inc();
+  }
+
+  auto operation = std::make_shared<PrivateKeyOperation>(
+      type, bssl::UpRef(pkey_), signature_algorithm, in, in_len, dispatcher_, time_source_);
+  std::weak_ptr<bool> still_alive = still_alive_;
+  operation->on_complete_ = [this, still_alive]() {
+    if (still_alive.lock() != nullptr) {
+      onOperationComplete();
+    }
+  };
+
+  if (!pool_.submit(operation, max_pending_operations_)) {
+    // The pool is saturated. Signing on the worker is slower for the other connections on this
+    // worker than waiting, but it bounds the memory held by queued handshakes.
+    stats_.inline_operations_.inc();
+    operation->run();
+    return copyOutput(*operation, out, out_len, max_out);
+  }
+
+  operation_ = std::move(operation);
+  operation_complete_ = false;
+  return ssl_private_key_retry;
+}
+
+void OffloadPrivateKeyConnection::onOperationComplete() {
+  ASSERT(operation_ != nullptr);
+  const MonotonicTime now = time_source_.monotonicTime();
+  stats_.queue_time_us_.recordValue(std::chrono::duration_cast<std::chrono::microseconds>(
+                                        operation_->startedAt() - operation_->createdAt())
+                                        .count());
+  stats_.operation_time_us_.recordValue(
+      std::chrono::duration_cast<std::chrono::microseconds>(now - operation_->createdAt())
+          .count());
+  operation_complete_ = true;
+  cb_.onPrivateKeyMethodComplete();
+}
+
+ssl_private_key_result_t OffloadPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                               size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  if (!operation_complete_) {
+    return ssl_private_key_retry;
+  }
+  PrivateKeyOperationSharedPtr operation = std::move(operation_);
+  return copyOutput(*operation, out, out_len, max_out);
+}
+
+ssl_private_key_result_t OffloadPrivateKeyConnection::copyOutput(
+    const PrivateKeyOperation& operation, uint8_t* out, size_t* out_len, size_t max_out) {
+  if (!operation.succeeded() || operation.output().size() > max_out) {
+    stats_.failures_.inc();
+    ENVOY_LOG(debug, "offload private key provider: private key operation failed");
+    return ssl_private_key_failure;
+  }
+  std::copy(operation.output().begin(), operation.output().end(), out);
+  *out_len = operation.output().size();
+  return ssl_private_key_success;
+}
+
+OffloadPrivateKeyMethodProvider::OffloadPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::offload::v3::OffloadPrivateKeyMethodConfig&
+        config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : time_source_(factory_context.api().timeSource()),
+      stats_(OffloadPrivateKeyStats{ALL_OFFLOAD_PRIVATE_KEY_STATS(
+          POOL_COUNTER_PREFIX(factory_context.scope(), "private_key_offload"),
+          POOL_HISTOGRAM_PREFIX(factory_context.scope(), "private_key_offload"))}) {
+  const std::string private_key =
+      Config::DataSource::read(config.private_key(), false, factory_context.api());
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+  const int key_type = EVP_PKEY_id(pkey_.get());
+  if (key_type != EVP_PKEY_RSA && key_type != EVP_PKEY_EC) {
+    throw EnvoyException("Only RSA and ECDSA private keys are supported.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  max_pending_operations_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_pending_operations, 1024);
+  const uint32_t thread_count = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, thread_count, 1);
+  const uint32_t max_batch_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batch_size, 16);
+  Thread::ThreadFactory& thread_factory = factory_context.api().threadFactory();
+  pool_ = factory_context.singletonManager().getTyped<OffloadThreadPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(offload_private_key_thread_pool),
+      [&thread_factory, thread_count, max_batch_size] {
+        return std::make_shared<OffloadThreadPool>(thread_factory, thread_count, max_batch_size);
+      });
+  if (pool_->threadCount() != thread_count || pool_->maxBatchSize() != max_batch_size) {
+    ENVOY_LOG(warn,
+              "offload private key provider: using the shared thread pool with {} threads and a "
+              "batch size of {}, rather than the configured {} threads and batch size of {}",
+              pool_->threadCount(), pool_->maxBatchSize(), thread_count, max_batch_size);
+  }
+}
+
+void OffloadPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException("Not registering the offload provider twice for same context");
+  }
+  auto* ops = new OffloadPrivateKeyConnection(cb, dispatcher, bssl::UpRef(pkey_), *pool_,
+                                              max_pending_operations_, stats_, time_source_);
+  SSL_set_ex_data(ssl, connectionIndex(), ops);
+}
+
+void OffloadPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  auto* ops = static_cast<OffloadPrivateKeyConnection*>(SSL_get_ex_data(ssl, connectionIndex()));
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+bool OffloadPrivateKeyMethodProvider::checkFips() {
+  if (EVP_PKEY_id(pkey_.get()) == EVP_PKEY_RSA) {
+    const RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+    return rsa != nullptr && RSA_check_fips(const_cast<RSA*>(rsa));
+  }
+  const EC_KEY* ec_key = EVP_PKEY_get0_EC_KEY(pkey_.get());
+  return ec_key != nullptr && EC_KEY_check_fips(ec_key);
+}
+
+Ssl::BoringSslPrivateKeyMethodSharedPtr
+OffloadPrivateKeyMethodProvider::getBoringSslPrivateKeyMethod() {
+  return method_;
+}
+
+int OffloadPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/offload/v3/offload.pb.h"
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/private_key_providers/offload/thread_pool.h"
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+#define ALL_OFFLOAD_PRIVATE_KEY_STATS(COUNTER, HISTOGRAM)                                          \
+  COUNTER(sign_requests)                                                                           \
+  COUNTER(decrypt_requests)                                                                        \
+  COUNTER(failures)                                                                                \
+  COUNTER(inline_operations)                                                                       \
+  HISTOGRAM(queue_time_us, Microseconds)                                                           \
+  HISTOGRAM(operation_time_us, Microseconds)
+
+/**
+ * Offload private key provider stats. @see stats_macros.h
+ */
+struct OffloadPrivateKeyStats {
+  ALL_OFFLOAD_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
+// OffloadPrivateKeyConnection holds the operation in flight for a given SSL connection. It is
+// only accessed from the connection's worker thread.
+class OffloadPrivateKeyConnection : public Logger::Loggable<Logger::Id::connection> {
+public:
+  OffloadPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                              Event::Dispatcher& dispatcher, bssl::UniquePtr<EVP_PKEY> pkey,
+                              OffloadThreadPool& pool, uint32_t max_pending_operations,
+                              OffloadPrivateKeyStats& stats, TimeSource& time_source);
+  ~OffloadPrivateKeyConnection();
+
+  ssl_private_key_result_t start(PrivateKeyOperation::Type type, uint8_t* out, size_t* out_len,
+                                 size_t max_out, uint16_t signature_algorithm, const uint8_t* in,
+                                 size_t in_len);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+private:
+  void onOperationComplete();
+  ssl_private_key_result_t copyOutput(const PrivateKeyOperation& operation, uint8_t* out,
+                                      size_t* out_len, size_t max_out);
+
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  OffloadThreadPool& pool_;
+  const uint32_t max_pending_operations_;
+  OffloadPrivateKeyStats& stats_;
+  TimeSource& time_source_;
+  PrivateKeyOperationSharedPtr operation_;
+  bool operation_complete_{};
+  // Completions posted by the thread pool hold a weak reference to this, so that a connection
+  // that closed while its operation was in flight is not called back.
+  std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
+};
+
+// OffloadPrivateKeyMethodProvider runs the private key operations of the SSL connections
+// registered with it on the thread pool shared by all offload providers.
+class OffloadPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                        public Logger::Loggable<Logger::Id::connection> {
+public:
+  OffloadPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::offload::v3::OffloadPrivateKeyMethodConfig&
+          config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override;
+
+  static int connectionIndex();
+
+private:
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  TimeSource& time_source_;
+  OffloadPrivateKeyStats stats_;
+  uint32_t max_pending_operations_;
+  OffloadThreadPoolSharedPtr pool_;
+};
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
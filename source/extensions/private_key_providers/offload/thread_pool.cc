@@ -0,0 +1,176 @@
+#include "source/extensions/private_key_providers/offload/thread_pool.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+PrivateKeyOperation::PrivateKeyOperation(Type type, bssl::UniquePtr<EVP_PKEY> pkey,
+                                         uint16_t signature_algorithm, const uint8_t* in,
+                                         size_t in_len, Event::Dispatcher& dispatcher,
+                                         TimeSource& time_source)
+    : type_(type), pkey_(std::move(pkey)), signature_algorithm_(signature_algorithm),
+      input_(in, in + in_len), dispatcher_(dispatcher), time_source_(time_source),
+      created_at_(time_source.monotonicTime()) {}
+
+void PrivateKeyOperation::run() {
+  started_at_ = time_source_.monotonicTime();
+  succeeded_ = type_ == Type::Sign ? sign() : decrypt();
+  if (!succeeded_) {
+    output_.clear();
+  }
+}
+
+void PrivateKeyOperation::fail() {
+  started_at_ = time_source_.monotonicTime();
+  succeeded_ = false;
+  output_.clear();
+}
+
+bool PrivateKeyOperation::sign() {
+  if (EVP_PKEY_id(pkey_.get()) != SSL_get_signature_algorithm_key_type(signature_algorithm_)) {
+    return false;
+  }
+
+  // This mirrors what BoringSSL does itself when no private key method is installed.
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx = nullptr;
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm_);
+  if (!EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, pkey_.get())) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm_) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1 /* salt length is digest length */))) {
+    return false;
+  }
+
+  size_t out_len = EVP_PKEY_size(pkey_.get());
+  output_.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), output_.data(), &out_len, input_.data(), input_.size())) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+bool PrivateKeyOperation::decrypt() {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  if (rsa == nullptr) {
+    return false;
+  }
+  size_t out_len = 0;
+  output_.resize(RSA_size(rsa));
+  if (!RSA_decrypt(rsa, &out_len, output_.data(), output_.size(), input_.data(), input_.size(),
+                   RSA_NO_PADDING)) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+OffloadThreadPool::OffloadThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                                     uint32_t max_batch_size)
+    : max_batch_size_(max_batch_size) {
+  ASSERT(thread_count > 0 && max_batch_size > 0);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    threads_.push_back(thread_factory.createThread(
+        [this]() { threadRoutine(); }, Thread::Options{fmt::format("pk_offload:{}", i)}));
+  }
+}
+
+OffloadThreadPool::~OffloadThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  for (auto& thread : threads_) {
+    thread->join();
+  }
+
+  // The connections of the remaining operations are still open, as closing a connection cancels
+  // its operation. Their handshakes fail when resumed, which closes them.
+  std::vector<PrivateKeyOperationSharedPtr> remaining;
+  {
+    absl::MutexLock lock(&mutex_);
+    remaining.assign(std::make_move_iterator(queue_.begin()),
+                     std::make_move_iterator(queue_.end()));
+    queue_.clear();
+  }
+  for (const PrivateKeyOperationSharedPtr& operation : remaining) {
+    operation->fail();
+  }
+  postCompletions(remaining);
+}
+
+bool OffloadThreadPool::submit(PrivateKeyOperationSharedPtr operation,
+                               uint32_t max_pending_operations) {
+  absl::MutexLock lock(&mutex_);
+  if (shutdown_ || queue_.size() >= max_pending_operations) {
+    return false;
+  }
+  queue_.push_back(std::move(operation));
+  return true;
+}
+
+void OffloadThreadPool::cancel(const PrivateKeyOperationSharedPtr& operation) {
+  absl::MutexLock lock(&mutex_);
+  auto it = std::find(queue_.begin(), queue_.end(), operation);
+  if (it != queue_.end()) {
+    queue_.erase(it);
+  }
+}
+
+void OffloadThreadPool::threadRoutine() {
+  std::vector<PrivateKeyOperationSharedPtr> batch;
+  batch.reserve(max_batch_size_);
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &OffloadThreadPool::hasWork));
+      if (shutdown_) {
+        // Operations still queued are failed by the destructor.
+        return;
+      }
+      const size_t count = std::min<size_t>(queue_.size(), max_batch_size_);
+      std::move(queue_.begin(), queue_.begin() + count, std::back_inserter(batch));
+      queue_.erase(queue_.begin(), queue_.begin() + count);
+    }
+
+    for (const PrivateKeyOperationSharedPtr& operation : batch) {
+      operation->run();
+    }
+    postCompletions(batch);
+  }
+}
+
+void OffloadThreadPool::postCompletions(std::vector<PrivateKeyOperationSharedPtr>& operations) {
+  // Post the completions once per dispatcher rather than once per operation. A batch rarely
+  // spans more than a few workers, so a linear scan is enough to group it.
+  while (!operations.empty()) {
+    Event::Dispatcher& dispatcher = operations.front()->dispatcher();
+    auto split = std::stable_partition(operations.begin(), operations.end(),
+                                       [&dispatcher](const PrivateKeyOperationSharedPtr& op) {
+                                         return &op->dispatcher() == &dispatcher;
+                                       });
+    std::vector<PrivateKeyOperationSharedPtr> completed(std::make_move_iterator(operations.begin()),
+                                                        std::make_move_iterator(split));
+    operations.erase(operations.begin(), split);
+    dispatcher.post([completed = std::move(completed)]() {
+      for (const PrivateKeyOperationSharedPtr& operation : completed) {
+        operation->on_complete_();
+      }
+    });
+  }
+}
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
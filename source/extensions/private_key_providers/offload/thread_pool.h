@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+/**
+ * A private key operation of a single TLS handshake. The inputs are copied when the operation is
+ * created, so that it does not reference the SSL object while it runs on a pool thread.
+ */
+class PrivateKeyOperation {
+public:
+  enum class Type { Sign, Decrypt };
+
+  PrivateKeyOperation(Type type, bssl::UniquePtr<EVP_PKEY> pkey, uint16_t signature_algorithm,
+                      const uint8_t* in, size_t in_len, Event::Dispatcher& dispatcher,
+                      TimeSource& time_source);
+
+  /**
+   * Perform the operation, storing the result in output(). May be called from any thread.
+   */
+  void run();
+
+  /**
+   * Mark the operation as failed without running it.
+   */
+  void fail();
+
+  Type type() const { return type_; }
+  Event::Dispatcher& dispatcher() const { return dispatcher_; }
+  bool succeeded() const { return succeeded_; }
+  const std::vector<uint8_t>& output() const { return output_; }
+  MonotonicTime createdAt() const { return created_at_; }
+  MonotonicTime startedAt() const { return started_at_; }
+
+  // Called on dispatcher() once the operation has run on a pool thread.
+  std::function<void()> on_complete_;
+
+private:
+  bool sign();
+  bool decrypt();
+
+  const Type type_;
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  const uint16_t signature_algorithm_;
+  const std::vector<uint8_t> input_;
+  Event::Dispatcher& dispatcher_;
+  TimeSource& time_source_;
+  const MonotonicTime created_at_;
+  MonotonicTime started_at_;
+  std::vector<uint8_t> output_;
+  bool succeeded_{};
+};
+
+using PrivateKeyOperationSharedPtr = std::shared_ptr<PrivateKeyOperation>;
+
+/**
+ * Threads that run private key operations queued by the workers. Each thread takes up to
+ * max_batch_size operations per wakeup, runs them, and posts the completions of each batch to
+ * every dispatcher involved as a single event. A single pool is shared by all providers through
+ * the singleton manager.
+ */
+class OffloadThreadPool : public Singleton::Instance, Logger::Loggable<Logger::Id::connection> {
+public:
+  OffloadThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                    uint32_t max_batch_size);
+  // Operations still queued are failed, so that their handshakes are resumed and fail instead of
+  // waiting forever.
+  ~OffloadThreadPool() override;
+
+  /**
+   * Queue an operation. Its on_complete_ callback is posted to its dispatcher once it has run.
+   * @param operation the operation to queue.
+   * @param max_pending_operations the number of queued operations beyond which the operation is
+   *        not queued.
+   * @return false if the operation was not queued.
+   */
+  bool submit(PrivateKeyOperationSharedPtr operation, uint32_t max_pending_operations);
+
+  /**
+   * Remove an operation from the queue if no thread has taken it yet. Called when the connection
+   * that queued it is closed.
+   */
+  void cancel(const PrivateKeyOperationSharedPtr& operation);
+
+  uint32_t threadCount() const { return threads_.size(); }
+  uint32_t maxBatchSize() const { return max_batch_size_; }
+
+private:
+  void threadRoutine();
+  bool hasWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || shutdown_;
+  }
+  // Post the completions of 'operations' to their dispatchers, one event per dispatcher.
+  static void postCompletions(std::vector<PrivateKeyOperationSharedPtr>& operations);
+
+  const uint32_t max_batch_size_;
+  absl::Mutex mutex_;
+  std::deque<PrivateKeyOperationSharedPtr> queue_ ABSL_GUARDED_BY(mutex_);
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using OffloadThreadPoolSharedPtr = std::shared_ptr<OffloadThreadPool>;
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
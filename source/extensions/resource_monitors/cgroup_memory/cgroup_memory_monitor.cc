@@ -0,0 +1,140 @@
+#include "source/extensions/resource_monitors/cgroup_memory/cgroup_memory_monitor.h"
+
+#include <algorithm>
+
+#include "envoy/common/exception.h"
+#include "envoy/extensions/resource_monitors/cgroup_memory/v3/cgroup_memory.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMemoryMonitor {
+
+namespace {
+
+constexpr absl::string_view CgroupMountPath = "/sys/fs/cgroup";
+constexpr absl::string_view ProcSelfCgroup = "/proc/self/cgroup";
+constexpr absl::string_view MemoryCurrent = "memory.current";
+constexpr absl::string_view MemoryMax = "memory.max";
+constexpr absl::string_view MemoryStat = "memory.stat";
+constexpr absl::string_view MemoryPressure = "memory.pressure";
+
+uint64_t parseBytes(absl::string_view name, absl::string_view value) {
+  uint64_t bytes;
+  if (!absl::SimpleAtoi(absl::StripAsciiWhitespace(value), &bytes)) {
+    throw EnvoyException(fmt::format("failed to parse {}", name));
+  }
+  return bytes;
+}
+
+// memory.stat has one "<key> <bytes>" entry per line. A missing key counts as zero, since the
+// kernel omits entries for features it was built without.
+uint64_t parseStat(absl::string_view contents, absl::string_view key) {
+  for (absl::string_view line : absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    if (absl::ConsumePrefix(&line, key) && absl::ConsumePrefix(&line, " ")) {
+      return parseBytes(MemoryStat, line);
+    }
+  }
+  return 0;
+}
+
+// memory.pressure looks like
+//   some avg10=1.23 avg60=0.50 avg300=0.10 total=123456
+//   full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+// The averages are percentages of wall time.
+double parseSomeAvg10(absl::string_view contents) {
+  for (absl::string_view line : absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    if (!absl::ConsumePrefix(&line, "some ")) {
+      continue;
+    }
+    for (absl::string_view field : absl::StrSplit(line, ' ', absl::SkipEmpty())) {
+      double percent;
+      if (absl::ConsumePrefix(&field, "avg10=") && absl::SimpleAtod(field, &percent)) {
+        return std::clamp(percent / 100, 0.0, 1.0);
+      }
+    }
+  }
+  throw EnvoyException(fmt::format("failed to parse {}", MemoryPressure));
+}
+
+} // namespace
+
+CgroupMemoryMonitor::CgroupMemoryMonitor(
+    const envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig& config,
+    Filesystem::Instance& file_system)
+    : cgroup_path_(config.cgroup_path().empty()
+                       ? cgroupPathFromProcCgroup(file_system.fileReadToEnd(ProcSelfCgroup))
+                       : config.cgroup_path()),
+      max_memory_bytes_(config.max_memory_bytes()),
+      include_pressure_stall_information_(config.include_pressure_stall_information()),
+      file_system_(file_system) {}
+
+std::string CgroupMemoryMonitor::cgroupPathFromProcCgroup(absl::string_view proc_cgroup) {
+  // Each line is "<hierarchy id>:<controllers>:<path>", and the cgroup v2 hierarchy is the one
+  // with id 0 and no controllers. The path is relative to the root of the hierarchy, which is the
+  // root of the cgroup namespace when Envoy runs in one.
+  for (absl::string_view line : absl::StrSplit(proc_cgroup, '\n', absl::SkipEmpty())) {
+    if (absl::ConsumePrefix(&line, "0::")) {
+      absl::ConsumeSuffix(&line, "/");
+      return absl::StrCat(CgroupMountPath, line);
+    }
+  }
+  throw EnvoyException(
+      fmt::format("failed to find the cgroup v2 of the process in {}", ProcSelfCgroup));
+}
+
+void CgroupMemoryMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
+  double pressure;
+  TRY_ASSERT_MAIN_THREAD { pressure = readPressure(); }
+  END_TRY
+  catch (const EnvoyException& error) {
+    callbacks.onFailure(error);
+    return;
+  }
+  callbacks.onSuccess({pressure});
+}
+
+double CgroupMemoryMonitor::readPressure() {
+  uint64_t limit = max_memory_bytes_;
+  // memory.max is "max" when the cgroup has no limit.
+  if (const std::string max = readFile(MemoryMax); absl::StripAsciiWhitespace(max) != "max") {
+    const uint64_t cgroup_limit = parseBytes(MemoryMax, max);
+    limit = limit == 0 ? cgroup_limit : std::min(limit, cgroup_limit);
+  }
+  if (limit == 0) {
+    throw EnvoyException(
+        fmt::format("{}/{} is unlimited and no max_memory_bytes is configured", cgroup_path_,
+                    MemoryMax));
+  }
+
+  const uint64_t current = parseBytes(MemoryCurrent, readFile(MemoryCurrent));
+  const uint64_t inactive_file = parseStat(readFile(MemoryStat), "inactive_file");
+  const uint64_t working_set = current > inactive_file ? current - inactive_file : 0;
+  double pressure = working_set / static_cast<double>(limit);
+
+  ENVOY_LOG_MISC(trace, "CgroupMemoryMonitor: current={}, inactive_file={}, limit={}", current,
+                 inactive_file, limit);
+
+  if (include_pressure_stall_information_) {
+    pressure = std::max(pressure, parseSomeAvg10(readFile(MemoryPressure)));
+  }
+  return pressure;
+}
+
+std::string CgroupMemoryMonitor::readFile(absl::string_view name) {
+  return file_system_.fileReadToEnd(absl::StrCat(cgroup_path_, "/", name));
+}
+
+} // namespace CgroupMemoryMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
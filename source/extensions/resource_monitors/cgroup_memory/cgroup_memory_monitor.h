@@ -0,0 +1,49 @@
+#pragma once
+
+#include "envoy/extensions/resource_monitors/cgroup_memory/v3/cgroup_memory.pb.h"
+#include "envoy/filesystem/filesystem.h"
+#include "envoy/server/resource_monitor.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMemoryMonitor {
+
+/**
+ * Memory monitor for the cgroup v2 Envoy runs in. The pressure is the working set of the cgroup,
+ * i.e. memory.current less the inactive file cache in memory.stat, divided by the lower of
+ * memory.max and the configured maximum. Optionally, the share of time the cgroup was stalled on
+ * memory according to memory.pressure raises the pressure further.
+ */
+class CgroupMemoryMonitor : public Server::ResourceMonitor {
+public:
+  CgroupMemoryMonitor(
+      const envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig& config,
+      Filesystem::Instance& file_system);
+
+  // Server::ResourceMonitor
+  void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
+
+  /**
+   * @param proc_cgroup supplies the contents of /proc/self/cgroup.
+   * @return the directory of the cgroup v2 of the process, under /sys/fs/cgroup.
+   * @throw EnvoyException if the process has no cgroup v2.
+   */
+  static std::string cgroupPathFromProcCgroup(absl::string_view proc_cgroup);
+
+private:
+  double readPressure();
+  std::string readFile(absl::string_view name);
+
+  const std::string cgroup_path_;
+  const uint64_t max_memory_bytes_;
+  const bool include_pressure_stall_information_;
+  Filesystem::Instance& file_system_;
+};
+
+} // namespace CgroupMemoryMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,7 @@
 #include "source/extensions/stat_sinks/common/statsd/statsd.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <string>
@@ -21,7 +23,7 @@
 #include "source/common/network/utility.h"
 #include "source/common/stats/symbol_table.h"
 
-#include "absl/strings/str_join.h"
+#include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -44,65 +46,132 @@ void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
   Network::Utility::writeToSocket(*io_handle_, data, nullptr, *parent_.server_address_);
 }
 
+void UdpStatsdSink::WriterImpl::writeDatagrams(absl::Span<const absl::string_view> datagrams) {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  if (!os_sys_calls.supportsMmsg()) {
+    Writer::writeDatagrams(datagrams);
+    return;
+  }
+
+  std::array<struct iovec, MAX_DATAGRAMS_PER_WRITE> iovecs;
+  std::array<struct mmsghdr, MAX_DATAGRAMS_PER_WRITE> messages;
+  while (!datagrams.empty()) {
+    const size_t count = std::min(datagrams.size(), MAX_DATAGRAMS_PER_WRITE);
+    for (size_t i = 0; i < count; ++i) {
+      iovecs[i].iov_base = const_cast<char*>(datagrams[i].data());
+      iovecs[i].iov_len = datagrams[i].size();
+      messages[i] = {};
+      messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(parent_.server_address_->sockAddr());
+      messages[i].msg_hdr.msg_namelen = parent_.server_address_->sockAddrLen();
+      messages[i].msg_hdr.msg_iov = &iovecs[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    size_t sent = 0;
+    while (sent < count) {
+      const Api::SysCallIntResult result = os_sys_calls.sendmmsg(
+          io_handle_->fdDoNotUse(), &messages[sent], count - sent, 0);
+      if (result.return_value_ <= 0) {
+        // As with the single datagram writes, statsd writes are best effort: the datagram that
+        // failed is dropped, for example when the socket buffer is full, and the rest are still
+        // written.
+        ENVOY_LOG_MISC(debug, "statsd sendmmsg failed: {}", errorDetails(result.errno_));
+        sent += 1;
+        continue;
+      }
+      sent += result.return_value_;
+    }
+    datagrams.remove_prefix(count);
+  }
+}
+
+void UdpStatsdSink::Writer::writeDatagrams(absl::Span<const absl::string_view> datagrams) {
+  for (const absl::string_view datagram : datagrams) {
+    Buffer::OwnedImpl buffer(datagram);
+    writeBuffer(buffer);
+  }
+}
+
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
                              const std::string& prefix, absl::optional<uint64_t> buffer_size,
                              const Statsd::TagFormat& tag_format)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
-      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+      flush_writer_(std::make_shared<WriterImpl>(*this)) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<WriterImpl>(*this);
   });
 }
 
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
-  Writer& writer = tls_->getTyped<Writer>();
-  Buffer::OwnedImpl buffer;
+  Writer& writer = *flush_writer_;
+  flush_buffer_.clear();
+  flush_datagram_ends_.clear();
 
   for (const auto& counter : snapshot.counters()) {
     if (counter.counter_.get().used()) {
-      const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
-      writeBuffer(buffer, writer, counter_str);
+      addMessage(writer, counter.counter_.get(), counter.delta_, "|c");
     }
   }
 
   for (const auto& gauge : snapshot.gauges()) {
     if (gauge.get().used()) {
-      const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
-      writeBuffer(buffer, writer, gauge_str);
+      addMessage(writer, gauge.get(), gauge.get().value(), "|g");
     }
   }
 
-  flushBuffer(buffer, writer);
+  if (flush_buffer_.size() > openDatagramStart()) {
+    flush_datagram_ends_.push_back(flush_buffer_.size());
+  }
+  flushDatagrams(writer);
   // TODO(efimki): Add support of text readouts stats.
 }
 
-void UdpStatsdSink::writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer,
-                                const std::string& statsd_metric) const {
-  if (statsd_metric.length() >= buffer_size_) {
-    // Our statsd_metric is too large to fit into the buffer, skip buffering and write directly
-    writer.write(statsd_metric);
-  } else {
-    if ((buffer.length() + statsd_metric.length() + 1) > buffer_size_) {
-      // If we add the new statsd_metric, we'll overflow our buffer. Flush the buffer to make
-      // room for the new statsd_metric.
-      flushBuffer(buffer, writer);
-    } else if (buffer.length() > 0) {
-      // We have room and have metrics already in the buffer, add a newline to separate
-      // metric entries.
-      buffer.add("\n");
-    }
-    buffer.add(statsd_metric);
+template <typename ValueType>
+void UdpStatsdSink::addMessage(Writer& writer, const Stats::Metric& metric, ValueType value,
+                               absl::string_view type) {
+  // The length of the metric is only known once it is formatted in place, so it is speculatively
+  // separated from the metrics already in the open datagram.
+  const size_t datagram_start = openDatagramStart();
+  const bool continues_datagram = flush_buffer_.size() > datagram_start;
+  if (continues_datagram) {
+    flush_buffer_.push_back('\n');
+  }
+  const size_t message_start = flush_buffer_.size();
+  appendMessage(flush_buffer_, metric, value, type);
+  if (continues_datagram && flush_buffer_.size() - datagram_start > buffer_size_) {
+    // If we add the new metric, we'll overflow the datagram. End the datagram before the
+    // separator, and move the metric to the next datagram.
+    flush_buffer_.erase(message_start - 1, 1);
+    flush_datagram_ends_.push_back(message_start - 1);
+  }
+  if (flush_buffer_.size() - openDatagramStart() >= buffer_size_) {
+    // The datagram is full, or only holds a metric too large for the buffer.
+    flush_datagram_ends_.push_back(flush_buffer_.size());
+  }
+  if (flush_datagram_ends_.size() >= MAX_DATAGRAMS_PER_WRITE) {
+    flushDatagrams(writer);
   }
 }
 
-void UdpStatsdSink::flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const {
-  if (buffer.length() == 0) {
-    return;
+size_t UdpStatsdSink::openDatagramStart() const {
+  return flush_datagram_ends_.empty() ? 0 : flush_datagram_ends_.back();
+}
+
+void UdpStatsdSink::flushDatagrams(Writer& writer) {
+  flush_datagrams_.clear();
+  size_t start = 0;
+  for (const size_t end : flush_datagram_ends_) {
+    flush_datagrams_.emplace_back(flush_buffer_.data() + start, end - start);
+    start = end;
+  }
+  if (!flush_datagrams_.empty()) {
+    writer.writeDatagrams(flush_datagrams_);
   }
-  writer.writeBuffer(buffer);
-  buffer.drain(buffer.length());
+  // Keep the open datagram, if any, at the start of the buffer.
+  flush_buffer_.erase(0, start);
+  flush_datagram_ends_.clear();
 }
 
 void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) {
@@ -128,52 +197,59 @@ void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint6
 
 template <typename ValueType>
 const std::string UdpStatsdSink::buildMessage(const Stats::Metric& metric, ValueType value,
-                                              const std::string& type) const {
+                                              absl::string_view type) const {
+  std::string message;
+  appendMessage(message, metric, value, type);
+  return message;
+}
+
+template <typename ValueType>
+void UdpStatsdSink::appendMessage(std::string& out, const Stats::Metric& metric, ValueType value,
+                                  absl::string_view type) const {
+  // metric name
+  absl::StrAppend(&out, prefix_, ".");
+  metric.constSymbolTable().appendToString(
+      use_tag_ ? metric.tagExtractedStatName() : metric.statName(), out);
+
   switch (tag_format_.tag_position) {
-  case Statsd::TagPosition::TagAfterValue: {
-    const std::string message = absl::StrCat(
-        // metric name
-        prefix_, ".", getName(metric),
-        // value and type
-        ":", value, type,
-        // tags
-        buildTagStr(metric.tags()));
-    return message;
-  }
+  case Statsd::TagPosition::TagAfterValue:
+    // value and type
+    absl::StrAppend(&out, ":", value, type);
+    // tags
+    appendTags(out, metric);
+    return;
 
-  case Statsd::TagPosition::TagAfterName: {
-    const std::string message = absl::StrCat(
-        // metric name
-        prefix_, ".", getName(metric),
-        // tags
-        buildTagStr(metric.tags()),
-        // value and type
-        ":", value, type);
-    return message;
-  }
+  case Statsd::TagPosition::TagAfterName:
+    // tags
+    appendTags(out, metric);
+    // value and type
+    absl::StrAppend(&out, ":", value, type);
+    return;
   }
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
-const std::string UdpStatsdSink::getName(const Stats::Metric& metric) const {
-  if (use_tag_) {
-    return metric.tagExtractedName();
-  } else {
-    return metric.name();
-  }
-}
-
-const std::string UdpStatsdSink::buildTagStr(const std::vector<Stats::Tag>& tags) const {
-  if (!use_tag_ || tags.empty()) {
-    return "";
+void UdpStatsdSink::appendTags(std::string& out, const Stats::Metric& metric) const {
+  if (!use_tag_) {
+    return;
   }
 
-  std::vector<std::string> tag_strings;
-  tag_strings.reserve(tags.size());
-  for (const Stats::Tag& tag : tags) {
-    tag_strings.emplace_back(tag.name_ + tag_format_.assign + tag.value_);
-  }
-  return tag_format_.start + absl::StrJoin(tag_strings, tag_format_.separator);
+  // The lambda captures a single reference, so that it fits in the std::function without an
+  // allocation for each metric.
+  struct TagState {
+    std::string& out_;
+    const Stats::SymbolTable& symbol_table_;
+    const Statsd::TagFormat& tag_format_;
+    bool first_;
+  } state{out, metric.constSymbolTable(), tag_format_, true};
+  metric.iterateTagStatNames([&state](Stats::StatName name, Stats::StatName value) -> bool {
+    state.out_.append(state.first_ ? state.tag_format_.start : state.tag_format_.separator);
+    state.first_ = false;
+    state.symbol_table_.appendToString(name, state.out_);
+    state.out_.append(state.tag_format_.assign);
+    state.symbol_table_.appendToString(value, state.out_);
+    return true;
+  });
 }
 
 TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
@@ -17,7 +17,9 @@
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -39,8 +41,19 @@ public:
   public:
     virtual void write(const std::string& message) PURE;
     virtual void writeBuffer(Buffer::Instance& data) PURE;
+
+    /**
+     * Writes each of the datagrams, in as few system calls as the writer supports. By default,
+     * each datagram is written with writeBuffer().
+     * @param datagrams supplies the datagrams to write.
+     */
+    virtual void writeDatagrams(absl::Span<const absl::string_view> datagrams);
   };
 
+  // The maximum number of datagrams handed to the writer at once, which bounds the memory used
+  // to format a flush.
+  static constexpr size_t MAX_DATAGRAMS_PER_WRITE = 64;
+
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
@@ -52,7 +65,7 @@ public:
                 const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
-        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format), flush_writer_(writer) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -60,6 +73,7 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  bool supportsDedicatedFlushThread() const override { return true; }
 
   bool getUseTagForTest() { return use_tag_; }
   uint64_t getBufferSizeForTest() { return buffer_size_; }
@@ -76,20 +90,26 @@ private:
     // Writer
     void write(const std::string& message) override;
     void writeBuffer(Buffer::Instance& data) override;
+    void writeDatagrams(absl::Span<const absl::string_view> datagrams) override;
 
   private:
     UdpStatsdSink& parent_;
     const Network::IoHandlePtr io_handle_;
   };
 
-  void flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const;
-  void writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer, const std::string& data) const;
+  template <typename ValueType>
+  void addMessage(Writer& writer, const Stats::Metric& metric, ValueType value,
+                  absl::string_view type);
+  size_t openDatagramStart() const;
+  void flushDatagrams(Writer& writer);
 
   template <typename ValueType>
   const std::string buildMessage(const Stats::Metric& metric, ValueType value,
-                                 const std::string& type) const;
-  const std::string getName(const Stats::Metric& metric) const;
-  const std::string buildTagStr(const std::vector<Stats::Tag>& tags) const;
+                                 absl::string_view type) const;
+  template <typename ValueType>
+  void appendMessage(std::string& out, const Stats::Metric& metric, ValueType value,
+                     absl::string_view type) const;
+  void appendTags(std::string& out, const Stats::Metric& metric) const;
 
   const ThreadLocal::SlotPtr tls_;
   const Network::Address::InstanceConstSharedPtr server_address_;
@@ -98,6 +118,14 @@ private:
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  // Writer used by flush(), which is not tied to a thread so flushes can run on the dedicated
+  // stats flush thread. Only one flush runs at a time.
+  const std::shared_ptr<Writer> flush_writer_;
+  // The metrics of a flush are formatted in place into flush_buffer_, as contiguous datagrams
+  // ending at the offsets in flush_datagram_ends_. The buffers are reused across flushes.
+  std::string flush_buffer_;
+  std::vector<size_t> flush_datagram_ends_;
+  std::vector<absl::string_view> flush_datagrams_;
 };
 
 /**
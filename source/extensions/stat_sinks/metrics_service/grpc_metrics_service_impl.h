@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "envoy/event/dispatcher.h"
 #include "envoy/grpc/async_client.h"
 #include "envoy/local_info/local_info.h"
 #include "envoy/network/connection.h"
@@ -112,30 +113,45 @@ private:
 };
 
 /**
- * Stat Sink that flushes metrics via a gRPC service.
+ * Stat Sink that flushes metrics via a gRPC service. When a main thread dispatcher is supplied,
+ * the metrics may be built on the dedicated stats flush thread, and are then sent from the main
+ * thread.
  */
 template <class RequestProto, class ResponseProto> class MetricsServiceSink : public Stats::Sink {
 public:
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      bool report_counters_as_deltas, bool emit_labels)
+      bool report_counters_as_deltas, bool emit_labels,
+      Event::Dispatcher* main_dispatcher = nullptr)
       : MetricsServiceSink(grpc_metrics_streamer,
-                           MetricsFlusher(report_counters_as_deltas, emit_labels)) {}
+                           MetricsFlusher(report_counters_as_deltas, emit_labels),
+                           main_dispatcher) {}
 
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      MetricsFlusher&& flusher)
-      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)) {}
+      MetricsFlusher&& flusher, Event::Dispatcher* main_dispatcher = nullptr)
+      : flusher_(std::move(flusher)), grpc_metrics_streamer_(std::move(grpc_metrics_streamer)),
+        main_dispatcher_(main_dispatcher) {}
 
   // MetricsService::Sink
   void flush(Stats::MetricSnapshot& snapshot) override {
-    grpc_metrics_streamer_->send(flusher_.flush(snapshot));
+    if (main_dispatcher_ == nullptr || main_dispatcher_->isThreadSafe()) {
+      grpc_metrics_streamer_->send(flusher_.flush(snapshot));
+      return;
+    }
+    // The gRPC stream can only be used from the main thread. Post callbacks must be copyable.
+    std::shared_ptr<MetricsPtr> metrics = std::make_shared<MetricsPtr>(flusher_.flush(snapshot));
+    main_dispatcher_->post([grpc_metrics_streamer = grpc_metrics_streamer_, metrics]() {
+      grpc_metrics_streamer->send(std::move(*metrics));
+    });
   }
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  bool supportsDedicatedFlushThread() const override { return main_dispatcher_ != nullptr; }
 
 private:
   const MetricsFlusher flusher_;
   GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto> grpc_metrics_streamer_;
+  Event::Dispatcher* const main_dispatcher_;
 };
 
 } // namespace MetricsService
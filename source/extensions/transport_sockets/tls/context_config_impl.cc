@@ -389,7 +389,8 @@ ServerContextConfigImpl::ServerContextConfigImpl(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, require_client_certificate, false)),
       ocsp_staple_policy_(ocspStaplePolicyFromProto(config.ocsp_staple_policy())),
       session_ticket_keys_provider_(getTlsSessionTicketKeysConfigProvider(factory_context, config)),
-      disable_stateless_session_resumption_(getStatelessSessionResumptionDisabled(config)) {
+      disable_stateless_session_resumption_(getStatelessSessionResumptionDisabled(config)),
+      kernel_tls_offload_(config.kernel_tls_offload()) {
 
   if (session_ticket_keys_provider_ != nullptr) {
     // Validate tls session ticket keys early to reject bad sds updates.
@@ -417,6 +418,22 @@ ServerContextConfigImpl::ServerContextConfigImpl(
     session_timeout_ =
         std::chrono::seconds(DurationUtil::durationToSeconds(config.session_timeout()));
   }
+
+  if (config.has_session_store()) {
+#ifdef WIN32
+    throw EnvoyException("TLS session stores are not supported on Windows");
+#else
+    session_store_ = SessionStoreConfig{
+        config.session_store().path(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.session_store(), max_sessions, 16384)};
+#endif
+  }
+
+#if !defined(__linux__)
+  if (kernel_tls_offload_) {
+    throw EnvoyException("Kernel TLS offload is only supported on Linux");
+  }
+#endif
 }
 
 void ServerContextConfigImpl::setSecretUpdateCallback(std::function<void()> callback) {
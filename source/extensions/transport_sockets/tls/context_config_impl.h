@@ -168,6 +168,10 @@ public:
   bool disableStatelessSessionResumption() const override {
     return disable_stateless_session_resumption_;
   }
+  const absl::optional<SessionStoreConfig>& sessionStore() const override {
+    return session_store_;
+  }
+  bool kernelTlsOffload() const override { return kernel_tls_offload_; }
 
 private:
   static const unsigned DEFAULT_MIN_VERSION;
@@ -191,6 +195,8 @@ private:
 
   absl::optional<std::chrono::seconds> session_timeout_;
   const bool disable_stateless_session_resumption_;
+  absl::optional<SessionStoreConfig> session_store_;
+  const bool kernel_tls_offload_;
 };
 
 } // namespace Tls
@@ -693,8 +693,16 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
                                      const Envoy::Ssl::ServerContextConfig& config,
                                      const std::vector<std::string>& server_names,
                                      TimeSource& time_source)
-    : ContextImpl(scope, config, time_source), session_ticket_keys_(config.sessionTicketKeys()),
+    : ContextImpl(scope, config, time_source),
+      session_store_(config.sessionStore().has_value() &&
+                             !config.capabilities().handles_session_resumption
+                         ? std::make_unique<SessionStore>(config.sessionStore()->path_,
+                                                          config.sessionStore()->max_sessions_,
+                                                          time_source)
+                         : nullptr),
+      session_ticket_keys_(config.sessionTicketKeys()),
       ocsp_staple_policy_(config.ocspStaplePolicy()) {
+  kernel_tls_offload_ = config.kernelTlsOffload();
   if (config.tlsCertificates().empty() && !config.capabilities().provides_certificates) {
     throw EnvoyException("Server TlsCertificates must have a certificate specified");
   }
@@ -754,6 +762,23 @@ ServerContextImpl::ServerContextImpl(Stats::Scope& scope,
           });
     }
 
+    // Sessions that miss the context's own cache are looked up in the shared store, which is
+    // visible to every worker and to the next hot restart generation.
+    if (session_store_ != nullptr) {
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->storeSession(session);
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_length, int* out_copy) -> SSL_SESSION* {
+            // The returned session is owned by the caller.
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->lookupSession(ssl, id, id_length);
+          });
+    }
+
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
       auto timeout = config.sessionTimeout().value().count();
       SSL_CTX_set_timeout(ctx.ssl_ctx_.get(), uint32_t(timeout));
@@ -885,6 +910,46 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
   return session_id;
 }
 
+int ServerContextImpl::storeSession(SSL_SESSION* session) {
+  unsigned id_length = 0;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+  uint8_t* session_bytes = nullptr;
+  size_t session_length = 0;
+  if (!SSL_SESSION_to_bytes(session, &session_bytes, &session_length)) {
+    stats_.session_store_insert_failed_.inc();
+    return 0;
+  }
+  const uint64_t expiry = SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session);
+  const SessionStore::InsertResult result =
+      session_store_->insert(absl::MakeConstSpan(id, id_length),
+                             absl::MakeConstSpan(session_bytes, session_length), expiry);
+  OPENSSL_free(session_bytes);
+  if (result == SessionStore::InsertResult::Inserted) {
+    stats_.session_store_insert_.inc();
+  } else {
+    stats_.session_store_insert_failed_.inc();
+  }
+  // The session is not retained, so its reference stays with the caller.
+  return 0;
+}
+
+SSL_SESSION* ServerContextImpl::lookupSession(SSL* ssl, const uint8_t* id, int id_length) {
+  std::vector<uint8_t> session_bytes;
+  if (id_length <= 0 ||
+      !session_store_->lookup(absl::MakeConstSpan(id, id_length), session_bytes)) {
+    stats_.session_store_miss_.inc();
+    return nullptr;
+  }
+  SSL_SESSION* session =
+      SSL_SESSION_from_bytes(session_bytes.data(), session_bytes.size(), SSL_get_SSL_CTX(ssl));
+  if (session == nullptr) {
+    stats_.session_store_miss_.inc();
+    return nullptr;
+  }
+  stats_.session_store_hit_.inc();
+  return session;
+}
+
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
   const EVP_MD* hmac = EVP_sha256();
@@ -19,6 +19,7 @@
 #include "source/extensions/transport_sockets/tls/cert_validator/cert_validator.h"
 #include "source/extensions/transport_sockets/tls/context_manager_impl.h"
 #include "source/extensions/transport_sockets/tls/ocsp/ocsp.h"
+#include "source/extensions/transport_sockets/tls/session_store.h"
 #include "source/extensions/transport_sockets/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -73,6 +74,12 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return true if record protection of established connections should be offloaded to the
+   * kernel.
+   */
+  bool kernelTlsOffload() const { return kernel_tls_offload_; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
@@ -137,6 +144,7 @@ protected:
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
   AccessLog::AccessLogFileSharedPtr tls_keylog_file_;
+  bool kernel_tls_offload_{};
 };
 
 using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
@@ -184,7 +192,10 @@ private:
   OcspStapleAction ocspStapleAction(const TlsContext& ctx, bool client_ocsp_capable);
 
   SessionContextID generateHashForSessionContextId(const std::vector<std::string>& server_names);
+  int storeSession(SSL_SESSION* session);
+  SSL_SESSION* lookupSession(SSL* ssl, const uint8_t* id, int id_length);
 
+  const SessionStorePtr session_store_;
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
 };
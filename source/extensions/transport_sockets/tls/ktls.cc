@@ -0,0 +1,248 @@
+#include "source/extensions/transport_sockets/tls/ktls.h"
+
+#include <cstring>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+
+#include "openssl/hkdf.h"
+#include "openssl/mem.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+
+// Older C libraries do not define these.
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+namespace {
+
+constexpr size_t SaltLength = 4;
+constexpr size_t IvLength = 12;
+
+void writeSequence(uint64_t sequence, uint8_t* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = sequence & 0xff;
+    sequence >>= 8;
+  }
+}
+
+// HKDF-Expand-Label from RFC 8446 section 7.1, with an empty context.
+bool expandLabel(const EVP_MD* digest, bssl::Span<const uint8_t> secret, absl::string_view label,
+                 uint8_t* out, size_t out_len) {
+  constexpr absl::string_view LabelPrefix = "tls13 ";
+  std::vector<uint8_t> info;
+  info.push_back(out_len >> 8);
+  info.push_back(out_len & 0xff);
+  info.push_back(LabelPrefix.size() + label.size());
+  info.insert(info.end(), LabelPrefix.begin(), LabelPrefix.end());
+  info.insert(info.end(), label.begin(), label.end());
+  info.push_back(0);
+  return HKDF_expand(out, out_len, digest, secret.data(), secret.size(), info.data(),
+                     info.size()) == 1;
+}
+
+bool tls13Keys(const EVP_MD* digest, bssl::Span<const uint8_t> secret, size_t key_length,
+               DirectionKeys& keys) {
+  keys.key_.resize(key_length);
+  return expandLabel(digest, secret, "key", keys.key_.data(), key_length) &&
+         expandLabel(digest, secret, "iv", keys.iv_.data(), IvLength);
+}
+
+// The TLS 1.2 key block of an AEAD cipher is client_write_key, server_write_key, client_write_IV
+// and server_write_IV, see RFC 5246 section 6.3. AES-GCM uses no MAC keys.
+bool tls12Keys(const SSL* ssl, size_t key_length, KeyMaterial& keys) {
+  const size_t block_length = SSL_get_key_block_len(ssl);
+  if (block_length != 2 * (key_length + SaltLength)) {
+    return false;
+  }
+  std::vector<uint8_t> block(block_length);
+  if (!SSL_generate_key_block(ssl, block.data(), block.size())) {
+    return false;
+  }
+  const uint8_t* client_key = block.data();
+  const uint8_t* server_key = client_key + key_length;
+  const uint8_t* client_salt = server_key + key_length;
+  const uint8_t* server_salt = client_salt + SaltLength;
+  const bool is_server = SSL_is_server(ssl);
+
+  keys.read_.key_.assign(is_server ? client_key : server_key,
+                         (is_server ? client_key : server_key) + key_length);
+  keys.write_.key_.assign(is_server ? server_key : client_key,
+                          (is_server ? server_key : client_key) + key_length);
+  memcpy(keys.read_.iv_.data(), is_server ? client_salt : server_salt, SaltLength);
+  memcpy(keys.write_.iv_.data(), is_server ? server_salt : client_salt, SaltLength);
+  writeSequence(keys.read_.sequence_, keys.read_.iv_.data() + SaltLength);
+  writeSequence(keys.write_.sequence_, keys.write_.iv_.data() + SaltLength);
+  OPENSSL_cleanse(block.data(), block.size());
+  return true;
+}
+
+#if defined(__linux__)
+template <class CryptoInfo>
+bool setCryptoInfo(os_fd_t fd, int direction, uint16_t version, uint16_t cipher_type,
+                   const DirectionKeys& keys) {
+  CryptoInfo info{};
+  info.info.version = version;
+  info.info.cipher_type = cipher_type;
+  ASSERT(keys.key_.size() == sizeof(info.key));
+  static_assert(sizeof(info.salt) + sizeof(info.iv) == IvLength, "unexpected IV length");
+  memcpy(info.key, keys.key_.data(), sizeof(info.key));
+  memcpy(info.salt, keys.iv_.data(), sizeof(info.salt));
+  memcpy(info.iv, keys.iv_.data() + sizeof(info.salt), sizeof(info.iv));
+  writeSequence(keys.sequence_, info.rec_seq);
+  const int rc =
+      Api::OsSysCallsSingleton::get().setsockopt(fd, SOL_TLS, direction, &info, sizeof(info))
+          .return_value_;
+  OPENSSL_cleanse(&info, sizeof(info));
+  return rc == 0;
+}
+
+bool setKeys(os_fd_t fd, int direction, const KeyMaterial& keys,
+             const DirectionKeys& direction_keys) {
+  const uint16_t version = keys.version_ == TLS1_3_VERSION ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+  if (direction_keys.key_.size() == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+    return setCryptoInfo<tls12_crypto_info_aes_gcm_128>(fd, direction, version,
+                                                        TLS_CIPHER_AES_GCM_128, direction_keys);
+  }
+  return setCryptoInfo<tls12_crypto_info_aes_gcm_256>(fd, direction, version,
+                                                      TLS_CIPHER_AES_GCM_256, direction_keys);
+}
+#endif
+
+} // namespace
+
+DirectionKeys::~DirectionKeys() {
+  OPENSSL_cleanse(key_.data(), key_.size());
+  OPENSSL_cleanse(iv_.data(), iv_.size());
+}
+
+absl::optional<KeyMaterial> keyMaterial(const SSL* ssl) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr || SSL_in_init(ssl) || SSL_has_pending(ssl)) {
+    return absl::nullopt;
+  }
+  size_t key_length;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    key_length = 16;
+    break;
+  case NID_aes_256_gcm:
+    key_length = 32;
+    break;
+  default:
+    return absl::nullopt;
+  }
+
+  KeyMaterial keys;
+  keys.version_ = SSL_version(ssl);
+  keys.read_.sequence_ = SSL_get_read_sequence(ssl);
+  keys.write_.sequence_ = SSL_get_write_sequence(ssl);
+  if (keys.version_ == TLS1_3_VERSION) {
+    bssl::Span<const uint8_t> read_secret;
+    bssl::Span<const uint8_t> write_secret;
+    const EVP_MD* digest = SSL_CIPHER_get_handshake_digest(cipher);
+    if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret) || digest == nullptr ||
+        !tls13Keys(digest, read_secret, key_length, keys.read_) ||
+        !tls13Keys(digest, write_secret, key_length, keys.write_)) {
+      return absl::nullopt;
+    }
+  } else if (keys.version_ == TLS1_2_VERSION) {
+    if (!tls12Keys(ssl, key_length, keys)) {
+      return absl::nullopt;
+    }
+  } else {
+    return absl::nullopt;
+  }
+  return keys;
+}
+
+#if defined(__linux__)
+EnableResult enable(os_fd_t fd, const SSL* ssl) {
+  const absl::optional<KeyMaterial> keys = keyMaterial(ssl);
+  if (!keys.has_value()) {
+    return EnableResult::Unsupported;
+  }
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  static constexpr char Ulp[] = "tls";
+  if (os_sys_calls.setsockopt(fd, SOL_TCP, TCP_ULP, Ulp, sizeof(Ulp)).return_value_ != 0) {
+    // The tls module is not loaded or the socket is not a TCP socket.
+    return EnableResult::Unsupported;
+  }
+  // Until keys are installed for a direction, the socket passes that direction through unchanged.
+  // The receive direction goes first because the kernel rejects it for versions or ciphers it does
+  // not support, while that case cannot be undone once the transmit direction is offloaded.
+  if (!setKeys(fd, TLS_RX, *keys, keys->read_)) {
+    return EnableResult::Unsupported;
+  }
+  if (!setKeys(fd, TLS_TX, *keys, keys->write_)) {
+    return EnableResult::Failed;
+  }
+  return EnableResult::Offloaded;
+}
+
+Api::SysCallSizeResult sendCloseNotify(os_fd_t fd) {
+  // A warning level close_notify alert, see RFC 8446 section 6.
+  uint8_t alert[2] = {1, 0};
+  iovec iov{alert, sizeof(alert)};
+  char control[CMSG_SPACE(sizeof(uint8_t))] = {};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = RecordTypeAlert;
+  return Api::OsSysCallsSingleton::get().sendmsg(fd, &msg, 0);
+}
+
+Api::SysCallSizeResult readRecord(os_fd_t fd, ControlRecord& record) {
+  // The kernel returns at most one record, whose plaintext is limited to 2^14 bytes.
+  record.data_.resize(16384);
+  iovec iov{record.data_.data(), record.data_.size()};
+  char control[CMSG_SPACE(sizeof(uint8_t))] = {};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  const Api::SysCallSizeResult result = Api::OsSysCallsSingleton::get().recvmsg(fd, &msg, 0);
+  if (result.return_value_ < 0) {
+    record.data_.clear();
+    return result;
+  }
+  record.data_.resize(result.return_value_);
+  record.type_ = RecordTypeApplicationData;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg != nullptr && cmsg->cmsg_level == SOL_TLS && cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+    record.type_ = *CMSG_DATA(cmsg);
+  }
+  return result;
+}
+#else
+EnableResult enable(os_fd_t, const SSL*) { return EnableResult::Unsupported; }
+
+Api::SysCallSizeResult sendCloseNotify(os_fd_t) { return {-1, SOCKET_ERROR_NOT_SUP}; }
+
+Api::SysCallSizeResult readRecord(os_fd_t, ControlRecord&) { return {-1, SOCKET_ERROR_NOT_SUP}; }
+#endif
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "envoy/api/os_sys_calls_common.h"
+#include "envoy/common/platform.h"
+
+#include "absl/types/optional.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Kernel TLS offload. Once the handshake completed, the negotiated record protection keys of a
+ * connection can be installed into the kernel. From then on, plaintext is written to and read from
+ * the socket directly and the kernel encrypts and decrypts the records. Only supported on Linux,
+ * for TLS 1.2 and TLS 1.3 with AES-GCM.
+ */
+namespace KernelTls {
+
+// TLS record content types, see RFC 8446 section 5.1.
+constexpr uint8_t RecordTypeAlert = 21;
+constexpr uint8_t RecordTypeHandshake = 22;
+constexpr uint8_t RecordTypeApplicationData = 23;
+
+/**
+ * Record protection keys of one direction of a connection.
+ */
+struct DirectionKeys {
+  ~DirectionKeys();
+
+  std::vector<uint8_t> key_;
+  // The 4 byte salt followed by the 8 byte IV, as the kernel expects them. For TLS 1.2 the IV is
+  // the explicit nonce of the next record, which BoringSSL sets to the record sequence number.
+  std::array<uint8_t, 12> iv_{};
+  uint64_t sequence_{};
+};
+
+/**
+ * Record protection keys of a connection.
+ */
+struct KeyMaterial {
+  uint16_t version_{};
+  DirectionKeys read_;
+  DirectionKeys write_;
+};
+
+/**
+ * Extracts the keys of an established connection.
+ * @param ssl the connection. Its handshake must be complete and no application data may have been
+ *        read or written yet.
+ * @return the keys, or absl::nullopt if the negotiated version or cipher cannot be offloaded or
+ *         BoringSSL already buffered data that was received after the handshake.
+ */
+absl::optional<KeyMaterial> keyMaterial(const SSL* ssl);
+
+enum class EnableResult {
+  // The kernel encrypts and decrypts the records of the connection.
+  Offloaded,
+  // Nothing changed, the connection must keep using BoringSSL for record protection.
+  Unsupported,
+  // The socket is in an unusable state and must be closed.
+  Failed,
+};
+
+/**
+ * Installs the keys of an established connection into the kernel.
+ * @param fd the socket of the connection.
+ * @param ssl the connection. @see keyMaterial() for the preconditions.
+ */
+EnableResult enable(os_fd_t fd, const SSL* ssl);
+
+/**
+ * Sends a close_notify alert on a socket with kernel TLS offload enabled.
+ */
+Api::SysCallSizeResult sendCloseNotify(os_fd_t fd);
+
+/**
+ * A non application data record received on a socket with kernel TLS offload enabled.
+ */
+struct ControlRecord {
+  uint8_t type_{};
+  std::string data_;
+};
+
+/**
+ * Reads the record at the head of the receive queue. Reading a non application data record with
+ * read() fails with EIO, the caller is expected to call this then.
+ * @param fd the socket.
+ * @param record receives the record.
+ */
+Api::SysCallSizeResult readRecord(os_fd_t fd, ControlRecord& record);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,275 @@
+#include "source/extensions/transport_sockets/tls/session_store.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "envoy/api/os_sys_calls.h"
+#include "envoy/common/exception.h"
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/common/hash.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+// A writer that has held a set lock for this long is assumed to have exited while holding it.
+constexpr std::chrono::nanoseconds StaleLockTimeout = std::chrono::seconds(1);
+
+uint64_t roundUpSlots(uint32_t max_sessions) {
+  return (static_cast<uint64_t>(max_sessions) + SessionStore::Ways - 1) / SessionStore::Ways *
+         SessionStore::Ways;
+}
+
+} // namespace
+
+SessionStore::SessionStore(const std::string& path, uint32_t max_sessions,
+                           TimeSource& time_source)
+    : path_(path), slot_count_(roundUpSlots(max_sessions)), set_count_(slot_count_ / Ways),
+      mapping_size_(sizeof(SessionStoreHeader) + set_count_ * sizeof(SessionSet) +
+                    slot_count_ * sizeof(SessionSlot)),
+      time_source_(time_source) {
+#ifdef WIN32
+  throw EnvoyException("TLS session stores are not supported on Windows");
+#else
+  if (!attach()) {
+    create();
+  }
+#endif
+}
+
+#ifndef WIN32
+SessionStore::~SessionStore() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapping_size_);
+  }
+}
+
+bool SessionStore::attach() {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallIntResult open_result = os_sys_calls.open(path_.c_str(), O_RDWR | O_CLOEXEC);
+  if (open_result.return_value_ == -1) {
+    return false;
+  }
+  const int fd = open_result.return_value_;
+
+  struct stat file_stat;
+  if (os_sys_calls.stat(path_.c_str(), &file_stat).return_value_ != 0 ||
+      static_cast<uint64_t>(file_stat.st_size) != mapping_size_) {
+    os_sys_calls.close(fd);
+    return false;
+  }
+  map(fd);
+
+  if (memcmp(header_->magic_, SESSION_STORE_MAGIC, sizeof(SESSION_STORE_MAGIC)) != 0 ||
+      header_->version_ != SESSION_STORE_VERSION || header_->slot_size_ != sizeof(SessionSlot) ||
+      header_->slot_count_ != slot_count_) {
+    ::munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void SessionStore::create() {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+
+  // Build the new store beside the final path and rename it into place once it is fully
+  // initialized, so that a concurrently starting process never maps a half-written header. An
+  // existing store with a different layout is replaced; the processes still mapping it keep using
+  // the old file until they exit.
+  const std::string temp_path = fmt::format("{}.{}.tmp", path_, ::getpid());
+  os_sys_calls.unlink(temp_path.c_str());
+  const Api::SysCallIntResult open_result = os_sys_calls.open(
+      temp_path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (open_result.return_value_ == -1) {
+    throw EnvoyException(fmt::format("unable to create TLS session store {}: {}", temp_path,
+                                     errorDetails(open_result.errno_)));
+  }
+  const int fd = open_result.return_value_;
+
+  // A freshly extended file reads as zeros: every set is unlocked and every slot is empty.
+  const Api::SysCallIntResult truncate_result = os_sys_calls.ftruncate(fd, mapping_size_);
+  if (truncate_result.return_value_ == -1) {
+    os_sys_calls.close(fd);
+    os_sys_calls.unlink(temp_path.c_str());
+    throw EnvoyException(fmt::format("unable to size TLS session store {}: {}", temp_path,
+                                     errorDetails(truncate_result.errno_)));
+  }
+  map(fd);
+
+  memcpy(header_->magic_, SESSION_STORE_MAGIC, sizeof(SESSION_STORE_MAGIC));
+  header_->version_ = SESSION_STORE_VERSION;
+  header_->slot_size_ = sizeof(SessionSlot);
+  header_->slot_count_ = slot_count_;
+
+  if (::rename(temp_path.c_str(), path_.c_str()) != 0) {
+    const int error = errno;
+    os_sys_calls.unlink(temp_path.c_str());
+    throw EnvoyException(
+        fmt::format("unable to create TLS session store {}: {}", path_, errorDetails(error)));
+  }
+}
+
+void SessionStore::map(int fd) {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallPtrResult mmap_result =
+      os_sys_calls.mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping keeps the file referenced; the descriptor is no longer needed.
+  os_sys_calls.close(fd);
+  if (mmap_result.return_value_ == MAP_FAILED) {
+    throw EnvoyException(fmt::format("unable to map TLS session store {}: {}", path_,
+                                     errorDetails(mmap_result.errno_)));
+  }
+  mapping_ = mmap_result.return_value_;
+  header_ = static_cast<SessionStoreHeader*>(mapping_);
+  sets_ = reinterpret_cast<SessionSet*>(static_cast<uint8_t*>(mapping_) +
+                                        sizeof(SessionStoreHeader));
+  slots_ = reinterpret_cast<SessionSlot*>(sets_ + set_count_);
+}
+#else
+SessionStore::~SessionStore() = default;
+#endif
+
+size_t SessionStore::setIndex(absl::Span<const uint8_t> id) const {
+  // xxHash64 is stable across processes, which absl::Hash is not.
+  return HashUtil::xxHash64(
+             absl::string_view(reinterpret_cast<const char*>(id.data()), id.size())) %
+         set_count_;
+}
+
+uint64_t SessionStore::tryLock(SessionSet& set) {
+  // Zero means unlocked, so a lock taken at time zero is recorded as taken one nanosecond later.
+  const uint64_t now = std::max<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              time_source_.monotonicTime().time_since_epoch())
+                                              .count(),
+                                          1);
+  uint64_t locked_at = 0;
+  if (set.locked_at_.compare_exchange_strong(locked_at, now, std::memory_order_acquire)) {
+    return now;
+  }
+  // A stale lock is taken over with a compare-exchange, so that of several writers racing to take
+  // it over only one succeeds. Its new value is necessarily different from the stale one.
+  if (now > locked_at && now - locked_at > static_cast<uint64_t>(StaleLockTimeout.count()) &&
+      set.locked_at_.compare_exchange_strong(locked_at, now, std::memory_order_acquire)) {
+    return now;
+  }
+  return 0;
+}
+
+uint64_t SessionStore::nowSeconds() const {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             time_source_.systemTime().time_since_epoch())
+      .count();
+}
+
+SessionStore::InsertResult SessionStore::insert(absl::Span<const uint8_t> id,
+                                                absl::Span<const uint8_t> session,
+                                                uint64_t expiry) {
+  if (id.empty() || id.size() > sizeof(SessionSlot::id_) || session.size() > maxSessionSize()) {
+    return InsertResult::TooLarge;
+  }
+  const size_t set_index = setIndex(id);
+  SessionSet& set = sets_[set_index];
+  const uint64_t owner = tryLock(set);
+  if (owner == 0) {
+    return InsertResult::Busy;
+  }
+
+  // Reuse the slot holding the same ID, else an empty or expired slot, else the slot closest to
+  // expiry.
+  const uint64_t now = nowSeconds();
+  SessionSlot* const first = slots_ + set_index * Ways;
+  SessionSlot* victim = first;
+  for (SessionSlot* slot = first; slot != first + Ways; ++slot) {
+    if (slot->id_length_ == id.size() && memcmp(slot->id_, id.data(), id.size()) == 0) {
+      victim = slot;
+      break;
+    }
+    if (slot->expiry_ <= now) {
+      victim = slot;
+    } else if (victim->expiry_ > now && slot->expiry_ < victim->expiry_) {
+      victim = slot;
+    }
+  }
+
+  const uint32_t sequence = beginSlotWrite(*victim);
+  victim->id_length_ = id.size();
+  memcpy(victim->id_, id.data(), id.size());
+  victim->session_length_ = session.size();
+  memcpy(victim->session_, session.data(), session.size());
+  victim->expiry_ = expiry;
+  const bool published = endSlotWrite(*victim, sequence);
+
+  // Only release the lock if it is still ours: a writer that was stalled for longer than the stale
+  // lock timeout must not release the lock of the writer that took it over.
+  uint64_t expected = owner;
+  set.locked_at_.compare_exchange_strong(expected, 0, std::memory_order_release,
+                                         std::memory_order_relaxed);
+  return published ? InsertResult::Inserted : InsertResult::Busy;
+}
+
+uint32_t SessionStore::beginSlotWrite(SessionSlot& slot) {
+  // An odd sequence belongs to a writer whose lock was taken over, which may still be writing.
+  // Moving to the next odd value rather than keeping it makes that writer's publish fail.
+  const uint32_t current = slot.sequence_.load(std::memory_order_relaxed);
+  const uint32_t sequence = current % 2 == 0 ? current + 1 : current + 2;
+  slot.sequence_.store(sequence, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  return sequence;
+}
+
+bool SessionStore::endSlotWrite(SessionSlot& slot, uint32_t sequence) {
+  uint32_t expected = sequence;
+  if (slot.sequence_.compare_exchange_strong(expected, sequence + 1, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+    return true;
+  }
+  // Another writer took the slot over while this one was stalled. Discard both writes by moving
+  // the sequence to an odd value neither of them owns: the slot is skipped by readers until it is
+  // rewritten.
+  while (!slot.sequence_.compare_exchange_weak(expected, expected + (expected % 2 == 0 ? 1 : 2),
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+  }
+  return false;
+}
+
+bool SessionStore::lookup(absl::Span<const uint8_t> id, std::vector<uint8_t>& session) const {
+  if (id.empty() || id.size() > sizeof(SessionSlot::id_)) {
+    return false;
+  }
+  const uint64_t now = nowSeconds();
+  const SessionSlot* const first = slots_ + setIndex(id) * Ways;
+  for (const SessionSlot* slot = first; slot != first + Ways; ++slot) {
+    const uint32_t sequence = slot->sequence_.load(std::memory_order_acquire);
+    if (sequence % 2 != 0 || slot->id_length_ != id.size() ||
+        memcmp(slot->id_, id.data(), id.size()) != 0 || slot->expiry_ <= now) {
+      continue;
+    }
+    // The length is re-validated because a concurrent writer may have changed it.
+    const size_t length = std::min<size_t>(slot->session_length_, maxSessionSize());
+    session.assign(slot->session_, slot->session_ + length);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence_.load(std::memory_order_relaxed) == sequence) {
+      return true;
+    }
+  }
+  session.clear();
+  return false;
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+// Increment this whenever the layout of the session store file changes.
+constexpr uint32_t SESSION_STORE_VERSION = 2;
+constexpr char SESSION_STORE_MAGIC[8] = {'E', 'N', 'V', 'O', 'Y', 'T', 'S', 'S'};
+
+/**
+ * Header laid directly at the start of the memory-mapped session store file. It is written once
+ * when the file is created and never modified afterwards.
+ */
+struct SessionStoreHeader {
+  char magic_[8];
+  uint32_t version_;
+  uint32_t slot_size_;
+  uint64_t slot_count_;
+  uint8_t reserved_[104];
+};
+
+/**
+ * Per-set lock word. Holds the monotonic time in nanoseconds at which a writer took the lock, or
+ * zero when the set is unlocked. The value written by a writer also identifies it as the owner:
+ * it only releases the lock if the word still holds that value. Padded to a cache line so that
+ * writers to neighbouring sets do not contend.
+ */
+struct SessionSet {
+  std::atomic<uint64_t> locked_at_;
+  uint8_t padding_[56];
+};
+
+/**
+ * A single cached session. sequence_ is odd while the slot is being rewritten; readers copy the
+ * slot without locking and discard the copy if sequence_ changed in the meantime.
+ */
+struct SessionSlot {
+  std::atomic<uint32_t> sequence_;
+  uint32_t id_length_;
+  uint32_t session_length_;
+  uint32_t reserved_;
+  // Expiry in seconds since the epoch, or zero for an empty slot.
+  uint64_t expiry_;
+  uint8_t id_[32]; // 32 == SSL_MAX_SSL_SESSION_ID_LENGTH
+  uint8_t session_[2048 - 56];
+};
+
+static_assert(sizeof(SessionStoreHeader) == 128, "unexpected session store header size");
+static_assert(sizeof(SessionSet) == 64, "unexpected session store set size");
+static_assert(sizeof(SessionSlot) == 2048, "unexpected session store slot size");
+
+/**
+ * TLS session cache kept in a memory-mapped file so that it is shared by every worker and by the
+ * next hot restart generation, which maps the same file. Placing the file on a tmpfs such as
+ * /dev/shm keeps it in memory.
+ *
+ * Sessions are hashed by their ID into sets of SessionStore::Ways slots. Writers take the set's
+ * lock word and give up instead of waiting when another writer holds it; a lock held for longer
+ * than a second is assumed to belong to a process that exited and is taken over. Readers never
+ * lock.
+ */
+class SessionStore {
+public:
+  static constexpr size_t Ways = 4;
+
+  enum class InsertResult { Inserted, TooLarge, Busy };
+
+  /**
+   * Map the store at path, creating it if it does not exist or was created with a different
+   * layout or size.
+   * @param path supplies the path of the backing file.
+   * @param max_sessions supplies the number of sessions the store can hold.
+   * @param time_source supplies the time source used for expiry and stale lock detection.
+   * @throw EnvoyException if the store cannot be created or mapped.
+   */
+  SessionStore(const std::string& path, uint32_t max_sessions, TimeSource& time_source);
+  ~SessionStore();
+
+  /**
+   * Insert a serialized session, replacing any session with the same ID. When the set is full the
+   * session closest to expiry is replaced.
+   * @param id supplies the session ID.
+   * @param session supplies the serialized session.
+   * @param expiry supplies the session expiry in seconds since the epoch.
+   */
+  InsertResult insert(absl::Span<const uint8_t> id, absl::Span<const uint8_t> session,
+                      uint64_t expiry);
+
+  /**
+   * Look up an unexpired session.
+   * @param id supplies the session ID.
+   * @param session receives the serialized session on success.
+   * @return bool whether a session was found.
+   */
+  bool lookup(absl::Span<const uint8_t> id, std::vector<uint8_t>& session) const;
+
+  /**
+   * @return the size of the largest serialized session that fits in a slot.
+   */
+  static constexpr size_t maxSessionSize() { return sizeof(SessionSlot::session_); }
+
+  /**
+   * Mark a slot as being rewritten by moving its sequence to a fresh odd value. An odd sequence
+   * left by a writer whose lock was taken over is moved past, so that writer can no longer publish.
+   * @param slot supplies the slot about to be rewritten.
+   * @return the odd sequence to pass to endSlotWrite().
+   */
+  static uint32_t beginSlotWrite(SessionSlot& slot);
+
+  /**
+   * Publish a rewritten slot. If another writer moved the sequence since beginSlotWrite(), the two
+   * writes may be interleaved, so the slot is left odd, and skipped by readers, until its next
+   * write.
+   * @param slot supplies the rewritten slot.
+   * @param sequence supplies the value returned by beginSlotWrite().
+   * @return bool whether the write was published.
+   */
+  static bool endSlotWrite(SessionSlot& slot, uint32_t sequence);
+
+  uint64_t slotCount() const { return slot_count_; }
+
+private:
+  bool attach();
+  void create();
+  void map(int fd);
+  size_t setIndex(absl::Span<const uint8_t> id) const;
+  // Returns the owner token of the lock, or zero if the lock could not be taken.
+  uint64_t tryLock(SessionSet& set);
+  uint64_t nowSeconds() const;
+
+  const std::string path_;
+  const uint64_t slot_count_;
+  const uint64_t set_count_;
+  const size_t mapping_size_;
+  TimeSource& time_source_;
+  void* mapping_{};
+  SessionStoreHeader* header_{};
+  SessionSet* sets_{};
+  SessionSlot* slots_{};
+};
+
+using SessionStorePtr = std::unique_ptr<SessionStore>;
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
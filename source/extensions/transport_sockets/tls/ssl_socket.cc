@@ -8,6 +8,7 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/extensions/transport_sockets/tls/io_handle_bio.h"
+#include "source/extensions/transport_sockets/tls/ktls.h"
 #include "source/extensions/transport_sockets/tls/ssl_handshaker.h"
 #include "source/extensions/transport_sockets/tls/utility.h"
 
@@ -110,6 +111,9 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
       return {action, 0, false};
     }
   }
+  if (kernel_tls_) {
+    return doReadKernelTls(read_buffer);
+  }
 
   bool keep_reading = true;
   bool end_stream = false;
@@ -182,6 +186,10 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (ctx_->kernelTlsOffload() && !enableKernelTls()) {
+    callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+    return;
+  }
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -196,6 +204,101 @@ void SslSocket::onFailure() { drainErrorQueue(); }
 
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
+bool SslSocket::enableKernelTls() {
+  switch (KernelTls::enable(callbacks_->ioHandle().fdDoNotUse(), rawSsl())) {
+  case KernelTls::EnableResult::Offloaded:
+    ENVOY_CONN_LOG(debug, "TLS records offloaded to the kernel", callbacks_->connection());
+    ctx_->stats().kernel_tls_offloaded_.inc();
+    kernel_tls_ = true;
+    return true;
+  case KernelTls::EnableResult::Unsupported:
+    ctx_->stats().kernel_tls_unsupported_.inc();
+    return true;
+  case KernelTls::EnableResult::Failed:
+    ctx_->stats().kernel_tls_failed_.inc();
+    failure_reason_ = "TLS error: failed to offload TLS records to the kernel";
+    return false;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+Network::IoResult SslSocket::doReadKernelTls(Buffer::Instance& read_buffer) {
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_read = 0;
+  bool end_stream = false;
+  do {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().read(read_buffer, absl::nullopt);
+    if (result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls read returns: {}", callbacks_->connection(),
+                     result.return_value_);
+      if (result.return_value_ == 0) {
+        // Non-graceful shutdown by closing the underlying socket.
+        end_stream = true;
+        break;
+      }
+      bytes_read += result.return_value_;
+      if (callbacks_->shouldDrainReadBuffer()) {
+        callbacks_->setTransportSocketIsReadable();
+        break;
+      }
+      continue;
+    }
+    if (result.err_->getSystemErrorCode() != EIO) {
+      ENVOY_CONN_LOG(trace, "ktls read error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+
+    // The next record is not application data.
+    KernelTls::ControlRecord record;
+    if (KernelTls::readRecord(callbacks_->ioHandle().fdDoNotUse(), record).return_value_ < 0) {
+      action = PostIoAction::Close;
+    } else if (record.type_ == KernelTls::RecordTypeAlert && record.data_.size() == 2 &&
+               record.data_[1] == SSL_AD_CLOSE_NOTIFY) {
+      // Graceful shutdown using close_notify TLS alert.
+      end_stream = true;
+    } else {
+      // Post-handshake messages and other alerts would need BoringSSL, which no longer has the
+      // current keys.
+      failure_reason_ =
+          absl::StrCat("TLS error: unexpected record of type ", static_cast<int>(record.type_),
+                       " with kernel TLS");
+      ENVOY_CONN_LOG(debug, "{}", callbacks_->connection(), failure_reason_);
+      action = PostIoAction::Close;
+    }
+    break;
+  } while (true);
+
+  ENVOY_CONN_LOG(trace, "ktls read {} bytes", callbacks_->connection(), bytes_read);
+  return {action, bytes_read, end_stream};
+}
+
+Network::IoResult SslSocket::doWriteKernelTls(Buffer::Instance& write_buffer, bool end_stream) {
+  uint64_t bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        break;
+      }
+      return {PostIoAction::Close, bytes_written, false};
+    }
+    ENVOY_CONN_LOG(trace, "ktls write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    bytes_written += result.return_value_;
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+  return {PostIoAction::KeepOpen, bytes_written, false};
+}
+
 void SslSocket::drainErrorQueue() {
   bool saw_error = false;
   bool saw_counted_error = false;
@@ -242,6 +345,9 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
       return {action, 0, false};
     }
   }
+  if (kernel_tls_) {
+    return doWriteKernelTls(write_buffer, end_stream);
+  }
 
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
@@ -301,6 +407,14 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_) {
+      const Api::SysCallSizeResult result =
+          KernelTls::sendCloseNotify(callbacks_->ioHandle().fdDoNotUse());
+      ENVOY_CONN_LOG(debug, "kTLS shutdown: rc={}", callbacks_->connection(),
+                     result.return_value_);
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
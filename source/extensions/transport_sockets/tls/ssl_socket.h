@@ -85,6 +85,9 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  bool enableKernelTls();
+  Network::IoResult doReadKernelTls(Buffer::Instance& read_buffer);
+  Network::IoResult doWriteKernelTls(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
@@ -94,6 +97,8 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // True once the kernel encrypts and decrypts the records of this connection.
+  bool kernel_tls_{};
 
   SslHandshakerImplSharedPtr info_;
 };
@@ -20,7 +20,14 @@ namespace Tls {
   COUNTER(ocsp_staple_failed)                                                                      \
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
-  COUNTER(ocsp_staple_requests)
+  COUNTER(ocsp_staple_requests)                                                                    \
+  COUNTER(session_store_hit)                                                                       \
+  COUNTER(session_store_miss)                                                                      \
+  COUNTER(session_store_insert)                                                                    \
+  COUNTER(session_store_insert_failed)                                                             \
+  COUNTER(kernel_tls_offloaded)                                                                    \
+  COUNTER(kernel_tls_unsupported)                                                                  \
+  COUNTER(kernel_tls_failed)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
@@ -1,5 +1,7 @@
 #include "source/server/active_stream_listener_base.h"
 
+#include <algorithm>
+
 #include "envoy/network/filter.h"
 
 #include "source/common/stats/timespan_impl.h"
@@ -24,6 +26,16 @@ void ActiveStreamListenerBase::emitLogs(Network::ListenerConfig& config,
   }
 }
 
+uint32_t ActiveStreamListenerBase::connectionBufferLimit() const {
+  const uint32_t limit = config_->perConnectionBufferLimitBytes();
+  if (limit == 0 || buffer_limit_step_ == BufferLimitScaleSteps) {
+    return limit;
+  }
+  const uint32_t floor = std::min(limit, MinScaledBufferLimitBytes);
+  return std::max(floor, static_cast<uint32_t>(static_cast<uint64_t>(limit) * buffer_limit_step_ /
+                                               BufferLimitScaleSteps));
+}
+
 void ActiveStreamListenerBase::newConnection(Network::ConnectionSocketPtr&& socket,
                                              std::unique_ptr<StreamInfo::StreamInfo> stream_info) {
   // Find matching filter chain.
@@ -48,7 +60,7 @@ void ActiveStreamListenerBase::newConnection(Network::ConnectionSocketPtr&& sock
     server_conn_ptr->setTransportSocketConnectTimeout(
         timeout, stats_.downstream_cx_transport_socket_connect_timeout_);
   }
-  server_conn_ptr->setBufferLimits(config_->perConnectionBufferLimitBytes());
+  server_conn_ptr->setBufferLimits(connectionBufferLimit());
   RELEASE_ASSERT(server_conn_ptr->connectionInfoProvider().remoteAddress() != nullptr, "");
   const bool empty_filter_chain = !config_->filterChainFactory().createNetworkFilterChain(
       *server_conn_ptr, filter_chain->networkFilterFactories());
@@ -135,6 +147,30 @@ void OwnedActiveStreamListenerBase::removeConnection(ActiveTcpConnection& connec
   }
 }
 
+void OwnedActiveStreamListenerBase::setBufferLimitScale(UnitFloat scale) {
+  const double steps = scale.value() * BufferLimitScaleSteps;
+  uint32_t step = static_cast<uint32_t>(steps);
+  if (step > buffer_limit_step_ && scale != UnitFloat::max()) {
+    // Limits are only raised again once the scale is half a step above the new step, so that a
+    // scale hovering around a step does not update every connection each time it is refreshed.
+    step = std::max(buffer_limit_step_, static_cast<uint32_t>(steps - 0.5));
+  }
+  if (step == buffer_limit_step_) {
+    return;
+  }
+  const uint32_t previous_limit = connectionBufferLimit();
+  buffer_limit_step_ = step;
+  const uint32_t limit = connectionBufferLimit();
+  if (limit == previous_limit) {
+    return;
+  }
+  for (auto& [filter_chain, active_connections] : connections_by_context_) {
+    for (auto& active_connection : active_connections->connections_) {
+      active_connection->connection_->setBufferLimits(limit);
+    }
+  }
+}
+
 ActiveConnections& OwnedActiveStreamListenerBase::getOrCreateActiveConnections(
     const Network::FilterChain& filter_chain) {
   ActiveConnectionCollectionPtr& connections = connections_by_context_[&filter_chain];
@@ -82,6 +82,14 @@ public:
   virtual Network::BalancedConnectionHandlerOptRef
   getBalancedHandlerByAddress(const Network::Address::Instance& address) PURE;
 
+  /**
+   * @return the buffer limit applied to new connections: the configured per connection limit
+   * scaled by the current buffer limit step. A scaled limit never drops below
+   * MinScaledBufferLimitBytes (or the configured limit, if smaller), and an unlimited
+   * configuration stays unlimited.
+   */
+  uint32_t connectionBufferLimit() const;
+
   void onSocketAccepted(std::unique_ptr<ActiveTcpSocket> active_socket) {
     // Create and run the filters
     if (config_->filterChainFactory().createListenerFilterChain(*active_socket)) {
@@ -113,6 +121,13 @@ public:
     }
   }
 
+  // Floor of a scaled per connection buffer limit, so that shrunk connections can still make
+  // progress with a full TLS record.
+  static constexpr uint32_t MinScaledBufferLimitBytes = 16 * 1024;
+  // The per connection buffer limit is scaled in steps of 1 / BufferLimitScaleSteps, so that the
+  // limits of existing connections are only updated a few times as the pressure changes.
+  static constexpr uint32_t BufferLimitScaleSteps = 8;
+
   // Below members are open to access by ActiveTcpSocket.
   Network::ConnectionHandler& parent_;
   const std::chrono::milliseconds listener_filters_timeout_;
@@ -138,6 +153,9 @@ protected:
   // collection is removed. This state is maintained in base class because this state is independent
   // from concrete connection type.
   bool is_deleting_{false};
+  // Step of the scale applied to the configured per connection buffer limit, from 0 to
+  // BufferLimitScaleSteps. Lowered by the shrink_buffer_limits overload action.
+  uint32_t buffer_limit_step_{BufferLimitScaleSteps};
 
 private:
   Event::Dispatcher& dispatcher_;
@@ -203,6 +221,13 @@ public:
    */
   void removeConnection(ActiveTcpConnection& connection);
 
+  /**
+   * Scale the buffer limits of new and existing connections owned by this listener. Existing
+   * connections are only walked when the scale moves to another step.
+   * @param scale supplies the fraction of the configured per connection buffer limit to apply.
+   */
+  void setBufferLimitScale(UnitFloat scale);
+
 protected:
   /**
    * Return the active connections container attached to the given filter chain.
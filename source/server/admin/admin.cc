@@ -46,6 +46,8 @@ namespace Server {
 
 ConfigTracker& AdminImpl::getConfigTracker() { return config_tracker_; }
 
+ConfigMemoryTracker& AdminImpl::getConfigMemoryTracker() { return config_memory_tracker_; }
+
 AdminImpl::NullRouteConfigProvider::NullRouteConfigProvider(TimeSource& time_source)
     : config_(new Router::NullConfigImpl()), time_source_(time_source) {}
 
@@ -91,7 +93,7 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
       config_dump_handler_(config_tracker_, server), init_dump_handler_(server),
       stats_handler_(server), logs_handler_(server), profiling_handler_(profile_path),
       runtime_handler_(server), listeners_handler_(server), server_cmd_handler_(server),
-      server_info_handler_(server),
+      server_info_handler_(server, config_memory_tracker_),
       // TODO(jsedgwick) add /runtime_reset endpoint that removes all admin-set values
       handlers_{
           makeHandler("/", "Admin home page", MAKE_ADMIN_HANDLER(handlerAdminHome), false, false),
@@ -122,6 +124,10 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                       MAKE_ADMIN_HANDLER(logs_handler_.handlerLogging), false, true),
           makeHandler("/memory", "print current allocation/heap usage",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemory), false, false),
+          makeHandler("/memory/config",
+                      "print the approximate memory footprint of each listener, cluster, route "
+                      "configuration and secret",
+                      MAKE_ADMIN_HANDLER(server_info_handler_.handlerConfigMemory), false, false),
           makeHandler("/quitquitquit", "exit the server",
                       MAKE_ADMIN_HANDLER(server_cmd_handler_.handlerQuitQuitQuit), false, true),
           makeHandler("/reset_counters", "reset all counters to zero",
@@ -133,8 +139,11 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
           makeHandler("/ready", "print server state, return 200 if LIVE, otherwise return 503",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerReady), false, false),
           makeStreamingHandler("/stats", "print server stats", stats_handler_, false, false),
-          makeHandler("/stats/prometheus", "print server stats in prometheus format",
-                      MAKE_ADMIN_HANDLER(stats_handler_.handlerPrometheusStats), false, false),
+          {"/stats/prometheus", "print server stats in prometheus format",
+           [this](absl::string_view path, AdminStream& admin_stream) -> Admin::RequestPtr {
+             return stats_handler_.makePrometheusRequest(path, admin_stream);
+           },
+           false, false},
           makeHandler("/stats/recentlookups", "Show recent stat-name lookups",
                       MAKE_ADMIN_HANDLER(stats_handler_.handlerStatsRecentLookups), false, false),
           makeHandler("/stats/recentlookups/clear", "clear list of stat-name lookups and counter",
@@ -39,6 +39,7 @@
 #include "source/server/admin/admin_filter.h"
 #include "source/server/admin/clusters_handler.h"
 #include "source/server/admin/config_dump_handler.h"
+#include "source/server/admin/config_memory_tracker_impl.h"
 #include "source/server/admin/config_tracker_impl.h"
 #include "source/server/admin/init_dump_handler.h"
 #include "source/server/admin/listeners_handler.h"
@@ -89,6 +90,7 @@ public:
                            bool mutates_server_state) override;
   bool removeHandler(const std::string& prefix) override;
   ConfigTracker& getConfigTracker() override;
+  ConfigMemoryTracker& getConfigMemoryTracker() override;
 
   void startHttpListener(const std::list<AccessLog::InstanceSharedPtr>& access_logs,
                          const std::string& address_out_path,
@@ -499,6 +501,7 @@ private:
   Http::Http1::CodecStats::AtomicPtr http1_codec_stats_;
   Http::Http2::CodecStats::AtomicPtr http2_codec_stats_;
   ConfigTrackerImpl config_tracker_;
+  ConfigMemoryTrackerImpl config_memory_tracker_;
   const Network::FilterChainSharedPtr admin_filter_chain_;
   Network::SocketSharedPtr socket_;
   std::vector<Network::ListenSocketFactoryPtr> socket_factories_;
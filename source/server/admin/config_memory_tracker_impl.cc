@@ -0,0 +1,84 @@
+#include "source/server/admin/config_memory_tracker_impl.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Server {
+
+void ConfigMemoryTrackerImpl::setBuildCost(ResourceType type, const std::string& name,
+                                           uint64_t allocated_bytes,
+                                           std::chrono::microseconds build_time) {
+  resources(type)[name] = {allocated_bytes, build_time};
+}
+
+void ConfigMemoryTrackerImpl::addBuildCost(ResourceType type, const std::string& name,
+                                           uint64_t allocated_bytes,
+                                           std::chrono::microseconds build_time) {
+  ResourceCost& cost = resources(type)[name];
+  cost.allocated_bytes += allocated_bytes;
+  cost.build_time += build_time;
+}
+
+void ConfigMemoryTrackerImpl::removeResource(ResourceType type, const std::string& name) {
+  resources(type).erase(name);
+}
+
+void ConfigMemoryTrackerImpl::dump(envoy::admin::v3::ConfigMemory& config_memory) const {
+  addSorted(listeners_, *config_memory.mutable_listeners());
+  addSorted(clusters_, *config_memory.mutable_clusters());
+  addSorted(route_configs_, *config_memory.mutable_route_configs());
+  addSorted(regexes_, *config_memory.mutable_regexes());
+  addSorted(tls_contexts_, *config_memory.mutable_tls_contexts());
+}
+
+void ConfigMemoryTrackerImpl::addSorted(
+    const ResourceMap& resources,
+    Protobuf::RepeatedPtrField<envoy::admin::v3::ConfigMemory::Resource>& out) {
+  const int first = out.size();
+  for (const auto& [name, cost] : resources) {
+    auto* resource = out.Add();
+    resource->set_name(name);
+    resource->set_allocated(cost.allocated_bytes);
+    if (cost.build_time.count() > 0) {
+      *resource->mutable_build_time() =
+          Protobuf::util::TimeUtil::MicrosecondsToDuration(cost.build_time.count());
+    }
+  }
+  std::sort(out.begin() + first, out.end(),
+            [](const envoy::admin::v3::ConfigMemory::Resource& a,
+               const envoy::admin::v3::ConfigMemory::Resource& b) {
+              return a.allocated() != b.allocated() ? a.allocated() > b.allocated()
+                                                    : a.name() < b.name();
+            });
+}
+
+void ConfigMemoryTrackerImpl::addSecrets(const absl::flat_hash_map<std::string, uint64_t>& secrets,
+                                         envoy::admin::v3::ConfigMemory& config_memory) {
+  ResourceMap resources;
+  resources.reserve(secrets.size());
+  for (const auto& [name, bytes] : secrets) {
+    resources[name] = {bytes, std::chrono::microseconds::zero()};
+  }
+  addSorted(resources, *config_memory.mutable_secrets());
+}
+
+ConfigMemoryTrackerImpl::ResourceMap& ConfigMemoryTrackerImpl::resources(ResourceType type) {
+  switch (type) {
+  case ResourceType::Listener:
+    return listeners_;
+  case ResourceType::Cluster:
+    return clusters_;
+  case ResourceType::RouteConfiguration:
+    return route_configs_;
+  case ResourceType::Regex:
+    return regexes_;
+  case ResourceType::TlsContext:
+    return tls_contexts_;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+} // namespace Server
+} // namespace Envoy
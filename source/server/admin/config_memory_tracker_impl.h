@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "envoy/admin/v3/memory.pb.h"
+#include "envoy/server/config_memory_tracker.h"
+
+#include "source/common/protobuf/protobuf.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Implementation of ConfigMemoryTracker.
+ */
+class ConfigMemoryTrackerImpl : public ConfigMemoryTracker {
+public:
+  struct ResourceCost {
+    uint64_t allocated_bytes;
+    std::chrono::microseconds build_time;
+  };
+  using ResourceMap = absl::flat_hash_map<std::string, ResourceCost>;
+
+  // Server::ConfigMemoryTracker
+  void setBuildCost(ResourceType type, const std::string& name, uint64_t allocated_bytes,
+                    std::chrono::microseconds build_time) override;
+  void addBuildCost(ResourceType type, const std::string& name, uint64_t allocated_bytes,
+                    std::chrono::microseconds build_time) override;
+  void removeResource(ResourceType type, const std::string& name) override;
+
+  /**
+   * Add the tracked resources to a ConfigMemory message.
+   */
+  void dump(envoy::admin::v3::ConfigMemory& config_memory) const;
+
+  /**
+   * Add resources to a repeated ConfigMemory field, sorted by decreasing footprint.
+   */
+  static void addSorted(const ResourceMap& resources,
+                        Protobuf::RepeatedPtrField<envoy::admin::v3::ConfigMemory::Resource>& out);
+
+  /**
+   * Add secrets, as reported by Secret::SecretManager::secretsAllocatedBytes(), to a ConfigMemory
+   * message.
+   */
+  static void addSecrets(const absl::flat_hash_map<std::string, uint64_t>& secrets,
+                         envoy::admin::v3::ConfigMemory& config_memory);
+
+private:
+  ResourceMap& resources(ResourceType type);
+
+  ResourceMap listeners_;
+  ResourceMap clusters_;
+  ResourceMap route_configs_;
+  ResourceMap regexes_;
+  ResourceMap tls_contexts_;
+};
+
+} // namespace Server
+} // namespace Envoy
@@ -1,12 +1,17 @@
 #include "source/server/admin/prometheus_stats.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 #include "source/common/common/regex.h"
+#include "source/common/http/headers.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/histogram_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
+#include "absl/strings/str_split.h"
 
 namespace Envoy {
 namespace Server {
@@ -224,6 +229,77 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
+constexpr absl::string_view ProtobufMediaType = "application/vnd.google.protobuf";
+constexpr absl::string_view ProtobufContentType =
+    "application/vnd.google.protobuf; proto=io.prometheus.client.MetricFamily; encoding=delimited";
+
+/*
+ * Adds the tags of a stat as the labels of a protobuf metric. Unlike in the
+ * text format, label values need no escaping.
+ */
+void addLabels(const std::vector<Stats::Tag>& tags, io::prometheus::client::Metric& metric) {
+  for (const Stats::Tag& tag : tags) {
+    io::prometheus::client::LabelPair& label = *metric.add_label();
+    label.set_name(sanitizeName(tag.name_));
+    label.set_value(tag.value_);
+  }
+}
+
+void generateCounterProtobuf(const Stats::Counter& counter,
+                             io::prometheus::client::Metric& metric) {
+  metric.mutable_counter()->set_value(counter.value());
+}
+
+void generateGaugeProtobuf(const Stats::Gauge& gauge, io::prometheus::client::Metric& metric) {
+  metric.mutable_gauge()->set_value(gauge.value());
+}
+
+// @see generateTextReadoutOutput.
+void generateTextReadoutProtobuf(const Stats::TextReadout& text_readout,
+                                 io::prometheus::client::Metric& metric) {
+  io::prometheus::client::LabelPair& label = *metric.add_label();
+  label.set_name("text_value");
+  label.set_value(text_readout.value());
+  metric.mutable_gauge()->set_value(0);
+}
+
+// The buckets are cumulative, and the +Inf bucket is implied by the sample count.
+void generateHistogramProtobuf(const Stats::ParentHistogram& histogram,
+                               io::prometheus::client::Metric& metric) {
+  const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
+  Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
+  const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
+  io::prometheus::client::Histogram& output = *metric.mutable_histogram();
+  output.set_sample_count(stats.sampleCount());
+  output.set_sample_sum(stats.sampleSum());
+  for (size_t i = 0; i < supported_buckets.size(); ++i) {
+    io::prometheus::client::Bucket& bucket = *output.add_bucket();
+    bucket.set_upper_bound(supported_buckets[i]);
+    bucket.set_cumulative_count(computed_buckets[i]);
+  }
+}
+
+/*
+ * Appends a message prefixed with its varint encoded length, as in the
+ * delimited protobuf exposition format.
+ */
+void appendDelimited(const Protobuf::Message& message, Buffer::Instance& response) {
+  const std::string serialized = message.SerializeAsString();
+  uint8_t length[10];
+  size_t length_size = 0;
+  uint64_t remaining = serialized.size();
+  do {
+    length[length_size] = remaining & 0x7f;
+    remaining >>= 7;
+    if (remaining != 0) {
+      length[length_size] |= 0x80;
+    }
+    ++length_size;
+  } while (remaining != 0);
+  response.add(length, length_size);
+  response.add(serialized);
+}
+
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
@@ -286,5 +362,246 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   return metric_name_count;
 }
 
+PrometheusFormat
+PrometheusStatsFormatter::negotiateFormat(const Http::RequestHeaderMap& request_headers) {
+  const Http::HeaderMap::GetResult accept =
+      request_headers.get(Http::CustomHeaders::get().Accept);
+  for (size_t i = 0; i < accept.size(); ++i) {
+    for (absl::string_view media_range : absl::StrSplit(accept[i]->value().getStringView(), ',')) {
+      // Prometheus asks for the delimited protobuf format with
+      // application/vnd.google.protobuf;proto=io.prometheus.client.MetricFamily;encoding=delimited
+      const std::vector<absl::string_view> params =
+          absl::StrSplit(media_range, ';', absl::SkipWhitespace());
+      if (params.empty() || absl::StripAsciiWhitespace(params[0]) != ProtobufMediaType) {
+        continue;
+      }
+      bool metric_family = false;
+      bool delimited = false;
+      for (size_t j = 1; j < params.size(); ++j) {
+        const absl::string_view param = absl::StripAsciiWhitespace(params[j]);
+        metric_family |= param == "proto=io.prometheus.client.MetricFamily";
+        delimited |= param == "encoding=delimited";
+      }
+      if (metric_family && delimited) {
+        return PrometheusFormat::Protobuf;
+      }
+    }
+  }
+  return PrometheusFormat::Text;
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(
+    Stats::Store& stats, const StatsParams& params,
+    const Stats::CustomStatNamespaces& custom_namespaces, PrometheusFormat format)
+    : params_(params), stats_(stats), custom_namespaces_(custom_namespaces), format_(format) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap& response_headers) {
+  if (format_ == PrometheusFormat::Protobuf) {
+    response_headers.setContentType(ProtobufContentType);
+  }
+  if (compressor_ != nullptr) {
+    response_headers.setReferenceKey(Http::CustomHeaders::get().ContentEncoding,
+                                     content_encoding_);
+    response_headers.setReferenceKey(Http::CustomHeaders::get().Vary,
+                                     Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+  }
+
+  // Hold onto all the scopes so that their stats outlive the request.
+  stats_.forEachScope(
+      [this](size_t s) { scopes_.reserve(s); },
+      [this](const Stats::Scope& scope) { scopes_.emplace_back(scope.getConstShared()); });
+  startPhase();
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  if (compressor_ == nullptr) {
+    return renderChunk(response);
+  }
+  Buffer::OwnedImpl chunk;
+  const bool more = renderChunk(chunk);
+  compressor_->compress(chunk, more ? Compression::Compressor::State::Flush
+                                    : Compression::Compressor::State::Finish);
+  response.move(chunk);
+  return more;
+}
+
+bool PrometheusStatsRequest::renderChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  const uint64_t starting_response_length = response.length();
+  while (response.length() - starting_response_length < chunk_size_) {
+    while (next_group_ == groups_.size()) {
+      switch (phase_) {
+      case Phase::Counters:
+        phase_ = Phase::Gauges;
+        break;
+      case Phase::Gauges:
+        phase_ = Phase::TextReadouts;
+        break;
+      case Phase::TextReadouts:
+        phase_ = Phase::Histograms;
+        break;
+      case Phase::Histograms:
+        return false;
+      }
+      startPhase();
+    }
+
+    Group& group = groups_[next_group_++];
+    if (format_ == PrometheusFormat::Protobuf) {
+      switch (phase_) {
+      case Phase::Counters:
+        renderGroupProtobuf<Stats::Counter>(group, io::prometheus::client::COUNTER,
+                                            generateCounterProtobuf, response);
+        break;
+      case Phase::Gauges:
+        renderGroupProtobuf<Stats::Gauge>(group, io::prometheus::client::GAUGE,
+                                          generateGaugeProtobuf, response);
+        break;
+      case Phase::TextReadouts:
+        renderGroupProtobuf<Stats::TextReadout>(group, io::prometheus::client::GAUGE,
+                                                generateTextReadoutProtobuf, response);
+        break;
+      case Phase::Histograms:
+        renderGroupProtobuf<Stats::ParentHistogram>(group, io::prometheus::client::HISTOGRAM,
+                                                    generateHistogramProtobuf, response);
+        break;
+      }
+      continue;
+    }
+    switch (phase_) {
+    case Phase::Counters:
+      renderGroup<Stats::Counter>(group, "counter", generateNumericOutput<Stats::Counter>,
+                                  response);
+      break;
+    case Phase::Gauges:
+      renderGroup<Stats::Gauge>(group, "gauge", generateNumericOutput<Stats::Gauge>, response);
+      break;
+    case Phase::TextReadouts:
+      // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+      renderGroup<Stats::TextReadout>(group, "gauge", generateTextReadoutOutput, response);
+      break;
+    case Phase::Histograms:
+      renderGroup<Stats::ParentHistogram>(group, "histogram", generateHistogramOutput, response);
+      break;
+    }
+  }
+  return true;
+}
+
+void PrometheusStatsRequest::startPhase() {
+  groups_.clear();
+  next_group_ = 0;
+  switch (phase_) {
+  case Phase::Counters:
+    populateGroups<Stats::Counter>();
+    break;
+  case Phase::Gauges:
+    populateGroups<Stats::Gauge>();
+    break;
+  case Phase::TextReadouts:
+    if (params_.prometheus_text_readouts_) {
+      populateGroups<Stats::TextReadout>();
+    }
+    break;
+  case Phase::Histograms:
+    populateGroups<Stats::Histogram>();
+    break;
+  }
+
+  // Sort the groups by their tag-extracted name to satisfy the "preferred"
+  // ordering from the prometheus spec, taking the symbol table lock once.
+  stats_.symbolTable().sortByStatNames<Group>(
+      groups_.begin(), groups_.end(),
+      [](const Group& group) -> Stats::StatName { return group.tag_extracted_name_; });
+}
+
+template <class StatType> void PrometheusStatsRequest::populateGroups() {
+  absl::flat_hash_map<Stats::StatName, size_t> group_indices;
+  Stats::IterateFn<StatType> add_stat = [this, &group_indices](
+                                            const Stats::RefcountPtr<StatType>& stat) -> bool {
+    if (!shouldShowMetric(*stat, params_)) {
+      return true;
+    }
+    // Only parent histograms have the cumulative statistics to render.
+    if constexpr (std::is_same_v<StatType, Stats::Histogram>) {
+      if (dynamic_cast<const Stats::ParentHistogram*>(stat.get()) == nullptr) {
+        return true;
+      }
+    }
+    const auto [iter, inserted] =
+        group_indices.try_emplace(stat->tagExtractedStatName(), groups_.size());
+    if (inserted) {
+      groups_.push_back(Group{stat->tagExtractedStatName(), {}});
+    }
+    groups_[iter->second].stats_.emplace_back(stat);
+    return true;
+  };
+  for (const Stats::ConstScopeSharedPtr& scope : scopes_) {
+    scope->iterate(add_stat);
+  }
+}
+
+absl::optional<std::string> PrometheusStatsRequest::prepareGroup(Group& group) {
+  const Stats::SymbolTable& symbol_table = stats_.constSymbolTable();
+  absl::optional<std::string> prefixed_tag_extracted_name =
+      PrometheusStatsFormatter::metricName(symbol_table.toString(group.tag_extracted_name_),
+                                           custom_namespaces_);
+  if (prefixed_tag_extracted_name.has_value()) {
+    // Scopes with the same name share their stats, so the same stat can have
+    // been added more than once. Stats with the same name are the same object,
+    // so the duplicates are adjacent once sorted.
+    symbol_table.sortByStatNames<Stats::RefcountPtr<Stats::Metric>>(
+        group.stats_.begin(), group.stats_.end(),
+        [](const Stats::RefcountPtr<Stats::Metric>& stat) { return stat->statName(); });
+    group.stats_.erase(std::unique(group.stats_.begin(), group.stats_.end()), group.stats_.end());
+  }
+  return prefixed_tag_extracted_name;
+}
+
+template <class StatType>
+void PrometheusStatsRequest::renderGroup(
+    Group& group, absl::string_view type,
+    const std::function<std::string(const StatType& metric,
+                                    const std::string& prefixed_tag_extracted_name)>&
+        generate_output,
+    Buffer::Instance& response) {
+  const absl::optional<std::string> prefixed_tag_extracted_name = prepareGroup(group);
+  if (prefixed_tag_extracted_name.has_value()) {
+    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+    for (const Stats::RefcountPtr<Stats::Metric>& stat : group.stats_) {
+      response.add(generate_output(dynamic_cast<const StatType&>(*stat),
+                                   prefixed_tag_extracted_name.value()));
+    }
+    response.add("\n");
+  }
+  // Release the stats, along with tag_extracted_name_, as soon as the group is rendered.
+  group.stats_.clear();
+}
+
+template <class StatType>
+void PrometheusStatsRequest::renderGroupProtobuf(
+    Group& group, io::prometheus::client::MetricType type,
+    const std::function<void(const StatType& metric, io::prometheus::client::Metric& output)>&
+        generate_output,
+    Buffer::Instance& response) {
+  const absl::optional<std::string> prefixed_tag_extracted_name = prepareGroup(group);
+  if (prefixed_tag_extracted_name.has_value()) {
+    io::prometheus::client::MetricFamily family;
+    family.set_name(prefixed_tag_extracted_name.value());
+    family.set_type(type);
+    family.mutable_metric()->Reserve(group.stats_.size());
+    for (const Stats::RefcountPtr<Stats::Metric>& stat : group.stats_) {
+      io::prometheus::client::Metric& metric = *family.add_metric();
+      addLabels(stat->tags(), metric);
+      generate_output(dynamic_cast<const StatType&>(*stat), metric);
+    }
+    appendDelimited(family, response);
+  }
+  // Release the stats, along with tag_extracted_name_, as soon as the group is rendered.
+  group.stats_.clear();
+}
+
 } // namespace Server
 } // namespace Envoy
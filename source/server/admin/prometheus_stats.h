@@ -4,14 +4,31 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/http/header_map.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
 #include "source/server/admin/stats_params.h"
 
+#include "io/prometheus/client/metrics.pb.h"
+
 namespace Envoy {
 namespace Server {
+
+/**
+ * Exposition formats of the Prometheus stats.
+ */
+enum class PrometheusFormat {
+  // The text format, version 0.0.4.
+  Text,
+  // Length-delimited io.prometheus.client.MetricFamily protobuf messages.
+  Protobuf,
+};
+
 /**
  * Formatter for metric/labels exported to Prometheus.
  *
@@ -45,6 +62,103 @@ public:
   static absl::optional<std::string>
   metricName(const std::string& extracted_name,
              const Stats::CustomStatNamespaces& custom_namespace_factory);
+
+  /**
+   * Picks the exposition format from the Accept header of a scrape request.
+   * The protobuf format is only used when the client explicitly accepts it.
+   */
+  static PrometheusFormat negotiateFormat(const Http::RequestHeaderMap& request_headers);
+};
+
+/**
+ * Streams the stats in the Prometheus text exposition format, in chunks of
+ * about chunk_size_ bytes. The output is the same as the one of
+ * PrometheusStatsFormatter::statsAsPrometheus(), but it is never held in memory
+ * as a whole.
+ *
+ * The exposition format requires all the stats with the same tag-extracted
+ * name to be emitted as a group, and these can be spread across any number of
+ * scopes. So each stat type is handled in a phase that first groups references
+ * to all the matching stats of that type by their tag-extracted name, and sorts
+ * the groups. The groups are then rendered one at a time, releasing the
+ * references of each group as it is rendered.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         PrometheusFormat format = PrometheusFormat::Text);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size. This is the size of the chunks before compression.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+  /**
+   * Compresses the response. Each chunk is flushed out of the compressor.
+   * @param compressor the compressor.
+   * @param content_encoding the value of the content-encoding response header.
+   */
+  void setCompressor(Compression::Compressor::CompressorPtr compressor,
+                     absl::string_view content_encoding) {
+    compressor_ = std::move(compressor);
+    content_encoding_ = std::string(content_encoding);
+  }
+
+private:
+  // Matches the order of the types in PrometheusStatsFormatter::statsAsPrometheus().
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms };
+
+  struct Group {
+    // Held by the first stat in stats_.
+    Stats::StatName tag_extracted_name_;
+    std::vector<Stats::RefcountPtr<Stats::Metric>> stats_;
+  };
+
+  // Renders the next chunk, before compression.
+  bool renderChunk(Buffer::Instance& response);
+
+  // Groups the stats of the current phase, and sorts the groups.
+  void startPhase();
+
+  template <class StatType> void populateGroups();
+
+  // Renders the group of stats of the templatized type, and releases them.
+  template <class StatType>
+  void renderGroup(Group& group, absl::string_view type,
+                   const std::function<std::string(const StatType& metric,
+                                                   const std::string& prefixed_tag_extracted_name)>&
+                       generate_output,
+                   Buffer::Instance& response);
+
+  // Renders the group of stats of the templatized type as a MetricFamily message,
+  // and releases them.
+  template <class StatType>
+  void renderGroupProtobuf(Group& group, io::prometheus::client::MetricType type,
+                           const std::function<void(const StatType& metric,
+                                                    io::prometheus::client::Metric& output)>&
+                               generate_output,
+                           Buffer::Instance& response);
+
+  // Sorts and de-duplicates the stats of a group, returning its prometheus
+  // metric name, or nullopt if the group has no valid name.
+  absl::optional<std::string> prepareGroup(Group& group);
+
+  const StatsParams params_;
+  Stats::Store& stats_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  const PrometheusFormat format_;
+  Compression::Compressor::CompressorPtr compressor_;
+  std::string content_encoding_;
+  std::vector<Stats::ConstScopeSharedPtr> scopes_;
+  Phase phase_{Phase::Counters};
+  std::vector<Group> groups_;
+  size_t next_group_{0};
+  uint64_t chunk_size_{DefaultChunkSize};
 };
 
 } // namespace Server
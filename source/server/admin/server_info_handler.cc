@@ -9,7 +9,9 @@
 namespace Envoy {
 namespace Server {
 
-ServerInfoHandler::ServerInfoHandler(Server::Instance& server) : HandlerContextBase(server) {}
+ServerInfoHandler::ServerInfoHandler(Server::Instance& server,
+                                     const ConfigMemoryTrackerImpl& config_memory_tracker)
+    : HandlerContextBase(server), config_memory_tracker_(config_memory_tracker) {}
 
 Http::Code ServerInfoHandler::handlerCerts(absl::string_view,
                                            Http::ResponseHeaderMap& response_headers,
@@ -55,6 +57,18 @@ Http::Code ServerInfoHandler::handlerMemory(absl::string_view,
   return Http::Code::OK;
 }
 
+Http::Code ServerInfoHandler::handlerConfigMemory(absl::string_view,
+                                                  Http::ResponseHeaderMap& response_headers,
+                                                  Buffer::Instance& response, AdminStream&) {
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  envoy::admin::v3::ConfigMemory config_memory;
+  config_memory_tracker_.dump(config_memory);
+  ConfigMemoryTrackerImpl::addSecrets(server_.secretManager().secretsAllocatedBytes(),
+                                      config_memory);
+  response.add(MessageUtil::getJsonStringFromMessageOrError(config_memory, true, true));
+  return Http::Code::OK;
+}
+
 Http::Code ServerInfoHandler::handlerReady(absl::string_view, Http::ResponseHeaderMap&,
                                            Buffer::Instance& response, AdminStream&) {
   const envoy::admin::v3::ServerInfo::State state =
@@ -6,6 +6,7 @@
 #include "envoy/server/admin.h"
 #include "envoy/server/instance.h"
 
+#include "source/server/admin/config_memory_tracker_impl.h"
 #include "source/server/admin/handler_ctx.h"
 
 #include "absl/strings/string_view.h"
@@ -16,7 +17,8 @@ namespace Server {
 class ServerInfoHandler : public HandlerContextBase {
 
 public:
-  ServerInfoHandler(Server::Instance& server);
+  ServerInfoHandler(Server::Instance& server,
+                    const ConfigMemoryTrackerImpl& config_memory_tracker);
 
   Http::Code handlerCerts(absl::string_view path_and_query,
                           Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
@@ -37,6 +39,13 @@ public:
   Http::Code handlerMemory(absl::string_view path_and_query,
                            Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
                            AdminStream&);
+
+  Http::Code handlerConfigMemory(absl::string_view path_and_query,
+                                 Http::ResponseHeaderMap& response_headers,
+                                 Buffer::Instance& response, AdminStream&);
+
+private:
+  const ConfigMemoryTrackerImpl& config_memory_tracker_;
 };
 
 } // namespace Server
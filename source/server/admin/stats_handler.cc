@@ -4,6 +4,8 @@
 #include <vector>
 
 #include "envoy/admin/v3/mutex_stats.pb.h"
+#include "envoy/compression/compressor/config.h"
+#include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
@@ -12,6 +14,11 @@
 #include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -70,7 +77,7 @@ Http::Code StatsHandler::handlerStatsRecentLookupsEnable(absl::string_view,
   return Http::Code::OK;
 }
 
-Admin::RequestPtr StatsHandler::makeRequest(absl::string_view path, AdminStream& /*admin_stream*/) {
+Admin::RequestPtr StatsHandler::makeRequest(absl::string_view path, AdminStream& admin_stream) {
   StatsParams params;
   Buffer::OwnedImpl response;
   Http::Code code = params.parse(path, response);
@@ -78,23 +85,13 @@ Admin::RequestPtr StatsHandler::makeRequest(absl::string_view path, AdminStream&
     return Admin::makeStaticTextRequest(response, code);
   }
 
-  if (params.format_ == StatsFormat::Prometheus) {
-    // TODO(#16139): modify streaming algorithm to cover Prometheus.
-    //
-    // This may be easiest to accomplish by populating the set
-    // with tagExtractedName(), and allowing for vectors of
-    // stats as multiples will have the same tag-extracted names.
-    // Ideally we'd find a way to do this without slowing down
-    // the non-Prometheus implementations.
-    Buffer::OwnedImpl response;
-    prometheusFlushAndRender(params, response);
-    return Admin::makeStaticTextRequest(response, code);
-  }
-
   if (server_.statsConfig().flushOnAdmin()) {
     server_.flushStats();
   }
 
+  if (params.format_ == StatsFormat::Prometheus) {
+    return makePrometheusRequest(params, admin_stream);
+  }
   return makeRequest(server_.stats(), params);
 }
 
@@ -102,39 +99,103 @@ Admin::RequestPtr StatsHandler::makeRequest(Stats::Store& stats, const StatsPara
   return std::make_unique<StatsRequest>(stats, params);
 }
 
-Http::Code StatsHandler::handlerPrometheusStats(absl::string_view path_and_query,
-                                                Http::ResponseHeaderMap&,
-                                                Buffer::Instance& response, AdminStream&) {
-  return prometheusStats(path_and_query, response);
-}
-
-Http::Code StatsHandler::prometheusStats(absl::string_view path_and_query,
-                                         Buffer::Instance& response) {
+Admin::RequestPtr StatsHandler::makePrometheusRequest(absl::string_view path_and_query,
+                                                      AdminStream& admin_stream) {
   StatsParams params;
+  Buffer::OwnedImpl response;
   Http::Code code = params.parse(path_and_query, response);
   if (code != Http::Code::OK) {
-    return code;
+    return Admin::makeStaticTextRequest(response, code);
   }
-  prometheusFlushAndRender(params, response);
-  return Http::Code::OK;
-}
 
-void StatsHandler::prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response) {
   if (server_.statsConfig().flushOnAdmin()) {
     server_.flushStats();
   }
-  prometheusRender(server_.stats(), server_.api().customStatNamespaces(), params, response);
+  return makePrometheusRequest(params, admin_stream);
+}
+
+Admin::RequestPtr StatsHandler::makePrometheusRequest(const StatsParams& params,
+                                                      AdminStream& admin_stream) {
+  const Http::RequestHeaderMap& request_headers = admin_stream.getRequestHeaders();
+  absl::string_view content_encoding;
+  Compression::Compressor::CompressorPtr compressor =
+      negotiateCompressor(request_headers, content_encoding);
+  return makePrometheusRequest(server_.stats(), server_.api().customStatNamespaces(), params,
+                               PrometheusStatsFormatter::negotiateFormat(request_headers),
+                               std::move(compressor), content_encoding);
 }
 
-void StatsHandler::prometheusRender(Stats::Store& stats,
-                                    const Stats::CustomStatNamespaces& custom_namespaces,
-                                    const StatsParams& params, Buffer::Instance& response) {
-  const std::vector<Stats::TextReadoutSharedPtr>& text_readouts_vec =
-      params.prometheus_text_readouts_ ? stats.textReadouts()
-                                       : std::vector<Stats::TextReadoutSharedPtr>();
-  PrometheusStatsFormatter::statsAsPrometheus(stats.counters(), stats.gauges(), stats.histograms(),
-                                              text_readouts_vec, response, params,
-                                              custom_namespaces);
+Admin::RequestPtr StatsHandler::makePrometheusRequest(
+    Stats::Store& stats, const Stats::CustomStatNamespaces& custom_namespaces,
+    const StatsParams& params, PrometheusFormat format,
+    Compression::Compressor::CompressorPtr compressor, absl::string_view content_encoding) {
+  auto request =
+      std::make_unique<PrometheusStatsRequest>(stats, params, custom_namespaces, format);
+  if (compressor != nullptr) {
+    request->setCompressor(std::move(compressor), content_encoding);
+  }
+  return request;
+}
+
+bool StatsHandler::acceptsEncoding(const Http::RequestHeaderMap& request_headers,
+                                   absl::string_view encoding) {
+  const Http::HeaderMap::GetResult accept_encoding =
+      request_headers.get(Http::CustomHeaders::get().AcceptEncoding);
+  for (size_t i = 0; i < accept_encoding.size(); ++i) {
+    for (absl::string_view coding : absl::StrSplit(accept_encoding[i]->value().getStringView(),
+                                                   ',', absl::SkipWhitespace())) {
+      const std::vector<absl::string_view> params =
+          absl::StrSplit(coding, ';', absl::SkipWhitespace());
+      if (params.empty() ||
+          !absl::EqualsIgnoreCase(absl::StripAsciiWhitespace(params[0]), encoding)) {
+        continue;
+      }
+      // A quality value of zero marks the coding as not acceptable, see RFC 9110 section 12.5.3.
+      for (size_t j = 1; j < params.size(); ++j) {
+        absl::string_view param = absl::StripAsciiWhitespace(params[j]);
+        double quality;
+        if (absl::ConsumePrefix(&param, "q=") && absl::SimpleAtod(param, &quality) &&
+            quality <= 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+Compression::Compressor::CompressorPtr
+StatsHandler::negotiateCompressor(const Http::RequestHeaderMap& request_headers,
+                                  absl::string_view& content_encoding) {
+  // zstd compresses stats about as well as gzip at a fraction of the CPU cost,
+  // so it is preferred when the client accepts both.
+  static const std::vector<std::pair<std::string, std::string>> codings = {
+      {Http::CustomHeaders::get().ContentEncodingValues.Zstd, "envoy.compression.zstd.compressor"},
+      {Http::CustomHeaders::get().ContentEncodingValues.Gzip, "envoy.compression.gzip.compressor"},
+  };
+  for (const auto& [coding, factory_name] : codings) {
+    if (!acceptsEncoding(request_headers, coding)) {
+      continue;
+    }
+    auto it = compressor_factories_.find(coding);
+    if (it == compressor_factories_.end()) {
+      Compression::Compressor::CompressorFactoryPtr compressor_factory;
+      auto* config_factory = Registry::FactoryRegistry<
+          Compression::Compressor::NamedCompressorLibraryConfigFactory>::getFactory(factory_name);
+      if (config_factory != nullptr) {
+        ProtobufTypes::MessagePtr config = config_factory->createEmptyConfigProto();
+        compressor_factory = config_factory->createCompressorFactoryFromProto(
+            *config, server_.serverFactoryContext());
+      }
+      it = compressor_factories_.emplace(coding, std::move(compressor_factory)).first;
+    }
+    if (it->second != nullptr) {
+      content_encoding = it->second->contentEncoding();
+      return it->second->createCompressor();
+    }
+  }
+  return nullptr;
 }
 
 Http::Code StatsHandler::handlerContention(absl::string_view,
@@ -4,15 +4,18 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/compression/compressor/factory.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
 #include "envoy/server/admin.h"
 #include "envoy/server/instance.h"
 
 #include "source/server/admin/handler_ctx.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -38,42 +41,41 @@ public:
   Http::Code handlerStatsRecentLookupsEnable(absl::string_view path_and_query,
                                              Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(absl::string_view path_and_query,
-                                    Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
 
   /**
-   * Parses and executes a prometheus stats request.
+   * Parses a prometheus stats request, served from /stats/prometheus
+   * regardless of the format parameter.
    *
    * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
+   * @return the streaming request
    */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
+  Admin::RequestPtr makePrometheusRequest(absl::string_view path_and_query, AdminStream&);
 
   /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  void prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
-
-  /**
-   * Renders the stats as prometheus. This is broken out as a separately
-   * callable API to facilitate the benchmark
+   * Creates a streaming prometheus stats request. This is broken out as a
+   * separately callable API to facilitate the benchmark
    * (test/server/admin/stats_handler_speed_test.cc) which does not have a
    * server object.
    *
    * @params stats the stats store to read
    * @param custom_namespaces namespace mappings used for prometheus
    * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
+   * @return the streaming request
    */
-  static void prometheusRender(Stats::Store& stats,
-                               const Stats::CustomStatNamespaces& custom_namespaces,
-                               const StatsParams& params, Buffer::Instance& response);
+  static Admin::RequestPtr
+  makePrometheusRequest(Stats::Store& stats, const Stats::CustomStatNamespaces& custom_namespaces,
+                        const StatsParams& params,
+                        PrometheusFormat format = PrometheusFormat::Text,
+                        Compression::Compressor::CompressorPtr compressor = nullptr,
+                        absl::string_view content_encoding = "");
+
+  /**
+   * @param request_headers the headers of a scrape request.
+   * @param encoding a content coding, such as "gzip".
+   * @return whether the Accept-Encoding header of the request allows the coding.
+   */
+  static bool acceptsEncoding(const Http::RequestHeaderMap& request_headers,
+                              absl::string_view encoding);
 
   Http::Code handlerContention(absl::string_view path_and_query,
                                Http::ResponseHeaderMap& response_headers,
@@ -83,6 +85,22 @@ public:
 
 private:
   friend class StatsHandlerTest;
+
+  // Creates a prometheus request with the format and compression negotiated
+  // from the headers of the admin request.
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params, AdminStream& admin_stream);
+
+  // Returns a compressor for the preferred coding accepted by the client, or
+  // nullptr if the response should not be compressed.
+  Compression::Compressor::CompressorPtr
+  negotiateCompressor(const Http::RequestHeaderMap& request_headers,
+                      absl::string_view& content_encoding);
+
+  // Compressor factories by content coding, created with their default
+  // configuration on first use. nullptr if the compression extension of a
+  // coding is not compiled in.
+  absl::flat_hash_map<std::string, Compression::Compressor::CompressorFactoryPtr>
+      compressor_factories_;
 };
 
 } // namespace Server
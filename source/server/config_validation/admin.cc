@@ -18,6 +18,8 @@ const Network::Socket& ValidationAdmin::socket() { return *socket_; }
 
 ConfigTracker& ValidationAdmin::getConfigTracker() { return config_tracker_; }
 
+ConfigMemoryTracker& ValidationAdmin::getConfigMemoryTracker() { return config_memory_tracker_; }
+
 void ValidationAdmin::startHttpListener(const std::list<AccessLog::InstanceSharedPtr>&,
                                         const std::string&,
                                         Network::Address::InstanceConstSharedPtr,
@@ -5,6 +5,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/network/listen_socket_impl.h"
+#include "source/server/admin/config_memory_tracker_impl.h"
 #include "source/server/admin/config_tracker_impl.h"
 
 namespace Envoy {
@@ -29,6 +30,7 @@ public:
   bool removeHandler(const std::string&) override;
   const Network::Socket& socket() override;
   ConfigTracker& getConfigTracker() override;
+  ConfigMemoryTracker& getConfigMemoryTracker() override;
   void startHttpListener(const std::list<AccessLog::InstanceSharedPtr>& access_logs,
                          const std::string& address_out_path,
                          Network::Address::InstanceConstSharedPtr address,
@@ -39,8 +41,11 @@ public:
   void addListenerToHandler(Network::ConnectionHandler* handler) override;
   uint32_t concurrency() const override { return 1; }
 
+  const ConfigMemoryTrackerImpl& configMemoryTracker() const { return config_memory_tracker_; }
+
 private:
   ConfigTrackerImpl config_tracker_;
+  ConfigMemoryTrackerImpl config_memory_tracker_;
   Network::SocketSharedPtr socket_;
 };
 
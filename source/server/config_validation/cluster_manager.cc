@@ -13,12 +13,16 @@ ClusterManagerPtr ValidationClusterManagerFactory::clusterManagerFromProto(
   return std::make_unique<ValidationClusterManager>(
       bootstrap, *this, stats_, tls_, context_.runtime(), local_info_, log_manager_,
       context_.mainThreadDispatcher(), admin_, validation_context_, context_.api(), http_context_,
-      grpc_context_, router_context_, server_);
+      grpc_context_, router_context_, server_, snapshot_subscription_factory_);
 }
 
 CdsApiPtr ValidationClusterManagerFactory::createCds(
     const envoy::config::core::v3::ConfigSource& cds_config,
     const xds::core::v3::ResourceLocator* cds_resources_locator, ClusterManager& cm) {
+  if (snapshot_subscription_factory_ != nullptr) {
+    // CDS is served from the snapshot, which does not connect anywhere.
+    return ProdClusterManagerFactory::createCds(cds_config, cds_resources_locator, cm);
+  }
   // Create the CdsApiImpl...
   ProdClusterManagerFactory::createCds(cds_config, cds_resources_locator, cm);
   // ... and then throw it away, so that we don't actually connect to it.
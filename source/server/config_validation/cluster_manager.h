@@ -14,7 +14,8 @@ namespace Upstream {
 
 /**
  * Config-validation-only implementation of ClusterManagerFactory, which creates
- * ValidationClusterManagers. It also creates, but never returns, CdsApiImpls.
+ * ValidationClusterManagers. It also creates, but never returns, CdsApiImpls, unless the xDS
+ * subscriptions are served from a snapshot.
  */
 class ValidationClusterManagerFactory : public ProdClusterManagerFactory {
 public:
@@ -29,18 +30,19 @@ public:
       Http::Context& http_context, Grpc::Context& grpc_context, Router::Context& router_context,
       AccessLog::AccessLogManager& log_manager, Singleton::Manager& singleton_manager,
       const Server::Options& options, Quic::QuicStatNames& quic_stat_names,
-      Server::Instance& server)
+      Server::Instance& server, Config::SubscriptionFactory* snapshot_subscription_factory)
       : ProdClusterManagerFactory(
             admin, runtime, stats, tls, dns_resolver, ssl_context_manager, main_thread_dispatcher,
             local_info, secret_manager, validation_context, api, http_context, grpc_context,
             router_context, log_manager, singleton_manager, options, quic_stat_names, server),
-        grpc_context_(grpc_context), router_context_(router_context) {}
+        grpc_context_(grpc_context), router_context_(router_context),
+        snapshot_subscription_factory_(snapshot_subscription_factory) {}
 
   ClusterManagerPtr
   clusterManagerFromProto(const envoy::config::bootstrap::v3::Bootstrap& bootstrap) override;
 
   // Delegates to ProdClusterManagerFactory::createCds, but discards the result and returns nullptr
-  // unconditionally.
+  // unless the xDS subscriptions are served from a snapshot.
   CdsApiPtr createCds(const envoy::config::core::v3::ConfigSource& cds_config,
                       const xds::core::v3::ResourceLocator* cds_resources_locator,
                       ClusterManager& cm) override;
@@ -48,10 +50,13 @@ public:
 private:
   Grpc::Context& grpc_context_;
   Router::Context& router_context_;
+  // If not null, serves the xDS subscriptions of the cluster manager from a snapshot.
+  Config::SubscriptionFactory* const snapshot_subscription_factory_;
 };
 
 /**
  * Config-validation-only implementation of ClusterManager, which opens no upstream connections.
+ * Its xDS subscriptions may be served from a snapshot, in place of the management server.
  */
 class ValidationClusterManager : public ClusterManagerImpl {
 public:
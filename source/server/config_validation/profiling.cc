@@ -0,0 +1,59 @@
+#include "source/server/config_validation/profiling.h"
+
+#include <chrono>
+
+#include "source/common/memory/stats.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+// Calls build() and adds the time and memory it took to the cost of the named resource. Nothing is
+// recorded if build() throws, since the configuration is then rejected.
+template <class Build>
+auto recordBuildCost(ConfigMemoryTracker& config_memory_tracker,
+                     ConfigMemoryTracker::ResourceType type, const std::string& name,
+                     TimeSource& time_source, Build build) {
+  const Memory::AllocatedBytesSampler allocated_bytes;
+  const MonotonicTime build_start_time = time_source.monotonicTime();
+  auto built = build();
+  config_memory_tracker.addBuildCost(type, name, allocated_bytes.allocatedBytes(),
+                                     std::chrono::duration_cast<std::chrono::microseconds>(
+                                         time_source.monotonicTime() - build_start_time));
+  return built;
+}
+
+} // namespace
+
+Regex::CompiledMatcherPtr ProfilingRegexEngine::matcher(const std::string& regex) const {
+  return recordBuildCost(config_memory_tracker_, ConfigMemoryTracker::ResourceType::Regex, regex,
+                         time_source_, [this, &regex]() { return engine_->matcher(regex); });
+}
+
+Ssl::ClientContextSharedPtr
+ProfilingContextManager::createSslClientContext(Stats::Scope& scope,
+                                                const Ssl::ClientContextConfig& config) {
+  return recordBuildCost(config_memory_tracker_, ConfigMemoryTracker::ResourceType::TlsContext,
+                         absl::StrCat("client:", config.serverNameIndication()), time_source_,
+                         [this, &scope, &config]() {
+                           return context_manager_->createSslClientContext(scope, config);
+                         });
+}
+
+Ssl::ServerContextSharedPtr
+ProfilingContextManager::createSslServerContext(Stats::Scope& scope,
+                                                const Ssl::ServerContextConfig& config,
+                                                const std::vector<std::string>& server_names) {
+  return recordBuildCost(config_memory_tracker_, ConfigMemoryTracker::ResourceType::TlsContext,
+                         absl::StrCat("server:", absl::StrJoin(server_names, ",")), time_source_,
+                         [this, &scope, &config, &server_names]() {
+                           return context_manager_->createSslServerContext(scope, config,
+                                                                           server_names);
+                         });
+}
+
+} // namespace Server
+} // namespace Envoy
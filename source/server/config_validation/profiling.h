@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "envoy/common/regex.h"
+#include "envoy/common/time.h"
+#include "envoy/server/config_memory_tracker.h"
+#include "envoy/ssl/context_manager.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Config-validation-only implementation of Regex::Engine, which delegates to another engine and
+ * records the cost of compiling each regex of the configuration, named by its pattern.
+ */
+class ProfilingRegexEngine : public Regex::Engine {
+public:
+  ProfilingRegexEngine(Regex::EnginePtr engine, ConfigMemoryTracker& config_memory_tracker,
+                       TimeSource& time_source)
+      : engine_(std::move(engine)), config_memory_tracker_(config_memory_tracker),
+        time_source_(time_source) {}
+
+  // Regex::Engine
+  Regex::CompiledMatcherPtr matcher(const std::string& regex) const override;
+
+private:
+  const Regex::EnginePtr engine_;
+  ConfigMemoryTracker& config_memory_tracker_;
+  TimeSource& time_source_;
+};
+
+/**
+ * Config-validation-only implementation of Ssl::ContextManager, which delegates to another context
+ * manager and records the cost of building each TLS context of the configuration. Client contexts
+ * are named by their SNI, and server contexts by the server names of their filter chain.
+ */
+class ProfilingContextManager : public Ssl::ContextManager {
+public:
+  ProfilingContextManager(Ssl::ContextManagerPtr context_manager,
+                          ConfigMemoryTracker& config_memory_tracker, TimeSource& time_source)
+      : context_manager_(std::move(context_manager)),
+        config_memory_tracker_(config_memory_tracker), time_source_(time_source) {}
+
+  // Ssl::ContextManager
+  Ssl::ClientContextSharedPtr
+  createSslClientContext(Stats::Scope& scope, const Ssl::ClientContextConfig& config) override;
+  Ssl::ServerContextSharedPtr
+  createSslServerContext(Stats::Scope& scope, const Ssl::ServerContextConfig& config,
+                         const std::vector<std::string>& server_names) override;
+  absl::optional<uint32_t> daysUntilFirstCertExpires() const override {
+    return context_manager_->daysUntilFirstCertExpires();
+  }
+  void iterateContexts(std::function<void(const Ssl::Context&)> callback) override {
+    context_manager_->iterateContexts(callback);
+  }
+  Ssl::PrivateKeyMethodManager& privateKeyMethodManager() override {
+    return context_manager_->privateKeyMethodManager();
+  }
+  absl::optional<uint64_t> secondsUntilFirstOcspResponseExpires() const override {
+    return context_manager_->secondsUntilFirstOcspResponseExpires();
+  }
+  void removeContext(const Ssl::ContextSharedPtr& old_context) override {
+    context_manager_->removeContext(old_context);
+  }
+
+private:
+  const Ssl::ContextManagerPtr context_manager_;
+  ConfigMemoryTracker& config_memory_tracker_;
+  TimeSource& time_source_;
+};
+
+} // namespace Server
+} // namespace Envoy
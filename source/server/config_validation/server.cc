@@ -2,15 +2,19 @@
 
 #include <memory>
 
+#include "envoy/admin/v3/memory.pb.h"
 #include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 
+#include "source/common/common/regex.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/utility.h"
+#include "source/common/config/xds_resource.h"
 #include "source/common/event/real_time_system.h"
 #include "source/common/local_info/local_info_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/singleton/manager_impl.h"
 #include "source/common/version/version.h"
+#include "source/server/config_validation/profiling.h"
 #include "source/server/ssl_context_manager.h"
 
 namespace Envoy {
@@ -27,8 +31,13 @@ bool validateConfig(const Options& options,
     Event::RealTimeSystem time_system;
     ValidationInstance server(options, time_system, local_address, stats_store, access_log_lock,
                               component_factory, thread_factory, file_system);
-    std::cout << "configuration '" << options.configPath() << "' OK" << std::endl;
     server.shutdown();
+    // The build costs are kept by the admin, which outlives the shutdown.
+    if (!options.configProfilePath().empty() &&
+        !server.writeConfigProfile(options.configProfilePath())) {
+      return false;
+    }
+    std::cout << "configuration '" << options.configPath() << "' OK" << std::endl;
     return true;
   }
   END_TRY
@@ -97,6 +106,26 @@ void ValidationInstance::initialize(const Options& options,
   Configuration::InitialImpl initial_config(bootstrap_);
   initial_config.initAdminAccessLog(bootstrap_, *this);
   admin_ = std::make_unique<Server::ValidationAdmin>(initial_config.admin().address());
+
+  // Initialize the regex engine and inject to singleton.
+  if (bootstrap_.has_default_regex_engine()) {
+    const auto& default_regex_engine = bootstrap_.default_regex_engine();
+    Regex::EngineFactory& factory =
+        Config::Utility::getAndCheckFactory<Regex::EngineFactory>(default_regex_engine);
+    auto config = Config::Utility::translateAnyToFactoryConfig(
+        default_regex_engine.typed_config(), messageValidationContext().staticValidationVisitor(),
+        factory);
+    regex_engine_ = factory.createEngine(*config, serverFactoryContext());
+  } else {
+    regex_engine_ = std::make_shared<Regex::GoogleReEngine>();
+  }
+  if (!options.configProfilePath().empty()) {
+    regex_engine_ = std::make_shared<ProfilingRegexEngine>(
+        std::move(regex_engine_), admin_->getConfigMemoryTracker(), api_->timeSource());
+  }
+  Regex::EngineSingleton::clear();
+  Regex::EngineSingleton::initialize(regex_engine_.get());
+
   listener_manager_ =
       std::make_unique<ListenerManagerImpl>(*this, *this, *this, false, quic_stat_names_);
   thread_local_.registerThread(*dispatcher_, true);
@@ -110,16 +139,83 @@ void ValidationInstance::initialize(const Options& options,
 
   secret_manager_ = std::make_unique<Secret::SecretManagerImpl>(admin().getConfigTracker());
   ssl_context_manager_ = createContextManager("ssl_context_manager", api_->timeSource());
+  if (!options.configProfilePath().empty()) {
+    ssl_context_manager_ = std::make_unique<ProfilingContextManager>(
+        std::move(ssl_context_manager_), admin_->getConfigMemoryTracker(), api_->timeSource());
+  }
+  if (!options.configProfileSnapshotDir().empty()) {
+    snapshot_subscription_factory_ = std::make_unique<Config::SnapshotSubscriptionFactory>(
+        options.configProfileSnapshotDir(), dispatcher(),
+        messageValidationContext().dynamicValidationVisitor(), *api_);
+  }
   cluster_manager_factory_ = std::make_unique<Upstream::ValidationClusterManagerFactory>(
       admin(), runtime(), stats(), threadLocal(), dnsResolver(), sslContextManager(), dispatcher(),
       localInfo(), *secret_manager_, messageValidationContext(), *api_, http_context_,
       grpc_context_, router_context_, accessLogManager(), singletonManager(), options,
-      quic_stat_names_, *this);
+      quic_stat_names_, *this, snapshot_subscription_factory_.get());
   config_.initialize(bootstrap_, *this, *cluster_manager_factory_);
   runtime().initialize(clusterManager());
+  if (snapshot_subscription_factory_ != nullptr) {
+    // The dynamic resources are served from the snapshot, so they are built as they would be by the
+    // server, once the primary clusters are initialized.
+    if (bootstrap_.dynamic_resources().has_lds_config() ||
+        !bootstrap_.dynamic_resources().lds_resources_locator().empty()) {
+      std::unique_ptr<xds::core::v3::ResourceLocator> lds_resources_locator;
+      if (!bootstrap_.dynamic_resources().lds_resources_locator().empty()) {
+        lds_resources_locator = std::make_unique<xds::core::v3::ResourceLocator>(
+            Config::XdsResourceIdentifier::decodeUrl(
+                bootstrap_.dynamic_resources().lds_resources_locator()));
+      }
+      listener_manager_->createLdsApi(bootstrap_.dynamic_resources().lds_config(),
+                                      lds_resources_locator.get());
+    }
+    clusterManager().setPrimaryClustersInitializedCb(
+        [this]() { clusterManager().initializeSecondaryClusters(bootstrap_); });
+  }
   clusterManager().setInitializedCb([this]() -> void { init_manager_.initialize(init_watcher_); });
 }
 
+bool ValidationInstance::writeConfigProfile(const std::string& path) const {
+  envoy::admin::v3::ConfigMemory profile;
+  admin_->configMemoryTracker().dump(profile);
+  ConfigMemoryTrackerImpl::addSecrets(secret_manager_->secretsAllocatedBytes(), profile);
+  const std::string profile_json =
+      MessageUtil::getJsonStringFromMessageOrError(profile, true, true);
+
+  static constexpr Filesystem::FlagSet DefaultFlags{1 << Filesystem::File::Operation::Write |
+                                                    1 << Filesystem::File::Operation::Create};
+  Filesystem::FilePtr file =
+      api_->fileSystem().createFile({Filesystem::DestinationType::File, path});
+  const Api::IoCallBoolResult open_result = file->open(DefaultFlags);
+  if (!open_result.ok()) {
+    std::cerr << fmt::format("cannot open config profile output file {}: {}", path,
+                             open_result.err_->getErrorDetails())
+              << std::endl;
+    return false;
+  }
+  const Api::IoCallSizeResult write_result = file->write(profile_json);
+  if (!write_result.ok()) {
+    std::cerr << fmt::format("cannot write config profile output file {}: {}", path,
+                             write_result.err_->getErrorDetails())
+              << std::endl;
+    return false;
+  }
+  if (static_cast<size_t>(write_result.return_value_) != profile_json.size()) {
+    std::cerr << fmt::format("cannot write config profile output file {}: wrote {} of {} bytes",
+                             path, write_result.return_value_, profile_json.size())
+              << std::endl;
+    return false;
+  }
+  const Api::IoCallBoolResult close_result = file->close();
+  if (!close_result.ok()) {
+    std::cerr << fmt::format("cannot close config profile output file {}: {}", path,
+                             close_result.err_->getErrorDetails())
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
 void ValidationInstance::shutdown() {
   // This normally happens at the bottom of InstanceImpl::run(), but we don't have a run(). We can
   // do an abbreviated shutdown here since there's less to clean up -- for example, no workers to
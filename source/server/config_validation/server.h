@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "envoy/common/regex.h"
 #include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/core/v3/config_source.pb.h"
 #include "envoy/config/listener/v3/listener.pb.h"
@@ -29,6 +30,7 @@
 #include "source/server/config_validation/api.h"
 #include "source/server/config_validation/cluster_manager.h"
 #include "source/server/config_validation/dns.h"
+#include "source/server/config_validation/snapshot_subscription.h"
 #include "source/server/listener_manager_impl.h"
 #include "source/server/server.h"
 
@@ -193,6 +195,13 @@ public:
     return nullptr;
   }
 
+  /**
+   * Write the time and memory it took to build each resource, as a JSON ConfigMemory message.
+   * @param path supplies the path of the file to write.
+   * @return bool whether the file was written. The reason it was not is printed on stderr.
+   */
+  bool writeConfigProfile(const std::string& path) const;
+
 private:
   void initialize(const Options& options,
                   const Network::Address::InstanceConstSharedPtr& local_address,
@@ -222,6 +231,9 @@ private:
   std::unique_ptr<Runtime::Loader> runtime_;
   Random::RandomGeneratorImpl random_generator_;
   std::unique_ptr<Ssl::ContextManager> ssl_context_manager_;
+  Regex::EnginePtr regex_engine_;
+  // snapshot_subscription_factory_ must outlive the cluster manager in config_, which uses it.
+  std::unique_ptr<Config::SnapshotSubscriptionFactory> snapshot_subscription_factory_;
   Configuration::MainImpl config_;
   LocalInfo::LocalInfoPtr local_info_;
   AccessLog::AccessLogManagerImpl access_log_manager_;
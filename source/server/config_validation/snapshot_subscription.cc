@@ -0,0 +1,145 @@
+#include "source/server/config_validation/snapshot_subscription.h"
+
+#include "source/common/common/fmt.h"
+#include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/filesystem_subscription_impl.h"
+#include "source/common/config/utility.h"
+#include "source/common/config/xds_resource.h"
+#include "source/common/filesystem/directory.h"
+#include "source/common/http/utility.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Config {
+
+SnapshotSubscriptionFactory::SnapshotSubscriptionFactory(
+    const std::string& snapshot_dir, Event::Dispatcher& dispatcher,
+    ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api)
+    : dispatcher_(dispatcher), validation_visitor_(validation_visitor), api_(api) {
+  Filesystem::Directory directory(snapshot_dir);
+  for (const Filesystem::DirectoryEntry& entry : directory) {
+    if (entry.type_ != Filesystem::FileType::Regular) {
+      continue;
+    }
+    const std::string path = snapshot_dir + "/" + entry.name_;
+    envoy::service::discovery::v3::DiscoveryResponse response;
+    MessageUtil::loadFromFile(path, response, validation_visitor_, api_);
+    if (response.type_url().empty()) {
+      throw EnvoyException(fmt::format("xDS snapshot file {} has no type_url", path));
+    }
+    const std::string type_url = response.type_url();
+    if (!responses_.try_emplace(type_url, std::move(response)).second) {
+      throw EnvoyException(
+          fmt::format("xDS snapshot {} has more than one response for {}", snapshot_dir, type_url));
+    }
+    ENVOY_LOG(debug, "loaded xDS snapshot of {} from {}", type_url, path);
+  }
+}
+
+SubscriptionPtr SnapshotSubscriptionFactory::subscriptionFromConfigSource(
+    const envoy::config::core::v3::ConfigSource& config, absl::string_view type_url,
+    Stats::Scope& scope, SubscriptionCallbacks& callbacks, OpaqueResourceDecoder& resource_decoder,
+    const SubscriptionOptions&) {
+  SubscriptionStats stats = Utility::generateStats(scope);
+
+  switch (config.config_source_specifier_case()) {
+  case envoy::config::core::v3::ConfigSource::ConfigSourceSpecifierCase::kPath: {
+    Utility::checkFilesystemSubscriptionBackingPath(config.path(), api_);
+    return std::make_unique<FilesystemSubscriptionImpl>(
+        dispatcher_, makePathConfigSource(config.path()), callbacks, resource_decoder, stats,
+        validation_visitor_, api_);
+  }
+  case envoy::config::core::v3::ConfigSource::ConfigSourceSpecifierCase::kPathConfigSource: {
+    Utility::checkFilesystemSubscriptionBackingPath(config.path_config_source().path(), api_);
+    return std::make_unique<FilesystemSubscriptionImpl>(dispatcher_, config.path_config_source(),
+                                                        callbacks, resource_decoder, stats,
+                                                        validation_visitor_, api_);
+  }
+  case envoy::config::core::v3::ConfigSource::ConfigSourceSpecifierCase::kApiConfigSource:
+  case envoy::config::core::v3::ConfigSource::ConfigSourceSpecifierCase::kAds:
+    return snapshotSubscription(type_url, stats, callbacks, resource_decoder);
+  default:
+    throw EnvoyException(
+        "Missing config source specifier in envoy::config::core::v3::ConfigSource");
+  }
+}
+
+SubscriptionPtr SnapshotSubscriptionFactory::collectionSubscriptionFromUrl(
+    const xds::core::v3::ResourceLocator& collection_locator,
+    const envoy::config::core::v3::ConfigSource&, absl::string_view resource_type,
+    Stats::Scope& scope, SubscriptionCallbacks& callbacks,
+    OpaqueResourceDecoder& resource_decoder) {
+  SubscriptionStats stats = Utility::generateStats(scope);
+
+  switch (collection_locator.scheme()) {
+  case xds::core::v3::ResourceLocator::FILE: {
+    const std::string path = Http::Utility::localPathFromFilePath(collection_locator.id());
+    Utility::checkFilesystemSubscriptionBackingPath(path, api_);
+    return std::make_unique<FilesystemCollectionSubscriptionImpl>(
+        dispatcher_, makePathConfigSource(path), callbacks, resource_decoder, stats,
+        validation_visitor_, api_);
+  }
+  case xds::core::v3::ResourceLocator::XDSTP: {
+    if (resource_type != collection_locator.resource_type()) {
+      throw EnvoyException(
+          fmt::format("xdstp:// type does not match {} in {}", resource_type,
+                      Config::XdsResourceIdentifier::encodeUrl(collection_locator)));
+    }
+    return snapshotSubscription(TypeUtil::descriptorFullNameToTypeUrl(resource_type), stats,
+                                callbacks, resource_decoder);
+  }
+  default:
+    throw EnvoyException(fmt::format("Unsupported collection resource locator: {}",
+                                     Config::XdsResourceIdentifier::encodeUrl(collection_locator)));
+  }
+}
+
+SubscriptionPtr
+SnapshotSubscriptionFactory::snapshotSubscription(absl::string_view type_url,
+                                                  SubscriptionStats stats,
+                                                  SubscriptionCallbacks& callbacks,
+                                                  OpaqueResourceDecoder& resource_decoder) const {
+  const auto it = responses_.find(type_url);
+  return std::make_unique<SnapshotSubscription>(it != responses_.end() ? &it->second : nullptr,
+                                                type_url, callbacks, resource_decoder, stats);
+}
+
+void SnapshotSubscription::start(const absl::flat_hash_set<std::string>& resource_names) {
+  started_ = true;
+  deliver(resource_names);
+}
+
+void SnapshotSubscription::updateResourceInterest(
+    const absl::flat_hash_set<std::string>& resource_names) {
+  if (started_) {
+    deliver(resource_names);
+  }
+}
+
+void SnapshotSubscription::deliver(const absl::flat_hash_set<std::string>& resource_names) {
+  stats_.update_attempt_.inc();
+  if (response_ == nullptr) {
+    // Like a management server which never answers, until the initial fetch times out.
+    ENVOY_LOG(warn, "xDS snapshot has no response for {}", type_url_);
+    callbacks_.onConfigUpdateFailed(ConfigUpdateFailureReason::FetchTimedout, nullptr);
+    return;
+  }
+
+  DecodedResourcesWrapper decoded_resources;
+  for (const auto& resource : response_->resources()) {
+    DecodedResourceImplPtr decoded_resource =
+        DecodedResourceImpl::fromResource(resource_decoder_, resource, response_->version_info());
+    // An empty interest is a wildcard subscription.
+    if (resource_names.empty() || resource_names.contains(decoded_resource->name())) {
+      decoded_resources.pushBack(std::move(decoded_resource));
+    }
+  }
+  // A rejected resource is not caught here, unlike by the subscriptions of the server, so that it
+  // fails the validation.
+  callbacks_.onConfigUpdate(decoded_resources.refvec_, response_->version_info());
+  stats_.update_success_.inc();
+  stats_.version_text_.set(response_->version_info());
+}
+
+} // namespace Config
+} // namespace Envoy
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/api/api.h"
+#include "envoy/config/core/v3/config_source.pb.h"
+#include "envoy/config/subscription.h"
+#include "envoy/config/subscription_factory.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/protobuf/message_validator.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Config {
+
+/**
+ * Config-validation-only implementation of SubscriptionFactory, which serves the subscriptions of
+ * a configuration from a snapshot of its management server instead of connecting to it. The
+ * snapshot is a directory holding one DiscoveryResponse per resource type, in any format read by
+ * MessageUtil::loadFromFile(). Subscriptions to local files are served from those files, as they
+ * are by the server.
+ */
+class SnapshotSubscriptionFactory : public SubscriptionFactory,
+                                    Logger::Loggable<Logger::Id::config> {
+public:
+  /**
+   * @param snapshot_dir the directory holding the snapshot.
+   * @throw EnvoyException if the snapshot cannot be read, or holds two responses for a type.
+   */
+  SnapshotSubscriptionFactory(const std::string& snapshot_dir, Event::Dispatcher& dispatcher,
+                              ProtobufMessage::ValidationVisitor& validation_visitor,
+                              Api::Api& api);
+
+  // Config::SubscriptionFactory
+  SubscriptionPtr subscriptionFromConfigSource(const envoy::config::core::v3::ConfigSource& config,
+                                               absl::string_view type_url, Stats::Scope& scope,
+                                               SubscriptionCallbacks& callbacks,
+                                               OpaqueResourceDecoder& resource_decoder,
+                                               const SubscriptionOptions& options) override;
+  SubscriptionPtr
+  collectionSubscriptionFromUrl(const xds::core::v3::ResourceLocator& collection_locator,
+                                const envoy::config::core::v3::ConfigSource& config,
+                                absl::string_view resource_type, Stats::Scope& scope,
+                                SubscriptionCallbacks& callbacks,
+                                OpaqueResourceDecoder& resource_decoder) override;
+
+private:
+  SubscriptionPtr snapshotSubscription(absl::string_view type_url, SubscriptionStats stats,
+                                       SubscriptionCallbacks& callbacks,
+                                       OpaqueResourceDecoder& resource_decoder) const;
+
+  Event::Dispatcher& dispatcher_;
+  ProtobufMessage::ValidationVisitor& validation_visitor_;
+  Api::Api& api_;
+  // The response of the snapshot for each type URL.
+  absl::flat_hash_map<std::string, envoy::service::discovery::v3::DiscoveryResponse> responses_;
+};
+
+/**
+ * Subscription served by a SnapshotSubscriptionFactory. When it starts, and whenever its interest
+ * changes, it delivers the resources of the snapshot which it is interested in, as the management
+ * server would answer its request.
+ */
+class SnapshotSubscription : public Subscription, Logger::Loggable<Logger::Id::config> {
+public:
+  /**
+   * @param response the response of the snapshot for the type of the subscription, or nullptr if
+   *        the snapshot has none.
+   */
+  SnapshotSubscription(const envoy::service::discovery::v3::DiscoveryResponse* response,
+                       absl::string_view type_url, SubscriptionCallbacks& callbacks,
+                       OpaqueResourceDecoder& resource_decoder, SubscriptionStats stats)
+      : response_(response), type_url_(type_url), callbacks_(callbacks),
+        resource_decoder_(resource_decoder), stats_(stats) {}
+
+  // Config::Subscription
+  void start(const absl::flat_hash_set<std::string>& resource_names) override;
+  void updateResourceInterest(const absl::flat_hash_set<std::string>& resource_names) override;
+  void requestOnDemandUpdate(const absl::flat_hash_set<std::string>&) override {
+    ENVOY_BUG(false, "unexpected request for on demand update");
+  }
+
+private:
+  void deliver(const absl::flat_hash_set<std::string>& resource_names);
+
+  const envoy::service::discovery::v3::DiscoveryResponse* const response_;
+  const std::string type_url_;
+  SubscriptionCallbacks& callbacks_;
+  OpaqueResourceDecoder& resource_decoder_;
+  SubscriptionStats stats_;
+  bool started_{};
+};
+
+} // namespace Config
+} // namespace Envoy
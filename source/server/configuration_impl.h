@@ -54,6 +54,8 @@ public:
   const std::list<Stats::SinkPtr>& sinks() const override { return sinks_; }
   std::chrono::milliseconds flushInterval() const override { return flush_interval_; }
   bool flushOnAdmin() const override { return flush_on_admin_; }
+  bool flushChangedOnly() const override { return flush_changed_only_; }
+  bool flushOnDedicatedThread() const override { return flush_on_dedicated_thread_; }
 
   void addSink(Stats::SinkPtr sink) { sinks_.emplace_back(std::move(sink)); }
 
@@ -61,6 +63,8 @@ private:
   std::list<Stats::SinkPtr> sinks_;
   std::chrono::milliseconds flush_interval_;
   bool flush_on_admin_{false};
+  const bool flush_changed_only_;
+  const bool flush_on_dedicated_thread_;
 };
 
 /**
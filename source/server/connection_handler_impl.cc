@@ -85,12 +85,13 @@ void ConnectionHandlerImpl::addListener(absl::optional<uint64_t> overridden_list
     for (auto& socket_factory : config.listenSocketFactories()) {
       auto address = socket_factory->localAddress();
       // worker_index_ doesn't have a value on the main thread for the admin server.
-      details->addActiveListener(
-          config, address, listener_reject_fraction_, disable_listeners_,
-          std::make_unique<ActiveTcpListener>(
-              *this, config, runtime,
-              socket_factory->getListenSocket(worker_index_.has_value() ? *worker_index_ : 0),
-              address, config.connectionBalancer(*address)));
+      auto tcp_listener = std::make_unique<ActiveTcpListener>(
+          *this, config, runtime,
+          socket_factory->getListenSocket(worker_index_.has_value() ? *worker_index_ : 0), address,
+          config.connectionBalancer(*address));
+      tcp_listener->setBufferLimitScale(buffer_limit_scale_);
+      details->addActiveListener(config, address, listener_reject_fraction_, disable_listeners_,
+                                 std::move(tcp_listener));
     }
   } else {
     ASSERT(config.udpListenerConfig().has_value(), "UDP listener factory is not initialized.");
@@ -285,6 +286,17 @@ void ConnectionHandlerImpl::setListenerRejectFraction(UnitFloat reject_fraction)
   }
 }
 
+void ConnectionHandlerImpl::setConnectionBufferLimitScale(UnitFloat scale) {
+  buffer_limit_scale_ = scale;
+  for (auto& iter : listener_map_by_tag_) {
+    for (auto& details : iter.second->per_address_details_list_) {
+      if (auto tcp_listener = details->tcpListener(); tcp_listener.has_value()) {
+        tcp_listener->get().setBufferLimitScale(scale);
+      }
+    }
+  }
+}
+
 Network::InternalListenerOptRef
 ConnectionHandlerImpl::findByAddress(const Network::Address::InstanceConstSharedPtr& address) {
   ASSERT(address->type() == Network::Address::Type::EnvoyInternal);
@@ -54,6 +54,7 @@ public:
   void disableListeners() override;
   void enableListeners() override;
   void setListenerRejectFraction(UnitFloat reject_fraction) override;
+  void setConnectionBufferLimitScale(UnitFloat scale) override;
   const std::string& statPrefix() const override { return per_handler_stat_prefix_; }
 
   // Network::TcpConnectionHandler
@@ -143,6 +144,7 @@ private:
   std::atomic<uint64_t> num_handler_connections_{};
   bool disable_listeners_;
   UnitFloat listener_reject_fraction_{UnitFloat::min()};
+  UnitFloat buffer_limit_scale_{UnitFloat::max()};
 };
 
 } // namespace Server
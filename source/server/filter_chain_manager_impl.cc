@@ -11,6 +11,7 @@
 #include "source/common/network/matching/inputs.h"
 #include "source/common/network/socket_interface.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/server/configuration_impl.h"
 
 #include "absl/container/node_hash_map.h"
@@ -22,6 +23,19 @@ namespace Server {
 
 namespace {
 
+// The transport socket factory of a filter chain is built from its transport socket and its server
+// names only.
+envoy::config::listener::v3::FilterChain
+transportSocketFactoryKey(const envoy::config::listener::v3::FilterChain& filter_chain) {
+  envoy::config::listener::v3::FilterChain key;
+  if (filter_chain.has_transport_socket()) {
+    *key.mutable_transport_socket() = filter_chain.transport_socket();
+  }
+  *key.mutable_filter_chain_match()->mutable_server_names() =
+      filter_chain.filter_chain_match().server_names();
+  return key;
+}
+
 // Return a fake address for use when either the source or destination is unix domain socket.
 // This address will only match the fallback matcher of 0.0.0.0/0, which is the default
 // when no IP matcher is configured.
@@ -345,6 +359,7 @@ void FilterChainManagerImpl::copyOrRebuildDefaultFilterChain(
   if (origin->default_filter_chain_message_.has_value() &&
       eq(origin->default_filter_chain_message_.value(), *default_filter_chain)) {
     default_filter_chain_ = origin->default_filter_chain_;
+    findTransportSocketFactory(transportSocketFactoryKey(*default_filter_chain));
   } else {
     default_filter_chain_ =
         filter_chain_factory_builder.buildFilterChain(*default_filter_chain, context_creator);
@@ -829,11 +844,50 @@ Network::DrainableFilterChainSharedPtr FilterChainManagerImpl::findExistingFilte
   if (iter != origin->fc_contexts_.end()) {
     // copy the context to this filter chain manager.
     fc_contexts_.emplace(filter_chain_message, iter->second);
+    // Keep the transport socket factory of the filter chain shareable by the next generations.
+    findTransportSocketFactory(transportSocketFactoryKey(filter_chain_message));
     return iter->second;
   }
   return nullptr;
 }
 
+Network::DownstreamTransportSocketFactorySharedPtr
+FilterChainManagerImpl::getOrCreateTransportSocketFactory(
+    const envoy::config::listener::v3::FilterChain& filter_chain,
+    const std::function<Network::DownstreamTransportSocketFactoryPtr()>& create_factory) {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.share_transport_socket_factories")) {
+    return create_factory();
+  }
+  envoy::config::listener::v3::FilterChain key = transportSocketFactoryKey(filter_chain);
+  Network::DownstreamTransportSocketFactorySharedPtr factory = findTransportSocketFactory(key);
+  if (factory == nullptr) {
+    factory = create_factory();
+    transport_socket_factories_.emplace(std::move(key), factory);
+  }
+  return factory;
+}
+
+Network::DownstreamTransportSocketFactorySharedPtr
+FilterChainManagerImpl::findTransportSocketFactory(
+    const envoy::config::listener::v3::FilterChain& key) {
+  auto iter = transport_socket_factories_.find(key);
+  if (iter != transport_socket_factories_.end()) {
+    return iter->second;
+  }
+  // Origin filter chain manager could be empty if the current is the ancestor.
+  const auto* origin = getOriginFilterChainManager();
+  if (origin == nullptr) {
+    return nullptr;
+  }
+  iter = origin->transport_socket_factories_.find(key);
+  if (iter == origin->transport_socket_factories_.end()) {
+    return nullptr;
+  }
+  transport_socket_factories_.emplace(key, iter->second);
+  return iter->second;
+}
+
 Configuration::FilterChainFactoryContextPtr FilterChainManagerImpl::createFilterChainFactoryContext(
     const ::envoy::config::listener::v3::FilterChain* const filter_chain) {
   // TODO(lambdai): add stats
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "envoy/config/listener/v3/listener_components.pb.h"
@@ -102,7 +103,7 @@ private:
 
 class FilterChainImpl : public Network::DrainableFilterChain {
 public:
-  FilterChainImpl(Network::DownstreamTransportSocketFactoryPtr&& transport_socket_factory,
+  FilterChainImpl(Network::DownstreamTransportSocketFactorySharedPtr transport_socket_factory,
                   std::vector<Network::FilterFactoryCb>&& filters_factory,
                   std::chrono::milliseconds transport_socket_connect_timeout,
                   absl::string_view name)
@@ -132,7 +133,7 @@ public:
 
 private:
   Configuration::FilterChainFactoryContextPtr factory_context_;
-  const Network::DownstreamTransportSocketFactoryPtr transport_socket_factory_;
+  const Network::DownstreamTransportSocketFactorySharedPtr transport_socket_factory_;
   const std::vector<Network::FilterFactoryCb> filters_factory_;
   const std::chrono::milliseconds transport_socket_connect_timeout_;
   const std::string name_;
@@ -227,6 +228,15 @@ public:
 
   static bool isWildcardServerName(const std::string& name);
 
+  // Return the transport socket factory of a filter chain which is being added. Filter chains with
+  // the same transport socket config and server names share one factory, which is also taken over
+  // from the origin filter chain manager, so that an in place update does not build a new TLS
+  // context for a changed filter chain whose transport socket did not change. Otherwise the
+  // factory is built by create_factory.
+  Network::DownstreamTransportSocketFactorySharedPtr getOrCreateTransportSocketFactory(
+      const envoy::config::listener::v3::FilterChain& filter_chain,
+      const std::function<Network::DownstreamTransportSocketFactoryPtr()>& create_factory);
+
   // Return the current view of filter chains, keyed by filter chain message. Used by the owning
   // listener to calculate the intersection of filter chains with another listener.
   const FcContextMap& filterChainsByMessage() const { return fc_contexts_; }
@@ -365,11 +375,21 @@ private:
   // Duplicate the inherent factory context if any.
   Network::DrainableFilterChainSharedPtr
   findExistingFilterChain(const envoy::config::listener::v3::FilterChain& filter_chain_message);
+  // Find the shared transport socket factory for the key in this filter chain manager or in the
+  // origin filter chain manager, in which case it is copied to this filter chain manager.
+  Network::DownstreamTransportSocketFactorySharedPtr
+  findTransportSocketFactory(const envoy::config::listener::v3::FilterChain& key);
 
   // Mapping from filter chain message to filter chain. This is used by LDS response handler to
   // detect the filter chains in the intersection of existing listener and new listener.
   FcContextMap fc_contexts_;
 
+  // Shared transport socket factories, keyed by a filter chain message which only holds the
+  // transport socket and the server names of the filter chains using the factory.
+  absl::flat_hash_map<envoy::config::listener::v3::FilterChain,
+                      Network::DownstreamTransportSocketFactorySharedPtr, MessageUtil, MessageUtil>
+      transport_socket_factories_;
+
   absl::optional<envoy::config::listener::v3::FilterChain> default_filter_chain_message_;
   // The optional fallback filter chain if destination_ports_map_ does not find a matched filter
   // chain.
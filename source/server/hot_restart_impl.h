@@ -21,7 +21,7 @@ namespace Server {
 
 // Increment this whenever there is a shared memory / RPC change that will prevent a hot restart
 // from working. Operations code can then cope with this and do a full restart.
-const uint64_t HOT_RESTART_VERSION = 11;
+const uint64_t HOT_RESTART_VERSION = 12;
 
 /**
  * Shared memory segment. This structure is laid directly into shared memory and is used amongst
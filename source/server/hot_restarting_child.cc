@@ -36,13 +36,13 @@ int HotRestartingChild::duplicateParentListenSocket(const std::string& address,
   return wrapped_reply->reply().pass_listen_socket().fd();
 }
 
-std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats() {
+std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats(bool stats_in_reply) {
   if (restart_epoch_ == 0 || parent_terminated_) {
     return nullptr;
   }
 
   HotRestartMessage wrapped_request;
-  wrapped_request.mutable_request()->mutable_stats();
+  wrapped_request.mutable_request()->mutable_stats()->set_stats_in_reply(stats_in_reply);
   sendHotRestartMessage(parent_address_, wrapped_request);
 
   std::unique_ptr<HotRestartMessage> wrapped_reply = receiveHotRestartMessage(Blocking::Yes);
@@ -109,17 +109,53 @@ void HotRestartingChild::mergeParentStats(Stats::Store& stats_store,
     hot_restart_generation_stat_name_ = hotRestartGeneration(stats_store).statName();
   }
 
-  // Convert the protobuf for serialized dynamic spans into the structure
-  // required by StatMerger.
-  Stats::StatMerger::DynamicsMap dynamics;
-  for (const auto& iter : stats_proto.dynamics()) {
-    Stats::DynamicSpans& spans = dynamics[iter.first];
-    for (int i = 0; i < iter.second.spans_size(); ++i) {
-      const HotRestartMessage::Reply::Span& span_proto = iter.second.spans(i);
-      spans.push_back(Stats::DynamicSpan(span_proto.first(), span_proto.last()));
+  if (!stats_proto.counter_deltas().empty() || !stats_proto.gauges().empty()) {
+    // Convert the protobuf for serialized dynamic spans into the structure
+    // required by StatMerger.
+    Stats::StatMerger::DynamicsMap dynamics;
+    for (const auto& iter : stats_proto.dynamics()) {
+      Stats::DynamicSpans& spans = dynamics[iter.first];
+      for (int i = 0; i < iter.second.spans_size(); ++i) {
+        const HotRestartMessage::Reply::Span& span_proto = iter.second.spans(i);
+        spans.push_back(Stats::DynamicSpan(span_proto.first(), span_proto.last()));
+      }
     }
+    stat_merger_->mergeStats(stats_proto.counter_deltas(), stats_proto.gauges(), dynamics);
+  }
+
+  if (stats_proto.stats_shared_memory_name().empty()) {
+    return;
+  }
+  // The parent encodes stat names token by token, with each distinct token stored once, so that
+  // merging costs one symbol table lookup per distinct token rather than a parse of every name.
+  bool decoded = false;
+  const bool mapped = consumeStatsFromSharedMemory(
+      stats_proto.stats_shared_memory_name(), stats_proto.stats_shared_memory_size(),
+      [this, &stats_store, &decoded](absl::Span<const uint8_t> data) {
+        decoded = HotRestartStatsReader::read(
+            data, stats_store.symbolTable(),
+            [this](HotRestartStatKind kind, Stats::StatName stat_name, uint64_t value) {
+              if (kind == HotRestartStatKind::Counter) {
+                stat_merger_->mergeCounter(stat_name, value);
+              } else {
+                stat_merger_->mergeGauge(stat_name, value);
+              }
+            });
+      });
+  if (!mapped) {
+    // The region is left in place, so the parent can send its stats in the reply instead.
+    ENVOY_LOG(error,
+              "failed to map hot restart stats shared memory region {} of {} bytes; asking the "
+              "parent to send the stats in the reply",
+              stats_proto.stats_shared_memory_name(), stats_proto.stats_shared_memory_size());
+    std::unique_ptr<HotRestartMessage> wrapped_reply = getParentStats(true);
+    if (wrapped_reply != nullptr) {
+      mergeParentStats(stats_store, wrapped_reply->reply().stats());
+    }
+  } else if (!decoded) {
+    ENVOY_LOG(error, "hot restart stats shared memory region {} is malformed",
+              stats_proto.stats_shared_memory_name());
   }
-  stat_merger_->mergeStats(stats_proto.counter_deltas(), stats_proto.gauges(), dynamics);
 }
 
 } // namespace Server
@@ -2,6 +2,7 @@
 
 #include "source/common/stats/stat_merger.h"
 #include "source/server/hot_restarting_base.h"
+#include "source/server/hot_restarting_stats.h"
 
 namespace Envoy {
 namespace Server {
@@ -15,7 +16,9 @@ public:
                      mode_t socket_mode);
 
   int duplicateParentListenSocket(const std::string& address, uint32_t worker_index);
-  std::unique_ptr<envoy::HotRestartMessage> getParentStats();
+  // 'stats_in_reply' asks the parent to send the stats in the reply rather than through shared
+  // memory.
+  std::unique_ptr<envoy::HotRestartMessage> getParentStats(bool stats_in_reply = false);
   void drainParentListeners();
   absl::optional<HotRestart::AdminShutdownResponse> sendParentAdminShutdownRequest();
   void sendParentTerminateRequest();
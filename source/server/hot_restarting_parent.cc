@@ -2,9 +2,10 @@
 
 #include "envoy/server/instance.h"
 
+#include "source/common/api/os_sys_calls_impl_hot_restart.h"
+#include "source/common/common/fmt.h"
 #include "source/common/memory/stats.h"
 #include "source/common/network/utility.h"
-#include "source/common/stats/stat_merger.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
 #include "source/server/listener_impl.h"
@@ -16,7 +17,9 @@ using HotRestartMessage = envoy::HotRestartMessage;
 
 HotRestartingParent::HotRestartingParent(int base_id, int restart_epoch,
                                          const std::string& socket_path, mode_t socket_mode)
-    : HotRestartingBase(base_id), restart_epoch_(restart_epoch) {
+    : HotRestartingBase(base_id), restart_epoch_(restart_epoch),
+      stats_shared_memory_name_(
+          fmt::format("/envoy_hot_restart_stats_{}_{}", base_id, restart_epoch)) {
   child_address_ = createDomainSocketAddress(restart_epoch_ + 1, "child", socket_path, socket_mode);
   bindDomainSocket(restart_epoch_, "parent", socket_path, socket_mode);
 }
@@ -29,7 +32,7 @@ void HotRestartingParent::initialize(Event::Dispatcher& dispatcher, Server::Inst
         onSocketEvent();
       },
       Event::FileTriggerType::Edge, Event::FileReadyType::Read);
-  internal_ = std::make_unique<Internal>(&server);
+  internal_ = std::make_unique<Internal>(&server, stats_shared_memory_name_);
 }
 
 void HotRestartingParent::onSocketEvent() {
@@ -56,7 +59,8 @@ void HotRestartingParent::onSocketEvent() {
 
     case HotRestartMessage::Request::kStats: {
       HotRestartMessage wrapped_reply;
-      internal_->exportStatsToChild(wrapped_reply.mutable_reply()->mutable_stats());
+      internal_->exportStatsToChild(wrapped_request->request().stats(),
+                                    wrapped_reply.mutable_reply()->mutable_stats());
       sendHotRestartMessage(child_address_, wrapped_reply);
       break;
     }
@@ -85,11 +89,19 @@ void HotRestartingParent::onSocketEvent() {
 
 void HotRestartingParent::shutdown() { socket_event_.reset(); }
 
-HotRestartingParent::Internal::Internal(Server::Instance* server) : server_(server) {
+HotRestartingParent::Internal::Internal(Server::Instance* server,
+                                        const std::string& stats_shared_memory_name)
+    : server_(server), stats_shared_memory_name_(stats_shared_memory_name) {
   Stats::Gauge& hot_restart_generation = hotRestartGeneration(server->stats());
   hot_restart_generation.inc();
 }
 
+HotRestartingParent::Internal::~Internal() {
+  // The child unlinks each region it consumes, so this only matters if the child went away
+  // before consuming the last one.
+  Api::HotRestartOsSysCallsSingleton::get().shmUnlink(stats_shared_memory_name_.c_str());
+}
+
 HotRestartMessage HotRestartingParent::Internal::shutdownAdmin() {
   server_->shutdownAdmin();
   HotRestartMessage wrapped_reply;
@@ -131,35 +143,87 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
   return wrapped_reply;
 }
 
-// TODO(fredlas) if there are enough stats for stat name length to become an issue, this current
-// implementation can negate the benefit of symbolized stat names by periodically reaching the
-// magnitude of memory usage that they are meant to avoid, since this map holds full-string
-// names. The problem can be solved by splitting the export up over many chunks.
-void HotRestartingParent::Internal::exportStatsToChild(HotRestartMessage::Reply::Stats* stats) {
-  server_->stats().forEachSinkedGauge(nullptr, [this, stats](Stats::Gauge& gauge) mutable {
+// Stats are handed over through a shared memory region rather than in the reply itself, with stat
+// names encoded as indexes into a table of their distinct tokens. This keeps the reply small, and
+// avoids elaborating every stat name into a string, however many stats there are. The reply only
+// carries the stats when the region cannot be used.
+void HotRestartingParent::Internal::exportStatsToChild(
+    const HotRestartMessage::Request::Stats& request, HotRestartMessage::Reply::Stats* stats) {
+  HotRestartStatsWriter writer(server_->stats().symbolTable());
+  server_->stats().forEachSinkedGauge(nullptr, [&writer](Stats::Gauge& gauge) {
     if (gauge.used()) {
-      const std::string name = gauge.name();
-      (*stats->mutable_gauges())[name] = gauge.value();
-      recordDynamics(stats, name, gauge.statName());
+      writer.add(HotRestartStatKind::Gauge, gauge.statName(), gauge.value());
     }
   });
 
-  server_->stats().forEachSinkedCounter(nullptr, [this, stats](Stats::Counter& counter) mutable {
+  server_->stats().forEachSinkedCounter(nullptr, [&writer](Stats::Counter& counter) {
     if (counter.used()) {
       // The hot restart parent is expected to have stopped its normal stat exporting (and so
       // latching) by the time it begins exporting to the hot restart child.
       uint64_t latched_value = counter.latch();
       if (latched_value > 0) {
-        const std::string name = counter.name();
-        (*stats->mutable_counter_deltas())[name] = latched_value;
-        recordDynamics(stats, name, counter.statName());
+        writer.add(HotRestartStatKind::Counter, counter.statName(), latched_value);
       }
     }
   });
+
+  bool in_reply = request.stats_in_reply();
+  if (in_reply) {
+    // The counter deltas of the region the child could not map have already been latched, so they
+    // are read back and sent along with the new ones.
+    if (stats_shared_memory_size_ > 0 &&
+        !consumeStatsFromSharedMemory(stats_shared_memory_name_, stats_shared_memory_size_,
+                                      [this, stats](absl::Span<const uint8_t> data) {
+                                        addStatsToReply(data, stats);
+                                      })) {
+      ENVOY_LOG(error, "failed to read back hot restart stats shared memory region {}",
+                stats_shared_memory_name_);
+      Api::HotRestartOsSysCallsSingleton::get().shmUnlink(stats_shared_memory_name_.c_str());
+    }
+    stats_shared_memory_size_ = 0;
+  } else {
+    const absl::optional<uint64_t> size =
+        publishStatsToSharedMemory(stats_shared_memory_name_, writer);
+    if (size.has_value()) {
+      stats->set_stats_shared_memory_name(stats_shared_memory_name_);
+      stats->set_stats_shared_memory_size(size.value());
+      stats_shared_memory_size_ = size.value();
+    } else {
+      ENVOY_LOG(error,
+                "failed to export {} stats to the child through shared memory region {}; sending "
+                "them in the reply",
+                writer.numStats(), stats_shared_memory_name_);
+      stats_shared_memory_size_ = 0;
+      in_reply = true;
+    }
+  }
+  if (in_reply) {
+    std::vector<uint8_t> data(writer.byteSize());
+    writer.write(absl::MakeSpan(data));
+    addStatsToReply(data, stats);
+  }
   stats->set_memory_allocated(Memory::Stats::totalCurrentlyAllocated());
   stats->set_num_connections(server_->listenerManager().numConnections());
 }
 
+void HotRestartingParent::Internal::addStatsToReply(absl::Span<const uint8_t> data,
+                                                    HotRestartMessage::Reply::Stats* stats) {
+  Stats::SymbolTable& symbol_table = server_->stats().symbolTable();
+  // The encoding was written by this process, so it is well formed.
+  HotRestartStatsReader::read(
+      data, symbol_table,
+      [this, stats, &symbol_table](HotRestartStatKind kind, Stats::StatName stat_name,
+                                   uint64_t value) {
+        const std::string name = symbol_table.toString(stat_name);
+        if (kind == HotRestartStatKind::Counter) {
+          (*stats->mutable_counter_deltas())[name] += value;
+        } else {
+          (*stats->mutable_gauges())[name] = value;
+        }
+        recordDynamics(stats, name, stat_name);
+      });
+}
+
 void HotRestartingParent::Internal::recordDynamics(HotRestartMessage::Reply::Stats* stats,
                                                    const std::string& name,
                                                    Stats::StatName stat_name) {
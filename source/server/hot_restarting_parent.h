@@ -2,6 +2,7 @@
 
 #include "source/common/common/hash.h"
 #include "source/server/hot_restarting_base.h"
+#include "source/server/hot_restarting_stats.h"
 
 namespace Envoy {
 namespace Server {
@@ -20,28 +21,42 @@ public:
 
   // The hot restarting parent's hot restart logic. Each function is meant to be called to fulfill a
   // request from the child for that action.
-  class Internal {
+  class Internal : public Logger::Loggable<Logger::Id::main> {
   public:
-    explicit Internal(Server::Instance* server);
+    // 'stats_shared_memory_name' names the shared memory region that stats are exported to the
+    // child through.
+    Internal(Server::Instance* server, const std::string& stats_shared_memory_name);
+    ~Internal();
     // Return value is the response to return to the child.
     envoy::HotRestartMessage shutdownAdmin();
     // Return value is the response to return to the child.
     envoy::HotRestartMessage
     getListenSocketsForChild(const envoy::HotRestartMessage::Request& request);
     // 'stats' is a field in the reply protobuf to be sent to the child, which we should populate.
-    void exportStatsToChild(envoy::HotRestartMessage::Reply::Stats* stats);
-    void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
-                        Stats::StatName stat_name);
+    void exportStatsToChild(const envoy::HotRestartMessage::Request::Stats& request,
+                            envoy::HotRestartMessage::Reply::Stats* stats);
     void drainListeners();
 
   private:
+    // Adds the stats in 'data', in the encoding written by HotRestartStatsWriter, to the maps of
+    // the reply.
+    void addStatsToReply(absl::Span<const uint8_t> data,
+                         envoy::HotRestartMessage::Reply::Stats* stats);
+    void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
+                        Stats::StatName stat_name);
+
     Server::Instance* const server_{};
+    const std::string stats_shared_memory_name_;
+    // The size of the region published by the last export, until the child asks for it to be sent
+    // in the reply instead.
+    uint64_t stats_shared_memory_size_{};
   };
 
 private:
   void onSocketEvent();
 
   const int restart_epoch_;
+  const std::string stats_shared_memory_name_;
   sockaddr_un child_address_;
   Event::FileEventPtr socket_event_;
   std::unique_ptr<Internal> internal_;
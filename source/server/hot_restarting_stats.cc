@@ -0,0 +1,226 @@
+#include "source/server/hot_restarting_stats.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/api/os_sys_calls_impl_hot_restart.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/safe_memcpy.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+struct Header {
+  uint32_t num_tokens_;
+  uint32_t reserved_;
+  uint64_t num_stats_;
+};
+
+constexpr uint64_t StatRecordSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+// Bounds-checked sequential access to an encoding, which may come from a process we do not fully
+// trust to have written it correctly.
+class Cursor {
+public:
+  explicit Cursor(absl::Span<const uint8_t> data) : data_(data) {}
+
+  template <class T> bool read(T& value) {
+    if (data_.size() - pos_ < sizeof(T)) {
+      return false;
+    }
+    safeMemcpyUnsafeSrc(&value, data_.data() + pos_);
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool readString(uint32_t length, absl::string_view& value) {
+    if (data_.size() - pos_ < length) {
+      return false;
+    }
+    value = absl::string_view(reinterpret_cast<const char*>(data_.data() + pos_), length);
+    pos_ += length;
+    return true;
+  }
+
+private:
+  absl::Span<const uint8_t> data_;
+  uint64_t pos_{};
+};
+
+template <class T> void writeValue(uint8_t*& out, const T& value) {
+  safeMemcpyUnsafeDst(out, &value);
+  out += sizeof(T);
+}
+
+} // namespace
+
+void HotRestartStatsWriter::add(HotRestartStatKind kind, Stats::StatName stat_name,
+                                uint64_t value) {
+  const size_t first_token = stat_tokens_.size();
+  symbol_table_.forEachToken(
+      stat_name,
+      [this](absl::string_view token) { stat_tokens_.push_back(tokenIndex(token) << 1); },
+      [this](absl::string_view token) { stat_tokens_.push_back(tokenIndex(token) << 1 | 1); });
+  const uint32_t num_tokens = stat_tokens_.size() - first_token;
+  stats_.push_back({value, num_tokens << 1 | static_cast<uint32_t>(kind)});
+}
+
+uint32_t HotRestartStatsWriter::tokenIndex(absl::string_view token) {
+  auto iter = token_indexes_.find(token);
+  if (iter != token_indexes_.end()) {
+    return iter->second;
+  }
+  const uint32_t index = tokens_.size();
+  tokens_.emplace_back(token);
+  token_indexes_.emplace(tokens_.back(), index);
+  token_bytes_ += sizeof(uint32_t) + token.size();
+  return index;
+}
+
+uint64_t HotRestartStatsWriter::byteSize() const {
+  return sizeof(Header) + token_bytes_ + stats_.size() * StatRecordSize +
+         stat_tokens_.size() * sizeof(uint32_t);
+}
+
+void HotRestartStatsWriter::write(absl::Span<uint8_t> out) const {
+  RELEASE_ASSERT(out.size() == byteSize(), "");
+  uint8_t* pos = out.data();
+  writeValue(pos, Header{static_cast<uint32_t>(tokens_.size()), 0, stats_.size()});
+  for (const std::string& token : tokens_) {
+    writeValue(pos, static_cast<uint32_t>(token.size()));
+    memcpy(pos, token.data(), token.size()); // NOLINT(safe-memcpy)
+    pos += token.size();
+  }
+  const uint32_t* stat_token = stat_tokens_.data();
+  for (const Stat& stat : stats_) {
+    writeValue(pos, stat.value_);
+    writeValue(pos, stat.num_tokens_and_kind_);
+    for (uint32_t i = 0, n = stat.num_tokens_and_kind_ >> 1; i < n; ++i) {
+      writeValue(pos, *stat_token++);
+    }
+  }
+  ASSERT(pos == out.data() + out.size());
+}
+
+bool HotRestartStatsReader::read(absl::Span<const uint8_t> data, Stats::SymbolTable& symbol_table,
+                                 const StatFn& stat_fn) {
+  Cursor cursor(data);
+  Header header;
+  if (!cursor.read(header)) {
+    return false;
+  }
+
+  // Tokens are interned on first use, symbolically or dynamically depending on how the parent
+  // encoded them, so each distinct token costs one symbol table lookup however many stats use it.
+  std::vector<absl::string_view> tokens;
+  for (uint32_t i = 0; i < header.num_tokens_; ++i) {
+    uint32_t length;
+    absl::string_view token;
+    if (!cursor.read(length) || !cursor.readString(length, token)) {
+      return false;
+    }
+    tokens.push_back(token);
+  }
+  Stats::StatNamePool symbolic_pool(symbol_table);
+  Stats::StatNameDynamicPool dynamic_pool(symbol_table);
+  std::vector<Stats::StatName> symbolic_names(tokens.size());
+  std::vector<Stats::StatName> dynamic_names(tokens.size());
+
+  Stats::StatNameVec segments;
+  for (uint64_t i = 0; i < header.num_stats_; ++i) {
+    uint64_t value;
+    uint32_t num_tokens_and_kind;
+    if (!cursor.read(value) || !cursor.read(num_tokens_and_kind)) {
+      return false;
+    }
+    segments.clear();
+    for (uint32_t j = 0, n = num_tokens_and_kind >> 1; j < n; ++j) {
+      uint32_t entry;
+      if (!cursor.read(entry)) {
+        return false;
+      }
+      const uint32_t index = entry >> 1;
+      if (index >= tokens.size()) {
+        return false;
+      }
+      const bool dynamic = entry & 1;
+      Stats::StatName& name = dynamic ? dynamic_names[index] : symbolic_names[index];
+      if (name.empty()) {
+        name = dynamic ? dynamic_pool.add(tokens[index]) : symbolic_pool.add(tokens[index]);
+      }
+      segments.push_back(name);
+    }
+    const Stats::SymbolTable::StoragePtr joined = symbol_table.join(segments);
+    const auto kind = static_cast<HotRestartStatKind>(num_tokens_and_kind & 1);
+    stat_fn(kind, Stats::StatName(joined.get()), value);
+  }
+  return true;
+}
+
+absl::optional<uint64_t> publishStatsToSharedMemory(const std::string& name,
+                                                    const HotRestartStatsWriter& writer) {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  Api::HotRestartOsSysCalls& hot_restart_os_sys_calls = Api::HotRestartOsSysCallsSingleton::get();
+
+  // The name is predictable, so a region left behind under it, whether by an earlier epoch or by
+  // another local process, is removed and never reused: the child must only read what this
+  // process wrote.
+  hot_restart_os_sys_calls.shmUnlink(name.c_str());
+  const Api::SysCallIntResult fd =
+      hot_restart_os_sys_calls.shmOpen(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd.return_value_ == -1) {
+    return absl::nullopt;
+  }
+  const uint64_t size = writer.byteSize();
+  absl::optional<uint64_t> result;
+  if (os_sys_calls.ftruncate(fd.return_value_, size).return_value_ != -1) {
+    const Api::SysCallPtrResult mapped =
+        os_sys_calls.mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.return_value_, 0);
+    if (mapped.return_value_ != MAP_FAILED) {
+      writer.write(absl::MakeSpan(static_cast<uint8_t*>(mapped.return_value_), size));
+      hot_restart_os_sys_calls.munmap(mapped.return_value_, size);
+      result = size;
+    }
+  }
+  os_sys_calls.close(fd.return_value_);
+  if (!result.has_value()) {
+    hot_restart_os_sys_calls.shmUnlink(name.c_str());
+  }
+  return result;
+}
+
+bool consumeStatsFromSharedMemory(const std::string& name, uint64_t size,
+                                  const std::function<void(absl::Span<const uint8_t>)>& read_fn) {
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  Api::HotRestartOsSysCalls& hot_restart_os_sys_calls = Api::HotRestartOsSysCallsSingleton::get();
+
+  const Api::SysCallIntResult fd = hot_restart_os_sys_calls.shmOpen(name.c_str(), O_RDONLY, 0);
+  if (fd.return_value_ == -1) {
+    return false;
+  }
+  // Touching the pages of a mapping beyond the end of a shorter region would raise SIGBUS, so the
+  // region must be at least as large as the parent said it is.
+  struct stat stat_buf;
+  if (os_sys_calls.fstat(fd.return_value_, &stat_buf).return_value_ == -1 || stat_buf.st_size < 0 ||
+      static_cast<uint64_t>(stat_buf.st_size) < size) {
+    os_sys_calls.close(fd.return_value_);
+    return false;
+  }
+  const Api::SysCallPtrResult mapped =
+      os_sys_calls.mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.return_value_, 0);
+  os_sys_calls.close(fd.return_value_);
+  if (mapped.return_value_ == MAP_FAILED) {
+    return false;
+  }
+  hot_restart_os_sys_calls.shmUnlink(name.c_str());
+  read_fn(absl::MakeConstSpan(static_cast<const uint8_t*>(mapped.return_value_), size));
+  hot_restart_os_sys_calls.munmap(mapped.return_value_, size);
+  return true;
+}
+
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "envoy/stats/stats.h"
+
+#include "source/common/stats/symbol_table.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Server {
+
+enum class HotRestartStatKind : uint32_t { Counter = 0, Gauge = 1 };
+
+/**
+ * Builds the flat encoding of counter deltas and gauge values that the hot restart parent hands
+ * to its child through shared memory. Rather than elaborating every stat name, each name is
+ * encoded as a sequence of indexes into a table of its distinct tokens, so that the child interns
+ * every token once instead of once per stat.
+ *
+ * The encoding is in host byte order, as both processes run builds with the same hot restart
+ * version:
+ *
+ *   uint32_t num_tokens, uint32_t reserved, uint64_t num_stats
+ *   num_tokens x { uint32_t length, char token[length] }
+ *   num_stats x { uint64_t value, uint32_t (num_name_tokens << 1 | kind),
+ *                 uint32_t (token_index << 1 | is_dynamic)[num_name_tokens] }
+ */
+class HotRestartStatsWriter {
+public:
+  explicit HotRestartStatsWriter(const Stats::SymbolTable& symbol_table)
+      : symbol_table_(symbol_table) {}
+
+  /**
+   * Adds a stat to the encoding.
+   * @param kind whether the stat is a counter or a gauge.
+   * @param stat_name the name of the stat.
+   * @param value the counter delta or the gauge value.
+   */
+  void add(HotRestartStatKind kind, Stats::StatName stat_name, uint64_t value);
+
+  /**
+   * @return the number of stats added.
+   */
+  uint64_t numStats() const { return stats_.size(); }
+
+  /**
+   * @return the size of the encoding in bytes.
+   */
+  uint64_t byteSize() const;
+
+  /**
+   * Writes the encoding.
+   * @param out the memory to write to, which must be byteSize() bytes long.
+   */
+  void write(absl::Span<uint8_t> out) const;
+
+private:
+  struct Stat {
+    uint64_t value_;
+    uint32_t num_tokens_and_kind_;
+  };
+
+  uint32_t tokenIndex(absl::string_view token);
+
+  const Stats::SymbolTable& symbol_table_;
+  // A deque, so that growing it does not move the strings the index map points into.
+  std::deque<std::string> tokens_;
+  absl::flat_hash_map<absl::string_view, uint32_t> token_indexes_;
+  uint64_t token_bytes_{};
+  std::vector<Stat> stats_;
+  // The name tokens of all stats, concatenated.
+  std::vector<uint32_t> stat_tokens_;
+};
+
+/**
+ * Decodes the encoding built by HotRestartStatsWriter.
+ */
+class HotRestartStatsReader {
+public:
+  using StatFn = std::function<void(HotRestartStatKind, Stats::StatName, uint64_t)>;
+
+  /**
+   * Decodes all stats, calling stat_fn for each of them.
+   * @param data the encoding.
+   * @param symbol_table the symbol table to build the stat names in.
+   * @param stat_fn called with the kind, name and value of each stat. The name is only valid for
+   *        the duration of the call.
+   * @return false if the encoding is malformed. Stats decoded before the problem was found have
+   *         been passed to stat_fn.
+   */
+  static bool read(absl::Span<const uint8_t> data, Stats::SymbolTable& symbol_table,
+                   const StatFn& stat_fn);
+};
+
+/**
+ * Publishes encoded stats in a POSIX shared memory region, replacing any previous region with the
+ * same name.
+ * @param name the name of the region.
+ * @param writer the stats to publish.
+ * @return the size of the region, or absl::nullopt if it could not be created.
+ */
+absl::optional<uint64_t> publishStatsToSharedMemory(const std::string& name,
+                                                    const HotRestartStatsWriter& writer);
+
+/**
+ * Maps a shared memory region created by publishStatsToSharedMemory(), passes its contents to
+ * read_fn and unlinks the region. A region that could not be mapped is left in place, so that its
+ * creator can read it back.
+ * @param name the name of the region.
+ * @param size the size of the region.
+ * @param read_fn called with the contents of the region.
+ * @return false if the region could not be mapped, including when it is smaller than size.
+ */
+bool consumeStatsFromSharedMemory(const std::string& name, uint64_t size,
+                                  const std::function<void(absl::Span<const uint8_t>)>& read_fn);
+
+} // namespace Server
+} // namespace Envoy
@@ -17,6 +17,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/config/utility.h"
+#include "source/common/memory/stats.h"
 #include "source/common/network/filter_matcher.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/listen_socket_impl.h"
@@ -461,6 +462,8 @@ bool ListenerManagerImpl::addOrUpdateListenerInternal(
   }
 
   ListenerImplPtr new_listener = nullptr;
+  const Memory::AllocatedBytesSampler allocated_bytes;
+  const MonotonicTime build_start_time = server_.timeSource().monotonicTime();
 
   // In place filter chain update depends on the active listener at worker.
   if (existing_active_listener != active_listeners_.end() &&
@@ -478,6 +481,11 @@ bool ListenerManagerImpl::addOrUpdateListenerInternal(
   }
 
   ListenerImpl& new_listener_ref = *new_listener;
+  // For an in place filter chain update, this only counts the filter chains which were rebuilt.
+  server_.admin().getConfigMemoryTracker().setBuildCost(
+      ConfigMemoryTracker::ResourceType::Listener, name, allocated_bytes.allocatedBytes(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          server_.timeSource().monotonicTime() - build_start_time));
 
   bool added = false;
   if (existing_warming_listener != warming_listeners_.end()) {
@@ -819,6 +827,8 @@ bool ListenerManagerImpl::removeListenerInternal(const std::string& name,
     }
   }
 
+  server_.admin().getConfigMemoryTracker().removeResource(
+      ConfigMemoryTracker::ResourceType::Listener, name);
   stats_.listener_removed_.inc();
   updateWarmingActiveGauges();
   return true;
@@ -985,15 +995,20 @@ Network::DrainableFilterChainSharedPtr ListenerFilterChainFactoryBuilder::buildF
   // socket or the QUIC listener and get to this point.
   ASSERT(!is_quic);
 #endif
-  ProtobufTypes::MessagePtr message =
-      Config::Utility::translateToFactoryConfig(transport_socket, validator_, config_factory);
-
-  std::vector<std::string> server_names(filter_chain.filter_chain_match().server_names().begin(),
-                                        filter_chain.filter_chain_match().server_names().end());
+  auto transport_socket_factory = listener_.filter_chain_manager_.getOrCreateTransportSocketFactory(
+      filter_chain, [this, &filter_chain, &transport_socket, &config_factory]() {
+        ProtobufTypes::MessagePtr message =
+            Config::Utility::translateToFactoryConfig(transport_socket, validator_, config_factory);
+
+        std::vector<std::string> server_names(
+            filter_chain.filter_chain_match().server_names().begin(),
+            filter_chain.filter_chain_match().server_names().end());
+        return config_factory.createTransportSocketFactory(*message, factory_context_,
+                                                           std::move(server_names));
+      });
 
   auto filter_chain_res = std::make_shared<FilterChainImpl>(
-      config_factory.createTransportSocketFactory(*message, factory_context_,
-                                                  std::move(server_names)),
+      std::move(transport_socket_factory),
       listener_component_factory_.createNetworkFilterFactoryList(filter_chain.filters(),
                                                                  *filter_chain_factory_context),
       std::chrono::milliseconds(
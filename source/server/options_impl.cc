@@ -152,6 +152,17 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
                                            "600", "string", cmd);
   TCLAP::SwitchArg enable_core_dump("", "enable-core-dump", "Enable core dumps", cmd, false);
 
+  TCLAP::ValueArg<std::string> config_profile_path(
+      "", "config-profile-path",
+      "Path to which the time and memory it took to build each listener, cluster and route "
+      "configuration are written in validate mode",
+      false, "", "string", cmd);
+  TCLAP::ValueArg<std::string> config_profile_snapshot_dir(
+      "", "config-profile-snapshot-dir",
+      "Directory of DiscoveryResponse files from which the xDS subscriptions of the configuration "
+      "are served in validate mode",
+      false, "", "string", cmd);
+
   TCLAP::MultiArg<std::string> stats_tag(
       "", "stats-tag",
       "This flag provides a universal tag for all stats generated by Envoy. The format is "
@@ -262,6 +273,8 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   drain_time_ = std::chrono::seconds(drain_time_s.getValue());
   parent_shutdown_time_ = std::chrono::seconds(parent_shutdown_time_s.getValue());
   socket_path_ = socket_path.getValue();
+  config_profile_path_ = config_profile_path.getValue();
+  config_profile_snapshot_dir_ = config_profile_snapshot_dir.getValue();
 
   if (socket_path_.at(0) == '@') {
     socket_mode_ = 0;
@@ -436,6 +449,8 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   for (const auto& tag : statsTags()) {
     command_line_options->add_stats_tag(fmt::format("{}:{}", tag.name_, tag.value_));
   }
+  command_line_options->set_config_profile_path(configProfilePath());
+  command_line_options->set_config_profile_snapshot_dir(configProfileSnapshotDir());
   return command_line_options;
 }
 
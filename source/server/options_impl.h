@@ -106,6 +106,14 @@ public:
 
   void setStatsTags(const Stats::TagVector& stats_tags) { stats_tags_ = stats_tags; }
 
+  void setConfigProfilePath(const std::string& config_profile_path) {
+    config_profile_path_ = config_profile_path;
+  }
+
+  void setConfigProfileSnapshotDir(const std::string& config_profile_snapshot_dir) {
+    config_profile_snapshot_dir_ = config_profile_snapshot_dir;
+  }
+
   // Server::Options
   uint64_t baseId() const override { return base_id_; }
   bool useDynamicBaseId() const override { return use_dynamic_base_id_; }
@@ -149,6 +157,10 @@ public:
   bool mutexTracingEnabled() const override { return mutex_tracing_enabled_; }
   bool coreDumpEnabled() const override { return core_dump_enabled_; }
   const Stats::TagVector& statsTags() const override { return stats_tags_; }
+  const std::string& configProfilePath() const override { return config_profile_path_; }
+  const std::string& configProfileSnapshotDir() const override {
+    return config_profile_snapshot_dir_;
+  }
   Server::CommandLineOptionsPtr toCommandLineOptions() const override;
   void parseComponentLogLevels(const std::string& component_log_levels);
   bool cpusetThreadsEnabled() const override { return cpuset_threads_; }
@@ -211,6 +223,8 @@ private:
   bool cpuset_threads_{false};
   std::vector<std::string> disabled_extensions_;
   Stats::TagVector stats_tags_;
+  std::string config_profile_path_;
+  std::string config_profile_snapshot_dir_;
   uint32_t count_{0};
 
   // Initialization added here to avoid integration_admin_test failure caused by uninitialized
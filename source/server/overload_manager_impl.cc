@@ -1,5 +1,6 @@
 #include "source/server/overload_manager_impl.h"
 
+#include <atomic>
 #include <chrono>
 
 #include "envoy/common/exception.h"
@@ -21,17 +22,40 @@ namespace Envoy {
 namespace Server {
 
 /**
- * Thread-local copy of the state of each configured overload action.
+ * Copy of a trigger on a worker resource, owned by a single thread and evaluated against that
+ * thread's own usage.
+ */
+struct WorkerTrigger {
+  NamedOverloadActionSymbolTable::Symbol action_;
+  OverloadAction::TriggerPtr trigger_;
+};
+
+using WorkerActionCallback = std::pair<NamedOverloadActionSymbolTable::Symbol, OverloadActionCb>;
+
+/**
+ * Thread-local copy of the state of each configured overload action. The state of an action is
+ * the maximum of the global state flushed by the overload manager and the state of any trigger on
+ * a worker resource evaluated by this thread.
  */
 class ThreadLocalOverloadStateImpl : public ThreadLocalOverloadState {
 public:
   explicit ThreadLocalOverloadStateImpl(
       const NamedOverloadActionSymbolTable& action_symbol_table,
       std::shared_ptr<absl::node_hash_map<OverloadProactiveResourceName, ProactiveResource>>&
-          proactive_resources)
+          proactive_resources,
+      Event::Dispatcher& dispatcher, std::vector<WorkerTrigger>&& worker_triggers,
+      std::vector<WorkerActionCallback>&& worker_action_callbacks)
       : action_symbol_table_(action_symbol_table),
         actions_(action_symbol_table.size(), OverloadActionState(UnitFloat::min())),
-        proactive_resources_(proactive_resources) {}
+        global_actions_(actions_), worker_actions_(actions_),
+        proactive_resources_(proactive_resources), dispatcher_(dispatcher),
+        worker_triggers_(std::move(worker_triggers)),
+        worker_action_callbacks_(std::move(worker_action_callbacks)) {
+    if (!worker_triggers_.empty()) {
+      dispatcher_.enableEventLoopTimes();
+      last_event_loop_times_ = dispatcher_.eventLoopTimes();
+    }
+  }
 
   const OverloadActionState& getState(const std::string& action) override {
     if (const auto symbol = action_symbol_table_.lookup(action); symbol != absl::nullopt) {
@@ -41,7 +65,30 @@ public:
   }
 
   void setState(NamedOverloadActionSymbolTable::Symbol action, OverloadActionState state) {
-    actions_[action.index()] = state;
+    global_actions_[action.index()] = state;
+    updateEffectiveState(action);
+  }
+
+  // Samples this thread's event loop utilization since the previous call and re-evaluates the
+  // worker triggers against it. Returns nullopt if this thread has no worker triggers.
+  absl::optional<double> updateWorkerResources() {
+    if (worker_triggers_.empty()) {
+      return absl::nullopt;
+    }
+    const Event::EventLoopTimes times = dispatcher_.eventLoopTimes();
+    const auto busy = times.busy_ - last_event_loop_times_.busy_;
+    const auto total = busy + (times.polling_ - last_event_loop_times_.polling_);
+    last_event_loop_times_ = times;
+    const double utilization =
+        total.count() > 0 ? static_cast<double>(busy.count()) / total.count() : 0;
+
+    for (auto& worker_trigger : worker_triggers_) {
+      if (worker_trigger.trigger_->updateValue(utilization)) {
+        worker_actions_[worker_trigger.action_.index()] = worker_trigger.trigger_->actionState();
+        updateEffectiveState(worker_trigger.action_);
+      }
+    }
+    return utilization;
   }
 
   bool tryAllocateResource(OverloadProactiveResourceName resource_name,
@@ -77,11 +124,35 @@ public:
   }
 
 private:
+  void updateEffectiveState(NamedOverloadActionSymbolTable::Symbol action) {
+    const OverloadActionState& global_state = global_actions_[action.index()];
+    const OverloadActionState& worker_state = worker_actions_[action.index()];
+    const OverloadActionState state =
+        worker_state.value() > global_state.value() ? worker_state : global_state;
+    if (state.value() == actions_[action.index()].value()) {
+      return;
+    }
+    actions_[action.index()] = state;
+    // Only actions with worker triggers have callbacks here; this thread is the one they were
+    // registered on, so they can run inline.
+    for (const auto& [callback_action, callback] : worker_action_callbacks_) {
+      if (callback_action.index() == action.index()) {
+        callback(state);
+      }
+    }
+  }
+
   static const OverloadActionState always_inactive_;
   const NamedOverloadActionSymbolTable& action_symbol_table_;
   std::vector<OverloadActionState> actions_;
+  std::vector<OverloadActionState> global_actions_;
+  std::vector<OverloadActionState> worker_actions_;
   std::shared_ptr<absl::node_hash_map<OverloadProactiveResourceName, ProactiveResource>>
       proactive_resources_;
+  Event::Dispatcher& dispatcher_;
+  std::vector<WorkerTrigger> worker_triggers_;
+  std::vector<WorkerActionCallback> worker_action_callbacks_;
+  Event::EventLoopTimes last_event_loop_times_;
 };
 
 const OverloadActionState ThreadLocalOverloadStateImpl::always_inactive_{UnitFloat::min()};
@@ -144,6 +215,18 @@ private:
   OverloadActionState state_;
 };
 
+OverloadAction::TriggerPtr createTrigger(const envoy::config::overload::v3::Trigger& config) {
+  switch (config.trigger_oneof_case()) {
+  case envoy::config::overload::v3::Trigger::TriggerOneofCase::kThreshold:
+    return std::make_unique<ThresholdTriggerImpl>(config.threshold());
+  case envoy::config::overload::v3::Trigger::TriggerOneofCase::kScaled:
+    return std::make_unique<ScaledTriggerImpl>(config.scaled());
+  case envoy::config::overload::v3::Trigger::TriggerOneofCase::TRIGGER_ONEOF_NOT_SET:
+    break;
+  }
+  throw EnvoyException(absl::StrCat("action not set for trigger ", config.name()));
+}
+
 Stats::Counter& makeCounter(Stats::Scope& scope, absl::string_view name_of_stat) {
   Stats::StatNameManagedStorage stat_name(name_of_stat, scope.symbolTable());
   return scope.counterFromStatName(stat_name.statName());
@@ -247,20 +330,7 @@ OverloadAction::OverloadAction(const envoy::config::overload::v3::OverloadAction
       scale_percent_gauge_(makeGauge(stats_scope, config.name(), "scale_percent",
                                      Stats::Gauge::ImportMode::Accumulate)) {
   for (const auto& trigger_config : config.triggers()) {
-    TriggerPtr trigger;
-
-    switch (trigger_config.trigger_oneof_case()) {
-    case envoy::config::overload::v3::Trigger::TriggerOneofCase::kThreshold:
-      trigger = std::make_unique<ThresholdTriggerImpl>(trigger_config.threshold());
-      break;
-    case envoy::config::overload::v3::Trigger::TriggerOneofCase::kScaled:
-      trigger = std::make_unique<ScaledTriggerImpl>(trigger_config.scaled());
-      break;
-    case envoy::config::overload::v3::Trigger::TriggerOneofCase::TRIGGER_ONEOF_NOT_SET:
-      throw EnvoyException(absl::StrCat("action not set for trigger ", trigger_config.name()));
-    }
-
-    if (!triggers_.try_emplace(trigger_config.name(), std::move(trigger)).second) {
+    if (!triggers_.try_emplace(trigger_config.name(), createTrigger(trigger_config)).second) {
       throw EnvoyException(
           absl::StrCat("Duplicate trigger resource for overload action ", config.name()));
     }
@@ -324,8 +394,14 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
         OverloadProactiveResources::get().proactive_action_name_to_resource_.find(name);
     ENVOY_LOG(debug, "Evaluating resource {}", name);
     bool result = false;
-    if (proactive_resource_it !=
-        OverloadProactiveResources::get().proactive_action_name_to_resource_.end()) {
+    if (name == OverloadWorkerResourceNames::get().EventLoopUtilization) {
+      ENVOY_LOG(debug, "Adding worker resource monitor for {}", name);
+      result = worker_resource_ == nullptr;
+      if (result) {
+        worker_resource_ = std::make_shared<WorkerResource>(name, stats_scope);
+      }
+    } else if (proactive_resource_it !=
+               OverloadProactiveResources::get().proactive_action_name_to_resource_.end()) {
       ENVOY_LOG(debug, "Adding proactive resource monitor for {}", name);
       auto& factory =
           Config::Utility::getAndCheckFactory<Configuration::ProactiveResourceMonitorFactory>(
@@ -381,6 +457,12 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
 
     for (const auto& trigger : action.triggers()) {
       const std::string& resource = trigger.name();
+      if (resource == OverloadWorkerResourceNames::get().EventLoopUtilization &&
+          worker_resource_ != nullptr) {
+        worker_triggers_.emplace_back(symbol, trigger);
+        worker_actions_.insert(symbol);
+        continue;
+      }
       auto proactive_resource_it =
           OverloadProactiveResources::get().proactive_action_name_to_resource_.find(resource);
 
@@ -399,12 +481,26 @@ void OverloadManagerImpl::start() {
   ASSERT(!started_);
   started_ = true;
 
-  tls_.set([this](Event::Dispatcher&) {
-    return std::make_shared<ThreadLocalOverloadStateImpl>(action_symbol_table_,
-                                                          proactive_resources_);
+  tls_.set([this](Event::Dispatcher& dispatcher) {
+    // The main thread doesn't serve traffic, so it doesn't evaluate worker resources.
+    std::vector<WorkerTrigger> worker_triggers;
+    if (&dispatcher != &dispatcher_) {
+      for (const auto& [action, trigger] : worker_triggers_) {
+        worker_triggers.push_back({action, createTrigger(trigger)});
+      }
+    }
+    std::vector<WorkerActionCallback> worker_action_callbacks;
+    for (const auto& [action, cb] : action_to_callbacks_) {
+      if (&cb.dispatcher_ == &dispatcher && worker_actions_.contains(action)) {
+        worker_action_callbacks.emplace_back(action, cb.callback_);
+      }
+    }
+    return std::make_shared<ThreadLocalOverloadStateImpl>(
+        action_symbol_table_, proactive_resources_, dispatcher, std::move(worker_triggers),
+        std::move(worker_action_callbacks));
   });
 
-  if (resources_.empty()) {
+  if (resources_.empty() && worker_resource_ == nullptr) {
     return;
   }
 
@@ -420,6 +516,9 @@ void OverloadManagerImpl::start() {
     for (auto& resource : resources_) {
       resource.second.update(flush_epoch_);
     }
+    if (worker_resource_ != nullptr) {
+      worker_resource_->update(tls_);
+    }
 
     timer_->enableTimer(refresh_interval_);
   });
@@ -501,6 +600,10 @@ void OverloadManagerImpl::updateResourcePressure(const std::string& resource, do
       // causes the action to have value B, B would have been the result for whichever order the
       // updates to resources 1 and 2 came in.
       state_updates_to_flush_.insert_or_assign(action, state);
+      if (worker_actions_.contains(action)) {
+        // Each thread runs its own callbacks once it has combined this with its worker state.
+        return;
+      }
       auto [callbacks_start, callbacks_end] = action_to_callbacks_.equal_range(action);
       std::for_each(callbacks_start, callbacks_end, [&](ActionToCallbackMap::value_type& cb_entry) {
         callbacks_to_flush_.insert_or_assign(&cb_entry.second, state);
@@ -571,5 +674,41 @@ void OverloadManagerImpl::Resource::onFailure(const EnvoyException& error) {
   failed_updates_counter_.inc();
 }
 
+OverloadManagerImpl::WorkerResource::WorkerResource(const std::string& name,
+                                                    Stats::Scope& stats_scope)
+    : name_(name), pressure_gauge_(makeGauge(stats_scope, name, "pressure",
+                                             Stats::Gauge::ImportMode::NeverImport)),
+      skipped_updates_counter_(makeCounter(stats_scope, name, "skipped_updates")) {}
+
+void OverloadManagerImpl::WorkerResource::update(
+    ThreadLocal::TypedSlot<ThreadLocalOverloadStateImpl>& tls) {
+  if (pending_update_) {
+    // Some worker hasn't got to the previous update yet. It keeps its last sampled state until it
+    // does, and its next sample will cover the whole time it was stalled.
+    ENVOY_LOG(debug, "Skipping update for worker resource {} which has pending update", name_);
+    skipped_updates_counter_.inc();
+    return;
+  }
+  pending_update_ = true;
+
+  // Percent, so that the maximum across threads can be tracked with an integer atomic.
+  auto max_pressure = std::make_shared<std::atomic<uint64_t>>(0);
+  tls.runOnAllThreads(
+      [max_pressure](OptRef<ThreadLocalOverloadStateImpl> overload_state) {
+        const absl::optional<double> pressure = overload_state->updateWorkerResources();
+        if (!pressure.has_value()) {
+          return;
+        }
+        const uint64_t percent = *pressure * 100;
+        uint64_t current = max_pressure->load();
+        while (percent > current && !max_pressure->compare_exchange_weak(current, percent)) {
+        }
+      },
+      [self = shared_from_this(), max_pressure]() {
+        self->pending_update_ = false;
+        self->pressure_gauge_.set(max_pressure->load());
+      });
+}
+
 } // namespace Server
 } // namespace Envoy
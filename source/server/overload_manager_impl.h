@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <vector>
 
 #include "envoy/api/api.h"
@@ -18,6 +19,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/event/scaled_range_timer_manager_impl.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/container/node_hash_set.h"
 
@@ -154,6 +156,22 @@ private:
     Stats::Counter& skipped_updates_counter_;
   };
 
+  // A built-in resource that each worker measures for itself on every refresh. The pressure gauge
+  // reports the highest pressure across the workers.
+  class WorkerResource : public std::enable_shared_from_this<WorkerResource> {
+  public:
+    WorkerResource(const std::string& name, Stats::Scope& stats_scope);
+
+    void update(ThreadLocal::TypedSlot<ThreadLocalOverloadStateImpl>& tls);
+
+  private:
+    const std::string name_;
+    bool pending_update_{};
+    Stats::Gauge& pressure_gauge_;
+    Stats::Counter& skipped_updates_counter_;
+  };
+  using WorkerResourceSharedPtr = std::shared_ptr<WorkerResource>;
+
   struct ActionCallback {
     ActionCallback(Event::Dispatcher& dispatcher, OverloadActionCb callback)
         : dispatcher_(dispatcher), callback_(callback) {}
@@ -173,6 +191,7 @@ private:
   const std::chrono::milliseconds refresh_interval_;
   Event::TimerPtr timer_;
   absl::node_hash_map<std::string, Resource> resources_;
+  WorkerResourceSharedPtr worker_resource_;
   std::shared_ptr<absl::node_hash_map<OverloadProactiveResourceName, ProactiveResource>>
       proactive_resources_;
 
@@ -194,6 +213,14 @@ private:
       std::unordered_multimap<NamedOverloadActionSymbolTable::Symbol, ActionCallback,
                               absl::Hash<NamedOverloadActionSymbolTable::Symbol>>;
   ActionToCallbackMap action_to_callbacks_;
+
+  // Triggers on the worker resource, copied into each worker's thread-local state, and the actions
+  // they belong to. Callbacks for those actions are run by the thread-local state of the thread
+  // they were registered on rather than by flushResourceUpdates().
+  std::vector<std::pair<NamedOverloadActionSymbolTable::Symbol,
+                        envoy::config::overload::v3::Trigger>>
+      worker_triggers_;
+  absl::flat_hash_set<NamedOverloadActionSymbolTable::Symbol> worker_actions_;
 };
 
 } // namespace Server
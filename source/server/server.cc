@@ -183,44 +183,69 @@ void InstanceImpl::failHealthcheck(bool fail) {
   server_stats_->live_.set(live_.load());
 }
 
-MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, TimeSource& time_source) {
+MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, TimeSource& time_source,
+                                       bool changed_only) {
   store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
+      [this, changed_only](std::size_t size) {
+        // Only a fraction of the stats are expected to change between flushes, so don't reserve
+        // room for all of them.
+        if (!changed_only) {
+          snapped_counters_.reserve(size);
+          counters_.reserve(size);
+        }
       },
-      [this](Stats::Counter& counter) {
+      [this, changed_only](Stats::Counter& counter) {
+        // Latch every counter, even when not flushing it, so the next delta starts from here.
+        const uint64_t delta = counter.latch();
+        if (changed_only && delta == 0) {
+          return;
+        }
         snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
+        counters_.push_back({delta, counter});
       });
 
   store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
+      [this, changed_only](std::size_t size) {
+        if (!changed_only) {
+          snapped_gauges_.reserve(size);
+          gauges_.reserve(size);
+        }
       },
-      [this](Stats::Gauge& gauge) {
+      [this, changed_only](Stats::Gauge& gauge) {
         ASSERT(gauge.importMode() != Stats::Gauge::ImportMode::Uninitialized);
+        if (!gauge.latchChanged() && changed_only) {
+          return;
+        }
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
       });
 
   store.forEachHistogram(
-      [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+      [this, changed_only](std::size_t size) {
+        if (!changed_only) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
-      [this](Stats::ParentHistogram& histogram) {
+      [this, changed_only](Stats::ParentHistogram& histogram) {
+        if (changed_only && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
 
   store.forEachSinkedTextReadout(
-      [this](std::size_t size) {
-        snapped_text_readouts_.reserve(size);
-        text_readouts_.reserve(size);
+      [this, changed_only](std::size_t size) {
+        if (!changed_only) {
+          snapped_text_readouts_.reserve(size);
+          text_readouts_.reserve(size);
+        }
       },
-      [this](Stats::TextReadout& text_readout) {
+      [this, changed_only](Stats::TextReadout& text_readout) {
+        if (!text_readout.latchChanged() && changed_only) {
+          return;
+        }
         snapped_text_readouts_.push_back(Stats::TextReadoutSharedPtr(&text_readout));
         text_readouts_.push_back(text_readout);
       });
@@ -229,12 +254,12 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, TimeSource& time_sou
 }
 
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       TimeSource& time_source) {
+                                       TimeSource& time_source, bool changed_only) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, time_source);
+  MetricSnapshotImpl snapshot(store, time_source, changed_only);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -293,12 +318,73 @@ void InstanceImpl::updateServerStats() {
 void InstanceImpl::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
-  InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, timeSource());
   // TODO(ramaraochavali): consider adding different flush interval for histograms.
   if (stat_flush_timer_ != nullptr) {
     stat_flush_timer_->enableTimer(stats_config.flushInterval());
   }
 
+  if (stats_flush_thread_ != nullptr) {
+    flushMetricsOnDedicatedThread();
+    return;
+  }
+  InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, timeSource(),
+                                    stats_config.flushChangedOnly());
+  stats_flush_in_progress_ = false;
+}
+
+void InstanceImpl::flushMetricsOnDedicatedThread() {
+  auto& stats_config = config_.statsConfig();
+  // The snapshot is taken on the main thread, as it latches the counters, which the hot restart
+  // code relies on, and it holds references to the metrics until the flush completes.
+  auto snapshot = std::make_shared<MetricSnapshotImpl>(stats_store_, timeSource(),
+                                                       stats_config.flushChangedOnly());
+  std::vector<Stats::Sink*> sinks;
+  for (const Stats::SinkPtr& sink : stats_config.sinks()) {
+    if (sink->supportsDedicatedFlushThread()) {
+      sinks.push_back(sink.get());
+    } else {
+      sink->flush(*snapshot);
+    }
+  }
+  if (sinks.empty()) {
+    stats_flush_in_progress_ = false;
+    return;
+  }
+
+  // The flush stays in progress until the flush thread is done with the snapshot, so the next
+  // histogram merge does not update the histograms while the sinks read them. The snapshot is
+  // released on the main thread.
+  stats_flush_dispatcher_->post([this, snapshot = std::move(snapshot),
+                                 sinks = std::move(sinks)]() mutable {
+    for (Stats::Sink* sink : sinks) {
+      sink->flush(*snapshot);
+    }
+    dispatcher_->post([this, snapshot = std::move(snapshot)]() mutable {
+      snapshot.reset();
+      stats_flush_in_progress_ = false;
+    });
+  });
+}
+
+void InstanceImpl::startStatsFlushThread() {
+  stats_flush_dispatcher_ = api_->allocateDispatcher("stats_flush");
+  // See comments in WorkerImpl::start for the naming convention.
+  Thread::Options options{"stats_flush"};
+  stats_flush_thread_ = api_->threadFactory().createThread(
+      [this]() -> void { stats_flush_dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit); },
+      options);
+}
+
+void InstanceImpl::stopStatsFlushThread() {
+  if (stats_flush_thread_ == nullptr) {
+    return;
+  }
+  stats_flush_dispatcher_->exit();
+  stats_flush_thread_->join();
+  stats_flush_thread_.reset();
+  stats_flush_dispatcher_.reset();
+  // The completion of a flush still running on the thread was posted to the main dispatcher,
+  // which no longer runs.
   stats_flush_in_progress_ = false;
 }
 
@@ -717,6 +803,9 @@ void InstanceImpl::initialize(Network::Address::InstanceConstSharedPtr local_add
   for (const Stats::SinkPtr& sink : stats_config.sinks()) {
     stats_store_.addSink(*sink);
   }
+  if (stats_config.flushOnDedicatedThread()) {
+    startStatsFlushThread();
+  }
   if (!stats_config.flushOnAdmin()) {
     // Some of the stat sinks may need dispatcher support so don't flush until the main loop starts.
     // Just setup the timer.
@@ -897,6 +986,9 @@ void InstanceImpl::run() {
   // startup (see RunHelperTest in server_test.cc).
   const auto run_helper = RunHelper(*this, options_, *dispatcher_, clusterManager(),
                                     access_log_manager_, init_manager_, overloadManager(), [this] {
+                                      if (clusterManager().adsMux() != nullptr) {
+                                        clusterManager().adsMux()->onServerInitialized();
+                                      }
                                       notifyCallbacksForStage(Stage::PostInit);
                                       startWorkers();
                                     });
@@ -948,6 +1040,9 @@ void InstanceImpl::terminate() {
     listener_manager_->stopWorkers();
   }
 
+  // The final flush below runs every sink on the main thread.
+  stopStatsFlushThread();
+
   // Only flush if we have not been hot restarted.
   if (stat_flush_timer_) {
     flushStats();
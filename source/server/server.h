@@ -129,9 +129,10 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param changed_only only flush the metrics that changed since the previous flush.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  TimeSource& time_source);
+                                  TimeSource& time_source, bool changed_only = false);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -307,6 +308,9 @@ public:
 private:
   ProtobufTypes::MessagePtr dumpBootstrapConfig();
   void flushStatsInternal();
+  void flushMetricsOnDedicatedThread();
+  void startStatsFlushThread();
+  void stopStatsFlushThread();
   void updateServerStats();
   void initialize(Network::Address::InstanceConstSharedPtr local_address,
                   ComponentFactory& component_factory);
@@ -369,6 +373,9 @@ private:
   Configuration::MainImpl config_;
   Network::DnsResolverSharedPtr dns_resolver_;
   Event::TimerPtr stat_flush_timer_;
+  // Runs the flushes of the sinks that support a dedicated flush thread, when enabled.
+  Event::DispatcherPtr stats_flush_dispatcher_;
+  Thread::ThreadPtr stats_flush_thread_;
   DrainManagerPtr drain_manager_;
   std::unique_ptr<Upstream::ClusterManagerFactory> cluster_manager_factory_;
   std::unique_ptr<Server::GuardDog> main_thread_guard_dog_;
@@ -421,7 +428,14 @@ private:
 //                     copying and probably be a cleaner API in general.
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
-  explicit MetricSnapshotImpl(Stats::Store& store, TimeSource& time_source);
+  /**
+   * @param store supplies the store to snapshot. All counters are latched, and all gauges and
+   *        text readouts have their changed state cleared.
+   * @param time_source supplies the time of the snapshot.
+   * @param changed_only only include the counters with a non-zero delta, the gauges and text
+   *        readouts that changed, and the histograms with samples in the last interval.
+   */
+  MetricSnapshotImpl(Stats::Store& store, TimeSource& time_source, bool changed_only = false);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -677,6 +677,68 @@ TEST(WatermarkBufferFactoryTest,
   }
 }
 
+// Tests that within a memory class, streams are reset in order of their exact
+// balance rather than in arbitrary order.
+TEST(WatermarkBufferFactoryTest, ResetsLargestStreamsWithinMemoryClassFirst) {
+  TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
+
+  // All accounts are in the final bucket, with distinct balances.
+  std::vector<AccountWithResetHandlerPtr> accounts;
+  for (int i = 0; i < 2 * kMaxStreamsResetPerCall; ++i) {
+    accounts.push_back(std::make_unique<AccountWithResetHandler>(factory));
+    accounts.back()->account_->charge(kThresholdForFinalBucket + i * kMinimumBalanceToTrack);
+  }
+  factory.inspectMemoryClasses([](MemoryClassesToAccountsSet& memory_classes_to_account) {
+    ASSERT_EQ(memory_classes_to_account[BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_ - 1].size(),
+              2 * kMaxStreamsResetPerCall);
+  });
+
+  // Shrink the largest account and grow the smallest one, so the ordering has
+  // to follow balance updates of tracked accounts.
+  accounts.back()->account_->credit(kMinimumBalanceToTrack * 2 * kMaxStreamsResetPerCall);
+  accounts.front()->account_->charge(kMinimumBalanceToTrack * 2 * kMaxStreamsResetPerCall);
+
+  accounts.front()->expectResetStream();
+  for (int i = kMaxStreamsResetPerCall + 1; i < 2 * kMaxStreamsResetPerCall - 1; ++i) {
+    accounts[i]->expectResetStream();
+  }
+  accounts[kMaxStreamsResetPerCall]->expectResetStream();
+
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), kMaxStreamsResetPerCall);
+  EXPECT_TRUE(accounts.front()->reset_handler_invoked_);
+  for (int i = 1; i < kMaxStreamsResetPerCall; ++i) {
+    EXPECT_FALSE(accounts[i]->reset_handler_invoked_);
+  }
+  for (int i = kMaxStreamsResetPerCall; i < 2 * kMaxStreamsResetPerCall - 1; ++i) {
+    EXPECT_TRUE(accounts[i]->reset_handler_invoked_);
+  }
+  EXPECT_FALSE(accounts.back()->reset_handler_invoked_);
+
+  for (int i = 1; i < kMaxStreamsResetPerCall; ++i) {
+    accounts[i]->expectResetStream();
+  }
+  accounts.back()->expectResetStream();
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), kMaxStreamsResetPerCall);
+}
+
+// Tests that an account that stops being tracked is no longer a reset victim.
+TEST(WatermarkBufferFactoryTest, DoesNotResetAccountsThatDroppedBelowTrackingThreshold) {
+  TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
+
+  AccountWithResetHandler tracked(factory);
+  AccountWithResetHandler untracked(factory);
+  tracked.account_->charge(kThresholdForFinalBucket);
+  untracked.account_->charge(kThresholdForFinalBucket);
+  untracked.account_->credit(kThresholdForFinalBucket - 1);
+
+  tracked.expectResetStream();
+  EXPECT_CALL(*untracked.reset_handler_, resetStream(_)).Times(0);
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), 1);
+
+  untracked.account_->credit(1);
+  untracked.account_->clearDownstream();
+}
+
 } // namespace
 } // namespace Buffer
 } // namespace Envoy
@@ -0,0 +1,97 @@
+// Compares decoding the resources of a large CDS response sequentially, as GrpcMuxImpl does for
+// small responses, with preparing them on several threads through ParallelResourcePreparer.
+//
+// Note: this should be run with --compilation_mode=opt.
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/cluster/v3/cluster.pb.validate.h"
+
+#include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/parallel_resource_preparer.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+using Cluster = envoy::config::cluster::v3::Cluster;
+
+Protobuf::RepeatedPtrField<ProtobufWkt::Any> makeClusters(int64_t num_clusters) {
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources;
+  for (int64_t i = 0; i < num_clusters; ++i) {
+    Cluster cluster;
+    cluster.set_name(absl::StrCat("cluster_", i));
+    cluster.set_type(envoy::config::cluster::v3::Cluster::EDS);
+    cluster.mutable_connect_timeout()->set_seconds(5);
+    cluster.mutable_eds_cluster_config()->mutable_eds_config()->mutable_ads();
+    cluster.set_lb_policy(envoy::config::cluster::v3::Cluster::LEAST_REQUEST);
+    auto* thresholds = cluster.mutable_circuit_breakers()->add_thresholds();
+    thresholds->mutable_max_connections()->set_value(1024);
+    thresholds->mutable_max_requests()->set_value(1024);
+    auto* health_check = cluster.add_health_checks();
+    health_check->mutable_timeout()->set_seconds(1);
+    health_check->mutable_interval()->set_seconds(10);
+    health_check->mutable_unhealthy_threshold()->set_value(3);
+    health_check->mutable_healthy_threshold()->set_value(2);
+    health_check->mutable_http_health_check()->set_path("/healthz");
+    resources.Add()->PackFrom(cluster);
+  }
+  return resources;
+}
+
+void bmDecodeSequential(::benchmark::State& state) {
+  const int64_t num_clusters = benchmark::skipExpensiveBenchmarks() ? 100 : state.range(0);
+  const Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources = makeClusters(num_clusters);
+  TestUtility::TestOpaqueResourceDecoderImpl<Cluster> resource_decoder("name");
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<DecodedResourcePtr> decoded;
+    decoded.reserve(resources.size());
+    for (const auto& resource : resources) {
+      decoded.push_back(DecodedResourceImpl::fromResource(resource_decoder, resource, "1"));
+    }
+    ::benchmark::DoNotOptimize(decoded);
+  }
+}
+
+// state.range(1) is the number of threads, including the calling thread.
+void bmDecodeParallel(::benchmark::State& state) {
+  const int64_t num_clusters = benchmark::skipExpensiveBenchmarks() ? 100 : state.range(0);
+  const Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources = makeClusters(num_clusters);
+  TestUtility::TestOpaqueResourceDecoderImpl<Cluster> resource_decoder("name");
+  ParallelResourcePreparer preparer(Thread::threadFactoryForTest(), state.range(1), 1);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<PreparedResourcePtr> prepared = preparer.prepare(resource_decoder, resources);
+    std::vector<DecodedResourcePtr> decoded;
+    decoded.reserve(resources.size());
+    for (int i = 0; i < resources.size(); ++i) {
+      decoded.push_back(
+          prepared.empty()
+              ? DecodedResourceImpl::fromResource(resource_decoder, resources[i], "1")
+              : DecodedResourceImpl::fromPreparedResource(resource_decoder,
+                                                          std::move(prepared[i]), "1"));
+    }
+    ::benchmark::DoNotOptimize(decoded);
+  }
+}
+
+} // namespace
+
+BENCHMARK(bmDecodeSequential)->Arg(1000)->Arg(20000)->Unit(::benchmark::kMillisecond);
+BENCHMARK(bmDecodeParallel)
+    ->Args({1000, 2})
+    ->Args({1000, 4})
+    ->Args({20000, 2})
+    ->Args({20000, 4})
+    ->Args({20000, 8})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace Config
+} // namespace Envoy
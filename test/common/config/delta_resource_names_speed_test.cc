@@ -0,0 +1,156 @@
+// Measures the time and memory taken to track the names of a large delta EDS subscription, which
+// are shared by the WatchMap, the DeltaSubscriptionState and its TtlManager through a single
+// ResourceNamePool, against a baseline in which each of them holds its own std::string copies.
+//
+// Note: this should be run with --compilation_mode=opt.
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.validate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/delta_subscription_state.h"
+#include "source/common/config/watch_map.h"
+#include "source/common/memory/stats.h"
+
+#include "test/benchmark/main.h"
+#include "test/mocks/config/custom_config_validators.h"
+#include "test/mocks/config/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/local_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+using ClusterLoadAssignment = envoy::config::endpoint::v3::ClusterLoadAssignment;
+
+/**
+ * Two watches, like two clusters sharing their endpoints, subscribe to the same `state.range(0)`
+ * EDS names. The server then sends all of them with a TTL, so that the WatchMap, the subscription
+ * state and the TtlManager all track every name. The number of distinct names interned in the pool
+ * and the memory used by the whole subscription are reported as counters.
+ */
+void bmDeltaSubscriptionNames(::benchmark::State& state) {
+  const int64_t num_resources = benchmark::skipExpensiveBenchmarks() ? 100 : state.range(0);
+  const std::string type_url = "type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment";
+
+  absl::flat_hash_set<std::string> names;
+  envoy::service::discovery::v3::DeltaDiscoveryResponse response;
+  response.set_type_url(type_url);
+  response.set_nonce("1");
+  for (int64_t i = 0; i < num_resources; ++i) {
+    const std::string name = absl::StrCat("outbound|8080||service_", i, ".ns.svc.cluster.local");
+    names.insert(name);
+    ClusterLoadAssignment assignment;
+    assignment.set_cluster_name(name);
+    auto* resource = response.add_resources();
+    resource->set_name(name);
+    resource->set_version("1");
+    resource->mutable_ttl()->set_seconds(60);
+    resource->mutable_resource()->PackFrom(assignment);
+  }
+
+  TestUtility::TestOpaqueResourceDecoderImpl<ClusterLoadAssignment> resource_decoder(
+      "cluster_name");
+  NiceMock<MockCustomConfigValidators> config_validators;
+  NiceMock<MockSubscriptionCallbacks> callbacks1;
+  NiceMock<MockSubscriptionCallbacks> callbacks2;
+  NiceMock<LocalInfo::MockLocalInfo> local_info;
+  NiceMock<Event::MockDispatcher> dispatcher;
+
+  for (auto _ : state) { // NOLINT
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    WatchMap watch_map(false, type_url, config_validators);
+    DeltaSubscriptionState sub_state(type_url, watch_map, local_info, dispatcher,
+                                     watch_map.resourceNames());
+    Watch* watch1 = watch_map.addWatch(callbacks1, resource_decoder);
+    Watch* watch2 = watch_map.addWatch(callbacks2, resource_decoder);
+
+    AddedRemoved added_removed = watch_map.updateWatchInterest(watch1, names);
+    sub_state.updateSubscriptionInterest(added_removed.added_, added_removed.removed_);
+    watch_map.updateWatchInterest(watch2, names);
+    ::benchmark::DoNotOptimize(sub_state.getNextRequestAckless());
+    ::benchmark::DoNotOptimize(sub_state.handleResponse(response));
+
+    state.counters["interned_names"] = watch_map.resourceNames().size();
+    state.counters["memory"] = Memory::Stats::totalCurrentlyAllocated() - start_mem;
+
+    watch_map.updateWatchInterest(watch1, {});
+    watch_map.updateWatchInterest(watch2, {});
+    watch_map.removeWatch(watch1);
+    watch_map.removeWatch(watch2);
+  }
+}
+
+/**
+ * The baseline for bmDeltaSubscriptionNames: the same `state.range(0)` names tracked by the
+ * containers that held them before they were interned, each keyed by its own std::string copy:
+ * the interest sets of the two watches, WatchMap::watch_interest_, the requested resource state of
+ * the subscription state, and the expiry set and lookup map of the TtlManager. Only the names and
+ * versions are tracked, not the responses, so the "memory" counters of the two benchmarks bound the
+ * saving from interning, while their times are not comparable. The number of copies of the names
+ * is reported as "name_copies".
+ */
+void bmDeltaSubscriptionStringNames(::benchmark::State& state) {
+  const int64_t num_resources = benchmark::skipExpensiveBenchmarks() ? 100 : state.range(0);
+
+  std::vector<std::string> names;
+  names.reserve(num_resources);
+  for (int64_t i = 0; i < num_resources; ++i) {
+    names.push_back(absl::StrCat("outbound|8080||service_", i, ".ns.svc.cluster.local"));
+  }
+  const int watch1 = 1;
+  const int watch2 = 2;
+  const MonotonicTime expiry = MonotonicTime() + std::chrono::seconds(60);
+
+  for (auto _ : state) { // NOLINT
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    absl::flat_hash_set<std::string> watch1_names;
+    absl::flat_hash_set<std::string> watch2_names;
+    absl::flat_hash_map<std::string, absl::flat_hash_set<const int*>> watch_interest;
+    absl::node_hash_map<std::string, std::string> requested_resource_state;
+    using TtlSet = std::set<std::pair<MonotonicTime, std::string>>;
+    TtlSet ttls;
+    absl::flat_hash_map<std::string, TtlSet::iterator> ttl_lookup;
+
+    for (const std::string& name : names) {
+      watch1_names.insert(name);
+      watch2_names.insert(name);
+      watch_interest[name].insert(&watch1);
+      watch_interest[name].insert(&watch2);
+      requested_resource_state.emplace(name, "1");
+      ttl_lookup.emplace(name, ttls.emplace(expiry, name).first);
+    }
+
+    state.counters["name_copies"] = watch1_names.size() + watch2_names.size() +
+                                    watch_interest.size() + requested_resource_state.size() +
+                                    ttls.size() + ttl_lookup.size();
+    state.counters["memory"] = Memory::Stats::totalCurrentlyAllocated() - start_mem;
+  }
+}
+
+} // namespace
+
+BENCHMARK(bmDeltaSubscriptionNames)->Arg(1000)->Arg(100000)->Unit(::benchmark::kMillisecond);
+BENCHMARK(bmDeltaSubscriptionStringNames)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace Config
+} // namespace Envoy
@@ -156,7 +156,7 @@ TEST_P(DeltaSubscriptionNoGrpcStreamTest, NoGrpcStream) {
     xds_context = std::make_shared<NewGrpcMuxImpl>(
         std::unique_ptr<Grpc::MockAsyncClient>(async_client), dispatcher, *method_descriptor,
         random, stats_store, rate_limit_settings, local_info,
-        std::make_unique<NiceMock<MockCustomConfigValidators>>());
+        std::make_unique<NiceMock<MockCustomConfigValidators>>(), nullptr);
   }
 
   GrpcSubscriptionImplPtr subscription = std::make_unique<GrpcSubscriptionImpl>(
@@ -42,8 +42,8 @@ protected:
       scoped_runtime.mergeValues({
           {"envoy.restart_features.explicit_wildcard_resource", "false"},
       });
-      state_ = std::make_unique<Envoy::Config::DeltaSubscriptionState>(type_url, callbacks_,
-                                                                       local_info_, dispatcher_);
+      state_ = std::make_unique<Envoy::Config::DeltaSubscriptionState>(
+          type_url, callbacks_, local_info_, dispatcher_, resource_names_);
     }
     updateSubscriptionInterest(initial_resources, {});
     auto cur_request = getNextRequestAckless();
@@ -110,6 +110,7 @@ protected:
   NiceMock<LocalInfo::MockLocalInfo> local_info_;
   NiceMock<Event::MockDispatcher> dispatcher_;
   Event::MockTimer* ttl_timer_;
+  ResourceNamePool resource_names_;
   // We start out interested in three resources: name1, name2, and name3.
   std::unique_ptr<Envoy::Config::DeltaSubscriptionState> state_;
 };
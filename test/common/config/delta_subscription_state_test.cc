@@ -62,8 +62,8 @@ protected:
       state_ = std::make_unique<Envoy::Config::XdsMux::DeltaSubscriptionState>(type_url, callbacks_,
                                                                                dispatcher_);
     } else {
-      state_ = std::make_unique<Envoy::Config::DeltaSubscriptionState>(type_url, callbacks_,
-                                                                       local_info_, dispatcher_);
+      state_ = std::make_unique<Envoy::Config::DeltaSubscriptionState>(
+          type_url, callbacks_, local_info_, dispatcher_, resource_names_);
     }
   }
 
@@ -156,6 +156,7 @@ protected:
   NiceMock<LocalInfo::MockLocalInfo> local_info_;
   NiceMock<Event::MockDispatcher> dispatcher_;
   Event::MockTimer* ttl_timer_;
+  ResourceNamePool resource_names_;
   // We start out interested in three resources: name1, name2, and name3.
   absl::variant<std::unique_ptr<Envoy::Config::DeltaSubscriptionState>,
                 std::unique_ptr<Envoy::Config::XdsMux::DeltaSubscriptionState>>
@@ -23,9 +23,12 @@
 #include "test/test_common/logging.h"
 #include "test/test_common/resources.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/test_time.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -61,7 +64,8 @@ public:
         local_info_, std::unique_ptr<Grpc::MockAsyncClient>(async_client_), dispatcher_,
         *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
             "envoy.service.discovery.v3.AggregatedDiscoveryService.StreamAggregatedResources"),
-        random_, stats_, rate_limit_settings_, true, std::move(config_validators_));
+        random_, stats_, rate_limit_settings_, true, std::move(config_validators_),
+        Thread::threadFactoryForTest());
   }
 
   void setup(const RateLimitSettings& custom_rate_limit_settings) {
@@ -69,7 +73,8 @@ public:
         local_info_, std::unique_ptr<Grpc::MockAsyncClient>(async_client_), dispatcher_,
         *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
             "envoy.service.discovery.v3.AggregatedDiscoveryService.StreamAggregatedResources"),
-        random_, stats_, custom_rate_limit_settings, true, std::move(config_validators_));
+        random_, stats_, custom_rate_limit_settings, true, std::move(config_validators_),
+        Thread::threadFactoryForTest());
   }
 
   void expectSendMessage(const std::string& type_url,
@@ -525,6 +530,86 @@ TEST_F(GrpcMuxImplTest, WildcardWatch) {
   }
 }
 
+// Validate that the resources of a response large enough to be decoded on several threads are
+// delivered in order.
+TEST_F(GrpcMuxImplTest, LargeResponse) {
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment>
+      resource_decoder("cluster_name");
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  const int num_resources = 5000;
+  auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+  response->set_type_url(type_url);
+  response->set_version_info("1");
+  for (int i = 0; i < num_resources; ++i) {
+    envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+    load_assignment.set_cluster_name(absl::StrCat("cluster_", i));
+    response->add_resources()->PackFrom(load_assignment);
+  }
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "1"))
+      .WillOnce(Invoke([num_resources](const std::vector<DecodedResourceRef>& resources,
+                                       const std::string&) {
+        ASSERT_EQ(num_resources, resources.size());
+        for (int i = 0; i < num_resources; ++i) {
+          EXPECT_EQ(absl::StrCat("cluster_", i), resources[i].get().name());
+          EXPECT_EQ(absl::StrCat("cluster_", i),
+                    dynamic_cast<const envoy::config::endpoint::v3::ClusterLoadAssignment&>(
+                        resources[i].get().resource())
+                        .cluster_name());
+        }
+      }));
+  expectSendMessage(type_url, {}, "1");
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+}
+
+// Validate that a large response is rejected with the error of its first invalid resource, with
+// and without parallel decoding.
+TEST_F(GrpcMuxImplTest, LargeResponseWithInvalidResources) {
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment>
+      resource_decoder("cluster_name");
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  for (const bool parallel : {true, false}) {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues({{"envoy.reloadable_features.parallel_xds_resource_decoding",
+                                 parallel ? "true" : "false"}});
+
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("1");
+    for (int i = 0; i < 5000; ++i) {
+      envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+      // An empty cluster name fails validation.
+      load_assignment.set_cluster_name(i == 3000 ? "" : absl::StrCat("cluster_", i));
+      ProtobufWkt::Any* resource = response->add_resources();
+      resource->PackFrom(load_assignment);
+      if (i == 4000) {
+        resource->set_type_url("bar");
+      }
+    }
+    EXPECT_CALL(callbacks_, onConfigUpdateFailed(ConfigUpdateFailureReason::UpdateRejected, _))
+        .WillOnce(Invoke([](ConfigUpdateFailureReason, const EnvoyException* e) {
+          EXPECT_TRUE(IsSubstring("", "", "Proto constraint validation failed", e->what()));
+        }));
+    EXPECT_CALL(async_stream_, sendMessageRaw_(_, false));
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+}
+
 // Validate behavior when watches specify resources (potentially overlapping).
 TEST_F(GrpcMuxImplTest, WatchDemux) {
   setup();
@@ -885,7 +970,7 @@ TEST_F(GrpcMuxImplTest, BadLocalInfoEmptyClusterName) {
           *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
               "envoy.service.discovery.v3.AggregatedDiscoveryService.StreamAggregatedResources"),
           random_, stats_, rate_limit_settings_, true,
-          std::make_unique<NiceMock<MockCustomConfigValidators>>()),
+          std::make_unique<NiceMock<MockCustomConfigValidators>>(), Thread::threadFactoryForTest()),
       EnvoyException,
       "ads: node 'id' and 'cluster' are required. Set it either in 'node' config or via "
       "--service-node and --service-cluster options.");
@@ -899,7 +984,7 @@ TEST_F(GrpcMuxImplTest, BadLocalInfoEmptyNodeName) {
           *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
               "envoy.service.discovery.v3.AggregatedDiscoveryService.StreamAggregatedResources"),
           random_, stats_, rate_limit_settings_, true,
-          std::make_unique<NiceMock<MockCustomConfigValidators>>()),
+          std::make_unique<NiceMock<MockCustomConfigValidators>>(), Thread::threadFactoryForTest()),
       EnvoyException,
       "ads: node 'id' and 'cluster' are required. Set it either in 'node' config or via "
       "--service-node and --service-cluster options.");
@@ -45,6 +45,36 @@ namespace {
 
 enum class LegacyOrUnified { Legacy, Unified };
 
+// Key value store backed by a map owned by the test, so that the test can inspect and seed its
+// contents after handing the store to the mux.
+class TestKeyValueStore : public KeyValueStore {
+public:
+  explicit TestKeyValueStore(std::map<std::string, std::string>& contents) : contents_(contents) {}
+
+  void addOrUpdate(absl::string_view key, absl::string_view value) override {
+    contents_[std::string(key)] = std::string(value);
+  }
+  void remove(absl::string_view key) override { contents_.erase(std::string(key)); }
+  absl::optional<absl::string_view> get(absl::string_view key) override {
+    auto it = contents_.find(std::string(key));
+    if (it == contents_.end()) {
+      return absl::nullopt;
+    }
+    return it->second;
+  }
+  void flush() override {}
+  void iterate(ConstIterateCb cb) const override {
+    for (const auto& [key, value] : contents_) {
+      if (cb(key, value) == Iterate::Break) {
+        return;
+      }
+    }
+  }
+
+private:
+  std::map<std::string, std::string>& contents_;
+};
+
 // We test some mux specific stuff below, other unit test coverage for singleton use of
 // NewGrpcMuxImpl is provided in [grpc_]subscription_impl_test.cc.
 class NewGrpcMuxImplTestBase : public testing::TestWithParam<LegacyOrUnified> {
@@ -70,7 +100,8 @@ public:
         std::unique_ptr<Grpc::MockAsyncClient>(async_client_), dispatcher_,
         *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
             "envoy.service.discovery.v3.AggregatedDiscoveryService.StreamAggregatedResources"),
-        random_, stats_, rate_limit_settings_, local_info_, std::move(config_validators_));
+        random_, stats_, rate_limit_settings_, local_info_, std::move(config_validators_),
+        std::move(snapshot_store_));
   }
 
   void expectSendMessage(const std::string& type_url,
@@ -154,6 +185,7 @@ public:
   Grpc::MockAsyncClient* async_client_;
   NiceMock<Grpc::MockAsyncStream> async_stream_;
   CustomConfigValidatorsPtr config_validators_;
+  KeyValueStorePtr snapshot_store_;
   NiceMock<LocalInfo::MockLocalInfo> local_info_;
   std::unique_ptr<GrpcMux> grpc_mux_;
   NiceMock<Config::MockSubscriptionCallbacks> callbacks_;
@@ -553,6 +585,247 @@ TEST_P(NewGrpcMuxImplTest, Shutdown) {
   // There won't be any unsubscribe messages for the legacy mux either for the same reason
 }
 
+class NewGrpcMuxImplSnapshotTest : public NewGrpcMuxImplTestBase {
+public:
+  NewGrpcMuxImplSnapshotTest() : NewGrpcMuxImplTestBase(LegacyOrUnified::Legacy) {}
+
+  void setupWithSnapshot() {
+    snapshot_store_ = std::make_unique<TestKeyValueStore>(snapshot_);
+    replay_callback_ = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+    setup();
+  }
+
+  static std::string snapshotKey(const std::string& name) {
+    return absl::StrCat(Config::TypeUrl::get().ClusterLoadAssignment, "\n", name);
+  }
+
+  static envoy::service::discovery::v3::Resource makeResource(const std::string& name,
+                                                              const std::string& version) {
+    envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+    load_assignment.set_cluster_name(name);
+    envoy::service::discovery::v3::Resource resource;
+    resource.set_name(name);
+    resource.set_version(version);
+    resource.mutable_resource()->PackFrom(load_assignment);
+    return resource;
+  }
+
+  void addToSnapshot(const std::string& name, const std::string& version) {
+    snapshot_[snapshotKey(name)] = makeResource(name, version).SerializeAsString();
+  }
+
+  // Replaces the mux with a new one loading the same snapshot, as a restart would.
+  void restart() {
+    grpc_mux_.reset();
+    testing::Mock::VerifyAndClearExpectations(&async_stream_);
+    async_client_ = new Grpc::MockAsyncClient();
+    config_validators_ = std::make_unique<NiceMock<MockCustomConfigValidators>>();
+    setupWithSnapshot();
+  }
+
+  std::map<std::string, std::string> snapshot_;
+  Event::MockSchedulableCallback* replay_callback_;
+};
+
+// Restored resources are delivered to a wildcard watch before the initial request is sent, and
+// the initial request carries their versions.
+TEST_F(NewGrpcMuxImplSnapshotTest, RestoresWildcardWatch) {
+  addToSnapshot("x", "1");
+  addToSnapshot("y", "2");
+  snapshot_["garbage"] = "not a resource";
+  setupWithSnapshot();
+
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  grpc_mux_->start();
+
+  // The initial request waits for the restored resources to be delivered.
+  EXPECT_CALL(async_stream_, sendMessageRaw_(_, _)).Times(0);
+  auto watch = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder_, {});
+  EXPECT_TRUE(replay_callback_->enabled_);
+  testing::Mock::VerifyAndClearExpectations(&async_stream_);
+
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, _, ""))
+      .WillOnce(Invoke([](const std::vector<DecodedResourceRef>& added_resources,
+                          const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+                          const std::string&) {
+        EXPECT_EQ(2, added_resources.size());
+        EXPECT_TRUE(removed_resources.empty());
+      }));
+  expectSendMessage(type_url, {}, {}, "", Grpc::Status::WellKnownGrpcStatus::Ok, "",
+                    {{"x", "1"}, {"y", "2"}});
+  replay_callback_->invokeCallback();
+}
+
+// Only the restored resources a watch asks for are delivered to it, and resources restored after
+// the server has responded are not delivered at all.
+TEST_F(NewGrpcMuxImplSnapshotTest, RestoresWatchedResources) {
+  addToSnapshot("x", "1");
+  addToSnapshot("y", "2");
+  setupWithSnapshot();
+
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  grpc_mux_->start();
+
+  auto watch = grpc_mux_->addWatch(type_url, {"x"}, callbacks_, resource_decoder_, {});
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, _, ""))
+      .WillOnce(Invoke([](const std::vector<DecodedResourceRef>& added_resources,
+                          const Protobuf::RepeatedPtrField<std::string>&, const std::string&) {
+        ASSERT_EQ(1, added_resources.size());
+        EXPECT_EQ("x", added_resources[0].get().name());
+        EXPECT_EQ("1", added_resources[0].get().version());
+      }));
+  expectSendMessage(type_url, {"x"}, {}, "", Grpc::Status::WellKnownGrpcStatus::Ok, "",
+                    {{"x", "1"}});
+  replay_callback_->invokeCallback();
+
+  auto response = std::make_unique<envoy::service::discovery::v3::DeltaDiscoveryResponse>();
+  response->set_type_url(type_url);
+  response->set_system_version_info("1");
+  response->set_nonce("111");
+  *response->add_resources() = makeResource("x", "2");
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, _, "1"));
+  expectSendMessage(type_url, {}, {}, "111");
+  onDiscoveryResponse(std::move(response));
+
+  EXPECT_CALL(*replay_callback_, scheduleCallbackCurrentIteration()).Times(0);
+  expectSendMessage(type_url, {"y"}, {});
+  watch->update({"x", "y"});
+}
+
+// Accepted resources are persisted with their versions, removed resources are forgotten and
+// rejected responses leave the snapshot untouched.
+TEST_F(NewGrpcMuxImplSnapshotTest, PersistsAcceptedResources) {
+  setupWithSnapshot();
+
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  auto watch = grpc_mux_->addWatch(type_url, {"x", "y"}, callbacks_, resource_decoder_, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {"x", "y"}, {});
+  grpc_mux_->start();
+
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DeltaDiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_nonce("1");
+    *response->add_resources() = makeResource("x", "1");
+    *response->add_resources() = makeResource("y", "1");
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, _, _));
+    expectSendMessage(type_url, {}, {}, "1");
+    onDiscoveryResponse(std::move(response));
+  }
+  ASSERT_EQ(2, snapshot_.size());
+  envoy::service::discovery::v3::Resource persisted;
+  ASSERT_TRUE(persisted.ParseFromString(snapshot_[snapshotKey("x")]));
+  EXPECT_TRUE(TestUtility::protoEqual(makeResource("x", "1"), persisted));
+
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DeltaDiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_nonce("2");
+    *response->add_resources() = makeResource("x", "2");
+    *response->add_resources() = makeResource("x", "2");
+    EXPECT_CALL(callbacks_, onConfigUpdateFailed(_, _));
+    expectSendMessage(type_url, {}, {}, "2", Grpc::Status::WellKnownGrpcStatus::Internal,
+                      "duplicate name x found among added/updated resources");
+    onDiscoveryResponse(std::move(response));
+  }
+  ASSERT_TRUE(persisted.ParseFromString(snapshot_[snapshotKey("x")]));
+  EXPECT_EQ("1", persisted.version());
+
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DeltaDiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_nonce("3");
+    response->add_removed_resources("y");
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, _, _));
+    expectSendMessage(type_url, {}, {}, "3");
+    onDiscoveryResponse(std::move(response));
+  }
+  EXPECT_EQ(1, snapshot_.size());
+  EXPECT_EQ(0, snapshot_.count(snapshotKey("y")));
+
+  expectSendMessage(type_url, {}, {"x", "y"});
+}
+
+// Restored resources that are not delivered before the server responds, and restored resources
+// of types nothing subscribes to, are removed from the snapshot rather than restored on every
+// start.
+TEST_F(NewGrpcMuxImplSnapshotTest, ForgetsUndeliveredResources) {
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  const std::string other_type_key = absl::StrCat(Config::TypeUrl::get().Cluster, "\nc");
+  setupWithSnapshot();
+
+  // First start: the server sends both watched resources, which are persisted.
+  {
+    auto watch = grpc_mux_->addWatch(type_url, {"x", "y"}, callbacks_, resource_decoder_, {});
+    EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+    expectSendMessage(type_url, {"x", "y"}, {});
+    grpc_mux_->start();
+
+    auto response = std::make_unique<envoy::service::discovery::v3::DeltaDiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_nonce("1");
+    *response->add_resources() = makeResource("x", "1");
+    *response->add_resources() = makeResource("y", "1");
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, _, _));
+    expectSendMessage(type_url, {}, {}, "1");
+    onDiscoveryResponse(std::move(response));
+    EXPECT_EQ(2, snapshot_.size());
+
+    expectSendMessage(type_url, {}, {"x", "y"});
+  }
+  // A resource of a type the next configuration does not subscribe to.
+  envoy::service::discovery::v3::Resource other = makeResource("c", "1");
+  other.mutable_resource()->set_type_url(Config::TypeUrl::get().Cluster);
+  snapshot_[other_type_key] = other.SerializeAsString();
+
+  // Second start: only "x" is watched, so "y" is never delivered.
+  restart();
+  {
+    EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+    grpc_mux_->start();
+    auto watch = grpc_mux_->addWatch(type_url, {"x"}, callbacks_, resource_decoder_, {});
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, _, ""));
+    expectSendMessage(type_url, {"x"}, {}, "", Grpc::Status::WellKnownGrpcStatus::Ok, "",
+                      {{"x", "1"}});
+    replay_callback_->invokeCallback();
+
+    auto response = std::make_unique<envoy::service::discovery::v3::DeltaDiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_nonce("2");
+    *response->add_resources() = makeResource("x", "2");
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, _, _));
+    expectSendMessage(type_url, {}, {}, "2");
+    onDiscoveryResponse(std::move(response));
+    EXPECT_EQ(0, snapshot_.count(snapshotKey("y")));
+    EXPECT_EQ(1, snapshot_.count(other_type_key));
+
+    grpc_mux_->onServerInitialized();
+    EXPECT_EQ(0, snapshot_.count(other_type_key));
+    ASSERT_EQ(1, snapshot_.size());
+
+    expectSendMessage(type_url, {}, {"x"});
+  }
+
+  // Third start: only "x" is restored.
+  restart();
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  grpc_mux_->start();
+  auto watch = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder_, {});
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, _, ""))
+      .WillOnce(Invoke([](const std::vector<DecodedResourceRef>& added_resources,
+                          const Protobuf::RepeatedPtrField<std::string>&, const std::string&) {
+        ASSERT_EQ(1, added_resources.size());
+        EXPECT_EQ("x", added_resources[0].get().name());
+        EXPECT_EQ("2", added_resources[0].get().version());
+      }));
+  expectSendMessage(type_url, {}, {}, "", Grpc::Status::WellKnownGrpcStatus::Ok, "",
+                    {{"x", "2"}});
+  replay_callback_->invokeCallback();
+}
+
 } // namespace
 } // namespace Config
 } // namespace Envoy
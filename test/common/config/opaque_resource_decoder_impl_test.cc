@@ -77,6 +77,53 @@ TEST_F(OpaqueResourceDecoderImplTest, Success) {
   EXPECT_EQ("foo", result.second);
 }
 
+// prepareResource() and finishResource() decode the same message as decodeResource().
+TEST_F(OpaqueResourceDecoderImplTest, PrepareAndFinishSuccess) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_resource;
+  cluster_resource.set_cluster_name("foo");
+  ProtobufWkt::Any opaque_resource;
+  opaque_resource.PackFrom(cluster_resource);
+  const auto decoded_resource =
+      resource_decoder_.finishResource(resource_decoder_.prepareResource(opaque_resource));
+  EXPECT_THAT(*decoded_resource, ProtoEq(cluster_resource));
+  EXPECT_EQ("foo", resource_decoder_.resourceName(*decoded_resource));
+}
+
+TEST_F(OpaqueResourceDecoderImplTest, PrepareAndFinishEmpty) {
+  ProtobufWkt::Any opaque_resource;
+  const auto decoded_resource =
+      resource_decoder_.finishResource(resource_decoder_.prepareResource(opaque_resource));
+  EXPECT_THAT(*decoded_resource, ProtoEq(envoy::config::endpoint::v3::ClusterLoadAssignment()));
+}
+
+// Errors are not thrown by prepareResource(), but by finishResource().
+TEST_F(OpaqueResourceDecoderImplTest, PrepareAndFinishErrors) {
+  {
+    ProtobufWkt::Any opaque_resource;
+    opaque_resource.set_type_url("huh");
+    PreparedResourcePtr prepared = resource_decoder_.prepareResource(opaque_resource);
+    EXPECT_THROW_WITH_REGEX(resource_decoder_.finishResource(std::move(prepared)), EnvoyException,
+                            "Unable to unpack");
+  }
+  {
+    ProtobufWkt::Any opaque_resource;
+    opaque_resource.PackFrom(envoy::config::endpoint::v3::ClusterLoadAssignment());
+    PreparedResourcePtr prepared = resource_decoder_.prepareResource(opaque_resource);
+    EXPECT_THROW(resource_decoder_.finishResource(std::move(prepared)), ProtoValidationException);
+  }
+  {
+    // The strict validation visitor rejects unknown fields when finishing.
+    envoy::config::endpoint::v3::ClusterLoadAssignment strange_resource;
+    strange_resource.set_cluster_name("fare");
+    strange_resource.GetReflection()->MutableUnknownFields(&strange_resource)->AddFixed32(1000, 1);
+    ProtobufWkt::Any opaque_resource;
+    opaque_resource.PackFrom(strange_resource);
+    PreparedResourcePtr prepared = resource_decoder_.prepareResource(opaque_resource);
+    EXPECT_THROW_WITH_REGEX(resource_decoder_.finishResource(std::move(prepared)), EnvoyException,
+                            "unknown field");
+  }
+}
+
 } // namespace
 } // namespace Config
 } // namespace Envoy
@@ -0,0 +1,121 @@
+#include "envoy/config/endpoint/v3/endpoint.pb.h"
+#include "envoy/config/endpoint/v3/endpoint.pb.validate.h"
+#include "envoy/service/discovery/v3/discovery.pb.h"
+
+#include "source/common/config/decoded_resource_impl.h"
+#include "source/common/config/parallel_resource_preparer.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+using ClusterLoadAssignment = envoy::config::endpoint::v3::ClusterLoadAssignment;
+
+// Counts the threads created through it.
+class CountingThreadFactory : public Thread::ThreadFactory {
+public:
+  Thread::ThreadPtr createThread(std::function<void()> thread_routine,
+                                 Thread::OptionsOptConstRef options) override {
+    ++threads_created_;
+    return Thread::threadFactoryForTest().createThread(std::move(thread_routine), options);
+  }
+  Thread::ThreadId currentThreadId() override {
+    return Thread::threadFactoryForTest().currentThreadId();
+  }
+
+  uint32_t threads_created_{};
+};
+
+class ParallelResourcePreparerTest : public testing::Test {
+public:
+  void addResources(int count) {
+    for (int i = 0; i < count; ++i) {
+      ClusterLoadAssignment load_assignment;
+      load_assignment.set_cluster_name(absl::StrCat("cluster_", resources_.size()));
+      resources_.Add()->PackFrom(load_assignment);
+    }
+  }
+
+  TestUtility::TestOpaqueResourceDecoderImpl<ClusterLoadAssignment> resource_decoder_{
+      "cluster_name"};
+  Protobuf::RepeatedPtrField<ProtobufWkt::Any> resources_;
+};
+
+// Small responses are left to the caller to decode sequentially.
+TEST_F(ParallelResourcePreparerTest, TooFewResources) {
+  ParallelResourcePreparer preparer(Thread::threadFactoryForTest(), 4, 10);
+  addResources(19);
+  EXPECT_TRUE(preparer.prepare(resource_decoder_, resources_).empty());
+
+  ParallelResourcePreparer single_thread_preparer(Thread::threadFactoryForTest(), 1, 10);
+  addResources(100);
+  EXPECT_TRUE(single_thread_preparer.prepare(resource_decoder_, resources_).empty());
+}
+
+// The prepared resources are in the order of the response, and decode to the same resources as
+// DecodedResourceImpl::fromResource().
+TEST_F(ParallelResourcePreparerTest, PreservesOrder) {
+  ParallelResourcePreparer preparer(Thread::threadFactoryForTest(), 4, 10);
+  addResources(1000);
+
+  std::vector<PreparedResourcePtr> prepared = preparer.prepare(resource_decoder_, resources_);
+  ASSERT_EQ(1000, prepared.size());
+  for (int i = 0; i < resources_.size(); ++i) {
+    ASSERT_NE(nullptr, prepared[i]);
+    auto decoded =
+        DecodedResourceImpl::fromPreparedResource(resource_decoder_, std::move(prepared[i]), "1");
+    auto expected = DecodedResourceImpl::fromResource(resource_decoder_, resources_[i], "1");
+    EXPECT_EQ(absl::StrCat("cluster_", i), decoded->name());
+    EXPECT_EQ(expected->name(), decoded->name());
+    EXPECT_EQ("1", decoded->version());
+    EXPECT_TRUE(decoded->hasResource());
+    EXPECT_TRUE(TestUtility::protoEqual(expected->resource(), decoded->resource()));
+  }
+}
+
+// The threads helping the calling thread are started by the first large response and reused by
+// the following ones.
+TEST_F(ParallelResourcePreparerTest, ReusesThreads) {
+  CountingThreadFactory thread_factory;
+  ParallelResourcePreparer preparer(thread_factory, 4, 10);
+  addResources(19);
+  EXPECT_TRUE(preparer.prepare(resource_decoder_, resources_).empty());
+  EXPECT_EQ(0, thread_factory.threads_created_);
+
+  addResources(1000);
+  for (int i = 0; i < 3; ++i) {
+    std::vector<PreparedResourcePtr> prepared = preparer.prepare(resource_decoder_, resources_);
+    ASSERT_EQ(resources_.size(), prepared.size());
+    for (int j = 0; j < resources_.size(); ++j) {
+      ASSERT_NE(nullptr, prepared[j]);
+      auto decoded =
+          DecodedResourceImpl::fromPreparedResource(resource_decoder_, std::move(prepared[j]), "1");
+      EXPECT_EQ(absl::StrCat("cluster_", j), decoded->name());
+    }
+    EXPECT_EQ(3, thread_factory.threads_created_);
+  }
+}
+
+// Resources wrapped in a Resource are not prepared.
+TEST_F(ParallelResourcePreparerTest, SkipsWrappedResources) {
+  ParallelResourcePreparer preparer(Thread::threadFactoryForTest(), 2, 1);
+  addResources(1);
+  envoy::service::discovery::v3::Resource wrapped;
+  wrapped.set_name("wrapped");
+  resources_.Add()->PackFrom(wrapped);
+
+  std::vector<PreparedResourcePtr> prepared = preparer.prepare(resource_decoder_, resources_);
+  ASSERT_EQ(2, prepared.size());
+  EXPECT_NE(nullptr, prepared[0]);
+  EXPECT_EQ(nullptr, prepared[1]);
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
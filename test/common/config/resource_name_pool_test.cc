@@ -0,0 +1,74 @@
+#include <string>
+
+#include "source/common/config/resource_name_pool.h"
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Config {
+namespace {
+
+TEST(ResourceNamePoolTest, InternSharesOneCopyPerName) {
+  ResourceNamePool pool;
+  {
+    InternedResourceName a1 = pool.intern("a");
+    InternedResourceName a2 = pool.intern(std::string("a"));
+    InternedResourceName b = pool.intern("b");
+    EXPECT_EQ(2, pool.size());
+
+    EXPECT_EQ("a", a1.name());
+    EXPECT_EQ(&a1.name(), &a2.name());
+    EXPECT_EQ(a1, a2);
+    EXPECT_NE(a1, b);
+    EXPECT_LT(a1, b);
+  }
+  EXPECT_EQ(0, pool.size());
+}
+
+TEST(ResourceNamePoolTest, NameIsReleasedWithItsLastHandle) {
+  ResourceNamePool pool;
+  absl::optional<InternedResourceName> copy;
+  {
+    InternedResourceName name = pool.intern("a");
+    copy = name;
+    InternedResourceName moved(std::move(name));
+    EXPECT_EQ(1, pool.size());
+  }
+  EXPECT_EQ(1, pool.size());
+  EXPECT_EQ("a", copy->name());
+
+  InternedResourceName other = pool.intern("b");
+  copy = other;
+  EXPECT_EQ(1, pool.size());
+  EXPECT_EQ("b", copy->name());
+
+  copy.reset();
+  EXPECT_EQ(1, pool.size());
+}
+
+TEST(ResourceNamePoolTest, ContainersLookUpPlainNames) {
+  ResourceNamePool pool;
+  {
+    InternedResourceNameSet set;
+    set.insert(pool.intern("a"));
+    EXPECT_TRUE(set.contains("a"));
+    EXPECT_TRUE(set.contains(std::string("a")));
+    EXPECT_FALSE(set.contains("b"));
+
+    InternedResourceNameMap<int> map;
+    map.emplace(pool.intern("a"), 1);
+    map.emplace(pool.intern("b"), 2);
+    ASSERT_NE(map.end(), map.find("b"));
+    EXPECT_EQ(2, map.find("b")->second);
+    EXPECT_EQ(2, pool.size());
+
+    EXPECT_EQ(1, map.erase("b"));
+    EXPECT_EQ(1, pool.size());
+  }
+  EXPECT_EQ(0, pool.size());
+}
+
+} // namespace
+} // namespace Config
+} // namespace Envoy
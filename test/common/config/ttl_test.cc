@@ -16,13 +16,14 @@ public:
   TtlManagerTest() { test_time_.setSystemTime(std::chrono::milliseconds(0)); }
   Event::MockDispatcher dispatcher_;
   Event::SimulatedTimeSystem test_time_;
+  ResourceNamePool resource_names_;
 };
 
 TEST_F(TtlManagerTest, BasicUsage) {
   absl::optional<std::vector<std::string>> maybe_expired;
   auto cb = [&](const auto& expired) { maybe_expired = expired; };
   auto ttl_timer = new Event::MockTimer(&dispatcher_);
-  TtlManager ttl(cb, dispatcher_, dispatcher_.timeSource());
+  TtlManager ttl(cb, dispatcher_, dispatcher_.timeSource(), resource_names_);
 
   EXPECT_CALL(*ttl_timer, enableTimer(std::chrono::milliseconds(1), _));
   EXPECT_CALL(*ttl_timer, enabled());
@@ -54,11 +55,37 @@ TEST_F(TtlManagerTest, BasicUsage) {
   ttl.clear("not hello");
 }
 
+// The tracked names are interned in the shared pool for as long as they have a TTL.
+TEST_F(TtlManagerTest, InternsTrackedNames) {
+  auto cb = [&](const auto&) {};
+  auto ttl_timer = new Event::MockTimer(&dispatcher_);
+  TtlManager ttl(cb, dispatcher_, dispatcher_.timeSource(), resource_names_);
+  InternedResourceName hello = resource_names_.intern("hello");
+
+  {
+    const auto scoped = ttl.scopedTtlUpdate();
+    ttl.add(std::chrono::milliseconds(1), "hello");
+    ttl.add(std::chrono::milliseconds(5), "not hello");
+    EXPECT_CALL(*ttl_timer, enableTimer(std::chrono::milliseconds(1), _));
+    EXPECT_CALL(*ttl_timer, enabled());
+  }
+  EXPECT_EQ(2, resource_names_.size());
+
+  {
+    const auto scoped = ttl.scopedTtlUpdate();
+    ttl.clear("hello");
+    ttl.clear("not hello");
+    EXPECT_CALL(*ttl_timer, disableTimer());
+  }
+  // Only the handle held by the test is left.
+  EXPECT_EQ(1, resource_names_.size());
+}
+
 TEST_F(TtlManagerTest, ScopedUpdate) {
   absl::optional<std::vector<std::string>> maybe_expired;
   auto cb = [&](const auto& expired) { maybe_expired = expired; };
   auto ttl_timer = new Event::MockTimer(&dispatcher_);
-  TtlManager ttl(cb, dispatcher_, dispatcher_.timeSource());
+  TtlManager ttl(cb, dispatcher_, dispatcher_.timeSource(), resource_names_);
 
   {
     const auto scoped = ttl.scopedTtlUpdate();
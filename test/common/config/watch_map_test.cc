@@ -394,6 +394,33 @@ TEST(WatchMapTest, AddRemoveAdd) {
   }
 }
 
+// Checks that watches on the same names share the names interned in the WatchMap's pool, and that
+// the names leave the pool once no watch is interested in them any more.
+TEST(WatchMapTest, WatchesShareInternedNames) {
+  MockSubscriptionCallbacks callbacks1;
+  MockSubscriptionCallbacks callbacks2;
+  TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment>
+      resource_decoder("cluster_name");
+  NiceMock<MockCustomConfigValidators> config_validators;
+  WatchMap watch_map(false, "ClusterLoadAssignmentType", config_validators);
+  Watch* watch1 = watch_map.addWatch(callbacks1, resource_decoder);
+  Watch* watch2 = watch_map.addWatch(callbacks2, resource_decoder);
+
+  watch_map.updateWatchInterest(watch1, {"alice", "bob"});
+  watch_map.updateWatchInterest(watch2, {"bob", "carol"});
+  EXPECT_EQ(3, watch_map.resourceNames().size());
+
+  AddedRemoved added_removed = watch_map.updateWatchInterest(watch1, {"bob"});
+  EXPECT_EQ(absl::flat_hash_set<std::string>({"alice"}), added_removed.removed_);
+  EXPECT_EQ(2, watch_map.resourceNames().size());
+
+  watch_map.updateWatchInterest(watch1, {});
+  watch_map.updateWatchInterest(watch2, {});
+  EXPECT_EQ(0, watch_map.resourceNames().size());
+  watch_map.removeWatch(watch1);
+  watch_map.removeWatch(watch2);
+}
+
 // Tests that nothing breaks if an update arrives that we entirely do not care about.
 TEST(WatchMapTest, UninterestingUpdate) {
   MockSubscriptionCallbacks callbacks;
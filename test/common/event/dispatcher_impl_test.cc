@@ -831,6 +831,50 @@ TEST_F(DispatcherMonotonicTimeTest, ApproximateMonotonicTime) {
   dispatcher_->run(Dispatcher::RunType::Block);
 }
 
+TEST(DispatcherEventLoopTimesTest, SaturatedLoopAccountsBusyTime) {
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher(api->allocateDispatcher("test_thread"));
+  TimeSource& time_source = dispatcher->timeSource();
+  dispatcher->enableEventLoopTimes();
+
+  // Saturate the loop with a callback that spins for 50ms, then let it idle until the timer fires
+  // 100ms after it was armed.
+  dispatcher->post([&time_source]() {
+    const MonotonicTime start = time_source.monotonicTime();
+    while (time_source.monotonicTime() - start < std::chrono::milliseconds(50)) {
+    }
+  });
+  TimerPtr timer = dispatcher->createTimer([&dispatcher]() { dispatcher->exit(); });
+  timer->enableTimer(std::chrono::milliseconds(100));
+  dispatcher->run(Dispatcher::RunType::RunUntilExit);
+
+  const EventLoopTimes times = dispatcher->eventLoopTimes();
+  EXPECT_GE(times.busy_, std::chrono::milliseconds(50));
+  EXPECT_GE(times.polling_, std::chrono::milliseconds(25));
+
+  // The time spent in a callback is accounted before the loop gets back to polling.
+  dispatcher->post([&dispatcher, &time_source, &times]() {
+    const MonotonicTime start = time_source.monotonicTime();
+    while (time_source.monotonicTime() - start < std::chrono::milliseconds(10)) {
+    }
+    EXPECT_GE(dispatcher->eventLoopTimes().busy_ - times.busy_, std::chrono::milliseconds(10));
+  });
+  dispatcher->run(Dispatcher::RunType::NonBlock);
+}
+
+TEST(DispatcherEventLoopTimesTest, NotTimedUntilEnabled) {
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher(api->allocateDispatcher("test_thread"));
+
+  TimerPtr timer = dispatcher->createTimer([&dispatcher]() { dispatcher->exit(); });
+  timer->enableTimer(std::chrono::milliseconds(10));
+  dispatcher->run(Dispatcher::RunType::RunUntilExit);
+
+  const EventLoopTimes times = dispatcher->eventLoopTimes();
+  EXPECT_EQ(std::chrono::microseconds(0), times.busy_);
+  EXPECT_EQ(std::chrono::microseconds(0), times.polling_);
+}
+
 class TimerImplTest : public testing::Test {
 protected:
   TimerImplTest() {
@@ -1,5 +1,6 @@
 #include "envoy/common/platform.h"
 
+#include "source/common/grpc/codec.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/message_impl.h"
@@ -405,5 +406,14 @@ TEST(GrpcContextTest, PrependGrpcFrameHeader) {
   EXPECT_EQ(buffer->toString(), header_string + "test");
 }
 
+// Ensure that frame flags are carried into the gRPC header.
+TEST(GrpcContextTest, PrependCompressedGrpcFrameHeader) {
+  auto buffer = std::make_unique<Buffer::OwnedImpl>();
+  buffer->add("test", 4);
+  Common::prependGrpcFrameHeader(*buffer, GRPC_FH_COMPRESSED);
+  EXPECT_EQ(5 + 4, buffer->length());
+  EXPECT_EQ(GRPC_FH_COMPRESSED, static_cast<uint8_t>(buffer->toString()[0]));
+}
+
 } // namespace Grpc
 } // namespace Envoy
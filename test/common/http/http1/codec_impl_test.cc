@@ -1981,7 +1981,7 @@ TEST_F(Http1ServerConnectionImplTest, ConnectRequestWithZeroContentLength) {
 }
 
 TEST_F(Http1ServerConnectionImplTest, WatermarkTest) {
-  EXPECT_CALL(connection_, bufferLimit()).WillOnce(Return(10));
+  EXPECT_CALL(connection_, bufferLimit()).WillRepeatedly(Return(10));
   initialize();
 
   NiceMock<MockRequestDecoder> decoder;
@@ -2014,6 +2014,34 @@ TEST_F(Http1ServerConnectionImplTest, WatermarkTest) {
       ->onUnderlyingConnectionBelowWriteBufferLowWatermark();
 }
 
+// The output buffer follows changes of the connection buffer limit between requests.
+TEST_F(Http1ServerConnectionImplTest, WatermarkFollowsConnectionBufferLimit) {
+  EXPECT_CALL(connection_, bufferLimit()).WillRepeatedly(Return(10));
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillRepeatedly(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  TestResponseHeaderMapImpl headers{{":status", "200"}};
+  response_encoder->encodeHeaders(headers, true);
+
+  // With a larger limit, the 200 response headers no longer exceed the high watermark.
+  EXPECT_CALL(connection_, bufferLimit()).WillRepeatedly(Return(1024));
+  buffer.add("GET / HTTP/1.1\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  Http::MockStreamCallbacks stream_callbacks;
+  response_encoder->getStream().addCallbacks(stream_callbacks);
+  EXPECT_CALL(stream_callbacks, onAboveWriteBufferHighWatermark()).Times(0);
+  response_encoder->encodeHeaders(headers, true);
+}
+
 TEST_F(Http1ServerConnectionImplTest, TestSmugglingDisallowChunkedContentLength0) {
   testServerAllowChunkedContentLength(0, false);
 }
@@ -0,0 +1,123 @@
+// Compares the reflection-based DeterministicProtoHash::hash() against hashing the
+// Protobuf::TextFormat rendering of the message, which MessageUtil::hash() uses when
+// envoy.restart_features.use_fast_protobuf_hash is disabled.
+//
+// Note: this should be run with --compilation_mode=opt.
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/config/route/v3/route.pb.h"
+
+#include "source/common/common/hash.h"
+#include "source/common/protobuf/deterministic_hash.h"
+#include "source/common/protobuf/protobuf.h"
+
+#include "test/benchmark/main.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+uint64_t textFormatHash(const Protobuf::Message& message) {
+  std::string text_format;
+  Protobuf::TextFormat::Printer printer;
+  printer.SetExpandAny(true);
+  printer.SetUseFieldNumber(true);
+  printer.SetSingleLineMode(true);
+  printer.SetHideUnknownFields(true);
+  printer.PrintToString(message, &text_format);
+  return HashUtil::xxHash64(text_format);
+}
+
+// A cluster with a static load assignment of the given number of endpoints.
+envoy::config::cluster::v3::Cluster makeCluster(int64_t num_endpoints) {
+  envoy::config::cluster::v3::Cluster cluster;
+  cluster.set_name("service_cluster");
+  cluster.mutable_connect_timeout()->set_seconds(5);
+  cluster.set_lb_policy(envoy::config::cluster::v3::Cluster::LEAST_REQUEST);
+  cluster.mutable_circuit_breakers()->add_thresholds()->mutable_max_connections()->set_value(1024);
+  ProtobufWkt::Struct& filter_metadata =
+      (*cluster.mutable_metadata()->mutable_filter_metadata())["envoy.lb"];
+  (*filter_metadata.mutable_fields())["canary"].set_bool_value(false);
+  (*filter_metadata.mutable_fields())["version"].set_string_value("v1.2.3");
+
+  auto* load_assignment = cluster.mutable_load_assignment();
+  load_assignment->set_cluster_name("service_cluster");
+  auto* locality_endpoints = load_assignment->add_endpoints();
+  locality_endpoints->mutable_locality()->set_zone("us-east-1a");
+  for (int64_t i = 0; i < num_endpoints; ++i) {
+    auto* lb_endpoint = locality_endpoints->add_lb_endpoints();
+    auto* socket_address =
+        lb_endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address();
+    socket_address->set_address(absl::StrCat("10.0.", i / 256, ".", i % 256));
+    socket_address->set_port_value(8080);
+    lb_endpoint->mutable_load_balancing_weight()->set_value(1);
+  }
+  return cluster;
+}
+
+// A route configuration with the given number of virtual hosts, each with ten routes.
+envoy::config::route::v3::RouteConfiguration makeRouteConfig(int64_t num_virtual_hosts) {
+  envoy::config::route::v3::RouteConfiguration route_config;
+  route_config.set_name("ingress_routes");
+  for (int64_t i = 0; i < num_virtual_hosts; ++i) {
+    auto* virtual_host = route_config.add_virtual_hosts();
+    virtual_host->set_name(absl::StrCat("vhost_", i));
+    virtual_host->add_domains(absl::StrCat("service-", i, ".example.com"));
+    for (int j = 0; j < 10; ++j) {
+      auto* route = virtual_host->add_routes();
+      route->mutable_match()->set_prefix(absl::StrCat("/api/v", j, "/"));
+      auto* header = route->mutable_match()->add_headers();
+      header->set_name("x-tenant");
+      header->mutable_string_match()->set_exact(absl::StrCat("tenant-", j));
+      route->mutable_route()->set_cluster(absl::StrCat("cluster_", i, "_", j));
+      route->mutable_route()->mutable_timeout()->set_seconds(15);
+      ProtobufWkt::Struct config;
+      (*config.mutable_fields())["disabled"].set_bool_value(j % 2 == 0);
+      (*route->mutable_typed_per_filter_config())["envoy.filters.http.example"].PackFrom(config);
+    }
+  }
+  return route_config;
+}
+
+void bmClusterTextFormatHash(::benchmark::State& state) {
+  const envoy::config::cluster::v3::Cluster cluster = makeCluster(state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    ::benchmark::DoNotOptimize(textFormatHash(cluster));
+  }
+}
+
+void bmClusterDeterministicHash(::benchmark::State& state) {
+  const envoy::config::cluster::v3::Cluster cluster = makeCluster(state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    ::benchmark::DoNotOptimize(DeterministicProtoHash::hash(cluster));
+  }
+}
+
+void bmRouteConfigTextFormatHash(::benchmark::State& state) {
+  const envoy::config::route::v3::RouteConfiguration route_config = makeRouteConfig(state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    ::benchmark::DoNotOptimize(textFormatHash(route_config));
+  }
+}
+
+void bmRouteConfigDeterministicHash(::benchmark::State& state) {
+  const envoy::config::route::v3::RouteConfiguration route_config = makeRouteConfig(state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    ::benchmark::DoNotOptimize(DeterministicProtoHash::hash(route_config));
+  }
+}
+
+} // namespace
+
+BENCHMARK(bmClusterTextFormatHash)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(bmClusterDeterministicHash)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(bmRouteConfigTextFormatHash)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(bmRouteConfigDeterministicHash)->Arg(1)->Arg(100)->Arg(1000);
+
+} // namespace Envoy
@@ -0,0 +1,118 @@
+#include "envoy/config/cluster/v3/cluster.pb.h"
+
+#include "source/common/common/base64.h"
+#include "source/common/protobuf/deterministic_hash.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace DeterministicProtoHash {
+namespace {
+
+TEST(DeterministicProtoHashTest, EqualMessagesHashEqually) {
+  envoy::config::cluster::v3::Cluster cluster1;
+  cluster1.set_name("cluster");
+  cluster1.mutable_connect_timeout()->set_seconds(5);
+  cluster1.add_dns_resolvers()->mutable_socket_address()->set_address("10.0.0.1");
+  envoy::config::cluster::v3::Cluster cluster2 = cluster1;
+
+  EXPECT_EQ(hash(cluster1), hash(cluster2));
+
+  cluster2.mutable_connect_timeout()->set_seconds(6);
+  EXPECT_NE(hash(cluster1), hash(cluster2));
+}
+
+TEST(DeterministicProtoHashTest, FieldPresence) {
+  envoy::config::cluster::v3::Cluster unset;
+  envoy::config::cluster::v3::Cluster set_to_zero;
+  set_to_zero.mutable_per_connection_buffer_limit_bytes()->set_value(0);
+  EXPECT_NE(hash(unset), hash(set_to_zero));
+
+  // Proto3 scalars at their default value are not set.
+  envoy::config::cluster::v3::Cluster default_name;
+  default_name.set_name("");
+  EXPECT_EQ(hash(unset), hash(default_name));
+}
+
+TEST(DeterministicProtoHashTest, SameValueInDifferentFields) {
+  envoy::config::cluster::v3::Cluster cluster1;
+  cluster1.set_name("a");
+  envoy::config::cluster::v3::Cluster cluster2;
+  cluster2.set_alt_stat_name("a");
+  EXPECT_NE(hash(cluster1), hash(cluster2));
+}
+
+TEST(DeterministicProtoHashTest, RepeatedFields) {
+  ProtobufWkt::ListValue list1;
+  list1.add_values()->set_string_value("ab");
+  list1.add_values()->set_string_value("c");
+  ProtobufWkt::ListValue list2;
+  list2.add_values()->set_string_value("a");
+  list2.add_values()->set_string_value("bc");
+  ProtobufWkt::ListValue list3;
+  list3.add_values()->set_string_value("c");
+  list3.add_values()->set_string_value("ab");
+
+  EXPECT_NE(hash(list1), hash(list2));
+  // Unlike map entries, the order of repeated elements is significant.
+  EXPECT_NE(hash(list1), hash(list3));
+}
+
+TEST(DeterministicProtoHashTest, MapOrderIsIgnored) {
+  // The same Struct, serialized with its map entries in both orders.
+  ProtobufWkt::Struct s1;
+  ASSERT_TRUE(s1.ParseFromString(Base64::decode("CgsKA2NkZRIEGgJpagoLCgJhYhIFGgNmZ2g=")));
+  ProtobufWkt::Struct s2;
+  ASSERT_TRUE(s2.ParseFromString(Base64::decode("CgsKAmFiEgUaA2ZnaAoLCgNjZGUSBBoCaWo=")));
+
+  EXPECT_EQ(hash(s1), hash(s2));
+
+  (*s2.mutable_fields())["ab"].set_string_value("fgi");
+  EXPECT_NE(hash(s1), hash(s2));
+}
+
+TEST(DeterministicProtoHashTest, AnyIsHashedThroughItsPayload) {
+  ProtobufWkt::Struct s;
+  (*s.mutable_fields())["ab"].set_string_value("fgh");
+  (*s.mutable_fields())["cde"].set_string_value("ij");
+
+  ProtobufWkt::Any any1;
+  any1.PackFrom(s);
+  ProtobufWkt::Any any2 = any1;
+  any2.set_value(Base64::decode("CgsKA2NkZRIEGgJpagoLCgJhYhIFGgNmZ2g="));
+  ProtobufWkt::Any any3 = any1;
+  any3.set_value(Base64::decode("CgsKAmFiEgUaA2ZnaAoLCgNjZGUSBBoCaWo="));
+
+  EXPECT_EQ(hash(any1), hash(any2));
+  EXPECT_EQ(hash(any2), hash(any3));
+  EXPECT_NE(hash(s), hash(any1));
+}
+
+TEST(DeterministicProtoHashTest, AnyWithUnknownType) {
+  ProtobufWkt::Any any1;
+  any1.set_type_url("type.googleapis.com/not.a.known.Type");
+  any1.set_value("abc");
+  ProtobufWkt::Any any2 = any1;
+
+  EXPECT_EQ(hash(any1), hash(any2));
+
+  any2.set_value("abd");
+  EXPECT_NE(hash(any1), hash(any2));
+}
+
+TEST(DeterministicProtoHashTest, UnknownFieldsAreIgnored) {
+  envoy::config::cluster::v3::Cluster cluster;
+  cluster.set_name("cluster");
+  std::string serialized = cluster.SerializeAsString();
+  // Field 4000, varint 1.
+  serialized.append("\x80\xfa\x01\x01", 4);
+  envoy::config::cluster::v3::Cluster with_unknown_field;
+  ASSERT_TRUE(with_unknown_field.ParseFromString(serialized));
+  ASSERT_FALSE(with_unknown_field.GetReflection()->GetUnknownFields(with_unknown_field).empty());
+
+  EXPECT_EQ(hash(cluster), hash(with_unknown_field));
+}
+
+} // namespace
+} // namespace DeterministicProtoHash
+} // namespace Envoy
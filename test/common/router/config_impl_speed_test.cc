@@ -1,11 +1,14 @@
 #include "envoy/config/route/v3/route.pb.h"
 #include "envoy/config/route/v3/route.pb.validate.h"
+#include "envoy/extensions/filters/http/rbac/v3/rbac.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/memory/stats.h"
 #include "source/common/router/config_impl.h"
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -136,9 +139,121 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Generates a route config with `num_vhosts` virtual hosts of 10 regex routes each. The first
+ * `num_changed` virtual hosts direct to a different status than in the original route config.
+ */
+static RouteConfiguration genMultiVhostRouteConfig(int num_vhosts, int num_changed) {
+  RouteConfiguration route_config;
+  for (int i = 0; i < num_vhosts; ++i) {
+    VirtualHost* v_host = route_config.add_virtual_hosts();
+    v_host->set_name(absl::StrCat("vhost_", i));
+    v_host->add_domains(absl::StrCat("vhost_", i, ".example.com"));
+    for (int j = 0; j < 10; ++j) {
+      Route* route = v_host->add_routes();
+      route->mutable_direct_response()->set_status(i < num_changed ? 201 : 200);
+      envoy::type::matcher::v3::RegexMatcher* regex = route->mutable_match()->mutable_safe_regex();
+      regex->mutable_google_re2();
+      regex->set_regex(absl::StrCat("^/shelves/[^\\\\/]+/route_", j, "$"));
+    }
+  }
+  return route_config;
+}
+
+/**
+ * Measure the cost of building the route table for an update that changes `state.range(1)` of the
+ * `state.range(0)` virtual hosts of the previous route table. Virtual hosts that are unchanged are
+ * reused, so the cost is driven by the number of changed virtual hosts, plus the hashing of all
+ * of them.
+ */
+static void bmRouteTableUpdate(benchmark::State& state) {
+  const int num_vhosts = state.range(0);
+  const int num_changed = state.range(1);
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  const ConfigImpl previous_config(genMultiVhostRouteConfig(num_vhosts, 0), OptionalHttpFilters(),
+                                   factory_context, ProtobufMessage::getNullValidationVisitor(),
+                                   false);
+  const RouteConfiguration route_config = genMultiVhostRouteConfig(num_vhosts, num_changed);
+  for (auto _ : state) { // NOLINT
+    ConfigImpl config(route_config, OptionalHttpFilters(), factory_context,
+                      ProtobufMessage::getNullValidationVisitor(), false, &previous_config);
+    benchmark::DoNotOptimize(config.reusedVirtualHosts());
+  }
+}
+
+/**
+ * Measure the memory used by a route table of `state.range(0)` routes which each have an RBAC
+ * per route config with a few policies, when the configs are kept from when the route table is
+ * loaded (`state.range(1) == 0`) or created again on first use (`state.range(1) == 1`). One route
+ * in a hundred is then used, and the memory used after that is reported as "memory_after_use".
+ */
+static void bmRouteTablePerFilterConfigMemory(benchmark::State& state) {
+  const int num_routes = state.range(0);
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.lazy_per_route_filter_configs",
+                               state.range(1) != 0 ? "true" : "false"}});
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+  for (int i = 0; i < num_routes; ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_match()->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+    route->mutable_direct_response()->set_status(200);
+    envoy::extensions::filters::http::rbac::v3::RBACPerRoute per_route_config;
+    auto& policies = *per_route_config.mutable_rbac()->mutable_rules()->mutable_policies();
+    for (int j = 0; j < 4; ++j) {
+      envoy::config::rbac::v3::Policy& policy = policies[absl::StrCat("policy_", j)];
+      auto* header = policy.add_permissions()->mutable_header();
+      header->set_name("x-tenant");
+      header->mutable_string_match()->set_prefix(absl::StrCat("tenant_", i, "_", j));
+      auto* cidr = policy.add_principals()->mutable_direct_remote_ip();
+      cidr->set_address_prefix(absl::StrCat("10.", j, ".", i % 256, ".0"));
+      cidr->mutable_prefix_len()->set_value(24);
+    }
+    (*route->mutable_typed_per_filter_config())["envoy.filters.http.rbac"].PackFrom(
+        per_route_config);
+  }
+
+  for (auto _ : state) { // NOLINT
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    ConfigImpl config(route_config, OptionalHttpFilters(), factory_context,
+                      ProtobufMessage::getNullValidationVisitor(), false);
+    const size_t loaded_mem = Memory::Stats::totalCurrentlyAllocated();
+    for (int i = 0; i < num_routes; i += 100) {
+      const auto route = config.route(genRequestHeaders(i), stream_info, 0);
+      benchmark::DoNotOptimize(route->mostSpecificPerFilterConfig("envoy.filters.http.rbac"));
+    }
+    const size_t used_mem = Memory::Stats::totalCurrentlyAllocated();
+    state.counters["memory"] = loaded_mem - start_mem;
+    state.counters["memory_per_route"] = (loaded_mem - start_mem) / num_routes;
+    state.counters["memory_after_use"] = used_mem - start_mem;
+  }
+}
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableUpdate)
+    ->Args({1000, 1})
+    ->Args({1000, 10})
+    ->Args({1000, 100})
+    ->Args({1000, 1000})
+    ->Args({4000, 1})
+    ->Args({4000, 4000})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bmRouteTablePerFilterConfigMemory)
+    ->Args({10000, 0})
+    ->Args({10000, 1})
+    ->Unit(benchmark::kMillisecond);
 
 } // namespace
 } // namespace Router
@@ -8941,6 +8941,40 @@ public:
       return obj;
     }
   };
+  // Lets its route specific configs be created again on first use, and counts how many it
+  // created.
+  class LazyTestFilterConfig : public Extensions::HttpFilters::Common::EmptyHttpFilterConfig {
+  public:
+    LazyTestFilterConfig() : EmptyHttpFilterConfig("test.lazy.filter") {}
+
+    Http::FilterFactoryCb createFilter(const std::string&,
+                                       Server::Configuration::FactoryContext&) override {
+      PANIC("not implemented");
+    }
+    ProtobufTypes::MessagePtr createEmptyRouteConfigProto() override {
+      return ProtobufTypes::MessagePtr{new ProtobufWkt::Duration()};
+    }
+    ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+      return ProtobufTypes::MessagePtr{new ProtobufWkt::Duration()};
+    }
+    std::set<std::string> configTypes() override { return {"google.protobuf.Duration"}; }
+    bool isRouteSpecificFilterConfigLazy(const Protobuf::Message&) const override { return true; }
+    Router::RouteSpecificFilterConfigConstSharedPtr
+    createRouteSpecificFilterConfig(const Protobuf::Message& message,
+                                    Server::Configuration::ServerFactoryContext&,
+                                    ProtobufMessage::ValidationVisitor&) override {
+      ++configs_created_;
+      if (throw_on_create_) {
+        throw EnvoyException("create failed");
+      }
+      auto obj = std::make_shared<DerivedFilterConfig>();
+      obj->config_.set_seconds(dynamic_cast<const ProtobufWkt::Duration&>(message).seconds());
+      return obj;
+    }
+
+    uint32_t configs_created_{};
+    bool throw_on_create_{};
+  };
   class DefaultTestFilterConfig : public Extensions::HttpFilters::Common::EmptyHttpFilterConfig {
   public:
     DefaultTestFilterConfig() : EmptyHttpFilterConfig("test.default.filter") {}
@@ -9003,6 +9037,9 @@ public:
   DefaultTestFilterConfig default_factory_;
   Registry::InjectFactory<Server::Configuration::NamedHttpFilterConfigFactory>
       registered_default_factory_;
+  LazyTestFilterConfig lazy_factory_;
+  Registry::InjectFactory<Server::Configuration::NamedHttpFilterConfigFactory>
+      registered_lazy_factory_{lazy_factory_};
 };
 
 TEST_F(PerFilterConfigsTest, UnknownFilterAny) {
@@ -9348,6 +9385,72 @@ virtual_hosts:
   checkNoPerFilterConfig(yaml, "filter.unknown", optional_http_filters);
 }
 
+const std::string LazyTypedConfigYaml = R"EOF(
+virtual_hosts:
+  - name: bar
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/foo" }
+        route: { cluster: baz }
+        typed_per_filter_config:
+          test.lazy.filter:
+            "@type": type.googleapis.com/google.protobuf.Duration
+            value: 123s
+      - match: { prefix: "/" }
+        route: { cluster: baz }
+    typed_per_filter_config:
+      test.lazy.filter:
+        "@type": type.googleapis.com/google.protobuf.Duration
+        value: 456s
+)EOF";
+
+// The route specific configs of a lazy factory are created once when the route configuration is
+// loaded, dropped, and created again when they are first used.
+TEST_F(PerFilterConfigsTest, LazyTypedConfig) {
+  factory_context_.cluster_manager_.initializeClusters({"baz"}, {});
+  const TestConfigImpl config(parseRouteConfigurationFromYaml(LazyTypedConfigYaml),
+                              factory_context_, true);
+  EXPECT_EQ(2, lazy_factory_.configs_created_);
+
+  const auto route = config.route(genHeaders("www.foo.com", "/", "GET"), 0);
+  for (int i = 0; i < 2; ++i) {
+    check(dynamic_cast<const DerivedFilterConfig*>(
+              route->mostSpecificPerFilterConfig("test.lazy.filter")),
+          456, "virtual host config");
+  }
+  EXPECT_EQ(3, lazy_factory_.configs_created_);
+
+  absl::InlinedVector<uint32_t, 3> expected_traveled_config({456, 123});
+  checkEach(LazyTypedConfigYaml, 123, expected_traveled_config, "test.lazy.filter");
+}
+
+// A lazy config which the filter rejects fails the route configuration, as an eager one does.
+TEST_F(PerFilterConfigsTest, LazyTypedConfigCreateFailure) {
+  factory_context_.cluster_manager_.initializeClusters({"baz"}, {});
+  lazy_factory_.throw_on_create_ = true;
+  EXPECT_THROW_WITH_MESSAGE(TestConfigImpl(parseRouteConfigurationFromYaml(LazyTypedConfigYaml),
+                                           factory_context_, true),
+                            EnvoyException, "create failed");
+  EXPECT_EQ(1, lazy_factory_.configs_created_);
+}
+
+TEST_F(PerFilterConfigsTest, LazyTypedConfigRuntimeGuardDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.lazy_per_route_filter_configs", "false"}});
+
+  factory_context_.cluster_manager_.initializeClusters({"baz"}, {});
+  const TestConfigImpl config(parseRouteConfigurationFromYaml(LazyTypedConfigYaml),
+                              factory_context_, true);
+  EXPECT_EQ(2, lazy_factory_.configs_created_);
+
+  const auto route = config.route(genHeaders("www.foo.com", "/", "GET"), 0);
+  check(dynamic_cast<const DerivedFilterConfig*>(
+            route->mostSpecificPerFilterConfig("test.lazy.filter")),
+        456, "virtual host config");
+  EXPECT_EQ(2, lazy_factory_.configs_created_);
+}
+
 class RouteMatchOverrideTest : public testing::Test, public ConfigImplTestBase {};
 
 TEST_F(RouteMatchOverrideTest, VerifyAllMatchableRoutes) {
@@ -9628,6 +9731,131 @@ virtual_hosts:
   EXPECT_NE(nullptr, dynamic_cast<const SslRedirectRoute*>(accepted_route.get()));
 }
 
+class ReuseVirtualHostsTest : public testing::Test, public ConfigImplTestBase {
+protected:
+  ReuseVirtualHostsTest() {
+    factory_context_.cluster_manager_.initializeClusters({"www", "api", "api_v2", "default"}, {});
+    route_config_ = parseRouteConfigurationFromYaml(R"EOF(
+name: foo
+virtual_hosts:
+- name: www
+  domains: ["www.lyft.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: www }
+- name: api
+  domains: ["api.lyft.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: api }
+- name: default
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF");
+  }
+
+  std::unique_ptr<ConfigImpl> createConfig(const ConfigImpl* previous_config) {
+    return std::make_unique<ConfigImpl>(route_config_, OptionalHttpFilters(), factory_context_,
+                                        ProtobufMessage::getNullValidationVisitor(), false,
+                                        previous_config);
+  }
+
+  const RouteEntry* routeEntry(const ConfigImpl& config, const std::string& host) {
+    RouteConstSharedPtr route = config.route(genHeaders(host, "/", "GET"), stream_info_, 0);
+    routes_.push_back(route);
+    return route != nullptr ? route->routeEntry() : nullptr;
+  }
+
+  envoy::config::route::v3::RouteConfiguration route_config_;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info_;
+  std::vector<RouteConstSharedPtr> routes_;
+};
+
+// Only the virtual host changed by an update is built again.
+TEST_F(ReuseVirtualHostsTest, ReusesUnchangedVirtualHosts) {
+  std::unique_ptr<ConfigImpl> previous_config = createConfig(nullptr);
+  EXPECT_EQ(0, previous_config->reusedVirtualHosts());
+  const VirtualHost& previous_www = routeEntry(*previous_config, "www.lyft.com")->virtualHost();
+  const VirtualHost& previous_api = routeEntry(*previous_config, "api.lyft.com")->virtualHost();
+
+  route_config_.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster(
+      "api_v2");
+  std::unique_ptr<ConfigImpl> config = createConfig(previous_config.get());
+  EXPECT_EQ(2, config->reusedVirtualHosts());
+  EXPECT_EQ(&previous_www, &routeEntry(*config, "www.lyft.com")->virtualHost());
+  EXPECT_NE(&previous_api, &routeEntry(*config, "api.lyft.com")->virtualHost());
+  EXPECT_EQ(&previous_www.routeConfig(),
+            &routeEntry(*config, "api.lyft.com")->virtualHost().routeConfig());
+
+  // The reused virtual hosts outlive the config they were built for.
+  previous_config.reset();
+  EXPECT_EQ("www", routeEntry(*config, "www.lyft.com")->clusterName());
+  EXPECT_EQ("api_v2", routeEntry(*config, "api.lyft.com")->clusterName());
+  EXPECT_EQ("default", routeEntry(*config, "lyft.com")->clusterName());
+  EXPECT_EQ("foo", routeEntry(*config, "lyft.com")->virtualHost().routeConfig().name());
+
+  // Virtual hosts can be added and removed.
+  route_config_.mutable_virtual_hosts()->DeleteSubrange(0, 1);
+  auto* vhost = route_config_.add_virtual_hosts();
+  vhost->set_name("www2");
+  vhost->add_domains("www2.lyft.com");
+  auto* route = vhost->add_routes();
+  route->mutable_match()->set_prefix("/");
+  route->mutable_route()->set_cluster("www");
+  std::unique_ptr<ConfigImpl> next_config = createConfig(config.get());
+  EXPECT_EQ(2, next_config->reusedVirtualHosts());
+  EXPECT_EQ("default", routeEntry(*next_config, "www.lyft.com")->clusterName());
+  EXPECT_EQ("www", routeEntry(*next_config, "www2.lyft.com")->clusterName());
+  EXPECT_EQ("api_v2", routeEntry(*next_config, "api.lyft.com")->clusterName());
+}
+
+// Virtual hosts are built again when the rest of the route configuration changes, as they depend
+// on it.
+TEST_F(ReuseVirtualHostsTest, CommonConfigChanged) {
+  std::unique_ptr<ConfigImpl> previous_config = createConfig(nullptr);
+
+  route_config_.set_name("bar");
+  std::unique_ptr<ConfigImpl> config = createConfig(previous_config.get());
+  EXPECT_EQ(0, config->reusedVirtualHosts());
+  EXPECT_EQ("bar", routeEntry(*config, "www.lyft.com")->virtualHost().routeConfig().name());
+
+  route_config_.add_internal_only_headers("x-internal");
+  std::unique_ptr<ConfigImpl> next_config = createConfig(config.get());
+  EXPECT_EQ(0, next_config->reusedVirtualHosts());
+  EXPECT_EQ(1, routeEntry(*next_config, "www.lyft.com")
+                   ->virtualHost()
+                   .routeConfig()
+                   .internalOnlyHeaders()
+                   .size());
+
+  // Different optional filters may change how per filter configs are built.
+  std::unique_ptr<ConfigImpl> optional_filters_config = std::make_unique<ConfigImpl>(
+      route_config_, OptionalHttpFilters{"envoy.filters.http.buffer"}, factory_context_,
+      ProtobufMessage::getNullValidationVisitor(), false, next_config.get());
+  EXPECT_EQ(0, optional_filters_config->reusedVirtualHosts());
+}
+
+// Virtual hosts are built again when the clusters they reference are validated.
+TEST_F(ReuseVirtualHostsTest, ValidateClusters) {
+  route_config_.mutable_validate_clusters()->set_value(true);
+  std::unique_ptr<ConfigImpl> previous_config = createConfig(nullptr);
+  std::unique_ptr<ConfigImpl> config = createConfig(previous_config.get());
+  EXPECT_EQ(0, config->reusedVirtualHosts());
+}
+
+TEST_F(ReuseVirtualHostsTest, RuntimeGuardDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.reuse_unchanged_virtual_hosts", "false"}});
+  std::unique_ptr<ConfigImpl> previous_config = createConfig(nullptr);
+  std::unique_ptr<ConfigImpl> config = createConfig(previous_config.get());
+  EXPECT_EQ(0, config->reusedVirtualHosts());
+  EXPECT_NE(&routeEntry(*previous_config, "www.lyft.com")->virtualHost(),
+            &routeEntry(*config, "www.lyft.com")->virtualHost());
+}
+
 } // namespace
 } // namespace Router
 } // namespace Envoy
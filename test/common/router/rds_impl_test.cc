@@ -657,6 +657,43 @@ TEST_F(RdsImplTest, VHDSandRDSupdateTogether) {
                        ->clusterName());
 }
 
+// An RDS update only builds the virtual hosts it changes.
+TEST_F(RdsImplTest, ReusesUnchangedVirtualHosts) {
+  setup();
+
+  auto route_config = TestUtility::parseYaml<envoy::config::route::v3::RouteConfiguration>(R"EOF(
+name: foo_route_config
+virtual_hosts:
+- name: foo
+  domains: ["foo"]
+  routes:
+  - match: { prefix: "/foo" }
+    route: { cluster: foo }
+- name: bar
+  domains: ["bar"]
+  routes:
+  - match: { prefix: "/bar" }
+    route: { cluster: bar }
+)EOF");
+  EXPECT_CALL(init_watcher_, ready());
+  rds_callbacks_->onConfigUpdate(TestUtility::decodeResources({route_config}).refvec_, "1");
+  const auto config_1 = std::dynamic_pointer_cast<const ConfigImpl>(rds_->configCast());
+  ASSERT_NE(nullptr, config_1);
+  EXPECT_EQ(0, config_1->reusedVirtualHosts());
+
+  route_config.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster("baz");
+  rds_callbacks_->onConfigUpdate(TestUtility::decodeResources({route_config}).refvec_, "2");
+  const auto config_2 = std::dynamic_pointer_cast<const ConfigImpl>(rds_->configCast());
+  ASSERT_NE(nullptr, config_2);
+  EXPECT_EQ(1, config_2->reusedVirtualHosts());
+  EXPECT_EQ("foo", route(Http::TestRequestHeaderMapImpl{{":authority", "foo"}, {":path", "/foo"}})
+                       ->routeEntry()
+                       ->clusterName());
+  EXPECT_EQ("baz", route(Http::TestRequestHeaderMapImpl{{":authority", "bar"}, {":path", "/bar"}})
+                       ->routeEntry()
+                       ->clusterName());
+}
+
 // Validate behavior when the config fails delivery at the subscription level.
 TEST_F(RdsImplTest, FailureSubscription) {
   InSequence s;
@@ -258,6 +258,33 @@ generic_secret:
                             "Duplicate static GenericSecret secret name encryption_key");
 }
 
+// Validate that secret manager reports the in-memory size of the static secrets by name.
+TEST_F(SecretManagerImplTest, SecretsAllocatedBytes) {
+  SecretManagerPtr secret_manager(new SecretManagerImpl(config_tracker_));
+  EXPECT_TRUE(secret_manager->secretsAllocatedBytes().empty());
+
+  envoy::extensions::transport_sockets::tls::v3::Secret small_secret;
+  TestUtility::loadFromYaml(R"EOF(
+name: "small"
+generic_secret:
+  secret:
+    inline_string: "a"
+)EOF",
+                            small_secret);
+  secret_manager->addStaticSecret(small_secret);
+  envoy::extensions::transport_sockets::tls::v3::Secret large_secret;
+  large_secret.set_name("large");
+  large_secret.mutable_generic_secret()->mutable_secret()->set_inline_string(
+      std::string(4096, 'a'));
+  secret_manager->addStaticSecret(large_secret);
+
+  const absl::flat_hash_map<std::string, uint64_t> secrets =
+      secret_manager->secretsAllocatedBytes();
+  ASSERT_EQ(2, secrets.size());
+  EXPECT_GT(secrets.at("small"), 0);
+  EXPECT_GT(secrets.at("large"), secrets.at("small") + 4000);
+}
+
 // Validate that secret manager deduplicates dynamic TLS certificate secret provider.
 // Regression test of https://github.com/envoyproxy/envoy/issues/5744
 TEST_F(SecretManagerImplTest, DeduplicateDynamicTlsCertificateSecretProvider) {
@@ -103,6 +103,27 @@ TEST_F(AllocatorImplTest, GaugesWithSameName) {
   EXPECT_EQ(0, g2->value());
 }
 
+TEST_F(AllocatorImplTest, LatchChanged) {
+  GaugeSharedPtr gauge =
+      alloc_.makeGauge(makeStat("gauge"), StatName(), {}, Gauge::ImportMode::Accumulate);
+  EXPECT_FALSE(gauge->latchChanged());
+  gauge->set(5);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+  gauge->inc();
+  gauge->dec();
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->setParentValue(3);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  TextReadoutSharedPtr text_readout = alloc_.makeTextReadout(makeStat("text"), StatName(), {});
+  EXPECT_FALSE(text_readout->latchChanged());
+  text_readout->set("value");
+  EXPECT_TRUE(text_readout->latchChanged());
+  EXPECT_FALSE(text_readout->latchChanged());
+}
+
 // Test for a race-condition where we may decrement the ref-count of a stat to
 // zero at the same time as we are allocating another instance of that
 // stat. This test reproduces that race organically by having a 12 threads each
@@ -169,6 +169,37 @@ TEST_F(StatNameTest, TestDynamicPools) {
   EXPECT_NE(dynamic2.data(), dynamic.data());
 }
 
+TEST_F(StatNameTest, AppendToString) {
+  StatNameDynamicPool dynamic_pool(table_);
+  const StatName dynamic = dynamic_pool.add("dynamic.name");
+  SymbolTable::StoragePtr joined = table_.join({makeStat("a.b"), dynamic, makeStat("c")});
+
+  std::string out = "prefix:";
+  table_.appendToString(makeStat("hello.world"), out);
+  EXPECT_EQ("prefix:hello.world", out);
+  out.push_back(',');
+  table_.appendToString(StatName(joined.get()), out);
+  EXPECT_EQ("prefix:hello.world,a.b.dynamic.name.c", out);
+  out.push_back(',');
+  table_.appendToString(dynamic_pool.add(""), out);
+  EXPECT_EQ("prefix:hello.world,a.b.dynamic.name.c,", out);
+  EXPECT_EQ(table_.toString(StatName(joined.get())), "a.b.dynamic.name.c");
+}
+
+TEST_F(StatNameTest, ForEachToken) {
+  StatNameDynamicPool dynamic_pool(table_);
+  const StatName dynamic = dynamic_pool.add("dynamic.name");
+  SymbolTable::StoragePtr joined = table_.join({makeStat("a.b"), dynamic, makeStat("c")});
+
+  std::vector<std::string> tokens;
+  table_.forEachToken(
+      StatName(joined.get()),
+      [&tokens](absl::string_view token) { tokens.push_back(absl::StrCat("symbolic:", token)); },
+      [&tokens](absl::string_view token) { tokens.push_back(absl::StrCat("dynamic:", token)); });
+  EXPECT_THAT(tokens, testing::ElementsAre("symbolic:a", "symbolic:b", "dynamic:dynamic.name",
+                                           "symbolic:c"));
+}
+
 TEST_F(StatNameTest, TestDynamicHash) {
   StatNameDynamicPool dynamic(table_);
   const StatName d1 = dynamic.add("dynamic");
@@ -231,7 +262,7 @@ TEST_F(StatNameTest, TestSuccessfulDecode) {
 class StatNameDeathTest : public StatNameTest {
 public:
   void decodeSymbolVec(const SymbolVec& symbol_vec) {
-    Thread::LockGuard lock(table_.lock_);
+    absl::ReaderMutexLock lock(&table_.lock_);
     for (Symbol symbol : symbol_vec) {
       table_.fromSymbol(symbol);
     }
@@ -531,22 +562,7 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
-  //
-  // Note also that we cannot guarantee there *will* be contentions
+  // Note that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
 
   wait.setReady();
@@ -599,23 +615,11 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
-  //
-  // Note also that we cannot guarantee there *will* be contentions
-  // as a machine or OS is free to run all threads serially.
+  // Encoding names whose symbols all exist only takes the symbol table
+  // lock in shared mode, so it adds no symbol table contentions after
+  // latching 'create_contentions' above. This cannot be asserted though,
+  // as the tracer also counts contentions on the synchronization
+  // primitives of this test.
 
   wait.setReady();
   for (auto& thread : threads) {
@@ -13,6 +13,7 @@
 #include "test/common/stats/make_elements_helper.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "benchmark/benchmark.h"
 
@@ -62,6 +63,71 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Runs state.range(0) threads, each encoding and freeing 1000 names. The names
+// are either shared by all threads, all of whose symbols are kept alive so
+// encoding them only looks up existing symbols, or distinct per thread, so
+// encoding them allocates new symbols.
+static void encodeContention(benchmark::State& state, bool existing_symbols) {
+  Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+  const int num_threads = state.range(0);
+  constexpr int num_names = 1000;
+  Envoy::Stats::SymbolTableImpl table;
+  Envoy::Stats::StatNamePool pool(table);
+  std::vector<std::vector<std::string>> names(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    for (int j = 0; j < num_names; ++j) {
+      names[i].push_back(existing_symbols
+                             ? absl::StrCat("cluster.service_", j, ".upstream_rq_total")
+                             : absl::StrCat("cluster.thread_", i, "_service_", j, ".rq"));
+      if (existing_symbols && i == 0) {
+        pool.add(names[i].back());
+      }
+    }
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer access;
+    absl::BlockingCounter accesses(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(thread_factory.createThread([&access, &accesses, &table, &names, i]() {
+        access.wait();
+        for (const std::string& name : names[i]) {
+          Envoy::Stats::StatNameStorage storage(name, table);
+          storage.free(table);
+        }
+        accesses.DecrementCount();
+      }));
+    }
+    access.setReady();
+    accesses.Wait();
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_threads * num_names);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeExistingContention(benchmark::State& state) { encodeContention(state, true); }
+BENCHMARK(bmEncodeExistingContention)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeNewContention(benchmark::State& state) { encodeContention(state, false); }
+BENCHMARK(bmEncodeNewContention)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
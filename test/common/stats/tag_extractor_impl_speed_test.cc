@@ -43,7 +43,9 @@
 #include "envoy/config/metrics/v3/stats.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
 #include "source/common/config/well_known_names.h"
+#include "source/common/stats/tag_extractor_impl.h"
 #include "source/common/stats/tag_producer_impl.h"
 
 #include "benchmark/benchmark.h"
@@ -106,6 +108,37 @@ void BM_ExtractTags(benchmark::State& state) {
 }
 BENCHMARK(BM_ExtractTags)->DenseRange(0, 26, 1);
 
+// Compares the default tokenized extractors applied one at a time, with
+// BM_ExtractTokens/0, to the same extractors combined into a
+// TagExtractorTokenSetImpl, with BM_ExtractTokens/1, over all the params.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ExtractTokens(benchmark::State& state) {
+  std::vector<TagExtractorPtr> extractors;
+  auto token_set = std::make_unique<TagExtractorTokenSetImpl>();
+  for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
+    extractors.emplace_back(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
+    token_set->add(desc.name_, desc.pattern_);
+  }
+  if (state.range(0) == 1) {
+    extractors.clear();
+    extractors.emplace_back(std::move(token_set));
+  }
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const Params& p : params) {
+      TagVector tags;
+      IntervalSetImpl<size_t> remove_characters;
+      TagExtractionContext tag_extraction_context(std::get<0>(p));
+      for (const TagExtractorPtr& extractor : extractors) {
+        extractor->extractTag(tag_extraction_context, tags, remove_characters);
+      }
+      benchmark::DoNotOptimize(tags);
+    }
+  }
+}
+BENCHMARK(BM_ExtractTokens)->Arg(0)->Arg(1);
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -551,5 +551,105 @@ TEST_F(TagExtractorTokensTest, TokensMismatchPatternTooLong) {
   EXPECT_FALSE(extract("article", "now.$.the.time.to", "now.is.the.time"));
 }
 
+class TagExtractorTokenSetTest : public testing::Test {
+protected:
+  TagExtractorTokenSetTest() {
+    for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
+      token_set_.add(desc.name_, desc.pattern_);
+      extractors_.emplace_back(std::make_unique<TagExtractorTokensImpl>(desc.name_, desc.pattern_));
+    }
+  }
+
+  // Expects the token set to extract the same tags and characters as the
+  // tokenized extractors applied one by one.
+  void expectSameAsTokens(absl::string_view stat_name) {
+    TagVector tags;
+    IntervalSetImpl<size_t> remove_characters;
+    TagExtractionContext context(stat_name);
+    bool extracted = false;
+    for (const TagExtractorPtr& extractor : extractors_) {
+      extracted |= extractor->extractTag(context, tags, remove_characters);
+    }
+
+    TagVector set_tags;
+    IntervalSetImpl<size_t> set_remove_characters;
+    TagExtractionContext set_context(stat_name);
+    EXPECT_EQ(extracted, token_set_.extractTag(set_context, set_tags, set_remove_characters))
+        << stat_name;
+    EXPECT_EQ(tags, set_tags) << stat_name;
+    EXPECT_EQ(StringUtil::removeCharacters(stat_name, remove_characters),
+              StringUtil::removeCharacters(stat_name, set_remove_characters))
+        << stat_name;
+  }
+
+  TagExtractorTokenSetImpl token_set_;
+  std::vector<TagExtractorPtr> extractors_;
+};
+
+TEST_F(TagExtractorTokenSetTest, CanAdd) {
+  for (const auto& desc : Config::TagNames::get().tokenizedDescriptorVec()) {
+    EXPECT_TRUE(TagExtractorTokenSetImpl::canAdd(desc.pattern_)) << desc.pattern_;
+  }
+  EXPECT_TRUE(TagExtractorTokenSetImpl::canAdd("$.**.aid"));
+  EXPECT_FALSE(TagExtractorTokenSetImpl::canAdd("now.**.$.of.their"));
+  EXPECT_FALSE(TagExtractorTokenSetImpl::canAdd("now.is.the.time"));
+}
+
+TEST_F(TagExtractorTokenSetTest, DefaultDescriptors) {
+  for (absl::string_view stat_name : {
+           "cluster.ratelimit.upstream_rq_timeout",
+           "cluster.grpc_cluster.grpc.grpc_service_1.grpc_method_1.success",
+           "cluster.grpc_cluster.grpc.grpc_service_1",
+           "cluster.only_name",
+           "mongo.mongo_filter.op_reply",
+           "mongo.mongo_filter.cmd.foo_cmd.reply_size",
+           "mongo.mongo_filter.collection.bar_collection.query.multi_get",
+           "mongo.mongo_filter.collection.bar_collection.callsite.baz_callsite.query.scatter_get",
+           "mongo.mongo_filter.collection.bar_collection.x.query.y.query.z",
+           "http.egress_dynamodb_iad.user_agent.ios.downstream_cx_total",
+           "http.fault_connection_manager.fault.fault_cluster.aborts_injected",
+           "vhost.vhost_1.vcluster.vcluster_1.upstream_rq_2xx",
+           "vhost.vhost_1.route.route_1.upstream_rq_2xx",
+           "auth.clientssl.clientssl_prefix.auth_ip_allowlist",
+           "tcp.tcp_prefix.downstream_flow_control_resumed_reading_total",
+           "listener.127.0.0.1_3012.http.http_prefix.downstream_rq_5xx",
+           "no_match",
+           "",
+       }) {
+    expectSameAsTokens(stat_name);
+  }
+}
+
+TEST(TagExtractorTokenSetPatternTest, Patterns) {
+  TagExtractorTokenSetImpl token_set;
+  token_set.add("first", "now.$.the.**");
+  token_set.add("last", "now.is.*.$");
+  token_set.add("middle", "now.*.$.**.aid");
+
+  auto extract = [&token_set](absl::string_view stat_name, TagVector& tags) {
+    IntervalSetImpl<size_t> remove_characters;
+    TagExtractionContext context(stat_name);
+    tags.clear();
+    return token_set.extractTag(context, tags, remove_characters)
+               ? StringUtil::removeCharacters(stat_name, remove_characters)
+               : "";
+  };
+
+  TagVector tags;
+  EXPECT_EQ("now.the", extract("now.is.the.time", tags));
+  EXPECT_THAT(tags, ElementsAre(Tag{"first", "is"}, Tag{"last", "time"}));
+  EXPECT_EQ("now.", extract("now.is.the.aid", tags));
+  EXPECT_THAT(tags, ElementsAre(Tag{"first", "is"}, Tag{"last", "aid"}, Tag{"middle", "the"}));
+
+  // A trailing '**' must match at least one token, unlike a '**' in the middle.
+  EXPECT_EQ("", extract("now.is.the", tags));
+  EXPECT_EQ("now.is.to.the.aid", extract("now.is.come.to.the.aid", tags));
+  EXPECT_THAT(tags, ElementsAre(Tag{"middle", "come"}));
+
+  EXPECT_EQ("", extract("then.is.the.time", tags));
+  EXPECT_THAT(tags, ElementsAre());
+  EXPECT_EQ("", extract("now", tags));
+}
+
 } // namespace Stats
 } // namespace Envoy
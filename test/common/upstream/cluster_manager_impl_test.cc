@@ -522,6 +522,27 @@ TEST_F(ClusterManagerImplTest, MultipleHealthCheckFail) {
                             "Multiple health checks not supported");
 }
 
+TEST_F(ClusterManagerImplTest, AdsSnapshotRequiresDeltaGrpc) {
+  const std::string yaml = R"EOF(
+ dynamic_resources:
+  ads_config:
+    api_type: GRPC
+    transport_api_version: V3
+    grpc_services:
+    - envoy_grpc:
+        cluster_name: ads_cluster
+  ads_snapshot_config:
+    config:
+      name: envoy.key_value.file_based
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.key_value.file_based.v3.FileBasedKeyValueStoreConfig
+        filename: xds_snapshot
+  )EOF";
+
+  EXPECT_THROW_WITH_MESSAGE(create(parseBootstrapFromV3Yaml(yaml)), EnvoyException,
+                            "ads_snapshot_config requires a DELTA_GRPC ads_config");
+}
+
 TEST_F(ClusterManagerImplTest, MultipleProtocolCluster) {
   time_system_.setSystemTime(std::chrono::milliseconds(1234567891234));
 
@@ -2062,6 +2083,117 @@ TEST_F(ClusterManagerImplTest, DynamicAddRemove) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(callbacks.get()));
 }
 
+// Validate that an update that only changes circuit breaker limits is applied to the active
+// cluster, and that other updates rebuild it.
+TEST_F(ClusterManagerImplTest, UpdateCircuitBreakerLimitsInPlace) {
+  create(defaultConfig());
+
+  InSequence s;
+  std::unique_ptr<MockClusterUpdateCallbacks> callbacks(new NiceMock<MockClusterUpdateCallbacks>());
+  ClusterUpdateCallbacksHandlePtr cb =
+      cluster_manager_->addThreadLocalClusterUpdateCallbacks(*callbacks);
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster1(new NiceMock<MockClusterMockPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster1, nullptr)));
+  EXPECT_CALL(*cluster1, initialize(_));
+  EXPECT_CALL(*callbacks, onClusterAddOrUpdate(_));
+  auto cluster_config = defaultStaticCluster("fake_cluster");
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(cluster_config, "v1"));
+  cluster1->initialize_callback_();
+  checkStats(1 /*added*/, 0 /*modified*/, 0 /*removed*/, 1 /*active*/, 0 /*warming*/);
+
+  auto* thresholds = cluster_config.mutable_circuit_breakers()->add_thresholds();
+  thresholds->mutable_max_connections()->set_value(10);
+  thresholds->mutable_max_requests()->set_value(20);
+  cluster_config.mutable_circuit_breakers()
+      ->add_per_host_thresholds()
+      ->mutable_max_connections()
+      ->set_value(5);
+  EXPECT_CALL(*cluster1->info_, updateResourceLimits(ProtoEq(cluster_config.circuit_breakers())));
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(cluster_config, "v2"));
+  checkStats(1 /*added*/, 1 /*modified*/, 0 /*removed*/, 1 /*active*/, 0 /*warming*/);
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_modified_in_place").value());
+  EXPECT_EQ(cluster1->info_, cluster_manager_->getThreadLocalCluster("fake_cluster")->info());
+
+  // The same config is now a no-op, and the config dump reflects the update.
+  EXPECT_FALSE(cluster_manager_->addOrUpdateCluster(cluster_config, "v2"));
+  auto message_ptr = admin_.config_tracker_.config_tracker_callbacks_["clusters"](
+      Matchers::UniversalStringMatcher());
+  const auto& config_dump = dynamic_cast<const envoy::admin::v3::ClustersConfigDump&>(*message_ptr);
+  ASSERT_EQ(1, config_dump.dynamic_active_clusters_size());
+  EXPECT_EQ("v2", config_dump.dynamic_active_clusters(0).version_info());
+  envoy::config::cluster::v3::Cluster dumped_cluster;
+  config_dump.dynamic_active_clusters(0).cluster().UnpackTo(&dumped_cluster);
+  EXPECT_THAT(dumped_cluster, ProtoEq(cluster_config));
+
+  // Changing anything else rebuilds the cluster.
+  cluster_config.mutable_per_connection_buffer_limit_bytes()->set_value(12345);
+  std::shared_ptr<MockClusterMockPrioritySet> cluster2(new NiceMock<MockClusterMockPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster2, nullptr)));
+  EXPECT_CALL(*cluster2, initialize(_))
+      .WillOnce(Invoke([](std::function<void()> initialize_callback) { initialize_callback(); }));
+  EXPECT_CALL(*callbacks, onClusterAddOrUpdate(_));
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(cluster_config, "v3"));
+  checkStats(1 /*added*/, 2 /*modified*/, 0 /*removed*/, 1 /*active*/, 0 /*warming*/);
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_modified_in_place").value());
+  EXPECT_EQ(cluster2->info_, cluster_manager_->getThreadLocalCluster("fake_cluster")->info());
+
+  // With the runtime guard disabled, limit changes rebuild the cluster too.
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.update_cluster_circuit_breakers_in_place", "false"}});
+  cluster_config.mutable_circuit_breakers()
+      ->mutable_thresholds(0)
+      ->mutable_max_connections()
+      ->set_value(11);
+  std::shared_ptr<MockClusterMockPrioritySet> cluster3(new NiceMock<MockClusterMockPrioritySet>());
+  EXPECT_CALL(factory_, clusterFromProto_(_, _, _, _))
+      .WillOnce(Return(std::make_pair(cluster3, nullptr)));
+  EXPECT_CALL(*cluster3, initialize(_))
+      .WillOnce(Invoke([](std::function<void()> initialize_callback) { initialize_callback(); }));
+  EXPECT_CALL(*callbacks, onClusterAddOrUpdate(_));
+  EXPECT_TRUE(cluster_manager_->addOrUpdateCluster(cluster_config, "v4"));
+  checkStats(1 /*added*/, 3 /*modified*/, 0 /*removed*/, 1 /*active*/, 0 /*warming*/);
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_modified_in_place").value());
+  EXPECT_EQ(cluster3->info_, cluster_manager_->getThreadLocalCluster("fake_cluster")->info());
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster2.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(cluster3.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(callbacks.get()));
+}
+
+TEST(ClusterMessageUtilTest, CircuitBreakerLimitsOnlyChange) {
+  envoy::config::cluster::v3::Cluster lhs;
+  lhs.set_name("cluster");
+  auto* thresholds = lhs.mutable_circuit_breakers()->add_thresholds();
+  thresholds->mutable_max_connections()->set_value(10);
+  envoy::config::cluster::v3::Cluster rhs = lhs;
+  EXPECT_TRUE(ClusterMessageUtil::circuitBreakerLimitsOnlyChange(lhs, rhs));
+
+  rhs.mutable_circuit_breakers()->mutable_thresholds(0)->mutable_max_connections()->set_value(20);
+  rhs.mutable_circuit_breakers()->mutable_thresholds(0)->mutable_max_retries()->set_value(1);
+  rhs.mutable_circuit_breakers()->add_per_host_thresholds()->mutable_max_connections()->set_value(
+      1);
+  EXPECT_FALSE(ClusterMessageUtil::circuitBreakerLimitsOnlyChange(lhs, rhs));
+  lhs.mutable_circuit_breakers()->add_per_host_thresholds();
+  EXPECT_TRUE(ClusterMessageUtil::circuitBreakerLimitsOnlyChange(lhs, rhs));
+
+  // Adding thresholds for another priority, or changing anything but the limits, is not.
+  envoy::config::cluster::v3::Cluster other_priority = rhs;
+  other_priority.mutable_circuit_breakers()->add_thresholds()->set_priority(
+      envoy::config::core::v3::HIGH);
+  EXPECT_FALSE(ClusterMessageUtil::circuitBreakerLimitsOnlyChange(lhs, other_priority));
+  envoy::config::cluster::v3::Cluster track_remaining = rhs;
+  track_remaining.mutable_circuit_breakers()->mutable_thresholds(0)->set_track_remaining(true);
+  EXPECT_FALSE(ClusterMessageUtil::circuitBreakerLimitsOnlyChange(lhs, track_remaining));
+  envoy::config::cluster::v3::Cluster metadata = rhs;
+  (*metadata.mutable_metadata()->mutable_filter_metadata())["foo"];
+  EXPECT_FALSE(ClusterMessageUtil::circuitBreakerLimitsOnlyChange(lhs, metadata));
+}
+
 TEST_F(ClusterManagerImplTest, AddOrUpdateClusterStaticExists) {
   const std::string json = fmt::sprintf("{\"static_resources\":{%s}}",
                                         clustersJson({defaultStaticClusterJson("fake_cluster")}));
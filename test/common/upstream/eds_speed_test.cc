@@ -58,7 +58,7 @@ public:
           local_info_, std::unique_ptr<Grpc::MockAsyncClient>(async_client_), dispatcher_,
           *Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
               "envoy.service.endpoint.v3.EndpointDiscoveryService.StreamEndpoints"),
-          random_, stats_, {}, true, std::move(config_validators_)));
+          random_, stats_, {}, true, std::move(config_validators_), api_->threadFactory()));
     }
     resetCluster(R"EOF(
       name: name
@@ -166,6 +166,45 @@ TEST(ResourceManagerImplTest, RetryBudgetOverrideGauge) {
   EXPECT_EQ(100u, rm.maxConnectionsPerHost());
   rm.retries().dec();
 }
+
+TEST(ResourceManagerImplTest, UpdateLimits) {
+  NiceMock<Runtime::MockLoader> runtime;
+  Stats::IsolatedStoreImpl store;
+
+  auto stats = clusterCircuitBreakersStats(store);
+  ResourceManagerImpl rm(runtime, "circuit_breakers.runtime_resource_manager_test.default.", 2, 2,
+                         2, 2, 2, 100, stats, absl::nullopt, absl::nullopt);
+
+  rm.connections().inc();
+  rm.connections().inc();
+  EXPECT_FALSE(rm.connections().canCreate());
+  EXPECT_EQ(1U, stats.cx_open_.value());
+  EXPECT_EQ(0U, stats.remaining_cx_.value());
+
+  // Raising the limit keeps the resources in use and closes the circuit breaker.
+  rm.updateLimits(4, 3, 3, 3, 3, 50);
+  EXPECT_EQ(4U, rm.connections().max());
+  EXPECT_EQ(2U, rm.connections().count());
+  EXPECT_TRUE(rm.connections().canCreate());
+  EXPECT_EQ(0U, stats.cx_open_.value());
+  EXPECT_EQ(2U, stats.remaining_cx_.value());
+  EXPECT_EQ(3U, rm.pendingRequests().max());
+  EXPECT_EQ(3U, rm.requests().max());
+  EXPECT_EQ(3U, rm.retries().max());
+  EXPECT_EQ(3U, stats.remaining_retries_.value());
+  EXPECT_EQ(3U, rm.connectionPools().max());
+  EXPECT_EQ(50U, rm.maxConnectionsPerHost());
+
+  // Lowering it below the resources in use opens the circuit breaker until they are released.
+  rm.updateLimits(1, 3, 3, 3, 3, 50);
+  EXPECT_FALSE(rm.connections().canCreate());
+  EXPECT_EQ(1U, stats.cx_open_.value());
+  EXPECT_EQ(0U, stats.remaining_cx_.value());
+  rm.connections().dec();
+  rm.connections().dec();
+  EXPECT_TRUE(rm.connections().canCreate());
+  EXPECT_EQ(0U, stats.cx_open_.value());
+}
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -0,0 +1,164 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/access_loggers/binary_ring/binary_ring_access_log_impl.h"
+#include "source/extensions/access_loggers/binary_ring/record_encoder.h"
+
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+namespace {
+
+using BinaryRingAccessLogConfig =
+    envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog;
+
+class RecordEncoderTest : public testing::Test {
+protected:
+  std::vector<DecodedField> encodeAndDecode(std::vector<Field> fields) {
+    RecordEncoder encoder(std::move(fields));
+    encoder.encode(stream_info_, record_);
+    std::vector<DecodedField> decoded;
+    EXPECT_TRUE(RecordEncoder::decode(absl::string_view(record_.data(), record_.size()), decoded));
+    return decoded;
+  }
+
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  RecordBuffer record_;
+};
+
+TEST_F(RecordEncoderTest, NumericAndStringFields) {
+  stream_info_.start_time_ = SystemTime(std::chrono::microseconds(1234567890123456));
+  stream_info_.response_code_ = 503;
+  stream_info_.protocol_ = Http::Protocol::Http2;
+  stream_info_.route_name_ = "my_route";
+  stream_info_.bytes_sent_ = 300;
+
+  const std::vector<DecodedField> decoded = encodeAndDecode(
+      {BinaryRingAccessLogConfig::START_TIME, BinaryRingAccessLogConfig::RESPONSE_CODE,
+       BinaryRingAccessLogConfig::PROTOCOL, BinaryRingAccessLogConfig::ROUTE_NAME,
+       BinaryRingAccessLogConfig::BYTES_SENT});
+  ASSERT_EQ(5, decoded.size());
+
+  EXPECT_EQ(BinaryRingAccessLogConfig::START_TIME, decoded[0].field_);
+  EXPECT_FALSE(decoded[0].is_string_);
+  EXPECT_EQ(1234567890123456, decoded[0].number_value_);
+  EXPECT_EQ(BinaryRingAccessLogConfig::RESPONSE_CODE, decoded[1].field_);
+  EXPECT_EQ(503, decoded[1].number_value_);
+  EXPECT_EQ(BinaryRingAccessLogConfig::PROTOCOL, decoded[2].field_);
+  EXPECT_TRUE(decoded[2].is_string_);
+  EXPECT_EQ("HTTP/2", decoded[2].string_value_);
+  EXPECT_EQ(BinaryRingAccessLogConfig::ROUTE_NAME, decoded[3].field_);
+  EXPECT_EQ("my_route", decoded[3].string_value_);
+  EXPECT_EQ(BinaryRingAccessLogConfig::BYTES_SENT, decoded[4].field_);
+  EXPECT_EQ(300, decoded[4].number_value_);
+}
+
+TEST_F(RecordEncoderTest, OmitsMissingValues) {
+  stream_info_.end_time_.reset();
+  stream_info_.response_code_.reset();
+  stream_info_.route_name_.clear();
+  stream_info_.upstreamInfo()->setUpstreamHost(nullptr);
+
+  EXPECT_TRUE(encodeAndDecode({BinaryRingAccessLogConfig::DURATION,
+                               BinaryRingAccessLogConfig::RESPONSE_CODE,
+                               BinaryRingAccessLogConfig::ROUTE_NAME,
+                               BinaryRingAccessLogConfig::UPSTREAM_HOST})
+                  .empty());
+  EXPECT_TRUE(record_.empty());
+}
+
+TEST_F(RecordEncoderTest, StringFieldsMatchEncoding) {
+  for (const Field field : RecordEncoder::allFields()) {
+    record_.clear();
+    stream_info_.route_name_ = "route";
+    stream_info_.response_code_details_ = "details";
+    stream_info_.protocol_ = Http::Protocol::Http11;
+    for (const DecodedField& decoded : encodeAndDecode({field})) {
+      EXPECT_EQ(RecordEncoder::isStringField(field), decoded.is_string_) << field;
+    }
+  }
+}
+
+TEST(RecordDecoderTest, MalformedRecords) {
+  std::vector<DecodedField> decoded;
+  // Unsupported wire type.
+  EXPECT_FALSE(RecordEncoder::decode("\x0d", decoded));
+  // String length past the end of the record.
+  EXPECT_FALSE(RecordEncoder::decode(absl::string_view("\x5a\x05""ab", 4), decoded));
+  // Truncated varint value.
+  EXPECT_FALSE(RecordEncoder::decode("\x18\x80", decoded));
+}
+
+class BinaryRingAccessLogTest : public testing::Test {
+protected:
+  BinaryRingAccessLogTest() : path_(TestEnvironment::temporaryPath("binary_ring_log.ring")) {
+    TestEnvironment::removePath(path_);
+  }
+  ~BinaryRingAccessLogTest() override { TestEnvironment::removePath(path_); }
+
+  const std::string path_;
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+  Http::TestResponseHeaderMapImpl response_headers_;
+  Http::TestResponseTrailerMapImpl response_trailers_;
+};
+
+TEST_F(BinaryRingAccessLogTest, WritesRecordsAndStats) {
+  auto ring_file = std::make_shared<RingFile>(path_, 65536);
+  BinaryRingAccessLog log(nullptr, RecordEncoder({BinaryRingAccessLogConfig::ROUTE_NAME}),
+                          ring_file, store_);
+
+  stream_info_.route_name_ = "route";
+  log.log(&request_headers_, &response_headers_, &response_trailers_, stream_info_);
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "access_logs.binary_ring.records_written")->value());
+  EXPECT_EQ(1, ring_file->header().records_.load());
+
+  // Nothing to write for this request.
+  stream_info_.route_name_.clear();
+  log.log(&request_headers_, &response_headers_, &response_trailers_, stream_info_);
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "access_logs.binary_ring.records_written")->value());
+
+  // Larger than a quarter of the ring.
+  stream_info_.route_name_ = std::string(ring_file->maxRecordSize(), 'r');
+  log.log(&request_headers_, &response_headers_, &response_trailers_, stream_info_);
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "access_logs.binary_ring.records_dropped")->value());
+
+  // Fill the ring until the oldest records are overwritten.
+  stream_info_.route_name_ = std::string(1000, 'r');
+  for (int i = 0; i < 100; ++i) {
+    log.log(&request_headers_, &response_headers_, &response_trailers_, stream_info_);
+  }
+  EXPECT_GT(
+      TestUtility::findCounter(store_, "access_logs.binary_ring.records_overwritten")->value(), 0);
+}
+
+TEST_F(BinaryRingAccessLogTest, ManagerSharesRingFiles) {
+  RingFileManager manager;
+  RingFileSharedPtr first = manager.getOrCreate(path_, 65536);
+  EXPECT_EQ(first, manager.getOrCreate(path_, 65536));
+  EXPECT_THROW_WITH_MESSAGE(
+      manager.getOrCreate(path_, 131072), EnvoyException,
+      fmt::format("binary access log ring file {} is already in use with a ring size of 65536 bytes",
+                  path_));
+
+  // Once released the path can be re-mapped with a new size.
+  first.reset();
+  EXPECT_EQ(131072, manager.getOrCreate(path_, 131072)->capacity());
+}
+
+} // namespace
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
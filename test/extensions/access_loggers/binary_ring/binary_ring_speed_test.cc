@@ -0,0 +1,80 @@
+// Compares the per-request cost of the binary ring access log with the text file access log
+// using the default format.
+
+#include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/access_loggers/binary_ring/binary_ring_access_log_impl.h"
+#include "source/extensions/access_loggers/common/file_access_log_impl.h"
+
+#include "test/common/stream_info/test_util.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace {
+
+std::unique_ptr<TestStreamInfo> makeStreamInfo(TimeSource& time_source) {
+  auto stream_info = std::make_unique<TestStreamInfo>(time_source);
+  stream_info->downstream_connection_info_provider_->setRemoteAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("203.0.113.1", 443));
+  stream_info->setResponseCode(200);
+  stream_info->setResponseCodeDetails("via_upstream");
+  stream_info->setRouteName("benchmark_route");
+  stream_info->addBytesReceived(1024);
+  stream_info->addBytesSent(65536);
+  return stream_info;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FileAccessLog(benchmark::State& state) {
+  Stats::IsolatedStoreImpl store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("benchmark_thread");
+  Thread::MutexBasicLockable lock;
+  AccessLog::AccessLogManagerImpl manager(std::chrono::milliseconds(1000), *api, *dispatcher, lock,
+                                          store);
+  const std::string path = TestEnvironment::temporaryPath("binary_ring_speed_test.log");
+  File::FileAccessLog log({Filesystem::DestinationType::File, path}, nullptr,
+                          Formatter::SubstitutionFormatUtils::defaultSubstitutionFormatter(),
+                          manager);
+
+  std::unique_ptr<TestStreamInfo> stream_info = makeStreamInfo(api->timeSource());
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"}, {":path", "/foo/bar"}, {":authority", "example.com"}};
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    log.log(&request_headers, nullptr, nullptr, *stream_info);
+  }
+}
+BENCHMARK(BM_FileAccessLog);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_BinaryRingAccessLog(benchmark::State& state) {
+  Stats::IsolatedStoreImpl store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  const std::string path = TestEnvironment::temporaryPath("binary_ring_speed_test.ring");
+  auto ring_file = std::make_shared<BinaryRing::RingFile>(path, 64 * 1024 * 1024);
+  BinaryRing::BinaryRingAccessLog log(
+      nullptr, BinaryRing::RecordEncoder(BinaryRing::RecordEncoder::allFields()), ring_file, store);
+
+  std::unique_ptr<TestStreamInfo> stream_info = makeStreamInfo(api->timeSource());
+  Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"}, {":path", "/foo/bar"}, {":authority", "example.com"}};
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    log.log(&request_headers, nullptr, nullptr, *stream_info);
+  }
+  state.counters["bytes_per_record"] =
+      static_cast<double>(ring_file->header().head_.load()) / state.iterations();
+}
+BENCHMARK(BM_BinaryRingAccessLog);
+
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,92 @@
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/binary_ring/v3/binary_ring.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/extensions/access_loggers/binary_ring/config.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+namespace {
+
+class BinaryRingAccessLogConfigTest : public testing::Test {
+protected:
+  BinaryRingAccessLogConfigTest()
+      : path_(TestEnvironment::temporaryPath("binary_ring_config.ring")) {
+    TestEnvironment::removePath(path_);
+  }
+  ~BinaryRingAccessLogConfigTest() override { TestEnvironment::removePath(path_); }
+
+  AccessLog::InstanceSharedPtr createLog(const std::string& yaml) {
+    envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    proto_config.set_path(path_);
+
+    envoy::config::accesslog::v3::AccessLog config;
+    config.set_name("envoy.access_loggers.binary_ring");
+    config.mutable_typed_config()->PackFrom(proto_config);
+    return AccessLog::AccessLogFactory::fromProto(config, context_);
+  }
+
+  const std::string path_;
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+};
+
+TEST_F(BinaryRingAccessLogConfigTest, ValidateFail) {
+  EXPECT_THROW(
+      BinaryRingAccessLogFactory().createAccessLogInstance(
+          envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog(), nullptr,
+          context_),
+      ProtoValidationException);
+}
+
+TEST_F(BinaryRingAccessLogConfigTest, RingSizeTooSmall) {
+  EXPECT_THROW(createLog(R"EOF(
+path: "ignored"
+ring_size_bytes: 1024
+)EOF"),
+               ProtoValidationException);
+}
+
+TEST_F(BinaryRingAccessLogConfigTest, CreatesRingFile) {
+  AccessLog::InstanceSharedPtr log = createLog(R"EOF(
+path: "ignored"
+ring_size_bytes: 65536
+fields: [START_TIME, RESPONSE_CODE]
+)EOF");
+  ASSERT_NE(nullptr, log);
+
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  stream_info.response_code_ = 200;
+  log->log(nullptr, nullptr, nullptr, stream_info);
+  EXPECT_EQ(1UL, context_.scope_.counterFromString("access_logs.binary_ring.records_written")
+                     .value());
+}
+
+TEST_F(BinaryRingAccessLogConfigTest, ConflictingRingSizes) {
+  AccessLog::InstanceSharedPtr log = createLog(R"EOF(
+path: "ignored"
+ring_size_bytes: 65536
+)EOF");
+  EXPECT_THROW_WITH_REGEX(createLog(R"EOF(
+path: "ignored"
+ring_size_bytes: 131072
+)EOF"),
+                          EnvoyException, "is already in use with a ring size of 65536 bytes");
+}
+
+} // namespace
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,283 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "source/extensions/access_loggers/binary_ring/ring_file.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace BinaryRing {
+namespace {
+
+constexpr uint64_t Capacity = 64;
+
+// Read-only mapping of a ring file, as an external tailer would hold it.
+class ReadOnlyMapping {
+public:
+  explicit ReadOnlyMapping(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    EXPECT_NE(-1, fd);
+    size_ = sizeof(RingFileHeader) + Capacity;
+    mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    EXPECT_NE(MAP_FAILED, mapping_);
+    ::close(fd);
+  }
+  ~ReadOnlyMapping() { ::munmap(mapping_, size_); }
+
+  RingFileReader reader() const { return {static_cast<const uint8_t*>(mapping_), size_}; }
+
+private:
+  void* mapping_;
+  size_t size_;
+};
+
+class RingFileTest : public testing::Test {
+protected:
+  RingFileTest() : path_(TestEnvironment::temporaryPath("binary_ring_test.ring")) {
+    TestEnvironment::removePath(path_);
+  }
+  ~RingFileTest() override { TestEnvironment::removePath(path_); }
+
+  std::vector<std::string> readAll(const RingFileReader& reader, uint64_t& cursor) {
+    std::vector<std::string> records;
+    std::string record;
+    while (reader.next(cursor, record) == RingFileReader::ReadResult::Record) {
+      records.push_back(record);
+    }
+    return records;
+  }
+
+  const std::string path_;
+};
+
+TEST(RingFramingTest, VarintRoundTrip) {
+  for (const uint64_t value : {0ULL, 1ULL, 127ULL, 128ULL, 300ULL, 1ULL << 35, ~0ULL}) {
+    uint8_t buffer[10];
+    const uint8_t* end = RingFraming::writeVarint(value, buffer);
+    EXPECT_EQ(RingFraming::varintSize(value), static_cast<size_t>(end - buffer));
+
+    absl::string_view view(reinterpret_cast<const char*>(buffer), end - buffer);
+    uint64_t decoded = 0;
+    EXPECT_TRUE(RingFraming::readVarint(view, decoded));
+    EXPECT_EQ(value, decoded);
+    EXPECT_TRUE(view.empty());
+  }
+}
+
+TEST(RingFramingTest, TruncatedVarint) {
+  absl::string_view view("\x80\x80", 2);
+  uint64_t value = 0;
+  EXPECT_FALSE(RingFraming::readVarint(view, value));
+  EXPECT_EQ(2, view.size());
+}
+
+TEST_F(RingFileTest, AppendAndRead) {
+  RingFile ring(path_, Capacity);
+  uint64_t overwritten = 0;
+  EXPECT_TRUE(ring.append("hello", overwritten));
+  EXPECT_TRUE(ring.append("world", overwritten));
+  EXPECT_EQ(0, overwritten);
+
+  ReadOnlyMapping mapping(path_);
+  RingFileReader reader = mapping.reader();
+  uint64_t cursor = reader.oldest();
+  EXPECT_EQ(std::vector<std::string>({"hello", "world"}), readAll(reader, cursor));
+  EXPECT_EQ(reader.newest(), cursor);
+  EXPECT_EQ(2, reader.header().records_.load());
+
+  std::string record;
+  EXPECT_EQ(RingFileReader::ReadResult::Empty, reader.next(cursor, record));
+  EXPECT_TRUE(ring.append("again", overwritten));
+  EXPECT_EQ(RingFileReader::ReadResult::Record, reader.next(cursor, record));
+  EXPECT_EQ("again", record);
+}
+
+TEST_F(RingFileTest, RejectsOversizedRecords) {
+  RingFile ring(path_, Capacity);
+  uint64_t overwritten = 0;
+  EXPECT_FALSE(ring.append(std::string(ring.maxRecordSize() + 1, 'x'), overwritten));
+  EXPECT_TRUE(ring.append(std::string(ring.maxRecordSize(), 'x'), overwritten));
+}
+
+TEST_F(RingFileTest, WrapsAndEvictsOldest) {
+  RingFile ring(path_, Capacity);
+  ReadOnlyMapping mapping(path_);
+  RingFileReader reader = mapping.reader();
+
+  // Each framed record is 11 bytes, so the sixth record does not fit before the end of the data
+  // area and forces padding plus eviction of the first record.
+  uint64_t overwritten = 0;
+  uint64_t total_overwritten = 0;
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(ring.append(absl::StrCat("record-", i, "!!"), overwritten));
+    total_overwritten += overwritten;
+  }
+  EXPECT_GT(total_overwritten, 0);
+
+  uint64_t cursor = reader.oldest();
+  const std::vector<std::string> records = readAll(reader, cursor);
+  ASSERT_EQ(8 - total_overwritten, records.size());
+  EXPECT_EQ("record-7!!", records.back());
+  EXPECT_LE(reader.newest() - reader.oldest(), Capacity);
+}
+
+TEST_F(RingFileTest, ReaderDetectsOverrun) {
+  RingFile ring(path_, Capacity);
+  ReadOnlyMapping mapping(path_);
+  RingFileReader reader = mapping.reader();
+
+  uint64_t overwritten = 0;
+  EXPECT_TRUE(ring.append("first-record", overwritten));
+  uint64_t cursor = reader.oldest();
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(ring.append("later-record", overwritten));
+  }
+
+  std::string record;
+  EXPECT_EQ(RingFileReader::ReadResult::Overrun, reader.next(cursor, record));
+  EXPECT_EQ(reader.oldest(), cursor);
+  EXPECT_EQ(RingFileReader::ReadResult::Record, reader.next(cursor, record));
+  EXPECT_EQ("later-record", record);
+}
+
+TEST_F(RingFileTest, ResumesExistingRing) {
+  uint64_t overwritten = 0;
+  {
+    RingFile ring(path_, Capacity);
+    EXPECT_TRUE(ring.append("before", overwritten));
+  }
+  {
+    RingFile ring(path_, Capacity);
+    EXPECT_TRUE(ring.append("after", overwritten));
+  }
+
+  ReadOnlyMapping mapping(path_);
+  RingFileReader reader = mapping.reader();
+  uint64_t cursor = reader.oldest();
+  EXPECT_EQ(std::vector<std::string>({"before", "after"}), readAll(reader, cursor));
+}
+
+TEST_F(RingFileTest, ReinitializesOnCapacityChange) {
+  uint64_t overwritten = 0;
+  {
+    RingFile ring(path_, Capacity * 2);
+    EXPECT_TRUE(ring.append("before", overwritten));
+  }
+  RingFile ring(path_, Capacity);
+  EXPECT_EQ(0, ring.header().head_.load());
+  EXPECT_EQ(Capacity, ring.header().capacity_);
+}
+
+// A hot restart parent and child map the same file and append to it concurrently. The lock in the
+// file header keeps their records intact: every record is either still readable or was reported
+// as overwritten.
+TEST_F(RingFileTest, ConcurrentWritersShareTheLock) {
+  constexpr uint64_t LargeCapacity = Capacity * 1024;
+  constexpr int RecordsPerWriter = 100000;
+  RingFile parent(path_, LargeCapacity);
+  RingFile child(path_, LargeCapacity);
+  std::atomic<bool> start{false};
+  std::atomic<uint64_t> overwritten_total{0};
+  auto write = [&](RingFile& ring, absl::string_view prefix) {
+    while (!start) {
+    }
+    uint64_t overwritten = 0;
+    for (int i = 0; i < RecordsPerWriter; ++i) {
+      EXPECT_TRUE(ring.append(absl::StrCat(prefix, i), overwritten));
+      overwritten_total += overwritten;
+    }
+  };
+  std::thread parent_thread([&] { write(parent, "parent-"); });
+  std::thread child_thread([&] { write(child, "child-"); });
+  start = true;
+  parent_thread.join();
+  child_thread.join();
+
+  EXPECT_EQ(2 * RecordsPerWriter, parent.header().records_.load());
+  const RingFileReader reader(reinterpret_cast<const uint8_t*>(&parent.header()),
+                              sizeof(RingFileHeader) + LargeCapacity);
+  uint64_t cursor = reader.oldest();
+  const std::vector<std::string> records = readAll(reader, cursor);
+  for (const std::string& record : records) {
+    EXPECT_TRUE(absl::StartsWith(record, "parent-") || absl::StartsWith(record, "child-"));
+  }
+  EXPECT_EQ(reader.newest(), cursor);
+  EXPECT_EQ(2 * RecordsPerWriter, records.size() + overwritten_total);
+}
+
+TEST_F(RingFileTest, ReinitializesCorruptCursorsOnResume) {
+  uint64_t overwritten = 0;
+  {
+    RingFile ring(path_, Capacity);
+    EXPECT_TRUE(ring.append("before", overwritten));
+    const_cast<RingFileHeader&>(ring.header()).tail_ = ring.header().head_ + 1;
+  }
+  RingFile ring(path_, Capacity);
+  EXPECT_EQ(0, ring.header().head_.load());
+  EXPECT_EQ(0, ring.header().tail_.load());
+
+  // A tailer whose cursor is past the new head is moved back to the oldest record.
+  EXPECT_TRUE(ring.append("after", overwritten));
+  ReadOnlyMapping mapping(path_);
+  RingFileReader reader = mapping.reader();
+  uint64_t cursor = 1000;
+  std::string record;
+  EXPECT_EQ(RingFileReader::ReadResult::Overrun, reader.next(cursor, record));
+  EXPECT_EQ(std::vector<std::string>({"after"}), readAll(reader, cursor));
+}
+
+// Corrupt framing at the tail drops the unreadable records instead of crashing the writer.
+TEST_F(RingFileTest, DropsRecordsWithCorruptFraming) {
+  RingFile ring(path_, Capacity);
+  uint64_t overwritten = 0;
+  EXPECT_TRUE(ring.append("0123456789", overwritten));
+  EXPECT_TRUE(ring.append("0123456789", overwritten));
+  {
+    const int fd = ::open(path_.c_str(), O_WRONLY);
+    ASSERT_NE(-1, fd);
+    const uint8_t garbage[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    ASSERT_EQ(sizeof(garbage), ::pwrite(fd, garbage, sizeof(garbage), sizeof(RingFileHeader)));
+    ::close(fd);
+  }
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(ring.append(absl::StrCat("record-", i), overwritten));
+  }
+
+  ReadOnlyMapping mapping(path_);
+  RingFileReader reader = mapping.reader();
+  uint64_t cursor = reader.oldest();
+  const std::vector<std::string> records = readAll(reader, cursor);
+  ASSERT_FALSE(records.empty());
+  EXPECT_EQ("record-9", records.back());
+}
+
+TEST(RingFileReaderTest, InvalidMapping) {
+  const std::string garbage(sizeof(RingFileHeader) + Capacity, 'x');
+  EXPECT_THROW_WITH_MESSAGE(
+      RingFileReader(reinterpret_cast<const uint8_t*>(garbage.data()), garbage.size()),
+      EnvoyException, "not a binary access log ring file");
+}
+
+TEST(RingFileErrorTest, UnopenablePath) {
+  EXPECT_THROW_WITH_REGEX(RingFile("/non/existent/dir/ring", Capacity), EnvoyException,
+                          "unable to open binary access log ring file /non/existent/dir/ring");
+}
+
+} // namespace
+} // namespace BinaryRing
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
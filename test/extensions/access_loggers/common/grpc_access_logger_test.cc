@@ -11,12 +11,14 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/access_log/mocks.h"
 #include "test/mocks/grpc/mocks.h"
 #include "test/mocks/ssl/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
 
 using testing::_;
 using testing::InSequence;
@@ -147,7 +149,7 @@ public:
         }));
   }
 
-  Stats::IsolatedStoreImpl stats_store_;
+  Stats::TestUtil::TestStore stats_store_;
   Event::MockTimer* timer_ = nullptr;
   Event::MockDispatcher dispatcher_;
   Grpc::MockAsyncClient* async_client_{new Grpc::MockAsyncClient};
@@ -260,6 +262,15 @@ TEST_F(GrpcAccessLogTest, StreamFailure) {
           }));
   logger_->log(mockHttpEntry());
   EXPECT_EQ(1, logger_->numInits());
+
+  // The dropped batch is not recorded in the batch histograms.
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  expectFlushedLogEntriesCount(stream, MOCK_HTTP_LOG_FIELD_NAME, 1);
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(std::vector<uint64_t>{1},
+            stats_store_.histogramValues("mock_access_log_prefix.batch_entries", false));
 }
 
 TEST_F(GrpcAccessLogTest, StreamFailureAndRetry) {
@@ -333,6 +344,138 @@ TEST_F(GrpcAccessLogTest, Flushing) {
   timer_->invokeCallback();
 }
 
+// Test that messages are gzip compressed and advertised with grpc-encoding.
+TEST_F(GrpcAccessLogTest, GzipCompression) {
+  config_.set_message_compression(
+      envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig::GZIP);
+  initLogger(FlushInterval, 0);
+
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  EXPECT_CALL(stream, isAboveWriteBufferHighWatermark()).WillOnce(Return(false));
+  EXPECT_CALL(stream, sendMessageRaw_(_, _)).Times(0);
+  EXPECT_CALL(stream, sendCompressedMessageRaw(_, false))
+      .WillOnce(Invoke([](Buffer::InstancePtr& request, bool) -> bool {
+        // gzip magic bytes.
+        EXPECT_EQ("\x1f\x8b", request->toString().substr(0, 2));
+        return true;
+      }));
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(1, logger_->numClears());
+
+  Http::TestRequestHeaderMapImpl headers;
+  callbacks->onCreateInitialMetadata(headers);
+  EXPECT_EQ("gzip", headers.get_("grpc-encoding"));
+}
+
+// Test that streams that cannot send compressed messages fall back to uncompressed messages.
+TEST_F(GrpcAccessLogTest, GzipCompressionUnsupported) {
+  config_.set_message_compression(
+      envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig::GZIP);
+  initLogger(FlushInterval, 0);
+
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  EXPECT_CALL(stream, sendCompressedMessageRaw(_, false)).WillOnce(Return(false));
+  expectFlushedLogEntriesCount(stream, MOCK_HTTP_LOG_FIELD_NAME, 1);
+  logger_->log(mockHttpEntry());
+
+  // Compression is not attempted again.
+  expectFlushedLogEntriesCount(stream, MOCK_HTTP_LOG_FIELD_NAME, 1);
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(2, logger_->numClears());
+}
+
+// Test that low priority entries are sampled while the stream is backed up.
+TEST_F(GrpcAccessLogTest, BackedUpSampling) {
+  config_.mutable_backed_up_sample_rate()->set_numerator(50);
+  initLogger(FlushInterval, 0);
+
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  EXPECT_CALL(stream, isAboveWriteBufferHighWatermark()).WillRepeatedly(Return(true));
+  EXPECT_CALL(stream, sendMessageRaw_(_, _)).Times(0);
+
+  // The first entry is buffered and backs the stream up.
+  logger_->log(mockHttpEntry());
+  // Every other entry is kept from now on.
+  for (int i = 0; i < 4; ++i) {
+    logger_->log(mockHttpEntry());
+  }
+  EXPECT_EQ(3,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+  EXPECT_EQ(
+      2, TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_sampled_out")->value());
+  EXPECT_EQ(0,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_dropped")->value());
+
+  // Once a flush succeeds, entries are no longer sampled.
+  EXPECT_CALL(stream, isAboveWriteBufferHighWatermark()).WillRepeatedly(Return(false));
+  EXPECT_CALL(stream, sendMessageRaw_(_, false)).Times(3);
+  EXPECT_CALL(*timer_, enableTimer(FlushInterval, _));
+  timer_->invokeCallback();
+  logger_->log(mockHttpEntry());
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(5,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+  EXPECT_EQ(
+      2, TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_sampled_out")->value());
+}
+
+// Test that a logger shared across workers flushes on its own dispatcher.
+TEST_F(GrpcAccessLogTest, AggregateAcrossWorkers) {
+  config_.set_aggregate_across_workers(true);
+  const int max_buffer_size = 2 * mockHttpEntry().ByteSizeLong();
+  initLogger(FlushInterval, max_buffer_size);
+
+  // Log from a thread other than the one owning the logger: filling the buffer schedules a single
+  // flush, and entries keep being buffered until twice the limit.
+  EXPECT_CALL(dispatcher_, isThreadSafe()).WillRepeatedly(Return(false));
+  std::function<void()> flush;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(Invoke([&flush](std::function<void()> cb) {
+    flush = std::move(cb);
+  }));
+  for (int i = 0; i < 5; ++i) {
+    logger_->log(mockHttpEntry());
+  }
+  EXPECT_EQ(4,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+  EXPECT_EQ(1,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_dropped")->value());
+
+  // The buffer is swapped out before the message is sent, so workers can keep logging while the
+  // owning thread sends it.
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+  EXPECT_CALL(stream, isAboveWriteBufferHighWatermark()).WillOnce(Return(false));
+  EXPECT_CALL(stream, sendMessageRaw_(_, false))
+      .WillOnce(Invoke([this](Buffer::InstancePtr& request, bool) {
+        ProtobufWkt::Struct message;
+        Buffer::ZeroCopyInputStreamImpl request_stream(std::move(request));
+        EXPECT_TRUE(message.ParseFromZeroCopyStream(&request_stream));
+        EXPECT_EQ(4, message.fields().at(MOCK_HTTP_LOG_FIELD_NAME).number_value());
+        logger_->log(mockHttpEntry());
+      }));
+  flush();
+  EXPECT_EQ(1, logger_->numClears());
+  EXPECT_EQ(5,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+  EXPECT_EQ(std::vector<uint64_t>{4},
+            stats_store_.histogramValues("mock_access_log_prefix.batch_entries", false));
+
+  // A flush posted after the logger is gone does nothing.
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce(Invoke([&flush](std::function<void()> cb) {
+    flush = std::move(cb);
+  }));
+  logger_->log(mockHttpEntry());
+  logger_.reset();
+  flush();
+}
+
 class MockGrpcAccessLoggerCache
     : public Common::GrpcAccessLoggerCache<
           MockGrpcAccessLoggerImpl,
@@ -353,6 +496,10 @@ private:
                                                       "mock_access_log_prefix.",
                                                       mockMethodDescriptor());
   }
+  bool aggregateAcrossWorkers(
+      const envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig& config) override {
+    return config.aggregate_across_workers();
+  }
 };
 
 class GrpcAccessLoggerCacheTest : public testing::Test {
@@ -407,6 +554,29 @@ TEST_F(GrpcAccessLoggerCacheTest, Deduplication) {
   EXPECT_NE(logger1, logger_cache_.getOrCreateLogger(config, Common::GrpcAccessLoggerType::HTTP));
 }
 
+// Test that a logger shared across workers is released with its last user.
+TEST_F(GrpcAccessLoggerCacheTest, SharedLoggerEviction) {
+  envoy::extensions::access_loggers::grpc::v3::CommonGrpcAccessLogConfig config;
+  config.set_log_name("log-1");
+  config.mutable_grpc_service()->mutable_envoy_grpc()->set_cluster_name("cluster-1");
+  config.set_aggregate_across_workers(true);
+
+  expectClientCreation();
+  MockGrpcAccessLoggerImpl::SharedPtr logger =
+      logger_cache_.getOrCreateLogger(config, Common::GrpcAccessLoggerType::HTTP);
+  EXPECT_EQ(logger, logger_cache_.getOrCreateLogger(config, Common::GrpcAccessLoggerType::HTTP));
+
+  // The logger is deleted on the thread that owns its stream.
+  EXPECT_CALL(tls_.dispatcher_, deleteInDispatcherThread(_)).Times(2);
+  logger.reset();
+
+  // The next access log with this configuration gets a new logger.
+  expectClientCreation();
+  logger = logger_cache_.getOrCreateLogger(config, Common::GrpcAccessLoggerType::HTTP);
+  EXPECT_NE(nullptr, logger);
+  logger.reset();
+}
+
 } // namespace
 } // namespace GrpcCommon
 } // namespace AccessLoggers
@@ -22,6 +22,16 @@ TEST(GrpcJsonTranscoderFilterConfigTest, ValidateFail) {
                ProtoValidationException);
 }
 
+// Only the route specific configs with an inline descriptor set are created lazily.
+TEST(GrpcJsonTranscoderFilterConfigTest, RouteSpecificFilterConfigLazy) {
+  envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder proto_config;
+  proto_config.set_proto_descriptor("/path/to/descriptor.pb");
+  EXPECT_FALSE(GrpcJsonTranscoderFilterConfig().isRouteSpecificFilterConfigLazy(proto_config));
+
+  proto_config.set_proto_descriptor_bin("descriptor");
+  EXPECT_TRUE(GrpcJsonTranscoderFilterConfig().isRouteSpecificFilterConfigLazy(proto_config));
+}
+
 } // namespace
 } // namespace GrpcJsonTranscoder
 } // namespace HttpFilters
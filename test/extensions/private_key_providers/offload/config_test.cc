@@ -0,0 +1,111 @@
+#include <string>
+
+#include "envoy/extensions/transport_sockets/tls/v3/cert.pb.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/private_key_providers/offload/config.h"
+#include "source/extensions/transport_sockets/tls/private_key/private_key_manager_impl.h"
+
+#include "test/mocks/server/transport_socket_factory_context.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+namespace {
+
+class OffloadConfigTest : public testing::Test {
+public:
+  OffloadConfigTest() : api_(Api::createApiForTest(store_)) {
+    ON_CALL(factory_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_, scope()).WillByDefault(ReturnRef(store_));
+    ON_CALL(factory_context_, sslContextManager()).WillByDefault(ReturnRef(context_manager_));
+    ON_CALL(context_manager_, privateKeyMethodManager())
+        .WillByDefault(ReturnRef(private_key_method_manager_));
+  }
+
+  Ssl::PrivateKeyMethodProviderSharedPtr createWithConfig(const std::string& yaml) {
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider private_key_provider;
+    TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), private_key_provider);
+    return factory_context_.sslContextManager()
+        .privateKeyMethodManager()
+        .createPrivateKeyMethodProvider(private_key_provider, factory_context_);
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Api::ApiPtr api_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  NiceMock<Ssl::MockContextManager> context_manager_;
+  TransportSockets::Tls::PrivateKeyMethodManagerImpl private_key_method_manager_;
+};
+
+TEST_F(OffloadConfigTest, CreateRsa) {
+  const std::string yaml = R"EOF(
+      provider_name: offload
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.offload.v3.OffloadPrivateKeyMethodConfig
+        private_key: { "filename": "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem" }
+        thread_count: 4
+        max_batch_size: 8
+        max_pending_operations: 64
+)EOF";
+
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithConfig(yaml);
+  ASSERT_NE(nullptr, provider);
+  EXPECT_TRUE(provider->checkFips());
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method = provider->getBoringSslPrivateKeyMethod();
+  ASSERT_NE(nullptr, method);
+  EXPECT_NE(nullptr, method->sign);
+  EXPECT_NE(nullptr, method->decrypt);
+  EXPECT_NE(nullptr, method->complete);
+}
+
+TEST_F(OffloadConfigTest, CreateEcdsa) {
+  const std::string yaml = R"EOF(
+      provider_name: offload
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.offload.v3.OffloadPrivateKeyMethodConfig
+        private_key: { "filename": "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/selfsigned_ecdsa_p256_key.pem" }
+)EOF";
+
+  Ssl::PrivateKeyMethodProviderSharedPtr provider = createWithConfig(yaml);
+  ASSERT_NE(nullptr, provider);
+  EXPECT_TRUE(provider->checkFips());
+}
+
+TEST_F(OffloadConfigTest, MissingPrivateKey) {
+  const std::string yaml = R"EOF(
+      provider_name: offload
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.offload.v3.OffloadPrivateKeyMethodConfig
+        thread_count: 2
+)EOF";
+
+  EXPECT_THROW(createWithConfig(yaml), EnvoyException);
+}
+
+TEST_F(OffloadConfigTest, ZeroThreads) {
+  const std::string yaml = R"EOF(
+      provider_name: offload
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.offload.v3.OffloadPrivateKeyMethodConfig
+        private_key: { "filename": "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem" }
+        thread_count: 0
+)EOF";
+
+  EXPECT_THROW(createWithConfig(yaml), EnvoyException);
+}
+
+} // namespace
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
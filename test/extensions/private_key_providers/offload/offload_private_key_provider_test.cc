@@ -0,0 +1,286 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/private_key_providers/offload/v3/offload.pb.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/private_key_providers/offload/offload_private_key_provider.h"
+
+#include "test/mocks/server/transport_socket_factory_context.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/evp.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+namespace {
+
+class TestCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  explicit TestCallbacks(Event::Dispatcher& dispatcher) : dispatcher_(dispatcher) {}
+
+  void onPrivateKeyMethodComplete() override {
+    ++completions_;
+    dispatcher_.exit();
+  }
+
+  Event::Dispatcher& dispatcher_;
+  uint32_t completions_{};
+};
+
+class OffloadPrivateKeyProviderTest : public testing::Test {
+protected:
+  OffloadPrivateKeyProviderTest()
+      : api_(Api::createApiForTest(store_)), dispatcher_(api_->allocateDispatcher("test_thread")),
+        ssl_ctx_(SSL_CTX_new(TLS_method())), ssl_(SSL_new(ssl_ctx_.get())),
+        callbacks_(*dispatcher_) {
+    ON_CALL(factory_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_, scope()).WillByDefault(ReturnRef(store_));
+  }
+
+  ~OffloadPrivateKeyProviderTest() override {
+    if (provider_ != nullptr) {
+      provider_->unregisterPrivateKeyMethod(ssl_.get());
+    }
+  }
+
+  void createProvider(const std::string& key_file, uint32_t thread_count = 2) {
+    envoy::extensions::private_key_providers::offload::v3::OffloadPrivateKeyMethodConfig config;
+    config.mutable_private_key()->set_filename(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file));
+    config.mutable_thread_count()->set_value(thread_count);
+    provider_ = std::make_shared<OffloadPrivateKeyMethodProvider>(config, factory_context_);
+    provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_);
+    method_ = provider_->getBoringSslPrivateKeyMethod();
+    pkey_ = readKey(key_file);
+  }
+
+  static bssl::UniquePtr<EVP_PKEY> readKey(const std::string& key_file) {
+    const std::string pem = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/" + key_file));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+    return bssl::UniquePtr<EVP_PKEY>(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  // Wait for the pool to post the completion, then collect the result.
+  ssl_private_key_result_t waitAndComplete(std::vector<uint8_t>& out) {
+    out.resize(1024);
+    size_t out_len = 0;
+    EXPECT_EQ(ssl_private_key_retry, method_->complete(ssl_.get(), out.data(), &out_len, 0));
+    dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+    EXPECT_EQ(1, callbacks_.completions_);
+    const ssl_private_key_result_t result =
+        method_->complete(ssl_.get(), out.data(), &out_len, out.size());
+    out.resize(out_len);
+    return result;
+  }
+
+  bool verify(uint16_t signature_algorithm, const std::vector<uint8_t>& signature) {
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pkey_ctx = nullptr;
+    if (!EVP_DigestVerifyInit(ctx.get(), &pkey_ctx,
+                              SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+                              pkey_.get())) {
+      return false;
+    }
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+        (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+         !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+      return false;
+    }
+    return EVP_DigestVerify(ctx.get(), signature.data(), signature.size(),
+                            reinterpret_cast<const uint8_t*>(message_.data()), message_.size());
+  }
+
+  ssl_private_key_result_t sign(uint16_t signature_algorithm) {
+    uint8_t out[1024];
+    size_t out_len = 0;
+    return method_->sign(ssl_.get(), out, &out_len, sizeof(out), signature_algorithm,
+                         reinterpret_cast<const uint8_t*>(message_.data()), message_.size());
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  bssl::UniquePtr<SSL> ssl_;
+  TestCallbacks callbacks_;
+  testing::NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  std::shared_ptr<OffloadPrivateKeyMethodProvider> provider_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  const std::string message_{"handshake transcript to sign"};
+};
+
+TEST_F(OffloadPrivateKeyProviderTest, RsaPkcs1Sign) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(ssl_private_key_success, waitAndComplete(signature));
+  EXPECT_TRUE(verify(SSL_SIGN_RSA_PKCS1_SHA256, signature));
+  EXPECT_EQ(1, store_.counterFromString("private_key_offload.sign_requests").value());
+  EXPECT_EQ(0, store_.counterFromString("private_key_offload.failures").value());
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, RsaPssSign) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PSS_RSAE_SHA384));
+
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(ssl_private_key_success, waitAndComplete(signature));
+  EXPECT_TRUE(verify(SSL_SIGN_RSA_PSS_RSAE_SHA384, signature));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, EcdsaSign) {
+  createProvider("selfsigned_ecdsa_p256_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_ECDSA_SECP256R1_SHA256));
+
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(ssl_private_key_success, waitAndComplete(signature));
+  EXPECT_TRUE(verify(SSL_SIGN_ECDSA_SECP256R1_SHA256, signature));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, RsaDecrypt) {
+  createProvider("unittest_key.pem");
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  std::vector<uint8_t> plaintext(RSA_size(rsa), 0x42);
+  plaintext[0] = 0;
+  std::vector<uint8_t> ciphertext(RSA_size(rsa));
+  size_t ciphertext_len = 0;
+  ASSERT_TRUE(RSA_encrypt(rsa, &ciphertext_len, ciphertext.data(), ciphertext.size(),
+                          plaintext.data(), plaintext.size(), RSA_NO_PADDING));
+
+  uint8_t out[1024];
+  size_t out_len = 0;
+  EXPECT_EQ(ssl_private_key_retry, method_->decrypt(ssl_.get(), out, &out_len, sizeof(out),
+                                                    ciphertext.data(), ciphertext_len));
+  std::vector<uint8_t> decrypted;
+  EXPECT_EQ(ssl_private_key_success, waitAndComplete(decrypted));
+  EXPECT_EQ(plaintext, decrypted);
+  EXPECT_EQ(1, store_.counterFromString("private_key_offload.decrypt_requests").value());
+}
+
+// A signature algorithm that does not match the key fails once the operation completes.
+TEST_F(OffloadPrivateKeyProviderTest, MismatchedSignatureAlgorithm) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_ECDSA_SECP256R1_SHA256));
+
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(ssl_private_key_failure, waitAndComplete(signature));
+  EXPECT_EQ(1, store_.counterFromString("private_key_offload.failures").value());
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, SecondOperationWhileInFlightFails) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+  EXPECT_EQ(ssl_private_key_failure, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+
+  std::vector<uint8_t> signature;
+  EXPECT_EQ(ssl_private_key_success, waitAndComplete(signature));
+}
+
+// The connection is not called back when it is closed while its operation is in flight.
+TEST_F(OffloadPrivateKeyProviderTest, UnregisterWhileInFlight) {
+  createProvider("unittest_key.pem");
+  EXPECT_EQ(ssl_private_key_retry, sign(SSL_SIGN_RSA_PKCS1_SHA256));
+  provider_->unregisterPrivateKeyMethod(ssl_.get());
+  // Destroying the provider joins the pool threads, so any completion has been posted by now.
+  provider_.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(0, callbacks_.completions_);
+}
+
+// Providers share the pool created by the first of them.
+TEST_F(OffloadPrivateKeyProviderTest, ProvidersShareThePool) {
+  createProvider("unittest_key.pem", 2);
+  envoy::extensions::private_key_providers::offload::v3::OffloadPrivateKeyMethodConfig config;
+  config.mutable_private_key()->set_filename(TestEnvironment::substitute(
+      "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"));
+  config.mutable_thread_count()->set_value(3);
+  OffloadPrivateKeyMethodProvider other(config, factory_context_);
+
+  OffloadThreadPoolSharedPtr pool = factory_context_.singletonManager().getTyped<OffloadThreadPool>(
+      "offload_private_key_thread_pool_singleton", []() -> Singleton::InstanceSharedPtr {
+        ADD_FAILURE() << "the pool should already exist";
+        return nullptr;
+      });
+  ASSERT_NE(nullptr, pool);
+  EXPECT_EQ(2, pool->threadCount());
+}
+
+// Operations still queued when the pool is destroyed are completed as failures, so that their
+// handshakes are resumed and the connections closed.
+TEST(OffloadThreadPoolTest, FailsQueuedOperationsOnShutdown) {
+  constexpr uint32_t NumOperations = 100;
+  Stats::IsolatedStoreImpl store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  const std::string pem = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+      "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/unittest_key.pem"));
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+  bssl::UniquePtr<EVP_PKEY> pkey(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  const std::string message = "handshake transcript to sign";
+
+  uint32_t succeeded = 0;
+  uint32_t failed = 0;
+  {
+    OffloadThreadPool pool(api->threadFactory(), 1, 1);
+    for (uint32_t i = 0; i < NumOperations; ++i) {
+      auto operation = std::make_shared<PrivateKeyOperation>(
+          PrivateKeyOperation::Type::Sign, bssl::UpRef(pkey), SSL_SIGN_RSA_PKCS1_SHA256,
+          reinterpret_cast<const uint8_t*>(message.data()), message.size(), *dispatcher,
+          api->timeSource());
+      PrivateKeyOperation* raw = operation.get();
+      operation->on_complete_ = [raw, &succeeded, &failed]() {
+        ++(raw->succeeded() ? succeeded : failed);
+      };
+      ASSERT_TRUE(pool.submit(std::move(operation), NumOperations));
+    }
+  }
+  dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(NumOperations, succeeded + failed);
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, UnregisteredSslFails) {
+  createProvider("unittest_key.pem");
+  bssl::UniquePtr<SSL> other_ssl(SSL_new(ssl_ctx_.get()));
+  uint8_t out[1024];
+  size_t out_len = 0;
+  EXPECT_EQ(ssl_private_key_failure,
+            method_->sign(other_ssl.get(), out, &out_len, sizeof(out), SSL_SIGN_RSA_PKCS1_SHA256,
+                          reinterpret_cast<const uint8_t*>(message_.data()), message_.size()));
+  EXPECT_EQ(ssl_private_key_failure,
+            method_->complete(other_ssl.get(), out, &out_len, sizeof(out)));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, RegisterTwiceThrows) {
+  createProvider("unittest_key.pem");
+  EXPECT_THROW_WITH_MESSAGE(
+      provider_->registerPrivateKeyMethod(ssl_.get(), callbacks_, *dispatcher_), EnvoyException,
+      "Not registering the offload provider twice for same context");
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, InvalidKey) {
+  envoy::extensions::private_key_providers::offload::v3::OffloadPrivateKeyMethodConfig config;
+  config.mutable_private_key()->set_inline_string("not a key");
+  EXPECT_THROW_WITH_MESSAGE(OffloadPrivateKeyMethodProvider(config, factory_context_),
+                            EnvoyException, "Failed to read private key.");
+}
+
+} // namespace
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,97 @@
+// Simulates a handshake storm: a burst of RSA-2048 signatures requested by a single worker. The
+// inline variant signs on the worker, which cannot serve its other connections until the whole
+// burst is done. The offload variants hand the burst to the provider's thread pool and run the
+// worker's event loop until every completion has arrived.
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/private_key_providers/offload/thread_pool.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+namespace {
+
+constexpr uint32_t StormSize = 64;
+constexpr char Transcript[] = "handshake transcript to sign";
+
+EVP_PKEY* rsaKey() {
+  static EVP_PKEY* pkey = []() {
+    bssl::UniquePtr<RSA> rsa(RSA_new());
+    bssl::UniquePtr<BIGNUM> e(BN_new());
+    RELEASE_ASSERT(BN_set_word(e.get(), RSA_F4), "");
+    RELEASE_ASSERT(RSA_generate_key_ex(rsa.get(), 2048, e.get(), nullptr), "");
+    EVP_PKEY* pkey = EVP_PKEY_new();
+    RELEASE_ASSERT(EVP_PKEY_assign_RSA(pkey, rsa.release()), "");
+    return pkey;
+  }();
+  return pkey;
+}
+
+PrivateKeyOperationSharedPtr makeOperation(Event::Dispatcher& dispatcher,
+                                           TimeSource& time_source) {
+  return std::make_shared<PrivateKeyOperation>(
+      PrivateKeyOperation::Type::Sign, bssl::UpRef(rsaKey()), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+      reinterpret_cast<const uint8_t*>(Transcript), sizeof(Transcript), dispatcher, time_source);
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_InlineSignStorm(benchmark::State& state) {
+  Stats::IsolatedStoreImpl store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("benchmark_thread");
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    for (uint32_t i = 0; i < StormSize; ++i) {
+      PrivateKeyOperationSharedPtr operation = makeOperation(*dispatcher, api->timeSource());
+      operation->run();
+      RELEASE_ASSERT(operation->succeeded(), "");
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * StormSize);
+}
+BENCHMARK(BM_InlineSignStorm)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_OffloadSignStorm(benchmark::State& state) {
+  Stats::IsolatedStoreImpl store;
+  Api::ApiPtr api = Api::createApiForTest(store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("benchmark_thread");
+  OffloadThreadPool pool(api->threadFactory(), state.range(0), state.range(1));
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    uint32_t completed = 0;
+    for (uint32_t i = 0; i < StormSize; ++i) {
+      PrivateKeyOperationSharedPtr operation = makeOperation(*dispatcher, api->timeSource());
+      operation->on_complete_ = [&completed, &dispatcher]() {
+        if (++completed == StormSize) {
+          dispatcher->exit();
+        }
+      };
+      RELEASE_ASSERT(pool.submit(std::move(operation), StormSize), "");
+    }
+    dispatcher->run(Event::Dispatcher::RunType::RunUntilExit);
+  }
+  state.SetItemsProcessed(state.iterations() * StormSize);
+}
+// Arguments are the number of pool threads and the maximum batch size.
+BENCHMARK(BM_OffloadSignStorm)
+    ->Args({1, 1})
+    ->Args({1, 16})
+    ->Args({2, 16})
+    ->Args({4, 16})
+    ->Args({4, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,183 @@
+#include "envoy/extensions/resource_monitors/cgroup_memory/v3/cgroup_memory.pb.h"
+
+#include "source/extensions/resource_monitors/cgroup_memory/cgroup_memory_monitor.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace CgroupMemoryMonitor {
+namespace {
+
+class ResourcePressure : public Server::ResourceUpdateCallbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+  }
+
+  void onFailure(const EnvoyException& error) override { error_ = error.what(); }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+  const std::string& error() const { return *error_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<std::string> error_;
+};
+
+// Fakes a cgroup v2 directory with the files the monitor reads.
+class CgroupMemoryMonitorTest : public testing::Test {
+protected:
+  CgroupMemoryMonitorTest()
+      : api_(Api::createApiForTest()), cgroup_path_(TestEnvironment::temporaryPath("cgroup")) {
+    TestEnvironment::createPath(cgroup_path_);
+    config_.set_cgroup_path(cgroup_path_);
+  }
+
+  ~CgroupMemoryMonitorTest() override { TestEnvironment::removePath(cgroup_path_); }
+
+  void writeFile(const std::string& name, const std::string& contents) {
+    TestEnvironment::writeStringToFileForTest(absl::StrCat(cgroup_path_, "/", name), contents,
+                                              true);
+  }
+
+  void writeMemoryFiles(const std::string& current, const std::string& max,
+                        uint64_t inactive_file) {
+    writeFile("memory.current", current + "\n");
+    writeFile("memory.max", max + "\n");
+    writeFile("memory.stat", absl::StrCat("anon 1000\nfile 3000\nactive_file 1000\ninactive_file ",
+                                          inactive_file, "\nshmem 0\n"));
+  }
+
+  ResourcePressure update() {
+    CgroupMemoryMonitor monitor(config_, api_->fileSystem());
+    ResourcePressure resource;
+    monitor.updateResourceUsage(resource);
+    return resource;
+  }
+
+  Api::ApiPtr api_;
+  const std::string cgroup_path_;
+  envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig config_;
+};
+
+TEST_F(CgroupMemoryMonitorTest, ComputesWorkingSetAgainstCgroupLimit) {
+  // Working set is 6000 - 2000 = 4000 of 10000.
+  writeMemoryFiles("6000", "10000", 2000);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.4, resource.pressure());
+}
+
+TEST_F(CgroupMemoryMonitorTest, ReclaimableCacheLargerThanUsage) {
+  writeMemoryFiles("1000", "10000", 2000);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0, resource.pressure());
+}
+
+TEST_F(CgroupMemoryMonitorTest, UsesLowerOfCgroupAndConfiguredLimit) {
+  writeMemoryFiles("6000", "10000", 1000);
+  config_.set_max_memory_bytes(5000);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(1.0, resource.pressure());
+
+  config_.set_max_memory_bytes(20000);
+  resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.5, resource.pressure());
+}
+
+TEST_F(CgroupMemoryMonitorTest, UnlimitedCgroupUsesConfiguredLimit) {
+  writeMemoryFiles("6000", "max", 1000);
+  config_.set_max_memory_bytes(20000);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.25, resource.pressure());
+}
+
+TEST_F(CgroupMemoryMonitorTest, UnlimitedCgroupWithoutConfiguredLimitFails) {
+  writeMemoryFiles("6000", "max", 1000);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasError());
+  EXPECT_THAT(resource.error(), testing::HasSubstr("is unlimited"));
+}
+
+TEST_F(CgroupMemoryMonitorTest, MissingStatEntryCountsAsZero) {
+  writeFile("memory.current", "6000\n");
+  writeFile("memory.max", "10000\n");
+  writeFile("memory.stat", "anon 6000\n");
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.6, resource.pressure());
+}
+
+TEST_F(CgroupMemoryMonitorTest, MissingFileFails) {
+  writeFile("memory.max", "10000\n");
+  ResourcePressure resource = update();
+  EXPECT_TRUE(resource.hasError());
+}
+
+TEST_F(CgroupMemoryMonitorTest, MalformedFileFails) {
+  writeMemoryFiles("lots", "10000", 0);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasError());
+  EXPECT_EQ("failed to parse memory.current", resource.error());
+}
+
+TEST_F(CgroupMemoryMonitorTest, PressureStallRaisesPressure) {
+  writeMemoryFiles("3000", "10000", 1000);
+  writeFile("memory.pressure", "some avg10=42.50 avg60=10.00 avg300=2.00 total=123456\n"
+                               "full avg10=30.00 avg60=5.00 avg300=1.00 total=65432\n");
+
+  // Ignored unless enabled.
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.2, resource.pressure());
+
+  config_.set_include_pressure_stall_information(true);
+  resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.425, resource.pressure());
+
+  // The working set fraction still applies when it is higher.
+  writeMemoryFiles("9000", "10000", 1000);
+  resource = update();
+  ASSERT_TRUE(resource.hasPressure());
+  EXPECT_DOUBLE_EQ(0.8, resource.pressure());
+}
+
+TEST_F(CgroupMemoryMonitorTest, MalformedPressureStallFails) {
+  writeMemoryFiles("3000", "10000", 1000);
+  writeFile("memory.pressure", "full avg10=30.00 avg60=5.00 avg300=1.00 total=65432\n");
+  config_.set_include_pressure_stall_information(true);
+  ResourcePressure resource = update();
+  ASSERT_TRUE(resource.hasError());
+  EXPECT_EQ("failed to parse memory.pressure", resource.error());
+}
+
+TEST(CgroupPathTest, ResolvesCgroupV2FromProcCgroup) {
+  EXPECT_EQ("/sys/fs/cgroup", CgroupMemoryMonitor::cgroupPathFromProcCgroup("0::/\n"));
+  EXPECT_EQ("/sys/fs/cgroup/system.slice/envoy.service",
+            CgroupMemoryMonitor::cgroupPathFromProcCgroup(
+                "12:memory:/system.slice/envoy.service\n0::/system.slice/envoy.service\n"));
+  EXPECT_THROW_WITH_MESSAGE(
+      CgroupMemoryMonitor::cgroupPathFromProcCgroup("12:memory:/system.slice/envoy.service\n"),
+      EnvoyException, "failed to find the cgroup v2 of the process in /proc/self/cgroup");
+}
+
+} // namespace
+} // namespace CgroupMemoryMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -14,12 +14,16 @@
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "spdlog/spdlog.h"
 
+using testing::_;
 using testing::NiceMock;
 
 namespace Envoy {
@@ -33,6 +37,14 @@ class MockWriter : public UdpStatsdSink::Writer {
 public:
   MOCK_METHOD(void, write, (const std::string& message));
   MOCK_METHOD(void, writeBuffer, (Buffer::Instance & buffer));
+  MOCK_METHOD(void, writeDatagrams, (absl::Span<const absl::string_view> datagrams));
+
+  MockWriter() {
+    ON_CALL(*this, writeDatagrams)
+        .WillByDefault([this](absl::Span<const absl::string_view> datagrams) {
+          UdpStatsdSink::Writer::writeDatagrams(datagrams);
+        });
+  }
 
   void delegateBufferFake() {
     ON_CALL(*this, writeBuffer).WillByDefault([this](Buffer::Instance& buffer) {
@@ -116,6 +128,88 @@ TEST_P(UdpStatsdSinkTest, InitWithIpAddress) {
   tls_.shutdownThread();
 }
 
+TEST_P(UdpStatsdSinkTest, WriteManyDatagrams) {
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  Network::Test::UdpSyncPeer server(GetParam());
+  UdpStatsdSink sink(tls_, server.localAddress(), false);
+
+  // More metrics than datagrams written at once, each in its own datagram.
+  const size_t num_counters = UdpStatsdSink::MAX_DATAGRAMS_PER_WRITE * 2 + 3;
+  std::vector<std::unique_ptr<NiceMock<Stats::MockCounter>>> counters;
+  for (size_t i = 0; i < num_counters; ++i) {
+    counters.push_back(std::make_unique<NiceMock<Stats::MockCounter>>());
+    counters.back()->name_ = absl::StrCat("test_counter_", i);
+    counters.back()->used_ = true;
+    snapshot.counters_.push_back({i, *counters.back()});
+  }
+
+  sink.flush(snapshot);
+  for (size_t i = 0; i < num_counters; ++i) {
+    Network::UdpRecvData data;
+    server.recv(data);
+    EXPECT_EQ(absl::StrCat("envoy.test_counter_", i, ":", i, "|c"), data.buffer_->toString());
+  }
+
+  tls_.shutdownThread();
+}
+
+class OverrideOsSysCallsImpl : public Api::OsSysCallsImpl {
+public:
+  MOCK_METHOD(Api::SysCallIntResult, sendmmsg,
+              (os_fd_t sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags));
+  MOCK_METHOD(bool, supportsMmsg, (), (const));
+};
+
+// A datagram that fails to be written is dropped, and the rest of the flush is still written.
+TEST_P(UdpStatsdSinkTest, WriteDatagramsAfterFailure) {
+  if (!Api::OsSysCallsSingleton::get().supportsMmsg()) {
+    GTEST_SKIP() << "sendmmsg is not supported on this platform";
+  }
+  OverrideOsSysCallsImpl os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, supportsMmsg()).WillRepeatedly(testing::Return(true));
+  // The first call writes the first five datagrams, the second fails, and the following calls
+  // write everything they are given.
+  int calls = 0;
+  EXPECT_CALL(os_sys_calls, sendmmsg(_, _, _, _))
+      .WillRepeatedly([&os_sys_calls, &calls](os_fd_t sockfd, struct mmsghdr* msgvec,
+                                              unsigned int vlen, int flags) {
+        ++calls;
+        if (calls == 2) {
+          return Api::SysCallIntResult{-1, SOCKET_ERROR_PERM};
+        }
+        return os_sys_calls.Api::OsSysCallsImpl::sendmmsg(
+            sockfd, msgvec, calls == 1 ? std::min(vlen, 5U) : vlen, flags);
+      });
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  Network::Test::UdpSyncPeer server(GetParam());
+  UdpStatsdSink sink(tls_, server.localAddress(), false);
+
+  const size_t num_counters = UdpStatsdSink::MAX_DATAGRAMS_PER_WRITE * 2 + 3;
+  std::vector<std::unique_ptr<NiceMock<Stats::MockCounter>>> counters;
+  for (size_t i = 0; i < num_counters; ++i) {
+    counters.push_back(std::make_unique<NiceMock<Stats::MockCounter>>());
+    counters.back()->name_ = absl::StrCat("test_counter_", i);
+    counters.back()->used_ = true;
+    snapshot.counters_.push_back({i, *counters.back()});
+  }
+
+  sink.flush(snapshot);
+  for (size_t i = 0; i < num_counters; ++i) {
+    if (i == 5) {
+      continue;
+    }
+    Network::UdpRecvData data;
+    server.recv(data);
+    EXPECT_EQ(absl::StrCat("envoy.test_counter_", i, ":", i, "|c"), data.buffer_->toString());
+  }
+
+  tls_.shutdownThread();
+}
+
 class UdpStatsdSinkWithTagsTest : public testing::TestWithParam<Network::Address::IpVersion> {};
 INSTANTIATE_TEST_SUITE_P(IpVersions, UdpStatsdSinkWithTagsTest,
                          testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
@@ -214,10 +308,11 @@ TEST(UdpStatsdSinkTest, CheckMetricLargerThanBuffer) {
   counter.latch_ = 1;
   snapshot.counters_.push_back({1, counter});
 
-  // Expect the metric to skip the buffer
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr),
-              write("envoy.test_counter:1|c"));
+  // Expect the metric to be written in its own datagram.
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
   sink.flush(snapshot);
+  EXPECT_EQ(writer_ptr->buffer_writes.size(), 1);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.test_counter:1|c");
   counter.used_ = false;
 
   NiceMock<Stats::MockGauge> gauge;
@@ -226,10 +321,11 @@ TEST(UdpStatsdSinkTest, CheckMetricLargerThanBuffer) {
   gauge.used_ = true;
   snapshot.gauges_.push_back(gauge);
 
-  // Expect the metric to skip the buffer
-  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr),
-              write("envoy.test_gauge:1|g"));
+  // Expect the metric to be written in its own datagram.
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
   sink.flush(snapshot);
+  EXPECT_EQ(writer_ptr->buffer_writes.size(), 2);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(1), "envoy.test_gauge:1|g");
 
   tls_.shutdownThread();
 }
@@ -300,6 +396,47 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesExceedingBufferSize) {
   tls_.shutdownThread();
 }
 
+TEST(UdpStatsdSinkTest, CheckBufferedWritesAcrossBatches) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  // Each datagram fits two counters.
+  uint64_t buffer_size = 48;
+  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), buffer_size);
+
+  const size_t num_counters = UdpStatsdSink::MAX_DATAGRAMS_PER_WRITE * 2 + 1;
+  std::vector<std::unique_ptr<NiceMock<Stats::MockCounter>>> counters;
+  for (size_t i = 0; i < num_counters; ++i) {
+    counters.push_back(std::make_unique<NiceMock<Stats::MockCounter>>());
+    counters.back()->name_ = absl::StrFormat("counter_%03d", i);
+    counters.back()->used_ = true;
+    snapshot.counters_.push_back({1, *counters.back()});
+  }
+
+  // The datagrams are handed to the writer in a full batch, and the last datagram with a single
+  // counter in a second one.
+  EXPECT_CALL(*writer_ptr, writeDatagrams(_)).Times(2);
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), UdpStatsdSink::MAX_DATAGRAMS_PER_WRITE + 1);
+  for (size_t i = 0; i < UdpStatsdSink::MAX_DATAGRAMS_PER_WRITE; ++i) {
+    EXPECT_EQ(writer_ptr->buffer_writes.at(i),
+              absl::StrFormat("envoy.counter_%03d:1|c\nenvoy.counter_%03d:1|c", 2 * i, 2 * i + 1));
+  }
+  EXPECT_EQ(writer_ptr->buffer_writes.back(),
+            absl::StrFormat("envoy.counter_%03d:1|c", num_counters - 1));
+
+  // The buffers are reused by the next flush.
+  writer_ptr->buffer_writes.clear();
+  snapshot.counters_.resize(1);
+  EXPECT_CALL(*writer_ptr, writeDatagrams(_));
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 1);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.counter_000:1|c");
+
+  tls_.shutdownThread();
+}
+
 TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
@@ -1781,6 +1781,39 @@ TEST_F(ServerContextConfigImplTest, TlsCertificateNonEmpty) {
       EnvoyException, "Server TlsCertificates must have a certificate specified");
 }
 
+#ifndef WIN32
+TEST_F(ServerContextConfigImplTest, SessionStore) {
+  const std::string path = TestEnvironment::temporaryPath("context_session_store");
+  TestEnvironment::removePath(path);
+  const std::string yaml = fmt::format(R"EOF(
+  common_tls_context:
+    tls_certificates:
+    - certificate_chain:
+        filename: "{{{{ test_rundir }}}}/test/extensions/transport_sockets/tls/test_data/selfsigned_cert.pem"
+      private_key:
+        filename: "{{{{ test_rundir }}}}/test/extensions/transport_sockets/tls/test_data/selfsigned_key.pem"
+  session_store:
+    path: "{}"
+  )EOF",
+                                       path);
+  envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), tls_context);
+  ServerContextConfigImpl server_context_config(tls_context, factory_context_);
+  ASSERT_TRUE(server_context_config.sessionStore().has_value());
+  EXPECT_EQ(path, server_context_config.sessionStore()->path_);
+  EXPECT_EQ(16384, server_context_config.sessionStore()->max_sessions_);
+
+  Event::SimulatedTimeSystem time_system;
+  ContextManagerImpl manager(time_system);
+  Stats::IsolatedStoreImpl store;
+  Envoy::Ssl::ServerContextSharedPtr server_ctx(
+      manager.createSslServerContext(store, server_context_config, std::vector<std::string>{}));
+  EXPECT_TRUE(Api::createApiForTest()->fileSystem().fileExists(path));
+  server_ctx.reset();
+  TestEnvironment::removePath(path);
+}
+#endif
+
 // Cannot ignore certificate expiration without a trusted CA.
 TEST_F(ServerContextConfigImplTest, InvalidIgnoreCertsNoCA) {
   envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
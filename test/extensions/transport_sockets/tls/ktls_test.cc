@@ -0,0 +1,221 @@
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/extensions/transport_sockets/tls/ktls.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+#include "openssl/pem.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+namespace {
+
+class KernelTlsTest : public testing::Test {
+protected:
+  // Connects a client and a server over TCP on the loopback interface and runs the handshake.
+  void connect(uint16_t version, const char* tls12_cipher) {
+    auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+    const os_fd_t listener = os_sys_calls.socket(AF_INET, SOCK_STREAM, 0).return_value_;
+    ASSERT_NE(INVALID_SOCKET, listener);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t address_length = sizeof(address);
+    ASSERT_EQ(0, os_sys_calls.bind(listener, reinterpret_cast<sockaddr*>(&address),
+                                   sizeof(address))
+                     .return_value_);
+    ASSERT_EQ(0, os_sys_calls.listen(listener, 1).return_value_);
+    ASSERT_EQ(0, ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_length));
+    client_fd_ = os_sys_calls.socket(AF_INET, SOCK_STREAM, 0).return_value_;
+    ASSERT_EQ(0, os_sys_calls.connect(client_fd_, reinterpret_cast<sockaddr*>(&address),
+                                      sizeof(address))
+                     .return_value_);
+    server_fd_ = os_sys_calls.accept(listener, nullptr, nullptr).return_value_;
+    ASSERT_NE(INVALID_SOCKET, server_fd_);
+    os_sys_calls.close(listener);
+    ASSERT_EQ(0, os_sys_calls.setsocketblocking(client_fd_, false).return_value_);
+    ASSERT_EQ(0, os_sys_calls.setsocketblocking(server_fd_, false).return_value_);
+
+    client_ctx_.reset(SSL_CTX_new(TLS_method()));
+    server_ctx_.reset(SSL_CTX_new(TLS_method()));
+    for (SSL_CTX* ctx : {client_ctx_.get(), server_ctx_.get()}) {
+      ASSERT_TRUE(SSL_CTX_set_min_proto_version(ctx, version));
+      ASSERT_TRUE(SSL_CTX_set_max_proto_version(ctx, version));
+      if (tls12_cipher != nullptr) {
+        ASSERT_TRUE(SSL_CTX_set_strict_cipher_list(ctx, tls12_cipher));
+      }
+    }
+    const std::string cert = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/"
+        "selfsigned_ecdsa_p256_cert.pem"));
+    const std::string key = TestEnvironment::readFileToStringForTest(TestEnvironment::substitute(
+        "{{ test_rundir }}/test/extensions/transport_sockets/tls/test_data/"
+        "selfsigned_ecdsa_p256_key.pem"));
+    bssl::UniquePtr<BIO> cert_bio(BIO_new_mem_buf(cert.data(), cert.size()));
+    bssl::UniquePtr<X509> x509(PEM_read_bio_X509(cert_bio.get(), nullptr, nullptr, nullptr));
+    bssl::UniquePtr<BIO> key_bio(BIO_new_mem_buf(key.data(), key.size()));
+    bssl::UniquePtr<EVP_PKEY> pkey(
+        PEM_read_bio_PrivateKey(key_bio.get(), nullptr, nullptr, nullptr));
+    ASSERT_TRUE(SSL_CTX_use_certificate(server_ctx_.get(), x509.get()));
+    ASSERT_TRUE(SSL_CTX_use_PrivateKey(server_ctx_.get(), pkey.get()));
+
+    client_.reset(SSL_new(client_ctx_.get()));
+    server_.reset(SSL_new(server_ctx_.get()));
+    SSL_set_fd(client_.get(), client_fd_);
+    SSL_set_fd(server_.get(), server_fd_);
+    SSL_set_connect_state(client_.get());
+    SSL_set_accept_state(server_.get());
+
+    bool client_done = false;
+    bool server_done = false;
+    for (int i = 0; i < 1000 && !(client_done && server_done); ++i) {
+      client_done = client_done || SSL_do_handshake(client_.get()) == 1;
+      server_done = server_done || SSL_do_handshake(server_.get()) == 1;
+    }
+    ASSERT_TRUE(client_done && server_done);
+  }
+
+  ~KernelTlsTest() override {
+    client_.reset();
+    server_.reset();
+    auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+    if (SOCKET_VALID(client_fd_)) {
+      os_sys_calls.close(client_fd_);
+    }
+    if (SOCKET_VALID(server_fd_)) {
+      os_sys_calls.close(server_fd_);
+    }
+  }
+
+  void expectMatchingKeys() {
+    const absl::optional<KeyMaterial> client_keys = keyMaterial(client_.get());
+    const absl::optional<KeyMaterial> server_keys = keyMaterial(server_.get());
+    ASSERT_TRUE(client_keys.has_value());
+    ASSERT_TRUE(server_keys.has_value());
+    EXPECT_EQ(client_keys->version_, server_keys->version_);
+    EXPECT_EQ(client_keys->write_.key_, server_keys->read_.key_);
+    EXPECT_EQ(client_keys->write_.iv_, server_keys->read_.iv_);
+    EXPECT_EQ(client_keys->write_.sequence_, server_keys->read_.sequence_);
+    EXPECT_EQ(client_keys->read_.key_, server_keys->write_.key_);
+    EXPECT_EQ(client_keys->read_.iv_, server_keys->write_.iv_);
+    EXPECT_EQ(client_keys->read_.sequence_, server_keys->write_.sequence_);
+    EXPECT_NE(client_keys->write_.key_, client_keys->read_.key_);
+  }
+
+  // Reads from the client until the given number of bytes arrived or the connection is closed.
+  std::string clientRead(size_t length) {
+    std::string data;
+    char buffer[1024];
+    for (int i = 0; i < 1000 && data.size() < length; ++i) {
+      const int rc = SSL_read(client_.get(), buffer, sizeof(buffer));
+      if (rc > 0) {
+        data.append(buffer, rc);
+      } else if (SSL_get_error(client_.get(), rc) != SSL_ERROR_WANT_READ) {
+        break;
+      }
+    }
+    return data;
+  }
+
+  bssl::UniquePtr<SSL_CTX> client_ctx_;
+  bssl::UniquePtr<SSL_CTX> server_ctx_;
+  bssl::UniquePtr<SSL> client_;
+  bssl::UniquePtr<SSL> server_;
+  os_fd_t client_fd_{INVALID_SOCKET};
+  os_fd_t server_fd_{INVALID_SOCKET};
+};
+
+TEST_F(KernelTlsTest, Tls12Aes128GcmKeys) {
+  connect(TLS1_2_VERSION, "ECDHE-ECDSA-AES128-GCM-SHA256");
+  expectMatchingKeys();
+  EXPECT_EQ(16, keyMaterial(server_.get())->write_.key_.size());
+}
+
+TEST_F(KernelTlsTest, Tls12Aes256GcmKeys) {
+  connect(TLS1_2_VERSION, "ECDHE-ECDSA-AES256-GCM-SHA384");
+  expectMatchingKeys();
+  EXPECT_EQ(32, keyMaterial(server_.get())->write_.key_.size());
+}
+
+TEST_F(KernelTlsTest, Tls13Keys) {
+  connect(TLS1_3_VERSION, nullptr);
+  if (SSL_CIPHER_get_cipher_nid(SSL_get_current_cipher(server_.get())) ==
+      NID_chacha20_poly1305) {
+    // BoringSSL prefers ChaCha20-Poly1305 without AES hardware support.
+    EXPECT_FALSE(keyMaterial(server_.get()).has_value());
+    return;
+  }
+  expectMatchingKeys();
+}
+
+TEST_F(KernelTlsTest, Tls12ChachaUnsupported) {
+  connect(TLS1_2_VERSION, "ECDHE-ECDSA-CHACHA20-POLY1305");
+  EXPECT_FALSE(keyMaterial(server_.get()).has_value());
+  EXPECT_EQ(EnableResult::Unsupported, enable(server_fd_, server_.get()));
+}
+
+TEST_F(KernelTlsTest, BeforeHandshake) {
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()));
+  bssl::UniquePtr<SSL> ssl(SSL_new(ctx.get()));
+  EXPECT_FALSE(keyMaterial(ssl.get()).has_value());
+}
+
+#if defined(__linux__)
+// Exchanges data between a BoringSSL client and a server whose records are protected by the
+// kernel. Skipped when the kernel TLS module is not available.
+TEST_F(KernelTlsTest, Tls12Offload) {
+  connect(TLS1_2_VERSION, "ECDHE-ECDSA-AES128-GCM-SHA256");
+  const EnableResult result = enable(server_fd_, server_.get());
+  if (result == EnableResult::Unsupported) {
+    GTEST_SKIP() << "kernel TLS is not available";
+  }
+  ASSERT_EQ(EnableResult::Offloaded, result);
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+
+  const std::string response = "response from the server";
+  ASSERT_EQ(static_cast<ssize_t>(response.size()),
+            os_sys_calls.write(server_fd_, response.data(), response.size()).return_value_);
+  EXPECT_EQ(response, clientRead(response.size()));
+
+  const std::string request = "request from the client";
+  ASSERT_EQ(static_cast<int>(request.size()),
+            SSL_write(client_.get(), request.data(), request.size()));
+  char buffer[1024];
+  Api::SysCallSizeResult read_result{-1, 0};
+  for (int i = 0; i < 1000 && read_result.return_value_ < 0; ++i) {
+    read_result = os_sys_calls.recv(server_fd_, buffer, sizeof(buffer), 0);
+  }
+  ASSERT_EQ(static_cast<ssize_t>(request.size()), read_result.return_value_);
+  EXPECT_EQ(request, std::string(buffer, read_result.return_value_));
+
+  // A close_notify alert from the client fails a plain read, then shows up as an alert record.
+  SSL_shutdown(client_.get());
+  read_result = {-1, 0};
+  for (int i = 0; i < 1000 && read_result.return_value_ < 0 && read_result.errno_ != EIO; ++i) {
+    read_result = os_sys_calls.recv(server_fd_, buffer, sizeof(buffer), 0);
+  }
+  EXPECT_EQ(EIO, read_result.errno_);
+  ControlRecord record;
+  ASSERT_EQ(2, readRecord(server_fd_, record).return_value_);
+  EXPECT_EQ(RecordTypeAlert, record.type_);
+  EXPECT_EQ(SSL_AD_CLOSE_NOTIFY, record.data_[1]);
+
+  ASSERT_EQ(2, sendCloseNotify(server_fd_).return_value_);
+  EXPECT_EQ("", clientRead(1));
+  EXPECT_EQ(SSL_RECEIVED_SHUTDOWN, SSL_get_shutdown(client_.get()) & SSL_RECEIVED_SHUTDOWN);
+}
+#endif
+
+} // namespace
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
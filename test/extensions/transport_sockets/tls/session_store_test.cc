@@ -0,0 +1,273 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "source/extensions/transport_sockets/tls/session_store.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class SessionStoreTest : public testing::Test {
+protected:
+  SessionStoreTest() : path_(TestEnvironment::temporaryPath("tls_session_store_test")) {
+    TestEnvironment::removePath(path_);
+    time_system_.setSystemTime(std::chrono::seconds(1000));
+  }
+  ~SessionStoreTest() override { TestEnvironment::removePath(path_); }
+
+  static std::vector<uint8_t> bytes(absl::string_view value) {
+    return {value.begin(), value.end()};
+  }
+
+  // Expiry, in seconds since the epoch, of a session that lives for `lifetime` seconds from now.
+  uint64_t expiresIn(uint64_t lifetime) {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               time_system_.systemTime().time_since_epoch())
+               .count() +
+           lifetime;
+  }
+
+  void insert(SessionStore& store, absl::string_view id, absl::string_view session,
+              uint64_t lifetime = 300) {
+    EXPECT_EQ(SessionStore::InsertResult::Inserted,
+              store.insert(bytes(id), bytes(session), expiresIn(lifetime)));
+  }
+
+  std::string lookup(const SessionStore& store, absl::string_view id) {
+    std::vector<uint8_t> session;
+    if (!store.lookup(bytes(id), session)) {
+      return "";
+    }
+    return {session.begin(), session.end()};
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  const std::string path_;
+};
+
+TEST_F(SessionStoreTest, InsertAndLookup) {
+  SessionStore store(path_, 16, time_system_);
+  EXPECT_EQ(16, store.slotCount());
+  EXPECT_EQ("", lookup(store, "id1"));
+
+  insert(store, "id1", "session1");
+  insert(store, "id2", "session2");
+  EXPECT_EQ("session1", lookup(store, "id1"));
+  EXPECT_EQ("session2", lookup(store, "id2"));
+
+  // Inserting the same ID again replaces the session.
+  insert(store, "id1", "session1b");
+  EXPECT_EQ("session1b", lookup(store, "id1"));
+}
+
+TEST_F(SessionStoreTest, RoundsUpToWholeSets) {
+  SessionStore store(path_, 5, time_system_);
+  EXPECT_EQ(8, store.slotCount());
+}
+
+TEST_F(SessionStoreTest, ExpiredSessionsAreNotReturned) {
+  SessionStore store(path_, 16, time_system_);
+  insert(store, "id", "session", 10);
+  EXPECT_EQ("session", lookup(store, "id"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ("", lookup(store, "id"));
+}
+
+TEST_F(SessionStoreTest, FullSetReplacesSessionClosestToExpiry) {
+  // A single set holds every session.
+  SessionStore store(path_, SessionStore::Ways, time_system_);
+  insert(store, "a", "session_a", 400);
+  insert(store, "b", "session_b", 100);
+  insert(store, "c", "session_c", 300);
+  insert(store, "d", "session_d", 200);
+
+  insert(store, "e", "session_e", 500);
+  EXPECT_EQ("", lookup(store, "b"));
+  EXPECT_EQ("session_a", lookup(store, "a"));
+  EXPECT_EQ("session_c", lookup(store, "c"));
+  EXPECT_EQ("session_d", lookup(store, "d"));
+  EXPECT_EQ("session_e", lookup(store, "e"));
+
+  // Expired sessions are replaced before live ones.
+  time_system_.advanceTimeWait(std::chrono::seconds(350));
+  insert(store, "f", "session_f", 500);
+  EXPECT_EQ("session_a", lookup(store, "a"));
+  EXPECT_EQ("session_e", lookup(store, "e"));
+  EXPECT_EQ("session_f", lookup(store, "f"));
+}
+
+TEST_F(SessionStoreTest, RejectsOversizedEntries) {
+  SessionStore store(path_, 16, time_system_);
+  EXPECT_EQ(SessionStore::InsertResult::TooLarge,
+            store.insert(bytes(std::string(33, 'i')), bytes("session"), expiresIn(300)));
+  EXPECT_EQ(SessionStore::InsertResult::TooLarge,
+            store.insert(bytes("id"), bytes(std::string(SessionStore::maxSessionSize() + 1, 'x')),
+                         expiresIn(300)));
+  EXPECT_EQ(SessionStore::InsertResult::TooLarge,
+            store.insert(bytes(""), bytes("session"), expiresIn(300)));
+
+  const std::string largest(SessionStore::maxSessionSize(), 'x');
+  insert(store, std::string(32, 'i'), largest);
+  EXPECT_EQ(largest, lookup(store, std::string(32, 'i')));
+}
+
+// A second mapping of the same file, as held by another worker's context or by the next hot
+// restart generation, sees the same sessions.
+TEST_F(SessionStoreTest, ReopenSharesSessions) {
+  SessionStore first(path_, 16, time_system_);
+  insert(first, "id", "session");
+
+  SessionStore second(path_, 16, time_system_);
+  EXPECT_EQ("session", lookup(second, "id"));
+
+  insert(second, "id2", "session2");
+  EXPECT_EQ("session2", lookup(first, "id2"));
+}
+
+TEST_F(SessionStoreTest, DifferentSizeRecreatesStore) {
+  SessionStore first(path_, 16, time_system_);
+  insert(first, "id", "session");
+
+  SessionStore second(path_, 32, time_system_);
+  EXPECT_EQ("", lookup(second, "id"));
+}
+
+TEST_F(SessionStoreTest, CorruptHeaderRecreatesStore) {
+  {
+    SessionStore store(path_, 16, time_system_);
+    insert(store, "id", "session");
+  }
+  {
+    const int fd = ::open(path_.c_str(), O_WRONLY);
+    ASSERT_NE(-1, fd);
+    ASSERT_EQ(1, ::pwrite(fd, "X", 1, 0));
+    ::close(fd);
+  }
+  SessionStore store(path_, 16, time_system_);
+  EXPECT_EQ("", lookup(store, "id"));
+}
+
+TEST_F(SessionStoreTest, StaleSetLockIsTakenOver) {
+  SessionStore store(path_, SessionStore::Ways, time_system_);
+
+  // Simulate a writer that took the only set's lock and exited.
+  const size_t size = sizeof(SessionStoreHeader) + sizeof(SessionSet) +
+                      SessionStore::Ways * sizeof(SessionSlot);
+  const int fd = ::open(path_.c_str(), O_RDWR);
+  ASSERT_NE(-1, fd);
+  void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  ASSERT_NE(MAP_FAILED, mapping);
+  auto* set = reinterpret_cast<SessionSet*>(static_cast<uint8_t*>(mapping) +
+                                            sizeof(SessionStoreHeader));
+  set->locked_at_ = std::max<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           time_system_.monotonicTime().time_since_epoch())
+                                           .count(),
+                                       1);
+
+  EXPECT_EQ(SessionStore::InsertResult::Busy,
+            store.insert(bytes("id"), bytes("session"), expiresIn(300)));
+  // Lookups never wait for writers.
+  EXPECT_EQ("", lookup(store, "id"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  insert(store, "id", "session");
+  EXPECT_EQ("session", lookup(store, "id"));
+  EXPECT_EQ(0, set->locked_at_.load());
+
+  ::munmap(mapping, size);
+}
+
+// A writer whose lock was taken over while it was stalled leaves the slot sequence odd. The next
+// writer must still publish an even sequence, and must not be unlocked by the stalled writer.
+TEST_F(SessionStoreTest, OddSequenceAndTakenOverLock) {
+  SessionStore store(path_, SessionStore::Ways, time_system_);
+
+  const size_t size = sizeof(SessionStoreHeader) + sizeof(SessionSet) +
+                      SessionStore::Ways * sizeof(SessionSlot);
+  const int fd = ::open(path_.c_str(), O_RDWR);
+  ASSERT_NE(-1, fd);
+  void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  ASSERT_NE(MAP_FAILED, mapping);
+  auto* set = reinterpret_cast<SessionSet*>(static_cast<uint8_t*>(mapping) +
+                                            sizeof(SessionStoreHeader));
+  auto* slots = reinterpret_cast<SessionSlot*>(set + 1);
+  for (size_t i = 0; i < SessionStore::Ways; ++i) {
+    slots[i].sequence_ = 3;
+  }
+
+  insert(store, "id", "session");
+  EXPECT_EQ("session", lookup(store, "id"));
+  // The odd sequence of the rewritten slot is moved past rather than reused, then published as
+  // the next even value.
+  int published = 0;
+  for (size_t i = 0; i < SessionStore::Ways; ++i) {
+    published += slots[i].sequence_.load() == 6;
+  }
+  EXPECT_EQ(1, published);
+
+  // Another writer holding the lock is not unlocked by an insert that could not take it.
+  const uint64_t owner = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             time_system_.monotonicTime().time_since_epoch())
+                             .count() +
+                         1;
+  set->locked_at_ = owner;
+  EXPECT_EQ(SessionStore::InsertResult::Busy,
+            store.insert(bytes("id2"), bytes("session2"), expiresIn(300)));
+  EXPECT_EQ(owner, set->locked_at_.load());
+
+  ::munmap(mapping, size);
+}
+
+// A writer stalled past the stale lock timeout cannot publish once another writer has taken its
+// slot over, whether or not that writer has published yet, and the slot is then skipped by readers
+// until its next write.
+TEST_F(SessionStoreTest, StalledWriterCannotPublish) {
+  SessionSlot slot{};
+
+  // The stalled writer resumes after the new owner published.
+  const uint32_t stalled = SessionStore::beginSlotWrite(slot);
+  EXPECT_EQ(1, stalled);
+  const uint32_t owner = SessionStore::beginSlotWrite(slot);
+  EXPECT_EQ(3, owner);
+  EXPECT_TRUE(SessionStore::endSlotWrite(slot, owner));
+  EXPECT_EQ(4, slot.sequence_.load());
+  EXPECT_FALSE(SessionStore::endSlotWrite(slot, stalled));
+  EXPECT_EQ(5, slot.sequence_.load());
+
+  // The stalled writer resumes while the new owner is still writing: neither publishes.
+  const uint32_t stalled2 = SessionStore::beginSlotWrite(slot);
+  EXPECT_EQ(7, stalled2);
+  const uint32_t owner2 = SessionStore::beginSlotWrite(slot);
+  EXPECT_EQ(9, owner2);
+  EXPECT_FALSE(SessionStore::endSlotWrite(slot, stalled2));
+  EXPECT_EQ(11, slot.sequence_.load());
+  EXPECT_FALSE(SessionStore::endSlotWrite(slot, owner2));
+  EXPECT_EQ(13, slot.sequence_.load());
+
+  // The next write publishes again.
+  const uint32_t next = SessionStore::beginSlotWrite(slot);
+  EXPECT_EQ(15, next);
+  EXPECT_TRUE(SessionStore::endSlotWrite(slot, next));
+  EXPECT_EQ(16, slot.sequence_.load());
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
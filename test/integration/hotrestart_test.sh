@@ -140,7 +140,7 @@ function run_testsuite() {
   # string, compare it against a hard-coded string.
   start_test "Checking for consistency of /hot_restart_version"
   CLI_HOT_RESTART_VERSION=$("${ENVOY_BIN}" --hot-restart-version --base-id "${BASE_ID}" 2>&1)
-  EXPECTED_CLI_HOT_RESTART_VERSION="11.${SHARED_MEMORY_SIZE}"
+  EXPECTED_CLI_HOT_RESTART_VERSION="12.${SHARED_MEMORY_SIZE}"
   echo "The Envoy's hot restart version is ${CLI_HOT_RESTART_VERSION}"
   echo "Now checking that the above version is what we expected."
   check [ "${CLI_HOT_RESTART_VERSION}" = "${EXPECTED_CLI_HOT_RESTART_VERSION}" ]
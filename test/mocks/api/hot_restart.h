@@ -14,6 +14,7 @@ public:
   // Api::HotRestartOsSysCalls
   MOCK_METHOD(SysCallIntResult, shmOpen, (const char*, int, mode_t));
   MOCK_METHOD(SysCallIntResult, shmUnlink, (const char*));
+  MOCK_METHOD(SysCallIntResult, munmap, (void*, size_t));
 };
 
 } // namespace Api
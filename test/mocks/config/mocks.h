@@ -41,6 +41,8 @@ public:
   ~MockOpaqueResourceDecoder() override;
 
   MOCK_METHOD(ProtobufTypes::MessagePtr, decodeResource, (const ProtobufWkt::Any& resource));
+  MOCK_METHOD(PreparedResourcePtr, prepareResource, (const ProtobufWkt::Any& resource));
+  MOCK_METHOD(ProtobufTypes::MessagePtr, finishResource, (PreparedResourcePtr && prepared));
   MOCK_METHOD(std::string, resourceName, (const Protobuf::Message& resource));
 };
 
@@ -108,6 +110,7 @@ public:
   ~MockGrpcMux() override;
 
   MOCK_METHOD(void, start, (), (override));
+  MOCK_METHOD(void, onServerInitialized, (), (override));
   MOCK_METHOD(ScopedResume, pause, (const std::string& type_url), (override));
   MOCK_METHOD(ScopedResume, pause, (const std::vector<std::string> type_urls), (override));
 
@@ -163,6 +163,8 @@ public:
   Buffer::WatermarkFactory& getWatermarkFactory() override { return buffer_factory_; }
   MOCK_METHOD(Thread::ThreadId, getCurrentThreadId, ());
   MOCK_METHOD(MonotonicTime, approximateMonotonicTime, (), (const));
+  MOCK_METHOD(void, enableEventLoopTimes, ());
+  MOCK_METHOD(EventLoopTimes, eventLoopTimes, (), (const));
   MOCK_METHOD(void, updateApproximateMonotonicTime, ());
   MOCK_METHOD(void, shutdown, ());
 
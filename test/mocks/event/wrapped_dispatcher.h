@@ -118,6 +118,10 @@ public:
     return impl_.approximateMonotonicTime();
   }
 
+  void enableEventLoopTimes() override { impl_.enableEventLoopTimes(); }
+
+  EventLoopTimes eventLoopTimes() const override { return impl_.eventLoopTimes(); }
+
   void updateApproximateMonotonicTime() override { impl_.updateApproximateMonotonicTime(); }
 
   bool isThreadSafe() const override { return impl_.isThreadSafe(); }
@@ -35,6 +35,7 @@ public:
     sendMessageRaw_(request, end_stream);
   }
   MOCK_METHOD(void, sendMessageRaw_, (Buffer::InstancePtr & request, bool end_stream));
+  MOCK_METHOD(bool, sendCompressedMessageRaw, (Buffer::InstancePtr & request, bool end_stream));
   MOCK_METHOD(void, closeStream, ());
   MOCK_METHOD(void, resetStream, ());
   MOCK_METHOD(bool, isAboveWriteBufferHighWatermark, (), (const));
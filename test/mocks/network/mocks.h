@@ -491,6 +491,7 @@ public:
   MOCK_METHOD(void, disableListeners, ());
   MOCK_METHOD(void, enableListeners, ());
   MOCK_METHOD(void, setListenerRejectFraction, (UnitFloat), (override));
+  MOCK_METHOD(void, setConnectionBufferLimitScale, (UnitFloat), (override));
   MOCK_METHOD(const std::string&, statPrefix, (), (const));
 
   uint64_t num_handler_connections_{};
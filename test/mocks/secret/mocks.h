@@ -55,6 +55,7 @@ public:
   MOCK_METHOD(GenericSecretConfigProviderSharedPtr, findOrCreateGenericSecretProvider,
               (const envoy::config::core::v3::ConfigSource&, const std::string&,
                Server::Configuration::TransportSocketFactoryContext&));
+  MOCK_METHOD((absl::flat_hash_map<std::string, uint64_t>), secretsAllocatedBytes, ());
 };
 
 class MockSecretCallbacks : public SecretCallbacks {
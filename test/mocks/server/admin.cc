@@ -12,6 +12,7 @@ namespace Server {
 
 MockAdmin::MockAdmin() {
   ON_CALL(*this, getConfigTracker()).WillByDefault(ReturnRef(config_tracker_));
+  ON_CALL(*this, getConfigMemoryTracker()).WillByDefault(ReturnRef(config_memory_tracker_));
   ON_CALL(*this, concurrency()).WillByDefault(Return(1));
   ON_CALL(*this, socket()).WillByDefault(ReturnRef(socket_));
   ON_CALL(*this, addHandler(_, _, _, _, _)).WillByDefault(Return(true));
@@ -7,6 +7,7 @@
 #include "test/mocks/network/socket.h"
 
 #include "absl/strings/string_view.h"
+#include "config_memory_tracker.h"
 #include "config_tracker.h"
 #include "gmock/gmock.h"
 
@@ -30,6 +31,7 @@ public:
   MOCK_METHOD(bool, removeHandler, (const std::string& prefix));
   MOCK_METHOD(Network::Socket&, socket, ());
   MOCK_METHOD(ConfigTracker&, getConfigTracker, ());
+  MOCK_METHOD(ConfigMemoryTracker&, getConfigMemoryTracker, ());
   MOCK_METHOD(void, startHttpListener,
               (const std::list<AccessLog::InstanceSharedPtr>& access_logs,
                const std::string& address_out_path,
@@ -43,6 +45,7 @@ public:
   MOCK_METHOD(uint32_t, concurrency, (), (const));
 
   NiceMock<MockConfigTracker> config_tracker_;
+  NiceMock<MockConfigMemoryTracker> config_memory_tracker_;
   NiceMock<Network::MockSocket> socket_;
 };
 
@@ -0,0 +1,14 @@
+#include "config_memory_tracker.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+
+MockConfigMemoryTracker::MockConfigMemoryTracker() = default;
+
+MockConfigMemoryTracker::~MockConfigMemoryTracker() = default;
+
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "envoy/server/config_memory_tracker.h"
+
+#include "gmock/gmock.h"
+
+namespace Envoy {
+namespace Server {
+class MockConfigMemoryTracker : public ConfigMemoryTracker {
+public:
+  MockConfigMemoryTracker();
+  ~MockConfigMemoryTracker() override;
+
+  // Server::ConfigMemoryTracker
+  MOCK_METHOD(void, setBuildCost,
+              (ResourceType type, const std::string& name, uint64_t allocated_bytes,
+               std::chrono::microseconds build_time));
+  MOCK_METHOD(void, addBuildCost,
+              (ResourceType type, const std::string& name, uint64_t allocated_bytes,
+               std::chrono::microseconds build_time));
+  MOCK_METHOD(void, removeResource, (ResourceType type, const std::string& name));
+};
+} // namespace Server
+} // namespace Envoy
@@ -5,6 +5,7 @@
 #include "admin.h"
 #include "admin_stream.h"
 #include "bootstrap_extension_factory.h"
+#include "config_memory_tracker.h"
 #include "config_tracker.h"
 #include "drain_manager.h"
 #include "factory_context.h"
@@ -46,6 +46,8 @@ MockOptions::MockOptions(const std::string& config_path) : config_path_(config_p
   ON_CALL(*this, socketPath()).WillByDefault(ReturnRef(socket_path_));
   ON_CALL(*this, socketMode()).WillByDefault(ReturnPointee(&socket_mode_));
   ON_CALL(*this, statsTags()).WillByDefault(ReturnRef(stats_tags_));
+  ON_CALL(*this, configProfilePath()).WillByDefault(ReturnRef(config_profile_path_));
+  ON_CALL(*this, configProfileSnapshotDir()).WillByDefault(ReturnRef(config_profile_snapshot_dir_));
 }
 
 MockOptions::~MockOptions() = default;
@@ -53,6 +53,8 @@ public:
   MOCK_METHOD(const std::string&, socketPath, (), (const));
   MOCK_METHOD(mode_t, socketMode, (), (const));
   MOCK_METHOD((const Stats::TagVector&), statsTags, (), (const));
+  MOCK_METHOD(const std::string&, configProfilePath, (), (const));
+  MOCK_METHOD(const std::string&, configProfileSnapshotDir, (), (const));
 
   std::string config_path_;
   envoy::config::bootstrap::v3::Bootstrap config_proto_;
@@ -78,6 +80,8 @@ public:
   std::string socket_path_;
   mode_t socket_mode_;
   Stats::TagVector stats_tags_;
+  std::string config_profile_path_;
+  std::string config_profile_snapshot_dir_;
 };
 } // namespace Server
 } // namespace Envoy
@@ -25,7 +25,9 @@ MockClientContextConfig::MockClientContextConfig() {
 }
 MockClientContextConfig::~MockClientContextConfig() = default;
 
-MockServerContextConfig::MockServerContextConfig() = default;
+MockServerContextConfig::MockServerContextConfig() {
+  ON_CALL(*this, sessionStore()).WillByDefault(testing::ReturnRef(session_store_));
+}
 MockServerContextConfig::~MockServerContextConfig() = default;
 
 MockPrivateKeyMethodManager::MockPrivateKeyMethodManager() = default;
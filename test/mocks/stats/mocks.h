@@ -75,7 +75,9 @@ public:
   std::string tagExtractedName() const override {
     return tag_extracted_name_.empty() ? name() : tag_extracted_name_;
   }
-  StatName tagExtractedStatName() const override { return tag_extracted_stat_name_->statName(); }
+  StatName tagExtractedStatName() const override {
+    return tag_extracted_stat_name_ == nullptr ? statName() : tag_extracted_stat_name_->statName();
+  }
   void iterateTagStatNames(const Metric::TagStatNameIterFn& fn) const override {
     ASSERT((tag_names_and_values_.size() % 2) == 0);
     for (size_t i = 0; i < tag_names_and_values_.size(); i += 2) {
@@ -166,6 +168,7 @@ public:
   MOCK_METHOD(uint64_t, value, (), (const));
   MOCK_METHOD(absl::optional<bool>, cachedShouldImport, (), (const));
   MOCK_METHOD(ImportMode, importMode, (), (const));
+  MOCK_METHOD(bool, latchChanged, ());
 
   bool used_;
   uint64_t value_;
@@ -231,6 +234,7 @@ public:
   MOCK_METHOD(void, set, (absl::string_view value), (override));
   MOCK_METHOD(bool, used, (), (const, override));
   MOCK_METHOD(std::string, value, (), (const, override));
+  MOCK_METHOD(bool, latchChanged, (), (override));
 
   bool used_;
   std::string value_;
@@ -0,0 +1,103 @@
+#include "envoy/admin/v3/memory.pb.h"
+
+#include "source/server/admin/config_memory_tracker_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+using ResourceType = ConfigMemoryTracker::ResourceType;
+
+TEST(ConfigMemoryTrackerImplTest, SetAndRemove) {
+  ConfigMemoryTrackerImpl tracker;
+  tracker.setBuildCost(ResourceType::Listener, "listener_a", 100, std::chrono::microseconds(7));
+  tracker.setBuildCost(ResourceType::Cluster, "cluster_a", 10, std::chrono::microseconds(1));
+  tracker.setBuildCost(ResourceType::Cluster, "cluster_b", 30, std::chrono::microseconds(3));
+  tracker.setBuildCost(ResourceType::Cluster, "cluster_c", 30, std::chrono::microseconds(0));
+  tracker.setBuildCost(ResourceType::RouteConfiguration, "route_a", 5,
+                       std::chrono::microseconds(5));
+  // A new version of a resource replaces the previous one.
+  tracker.setBuildCost(ResourceType::Cluster, "cluster_a", 20, std::chrono::microseconds(2000002));
+  tracker.removeResource(ResourceType::RouteConfiguration, "route_a");
+  tracker.removeResource(ResourceType::RouteConfiguration, "unknown");
+
+  envoy::admin::v3::ConfigMemory config_memory;
+  tracker.dump(config_memory);
+  envoy::admin::v3::ConfigMemory expected;
+  TestUtility::loadFromYaml(R"EOF(
+listeners:
+- name: listener_a
+  allocated: 100
+  build_time: 0.000007s
+clusters:
+- name: cluster_b
+  allocated: 30
+  build_time: 0.000003s
+- name: cluster_c
+  allocated: 30
+- name: cluster_a
+  allocated: 20
+  build_time: 2.000002s
+)EOF",
+                            expected);
+  EXPECT_TRUE(TestUtility::protoEqual(expected, config_memory));
+}
+
+TEST(ConfigMemoryTrackerImplTest, AddBuildCost) {
+  ConfigMemoryTrackerImpl tracker;
+  tracker.addBuildCost(ResourceType::Regex, "a.*", 10, std::chrono::microseconds(1));
+  tracker.addBuildCost(ResourceType::Regex, "b.*", 15, std::chrono::microseconds(2));
+  // A resource built once more adds to its cost.
+  tracker.addBuildCost(ResourceType::Regex, "a.*", 10, std::chrono::microseconds(3));
+  tracker.addBuildCost(ResourceType::TlsContext, "server:example.com", 50,
+                       std::chrono::microseconds(4));
+
+  envoy::admin::v3::ConfigMemory config_memory;
+  tracker.dump(config_memory);
+  envoy::admin::v3::ConfigMemory expected;
+  TestUtility::loadFromYaml(R"EOF(
+regexes:
+- name: a.*
+  allocated: 20
+  build_time: 0.000004s
+- name: b.*
+  allocated: 15
+  build_time: 0.000002s
+tls_contexts:
+- name: server:example.com
+  allocated: 50
+  build_time: 0.000004s
+)EOF",
+                            expected);
+  EXPECT_TRUE(TestUtility::protoEqual(expected, config_memory));
+}
+
+TEST(ConfigMemoryTrackerImplTest, AddSortedAppends) {
+  envoy::admin::v3::ConfigMemory config_memory;
+  config_memory.add_secrets()->set_name("existing");
+  ConfigMemoryTrackerImpl::addSorted(
+      {{"small", {1, std::chrono::microseconds(1)}}, {"large", {2, std::chrono::microseconds(1)}}},
+      *config_memory.mutable_secrets());
+  ASSERT_EQ(3, config_memory.secrets_size());
+  EXPECT_EQ("existing", config_memory.secrets(0).name());
+  EXPECT_EQ("large", config_memory.secrets(1).name());
+  EXPECT_EQ("small", config_memory.secrets(2).name());
+}
+
+TEST(ConfigMemoryTrackerImplTest, AddSecrets) {
+  envoy::admin::v3::ConfigMemory config_memory;
+  ConfigMemoryTrackerImpl::addSecrets({{"small", 1}, {"large", 2}}, config_memory);
+  ASSERT_EQ(2, config_memory.secrets_size());
+  EXPECT_EQ("large", config_memory.secrets(0).name());
+  EXPECT_EQ(2, config_memory.secrets(0).allocated());
+  EXPECT_FALSE(config_memory.secrets(0).has_build_time());
+  EXPECT_EQ("small", config_memory.secrets(1).name());
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
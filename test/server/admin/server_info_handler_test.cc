@@ -62,6 +62,43 @@ TEST_P(AdminInstanceTest, Memory) {
                                   Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0))));
 }
 
+TEST_P(AdminInstanceTest, ConfigMemory) {
+  ConfigMemoryTracker& tracker = admin_.getConfigMemoryTracker();
+  tracker.setBuildCost(ConfigMemoryTracker::ResourceType::Cluster, "small_cluster", 10,
+                       std::chrono::microseconds(1));
+  tracker.setBuildCost(ConfigMemoryTracker::ResourceType::Cluster, "large_cluster", 20,
+                       std::chrono::microseconds(1));
+  tracker.setBuildCost(ConfigMemoryTracker::ResourceType::Listener, "listener", 30,
+                       std::chrono::microseconds(1000));
+  envoy::extensions::transport_sockets::tls::v3::Secret secret;
+  TestUtility::loadFromYaml(R"EOF(
+name: generic
+generic_secret:
+  secret:
+    inline_string: "secret"
+)EOF",
+                            secret);
+  server_.secretManager().addStaticSecret(secret);
+
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/memory/config", header_map, response));
+  EXPECT_EQ("application/json", header_map.getContentTypeValue());
+  envoy::admin::v3::ConfigMemory output_proto;
+  TestUtility::loadFromJson(response.toString(), output_proto);
+  ASSERT_EQ(1, output_proto.listeners_size());
+  EXPECT_EQ("listener", output_proto.listeners(0).name());
+  EXPECT_EQ(30, output_proto.listeners(0).allocated());
+  EXPECT_EQ(1, DurationUtil::durationToMilliseconds(output_proto.listeners(0).build_time()));
+  ASSERT_EQ(2, output_proto.clusters_size());
+  EXPECT_EQ("large_cluster", output_proto.clusters(0).name());
+  EXPECT_EQ("small_cluster", output_proto.clusters(1).name());
+  EXPECT_EQ(0, output_proto.route_configs_size());
+  ASSERT_EQ(1, output_proto.secrets_size());
+  EXPECT_EQ("generic", output_proto.secrets(0).name());
+  EXPECT_GT(output_proto.secrets(0).allocated(), 0);
+}
+
 TEST_P(AdminInstanceTest, GetReadyRequest) {
   NiceMock<Init::MockManager> initManager;
   ON_CALL(server_, initManager()).WillByDefault(ReturnRef(initManager));
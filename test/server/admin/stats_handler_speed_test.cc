@@ -1,14 +1,21 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from a
 // quiescent system with disabled cstate power management.
 
+#include "envoy/compression/compressor/config.h"
+#include "envoy/registry/registry.h"
+
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/memory/stats.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
+#include "test/mocks/server/instance.h"
 #include "test/test_common/test_runtime.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -34,32 +41,92 @@ public:
   }
 
   /**
-   * Issues an admin request against the stats saved in store_.
+   * Issues an admin request against the stats saved in store_, draining each
+   * chunk as a client would. Records the peak growth of allocated memory
+   * during the request in peak_allocated_, when tcmalloc is available.
    */
   uint64_t handlerStats(const StatsParams& params) {
-    Buffer::OwnedImpl data;
-    if (params.format_ == Envoy::Server::StatsFormat::Prometheus) {
-      Envoy::Server::StatsHandler::prometheusRender(store_, custom_namespaces_, params, data);
-      return data.length();
+    return render(params.format_ == Envoy::Server::StatsFormat::Prometheus
+                      ? StatsHandler::makePrometheusRequest(store_, custom_namespaces_, params)
+                      : StatsHandler::makeRequest(store_, params));
+  }
+
+  /**
+   * Issues a Prometheus scrape against the stats saved in store_, in the given
+   * exposition format and compressed with the given content coding, if any,
+   * using the default configuration of its compressor extension.
+   */
+  uint64_t prometheusScrape(const StatsParams& params, PrometheusFormat format,
+                            absl::string_view content_encoding) {
+    Compression::Compressor::CompressorPtr compressor;
+    if (!content_encoding.empty()) {
+      Compression::Compressor::CompressorFactoryPtr& compressor_factory =
+          compressor_factories_[content_encoding];
+      if (compressor_factory == nullptr) {
+        auto* config_factory = Registry::FactoryRegistry<
+            Compression::Compressor::NamedCompressorLibraryConfigFactory>::
+            getFactory(absl::StrCat("envoy.compression.", content_encoding, ".compressor"));
+        RELEASE_ASSERT(config_factory != nullptr, "unknown content encoding");
+        compressor_factory = config_factory->createCompressorFactoryFromProto(
+            *config_factory->createEmptyConfigProto(), factory_context_);
+      }
+      compressor = compressor_factory->createCompressor();
     }
-    Admin::RequestPtr request = StatsHandler::makeRequest(store_, params);
+    return render(StatsHandler::makePrometheusRequest(store_, custom_namespaces_, params, format,
+                                                      std::move(compressor), content_encoding));
+  }
+
+  uint64_t render(Admin::RequestPtr request) {
+    Buffer::OwnedImpl data;
+    const uint64_t allocated_before = Memory::Stats::totalCurrentlyAllocated();
+    peak_allocated_ = 0;
     auto response_headers = Http::ResponseHeaderMapImpl::create();
     request->start(*response_headers);
     uint64_t count = 0;
     bool more = true;
     do {
       more = request->nextChunk(data);
+      recordAllocated(allocated_before);
       count += data.length();
       data.drain(data.length());
     } while (more);
     return count;
   }
 
+  /**
+   * Renders the stats saved in store_ in Prometheus format all at once, as
+   * /stats/prometheus used to, for comparison with the streaming request.
+   */
+  uint64_t prometheusBuffered(const StatsParams& params) {
+    const uint64_t allocated_before = Memory::Stats::totalCurrentlyAllocated();
+    peak_allocated_ = 0;
+    Buffer::OwnedImpl data;
+    PrometheusStatsFormatter::statsAsPrometheus(
+        store_.counters(), store_.gauges(), store_.histograms(),
+        params.prometheus_text_readouts_ ? store_.textReadouts()
+                                         : std::vector<Stats::TextReadoutSharedPtr>(),
+        data, params, custom_namespaces_);
+    recordAllocated(allocated_before);
+    return data.length();
+  }
+
+  void recordAllocated(uint64_t allocated_before) {
+    const uint64_t allocated = Memory::Stats::totalCurrentlyAllocated();
+    if (allocated > allocated_before) {
+      peak_allocated_ = std::max(peak_allocated_, allocated - allocated_before);
+    }
+  }
+
   Stats::SymbolTableImpl symbol_table_;
   Stats::AllocatorImpl alloc_;
   Stats::ThreadLocalStoreImpl store_;
   std::vector<Stats::ScopeSharedPtr> scopes_;
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
+  uint64_t peak_allocated_{0};
+  testing::NiceMock<Configuration::MockServerFactoryContext> factory_context_;
+  // Compressors may refer to the state of their factory.
+  absl::flat_hash_map<std::string, Compression::Compressor::CompressorFactoryPtr>
+      compressor_factories_;
 };
 
 } // namespace Server
@@ -207,9 +274,26 @@ static void BM_AllCountersPrometheus(benchmark::State& state) {
     uint64_t count = test_context.handlerStats(params);
     RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M"); // actual = 261,578,000
   }
+  state.counters["peak_allocated_mb"] = test_context.peak_allocated_ / (1000.0 * 1000.0);
 }
 BENCHMARK(BM_AllCountersPrometheus)->Unit(benchmark::kMillisecond);
 
+// Renders the same output as BM_AllCountersPrometheus, buffering all of it.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusBuffered(benchmark::State& state) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext();
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus", response);
+
+  for (auto _ : state) { // NOLINT
+    uint64_t count = test_context.prometheusBuffered(params);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M");
+  }
+  state.counters["peak_allocated_mb"] = test_context.peak_allocated_ / (1000.0 * 1000.0);
+}
+BENCHMARK(BM_AllCountersPrometheusBuffered)->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_UsedCountersPrometheus(benchmark::State& state) {
   Envoy::Server::StatsHandlerTest& test_context = testContext();
@@ -254,3 +338,44 @@ static void BM_Re2FilteredCountersPrometheus(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_Re2FilteredCountersPrometheus)->Unit(benchmark::kMillisecond);
+
+// Renders the same stats as BM_AllCountersPrometheus in the given exposition
+// format and content coding, reporting the size of the response body.
+static void prometheusScrape(benchmark::State& state, Envoy::Server::PrometheusFormat format,
+                             absl::string_view content_encoding) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext();
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus", response);
+
+  uint64_t count = 0;
+  for (auto _ : state) { // NOLINT
+    count = test_context.prometheusScrape(params, format, content_encoding);
+    RELEASE_ASSERT(count > 0, "expected count > 0");
+  }
+  state.counters["payload_mb"] = count / (1000.0 * 1000.0);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusGzip(benchmark::State& state) {
+  prometheusScrape(state, Envoy::Server::PrometheusFormat::Text, "gzip");
+}
+BENCHMARK(BM_AllCountersPrometheusGzip)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusZstd(benchmark::State& state) {
+  prometheusScrape(state, Envoy::Server::PrometheusFormat::Text, "zstd");
+}
+BENCHMARK(BM_AllCountersPrometheusZstd)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusProtobuf(benchmark::State& state) {
+  prometheusScrape(state, Envoy::Server::PrometheusFormat::Protobuf, "");
+}
+BENCHMARK(BM_AllCountersPrometheusProtobuf)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusProtobufZstd(benchmark::State& state) {
+  prometheusScrape(state, Envoy::Server::PrometheusFormat::Protobuf, "zstd");
+}
+BENCHMARK(BM_AllCountersPrometheusProtobufZstd)->Unit(benchmark::kMillisecond);
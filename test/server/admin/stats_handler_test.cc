@@ -1,13 +1,18 @@
 #include <regex>
 #include <string>
 
+#include "envoy/compression/decompressor/config.h"
+#include "envoy/registry/registry.h"
+
 #include "source/common/common/regex.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 #include "source/server/admin/stats_request.h"
 
 #include "test/mocks/server/admin_stream.h"
+#include "test/mocks/server/factory_context.h"
 #include "test/mocks/server/instance.h"
 #include "test/server/admin/admin_instance.h"
 #include "test/test_common/logging.h"
@@ -15,6 +20,7 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+using testing::_;
 using testing::Combine;
 using testing::EndsWith;
 using testing::HasSubstr;
@@ -35,6 +41,7 @@ public:
     store_ = std::make_unique<Stats::ThreadLocalStoreImpl>(alloc_);
     store_->addSink(sink_);
     store_->initializeThreading(main_thread_dispatcher_, tls_);
+    ON_CALL(admin_stream_, getRequestHeaders()).WillByDefault(ReturnRef(request_headers_));
   }
 
   ~StatsHandlerTest() {
@@ -89,8 +96,7 @@ public:
     EXPECT_CALL(api_, customStatNamespaces()).WillRepeatedly(ReturnRef(custom_namespaces_));
     StatsHandler handler(instance);
     Admin::RequestPtr request = handler.makeRequest(url, admin_stream_);
-    Http::TestResponseHeaderMapImpl response_headers;
-    Http::Code code = request->start(response_headers);
+    Http::Code code = request->start(response_headers_);
     Buffer::OwnedImpl data;
     while (request->nextChunk(data)) {
     }
@@ -131,7 +137,9 @@ public:
   Stats::MockSink sink_;
   Stats::ThreadLocalStoreImplPtr store_;
   Stats::CustomStatNamespacesImpl custom_namespaces_;
-  MockAdminStream admin_stream_;
+  NiceMock<MockAdminStream> admin_stream_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+  Http::TestResponseHeaderMapImpl response_headers_;
   Configuration::MockStatsConfig stats_config_;
   TestScopedRuntime scoped_runtime_;
 };
@@ -1304,6 +1312,210 @@ envoy_cluster_upstream_cx_active{cluster="c2"} 12
   EXPECT_EQ(expected_response, code_response.second);
 }
 
+TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusChunked) {
+  createTestStats();
+  Stats::Counter& c3 = store_->counterFromStatNameWithTags(
+      makeStat("cluster.upstream.cx.total"), {{makeStat("cluster"), makeStat("c3")}});
+  c3.add(30);
+
+  // Scopes with the same name share their stats, which must only be rendered once.
+  Stats::ScopeSharedPtr scope1 = store_->createScope("shared");
+  Stats::ScopeSharedPtr scope2 = store_->createScope("shared");
+  scope1->counterFromString("requests").add(5);
+  EXPECT_EQ(5, scope2->counterFromString("requests").value());
+
+  StatsParams params;
+  Buffer::OwnedImpl response;
+  ASSERT_EQ(Http::Code::OK, params.parse("/stats?format=prometheus", response));
+  PrometheusStatsRequest request(*store_, params, custom_namespaces_);
+  // Every group of stats lands in its own chunk.
+  request.setChunkSize(1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+  std::vector<std::string> chunks;
+  bool more = true;
+  while (more) {
+    more = request.nextChunk(response);
+    chunks.push_back(response.toString());
+    response.drain(response.length());
+  }
+
+  const std::vector<std::string> expected_chunks = {
+      R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{cluster="c1"} 10
+envoy_cluster_upstream_cx_total{cluster="c2"} 20
+envoy_cluster_upstream_cx_total{cluster="c3"} 30
+
+)EOF",
+      R"EOF(# TYPE envoy_shared_requests counter
+envoy_shared_requests{} 5
+
+)EOF",
+      R"EOF(# TYPE envoy_cluster_upstream_cx_active gauge
+envoy_cluster_upstream_cx_active{cluster="c1"} 11
+envoy_cluster_upstream_cx_active{cluster="c2"} 12
+
+)EOF",
+      ""};
+  EXPECT_EQ(expected_chunks, chunks);
+}
+
+// Parses a body in the delimited protobuf exposition format.
+std::vector<io::prometheus::client::MetricFamily> parseMetricFamilies(absl::string_view data) {
+  std::vector<io::prometheus::client::MetricFamily> families;
+  Protobuf::io::ArrayInputStream stream(data.data(), data.size());
+  Protobuf::io::CodedInputStream input(&stream);
+  uint32_t length;
+  while (input.ReadVarint32(&length)) {
+    const Protobuf::io::CodedInputStream::Limit limit = input.PushLimit(length);
+    families.emplace_back();
+    EXPECT_TRUE(families.back().ParseFromCodedStream(&input));
+    EXPECT_TRUE(input.ConsumedEntireMessage());
+    input.PopLimit(limit);
+  }
+  return families;
+}
+
+TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusProtobuf) {
+  createTestStats();
+  request_headers_.addCopy(
+      Http::CustomHeaders::get().Accept,
+      "application/vnd.google.protobuf;proto=io.prometheus.client.MetricFamily;"
+      "encoding=delimited;q=0.7,text/plain;version=0.0.4;q=0.3");
+
+  const CodeResponse code_response = handlerStats("/stats?format=prometheus");
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+  EXPECT_EQ("application/vnd.google.protobuf; proto=io.prometheus.client.MetricFamily; "
+            "encoding=delimited",
+            response_headers_.getContentTypeValue());
+
+  const std::vector<io::prometheus::client::MetricFamily> families =
+      parseMetricFamilies(code_response.second);
+  ASSERT_EQ(3, families.size());
+  EXPECT_EQ("envoy_cluster_upstream_cx_total", families[0].name());
+  EXPECT_EQ(io::prometheus::client::COUNTER, families[0].type());
+  ASSERT_EQ(2, families[0].metric_size());
+  ASSERT_EQ(1, families[0].metric(0).label_size());
+  EXPECT_EQ("cluster", families[0].metric(0).label(0).name());
+  EXPECT_EQ("c1", families[0].metric(0).label(0).value());
+  EXPECT_EQ(10, families[0].metric(0).counter().value());
+  EXPECT_EQ("c2", families[0].metric(1).label(0).value());
+  EXPECT_EQ(20, families[0].metric(1).counter().value());
+
+  EXPECT_EQ("envoy_cluster_upstream_cx_active", families[1].name());
+  EXPECT_EQ(io::prometheus::client::GAUGE, families[1].type());
+  ASSERT_EQ(2, families[1].metric_size());
+  EXPECT_EQ(11, families[1].metric(0).gauge().value());
+  EXPECT_EQ(12, families[1].metric(1).gauge().value());
+
+  EXPECT_EQ("envoy_control_plane_identifier", families[2].name());
+  EXPECT_EQ(io::prometheus::client::GAUGE, families[2].type());
+  ASSERT_EQ(1, families[2].metric_size());
+  ASSERT_EQ(2, families[2].metric(0).label_size());
+  EXPECT_EQ("text_value", families[2].metric(0).label(1).name());
+  EXPECT_EQ("cp-1", families[2].metric(0).label(1).value());
+  EXPECT_EQ(0, families[2].metric(0).gauge().value());
+}
+
+TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusProtobufHistogram) {
+  setHistogramBucketSettings("cluster", {10, 20});
+  Stats::Histogram& histogram = store_->histogramFromStatNameWithTags(
+      makeStat("cluster.upstream.rq.time"), {{makeStat("cluster"), makeStat("c1")}},
+      Stats::Histogram::Unit::Milliseconds);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(histogram), _)).Times(3);
+  histogram.recordValue(5);
+  histogram.recordValue(15);
+  histogram.recordValue(25);
+  store_->mergeHistograms([]() -> void {});
+
+  request_headers_.addCopy(Http::CustomHeaders::get().Accept,
+                           "application/vnd.google.protobuf; "
+                           "proto=io.prometheus.client.MetricFamily; encoding=delimited");
+  const CodeResponse code_response = handlerStats("/stats?format=prometheus");
+  const std::vector<io::prometheus::client::MetricFamily> families =
+      parseMetricFamilies(code_response.second);
+  ASSERT_EQ(1, families.size());
+  EXPECT_EQ("envoy_cluster_upstream_rq_time", families[0].name());
+  EXPECT_EQ(io::prometheus::client::HISTOGRAM, families[0].type());
+  ASSERT_EQ(1, families[0].metric_size());
+  const io::prometheus::client::Histogram& output = families[0].metric(0).histogram();
+  EXPECT_EQ(3, output.sample_count());
+  ASSERT_EQ(2, output.bucket_size());
+  EXPECT_EQ(10, output.bucket(0).upper_bound());
+  EXPECT_EQ(1, output.bucket(0).cumulative_count());
+  EXPECT_EQ(20, output.bucket(1).upper_bound());
+  EXPECT_EQ(2, output.bucket(1).cumulative_count());
+}
+
+TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusTextUnlessProtobufAccepted) {
+  createTestStats();
+  // Only the delimited encoding of MetricFamily messages is supported.
+  request_headers_.addCopy(Http::CustomHeaders::get().Accept,
+                           "application/vnd.google.protobuf;"
+                           "proto=io.prometheus.client.MetricFamily;encoding=text");
+  const CodeResponse code_response = handlerStats("/stats?format=prometheus");
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+  EXPECT_EQ(nullptr, response_headers_.ContentType());
+  EXPECT_THAT(code_response.second, StartsWith("# TYPE envoy_cluster_upstream_cx_total counter\n"));
+}
+
+TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusGzip) {
+  createTestStats();
+  request_headers_.addCopy(Http::CustomHeaders::get().AcceptEncoding, "br, gzip;q=0.8");
+  const CodeResponse code_response = handlerStats("/stats?format=prometheus");
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+  EXPECT_EQ("gzip", response_headers_.get_(Http::CustomHeaders::get().ContentEncoding));
+  EXPECT_EQ("Accept-Encoding", response_headers_.get_(Http::CustomHeaders::get().Vary));
+
+  Buffer::OwnedImpl compressed(code_response.second);
+  auto* decompressor_config_factory = Registry::FactoryRegistry<
+      Compression::Decompressor::NamedDecompressorLibraryConfigFactory>::
+      getFactory("envoy.compression.gzip.decompressor");
+  ASSERT_NE(nullptr, decompressor_config_factory);
+  NiceMock<Configuration::MockFactoryContext> factory_context;
+  Compression::Decompressor::DecompressorFactoryPtr decompressor_factory =
+      decompressor_config_factory->createDecompressorFactoryFromProto(
+          *decompressor_config_factory->createEmptyConfigProto(), factory_context);
+  Buffer::OwnedImpl decompressed;
+  decompressor_factory->createDecompressor("test.")->decompress(compressed, decompressed);
+  EXPECT_EQ(R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{cluster="c1"} 10
+envoy_cluster_upstream_cx_total{cluster="c2"} 20
+
+# TYPE envoy_cluster_upstream_cx_active gauge
+envoy_cluster_upstream_cx_active{cluster="c1"} 11
+envoy_cluster_upstream_cx_active{cluster="c2"} 12
+
+# TYPE envoy_control_plane_identifier gauge
+envoy_control_plane_identifier{cluster="c1",text_value="cp-1"} 0
+
+)EOF",
+            decompressed.toString());
+}
+
+TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusNoAcceptedEncoding) {
+  createTestStats();
+  request_headers_.addCopy(Http::CustomHeaders::get().AcceptEncoding, "gzip;q=0, br");
+  const CodeResponse code_response = handlerStats("/stats?format=prometheus");
+  EXPECT_FALSE(response_headers_.has(Http::CustomHeaders::get().ContentEncoding));
+  EXPECT_THAT(code_response.second, StartsWith("# TYPE envoy_cluster_upstream_cx_total counter\n"));
+}
+
+TEST(StatsHandlerAcceptsEncodingTest, AcceptsEncoding) {
+  auto accepts = [](absl::string_view accept_encoding, absl::string_view encoding) {
+    Http::TestRequestHeaderMapImpl headers{{"accept-encoding", std::string(accept_encoding)}};
+    return StatsHandler::acceptsEncoding(headers, encoding);
+  };
+  EXPECT_TRUE(accepts("gzip", "gzip"));
+  EXPECT_TRUE(accepts("deflate, GZIP", "gzip"));
+  EXPECT_TRUE(accepts("zstd;q=0.5, gzip;q=1.0", "zstd"));
+  EXPECT_FALSE(accepts("zstd;q=0", "zstd"));
+  EXPECT_FALSE(accepts("zstd; q=0.000", "zstd"));
+  EXPECT_FALSE(accepts("gzip", "zstd"));
+  EXPECT_FALSE(accepts("", "gzip"));
+  EXPECT_FALSE(StatsHandler::acceptsEncoding(Http::TestRequestHeaderMapImpl{}, "gzip"));
+}
+
 TEST_P(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusInvalidRegex) {
   const std::string url = "/stats?format=prometheus&filter=(+invalid)";
 
@@ -54,7 +54,7 @@ TEST(ValidationClusterManagerTest, MockedMethods) {
   ValidationClusterManagerFactory factory(
       admin, runtime, stats_store, tls, dns_resolver, ssl_context_manager, dispatcher, local_info,
       secret_manager, validation_context, *api, http_context, grpc_context, router_context,
-      log_manager, singleton_manager, options, quic_stat_names, server);
+      log_manager, singleton_manager, options, quic_stat_names, server, nullptr);
 
   const envoy::config::bootstrap::v3::Bootstrap bootstrap;
   ClusterManagerPtr cluster_manager = factory.clusterManagerFromProto(bootstrap);
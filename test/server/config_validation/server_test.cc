@@ -1,6 +1,7 @@
 #include <memory>
 #include <vector>
 
+#include "envoy/admin/v3/memory.pb.h"
 #include "envoy/server/filter_config.h"
 
 #include "source/server/config_validation/server.h"
@@ -13,6 +14,8 @@
 #include "test/test_common/registry.h"
 #include "test/test_common/test_time.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Server {
 namespace {
@@ -89,6 +92,35 @@ TEST_P(ValidationServerTest, Validate) {
                              Filesystem::fileSystemForTest()));
 }
 
+TEST_P(ValidationServerTest, ConfigProfile) {
+  options_.config_profile_path_ = TestEnvironment::temporaryPath("config_profile.json");
+  EXPECT_TRUE(validateConfig(options_, Network::Address::InstanceConstSharedPtr(),
+                             component_factory_, Thread::threadFactoryForTest(),
+                             Filesystem::fileSystemForTest()));
+
+  envoy::admin::v3::ConfigMemory profile;
+  TestUtility::loadFromJson(
+      TestEnvironment::readFileToStringForTest(options_.config_profile_path_), profile);
+  EXPECT_GT(profile.listeners_size(), 0);
+  EXPECT_GT(profile.clusters_size(), 0);
+  for (const auto& cluster : profile.clusters()) {
+    EXPECT_FALSE(cluster.name().empty());
+  }
+}
+
+TEST_P(ValidationServerTest, ConfigProfileWriteFailure) {
+  options_.config_profile_path_ = "/nonexistent/directory/config_profile.json";
+  testing::internal::CaptureStdout();
+  testing::internal::CaptureStderr();
+  EXPECT_FALSE(validateConfig(options_, Network::Address::InstanceConstSharedPtr(),
+                              component_factory_, Thread::threadFactoryForTest(),
+                              Filesystem::fileSystemForTest()));
+  EXPECT_THAT(testing::internal::GetCapturedStderr(),
+              testing::HasSubstr("cannot open config profile output file "
+                                 "/nonexistent/directory/config_profile.json"));
+  EXPECT_THAT(testing::internal::GetCapturedStdout(), testing::Not(testing::HasSubstr("OK")));
+}
+
 TEST_P(ValidationServerTest, NoopLifecycleNotifier) {
   Thread::MutexBasicLockable access_log_lock;
   Stats::IsolatedStoreImpl stats_store;
@@ -195,6 +227,196 @@ INSTANTIATE_TEST_SUITE_P(
     AllConfigs, RuntimeFeatureValidationServerTest,
     ::testing::ValuesIn(RuntimeFeatureValidationServerTest::getAllConfigFiles()));
 
+// Validates a configuration whose listeners, clusters and routes are all served by a management
+// server, from a snapshot of that server.
+class ValidationServerSnapshotTest : public testing::Test {
+protected:
+  ValidationServerSnapshotTest()
+      : snapshot_dir_(TestEnvironment::temporaryPath(
+            absl::StrCat("xds_snapshot_",
+                         testing::UnitTest::GetInstance()->current_test_info()->name()))) {
+    TestEnvironment::createPath(snapshot_dir_);
+    options_.config_path_ = TestEnvironment::writeStringToFileForTest(
+        absl::StrCat(testing::UnitTest::GetInstance()->current_test_info()->name(),
+                     "_bootstrap.yaml"),
+        R"EOF(
+node:
+  id: node
+  cluster: node_cluster
+static_resources:
+  clusters:
+  - name: xds
+    type: STATIC
+    load_assignment:
+      cluster_name: xds
+      endpoints:
+      - lb_endpoints:
+        - endpoint:
+            address:
+              socket_address: { address: 127.0.0.1, port_value: 18000 }
+dynamic_resources:
+  lds_config:
+    resource_api_version: V3
+    api_config_source:
+      api_type: GRPC
+      transport_api_version: V3
+      grpc_services:
+      - envoy_grpc: { cluster_name: xds }
+  cds_config:
+    resource_api_version: V3
+    api_config_source:
+      api_type: GRPC
+      transport_api_version: V3
+      grpc_services:
+      - envoy_grpc: { cluster_name: xds }
+)EOF");
+    options_.config_profile_snapshot_dir_ = snapshot_dir_;
+  }
+
+  void writeSnapshotFile(const std::string& name, const std::string& yaml) {
+    TestEnvironment::writeStringToFileForTest(absl::StrCat(snapshot_dir_, "/", name), yaml, true);
+  }
+
+  void writeSnapshot() {
+    writeSnapshotFile("cds.yaml", R"EOF(
+version_info: "1"
+type_url: type.googleapis.com/envoy.config.cluster.v3.Cluster
+resources:
+- "@type": type.googleapis.com/envoy.config.cluster.v3.Cluster
+  name: backend
+  type: EDS
+  eds_cluster_config:
+    eds_config:
+      resource_api_version: V3
+      api_config_source:
+        api_type: GRPC
+        transport_api_version: V3
+        grpc_services:
+        - envoy_grpc: { cluster_name: xds }
+  transport_socket:
+    name: envoy.transport_sockets.tls
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.transport_sockets.tls.v3.UpstreamTlsContext
+      sni: backend.example.com
+)EOF");
+    writeSnapshotFile("eds.yaml", R"EOF(
+version_info: "1"
+type_url: type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment
+resources:
+- "@type": type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment
+  cluster_name: backend
+  endpoints:
+  - lb_endpoints:
+    - endpoint:
+        address:
+          socket_address: { address: 127.0.0.1, port_value: 8080 }
+)EOF");
+    writeSnapshotFile("lds.yaml", R"EOF(
+version_info: "1"
+type_url: type.googleapis.com/envoy.config.listener.v3.Listener
+resources:
+- "@type": type.googleapis.com/envoy.config.listener.v3.Listener
+  name: listener_0
+  address:
+    socket_address: { address: 127.0.0.1, port_value: 10000 }
+  filter_chains:
+  - filters:
+    - name: envoy.filters.network.http_connection_manager
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.filters.network.http_connection_manager.v3.HttpConnectionManager
+        stat_prefix: ingress_http
+        rds:
+          route_config_name: routes
+          config_source:
+            resource_api_version: V3
+            api_config_source:
+              api_type: GRPC
+              transport_api_version: V3
+              grpc_services:
+              - envoy_grpc: { cluster_name: xds }
+        http_filters:
+        - name: envoy.filters.http.router
+          typed_config:
+            "@type": type.googleapis.com/envoy.extensions.filters.http.router.v3.Router
+)EOF");
+    writeSnapshotFile("rds.yaml", R"EOF(
+version_info: "1"
+type_url: type.googleapis.com/envoy.config.route.v3.RouteConfiguration
+resources:
+- "@type": type.googleapis.com/envoy.config.route.v3.RouteConfiguration
+  name: routes
+  virtual_hosts:
+  - name: backend
+    domains: ["*"]
+    routes:
+    - match:
+        safe_regex:
+          google_re2: {}
+          regex: "/api/.*"
+      route: { cluster: backend }
+)EOF");
+  }
+
+  bool validate() {
+    return validateConfig(options_, Network::Address::InstanceConstSharedPtr(), component_factory_,
+                          Thread::threadFactoryForTest(), Filesystem::fileSystemForTest());
+  }
+
+  const std::string snapshot_dir_;
+  testing::NiceMock<MockOptions> options_;
+  TestComponentFactory component_factory_;
+};
+
+MATCHER_P(ResourceNamed, name, "") { return arg.name() == name; }
+
+TEST_F(ValidationServerSnapshotTest, ConfigProfile) {
+  writeSnapshot();
+  options_.config_profile_path_ = TestEnvironment::temporaryPath("snapshot_config_profile.json");
+  EXPECT_TRUE(validate());
+
+  envoy::admin::v3::ConfigMemory profile;
+  TestUtility::loadFromJson(
+      TestEnvironment::readFileToStringForTest(options_.config_profile_path_), profile);
+  EXPECT_THAT(profile.listeners(), testing::Contains(ResourceNamed("listener_0")));
+  EXPECT_THAT(profile.clusters(), testing::Contains(ResourceNamed("backend")));
+  EXPECT_THAT(profile.route_configs(), testing::Contains(ResourceNamed("routes")));
+  EXPECT_THAT(profile.regexes(), testing::Contains(ResourceNamed("/api/.*")));
+  EXPECT_THAT(profile.tls_contexts(),
+              testing::Contains(ResourceNamed("client:backend.example.com")));
+}
+
+// A resource of the snapshot which the server would reject fails the validation.
+TEST_F(ValidationServerSnapshotTest, RejectedResource) {
+  writeSnapshot();
+  writeSnapshotFile("cds.yaml", R"EOF(
+version_info: "2"
+type_url: type.googleapis.com/envoy.config.cluster.v3.Cluster
+resources:
+- "@type": type.googleapis.com/envoy.config.cluster.v3.Cluster
+  name: backend
+  type: STATIC
+  connect_timeout: -1s
+)EOF");
+  EXPECT_FALSE(validate());
+}
+
+TEST_F(ValidationServerSnapshotTest, DuplicateType) {
+  writeSnapshot();
+  writeSnapshotFile("cds_again.yaml", R"EOF(
+version_info: "2"
+type_url: type.googleapis.com/envoy.config.cluster.v3.Cluster
+)EOF");
+  EXPECT_FALSE(validate());
+}
+
+TEST_F(ValidationServerSnapshotTest, MissingTypeUrl) {
+  writeSnapshot();
+  writeSnapshotFile("untyped.yaml", R"EOF(
+version_info: "1"
+)EOF");
+  EXPECT_FALSE(validate());
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
@@ -130,7 +130,9 @@ public:
     bool handOffRestoredDestinationConnections() const override {
       return hand_off_restored_destination_connections_;
     }
-    uint32_t perConnectionBufferLimitBytes() const override { return 0; }
+    uint32_t perConnectionBufferLimitBytes() const override {
+      return per_connection_buffer_limit_bytes_;
+    }
     std::chrono::milliseconds listenerFiltersTimeout() const override {
       return listener_filters_timeout_;
     }
@@ -175,6 +177,7 @@ public:
     std::unique_ptr<Init::Manager> init_manager_;
     const bool ignore_global_conn_limit_;
     envoy::config::core::v3::TrafficDirection direction_;
+    uint32_t per_connection_buffer_limit_bytes_{};
     Network::UdpListenerCallbacks* udp_listener_callbacks_{};
   };
 
@@ -855,6 +858,67 @@ TEST_F(ConnectionHandlerTest, AddListenerSetRejectFraction) {
   handler_->addListener(absl::nullopt, *test_listener, runtime_);
 }
 
+TEST_F(ConnectionHandlerTest, SetConnectionBufferLimitScale) {
+  Network::TcpListenerCallbacks* listener_callbacks;
+  auto listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener =
+      addListener(1, false, false, "test_listener", listener, &listener_callbacks);
+  test_listener->per_connection_buffer_limit_bytes_ = 1024 * 1024;
+  handler_->setConnectionBufferLimitScale(UnitFloat(0.5f));
+  handler_->addListener(absl::nullopt, *test_listener, runtime_);
+
+  // New connections pick up the scale that was set before the listener was added.
+  auto* connection = new NiceMock<Network::MockServerConnection>();
+  EXPECT_CALL(manager_, findFilterChain(_)).WillOnce(Return(filter_chain_.get()));
+  EXPECT_CALL(dispatcher_, createServerConnection_()).WillOnce(Return(connection));
+  EXPECT_CALL(*connection, setBufferLimits(512 * 1024));
+  EXPECT_CALL(factory_, createNetworkFilterChain(_, _)).WillOnce(Return(true));
+  listener_callbacks->onAccept(std::make_unique<NiceMock<Network::MockConnectionSocket>>());
+  EXPECT_EQ(1UL, handler_->numConnections());
+
+  // Existing connections are updated in place, but never shrink below the floor.
+  EXPECT_CALL(*connection, setBufferLimits(256 * 1024));
+  handler_->setConnectionBufferLimitScale(UnitFloat(0.25f));
+  EXPECT_CALL(*connection, setBufferLimits(16 * 1024));
+  handler_->setConnectionBufferLimitScale(UnitFloat::min());
+
+  // Connections are left alone while the scale stays within a step, and limits are only raised
+  // again half a step above the next one.
+  EXPECT_CALL(*connection, setBufferLimits(_)).Times(0);
+  handler_->setConnectionBufferLimitScale(UnitFloat(0.1f));
+  handler_->setConnectionBufferLimitScale(UnitFloat(0.15f));
+  EXPECT_CALL(*connection, setBufferLimits(128 * 1024));
+  handler_->setConnectionBufferLimitScale(UnitFloat(0.2f));
+
+  EXPECT_CALL(*connection, setBufferLimits(1024 * 1024));
+  handler_->setConnectionBufferLimitScale(UnitFloat::max());
+
+  EXPECT_CALL(*listener, onDestroy());
+  EXPECT_CALL(*access_log_, log(_, _, _, _));
+}
+
+TEST_F(ConnectionHandlerTest, SetConnectionBufferLimitScaleKeepsUnlimitedBuffers) {
+  Network::TcpListenerCallbacks* listener_callbacks;
+  auto listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener =
+      addListener(1, false, false, "test_listener", listener, &listener_callbacks);
+  handler_->addListener(absl::nullopt, *test_listener, runtime_);
+  handler_->setConnectionBufferLimitScale(UnitFloat(0.5f));
+
+  auto* connection = new NiceMock<Network::MockServerConnection>();
+  EXPECT_CALL(manager_, findFilterChain(_)).WillOnce(Return(filter_chain_.get()));
+  EXPECT_CALL(dispatcher_, createServerConnection_()).WillOnce(Return(connection));
+  EXPECT_CALL(*connection, setBufferLimits(0));
+  EXPECT_CALL(factory_, createNetworkFilterChain(_, _)).WillOnce(Return(true));
+  listener_callbacks->onAccept(std::make_unique<NiceMock<Network::MockConnectionSocket>>());
+
+  EXPECT_CALL(*connection, setBufferLimits(_)).Times(0);
+  handler_->setConnectionBufferLimitScale(UnitFloat::min());
+
+  EXPECT_CALL(*listener, onDestroy());
+  EXPECT_CALL(*access_log_, log(_, _, _, _));
+}
+
 TEST_F(ConnectionHandlerTest, SetsTransportSocketConnectTimeout) {
   InSequence s;
 
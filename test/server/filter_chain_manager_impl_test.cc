@@ -23,12 +23,14 @@
 #include "source/server/listener_manager_impl.h"
 
 #include "test/mocks/network/mocks.h"
+#include "test/mocks/network/transport_socket.h"
 #include "test/mocks/server/drain_manager.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/server/utility.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/registry.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
@@ -254,6 +256,68 @@ TEST_P(FilterChainManagerImplTest, DuplicateContextsAreNotBuilt) {
       nullptr, filter_chain_factory_builder_, new_filter_chain_manager);
 }
 
+// Filter chains with the same transport socket and server names share their transport socket
+// factory, also with the next generation of filter chain manager.
+TEST_P(FilterChainManagerImplTest, TransportSocketFactoriesAreShared) {
+  int factories_created = 0;
+  const std::function<Network::DownstreamTransportSocketFactoryPtr()> create_factory =
+      [&factories_created]() {
+        ++factories_created;
+        return std::make_unique<NiceMock<Network::MockDownstreamTransportSocketFactory>>();
+      };
+  envoy::config::listener::v3::FilterChain filter_chain = filter_chain_template_;
+  filter_chain.mutable_filter_chain_match()->add_server_names("example.com");
+  auto factory =
+      filter_chain_manager_.getOrCreateTransportSocketFactory(filter_chain, create_factory);
+  EXPECT_EQ(1, factories_created);
+
+  // The filters and the other match criteria of the filter chain do not matter.
+  envoy::config::listener::v3::FilterChain same_transport_socket = filter_chain;
+  same_transport_socket.set_name("other");
+  same_transport_socket.mutable_filter_chain_match()->mutable_destination_port()->set_value(20000);
+  same_transport_socket.add_filters()->set_name("filter");
+  EXPECT_EQ(factory, filter_chain_manager_.getOrCreateTransportSocketFactory(same_transport_socket,
+                                                                             create_factory));
+  EXPECT_EQ(1, factories_created);
+
+  envoy::config::listener::v3::FilterChain other_server_name = filter_chain;
+  other_server_name.mutable_filter_chain_match()->set_server_names(0, "other.example.com");
+  auto other_factory =
+      filter_chain_manager_.getOrCreateTransportSocketFactory(other_server_name, create_factory);
+  EXPECT_NE(factory, other_factory);
+  EXPECT_EQ(2, factories_created);
+
+  envoy::config::listener::v3::FilterChain raw_buffer = filter_chain;
+  raw_buffer.clear_transport_socket();
+  EXPECT_NE(factory,
+            filter_chain_manager_.getOrCreateTransportSocketFactory(raw_buffer, create_factory));
+  EXPECT_EQ(3, factories_created);
+
+  FilterChainManagerImpl new_filter_chain_manager{
+      std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234), parent_context_,
+      init_manager_, filter_chain_manager_};
+  EXPECT_EQ(other_factory, new_filter_chain_manager.getOrCreateTransportSocketFactory(
+                               other_server_name, create_factory));
+  EXPECT_EQ(3, factories_created);
+}
+
+TEST_P(FilterChainManagerImplTest, TransportSocketFactoriesAreNotSharedWithRuntimeGuardDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.share_transport_socket_factories", "false"}});
+  int factories_created = 0;
+  const std::function<Network::DownstreamTransportSocketFactoryPtr()> create_factory =
+      [&factories_created]() {
+        ++factories_created;
+        return std::make_unique<NiceMock<Network::MockDownstreamTransportSocketFactory>>();
+      };
+  auto factory = filter_chain_manager_.getOrCreateTransportSocketFactory(filter_chain_template_,
+                                                                         create_factory);
+  EXPECT_NE(factory, filter_chain_manager_.getOrCreateTransportSocketFactory(filter_chain_template_,
+                                                                             create_factory));
+  EXPECT_EQ(2, factories_created);
+}
+
 TEST_P(FilterChainManagerImplTest, CreatedFilterChainFactoryContextHasIndependentDrainClose) {
   std::vector<envoy::config::listener::v3::FilterChain> filter_chain_messages;
   for (int i = 0; i < 3; i++) {
@@ -0,0 +1,114 @@
+// Compares handing stats from a hot restart parent to its child through the token-table encoding
+// used by HotRestartStatsWriter against the map of elaborated stat names it replaced.
+//
+// Note: this should be run with --compilation_mode=opt.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/common/stats/stat_merger.h"
+#include "source/common/stats/symbol_table.h"
+#include "source/server/hot_restarting_stats.h"
+
+#include "test/benchmark/main.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Server {
+
+class HotRestartStatsSpeedTest {
+public:
+  explicit HotRestartStatsSpeedTest(uint64_t num_stats) : parent_pool_(parent_symbol_table_) {
+    // Stat names shaped like cluster stats, so that most tokens repeat across names.
+    for (uint64_t idx = 0; idx < num_stats; ++idx) {
+      stat_names_.push_back(parent_pool_.add(
+          absl::StrCat("cluster.service_", idx / 100, ".upstream_rq_", idx % 100, ".total")));
+    }
+  }
+
+  void sharedMemoryEncoding(::benchmark::State& state) {
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      HotRestartStatsWriter writer(parent_symbol_table_);
+      for (uint64_t idx = 0; idx < stat_names_.size(); ++idx) {
+        writer.add(idx % 2 == 0 ? HotRestartStatKind::Counter : HotRestartStatKind::Gauge,
+                   stat_names_[idx], idx);
+      }
+      std::vector<uint8_t> data(writer.byteSize());
+      writer.write(absl::MakeSpan(data));
+
+      Stats::SymbolTableImpl child_symbol_table;
+      Stats::IsolatedStoreImpl child_store(child_symbol_table);
+      Stats::StatMerger merger(child_store);
+      const bool ok = HotRestartStatsReader::read(
+          data, child_symbol_table,
+          [&merger](HotRestartStatKind kind, Stats::StatName stat_name, uint64_t value) {
+            if (kind == HotRestartStatKind::Counter) {
+              merger.mergeCounter(stat_name, value);
+            } else {
+              merger.mergeGauge(stat_name, value);
+            }
+          });
+      RELEASE_ASSERT(ok, "");
+      state.counters["bytes"] = data.size();
+    }
+  }
+
+  void protoEncoding(::benchmark::State& state) {
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      Protobuf::Map<std::string, uint64_t> counter_deltas;
+      Protobuf::Map<std::string, uint64_t> gauges;
+      for (uint64_t idx = 0; idx < stat_names_.size(); ++idx) {
+        auto& stats = idx % 2 == 0 ? counter_deltas : gauges;
+        stats[parent_symbol_table_.toString(stat_names_[idx])] = idx;
+      }
+
+      Stats::SymbolTableImpl child_symbol_table;
+      Stats::IsolatedStoreImpl child_store(child_symbol_table);
+      Stats::StatMerger merger(child_store);
+      merger.mergeStats(counter_deltas, gauges);
+    }
+  }
+
+private:
+  Stats::SymbolTableImpl parent_symbol_table_;
+  Stats::StatNamePool parent_pool_;
+  std::vector<Stats::StatName> stat_names_;
+};
+
+static void bmSharedMemoryEncoding(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  HotRestartStatsSpeedTest speed_test(state.range(0));
+  speed_test.sharedMemoryEncoding(state);
+}
+
+static void bmProtoEncoding(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  HotRestartStatsSpeedTest speed_test(state.range(0));
+  speed_test.protoEncoding(state);
+}
+
+BENCHMARK(bmSharedMemoryEncoding)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000000);
+BENCHMARK(bmProtoEncoding)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
+
+} // namespace Server
+} // namespace Envoy
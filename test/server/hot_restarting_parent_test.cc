@@ -1,13 +1,17 @@
+#include <unistd.h>
+
 #include <memory>
 
 #include "source/common/network/address_impl.h"
 #include "source/server/hot_restarting_child.h"
 #include "source/server/hot_restarting_parent.h"
+#include "source/server/hot_restarting_stats.h"
 
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/listener_manager.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "gtest/gtest.h"
 
 using testing::InSequence;
@@ -22,8 +26,34 @@ using HotRestartMessage = envoy::HotRestartMessage;
 
 class HotRestartingParentTest : public testing::Test {
 public:
+  struct DecodedStats {
+    absl::flat_hash_map<std::string, uint64_t> counter_deltas_;
+    absl::flat_hash_map<std::string, uint64_t> gauges_;
+  };
+
+  // Reads back the stats exported through shared memory, consuming the region as the child would.
+  static DecodedStats decodeStats(const HotRestartMessage::Reply::Stats& stats,
+                                  Stats::SymbolTable& symbol_table) {
+    DecodedStats decoded;
+    EXPECT_TRUE(consumeStatsFromSharedMemory(
+        stats.stats_shared_memory_name(), stats.stats_shared_memory_size(),
+        [&decoded, &symbol_table](absl::Span<const uint8_t> data) {
+          EXPECT_TRUE(HotRestartStatsReader::read(
+              data, symbol_table,
+              [&decoded, &symbol_table](HotRestartStatKind kind, Stats::StatName stat_name,
+                                        uint64_t value) {
+                auto& stats_of_kind = kind == HotRestartStatKind::Counter
+                                          ? decoded.counter_deltas_
+                                          : decoded.gauges_;
+                stats_of_kind[symbol_table.toString(stat_name)] = value;
+              }));
+        }));
+    return decoded;
+  }
+
   NiceMock<MockInstance> server_;
-  HotRestartingParent::Internal hot_restarting_parent_{&server_};
+  HotRestartingParent::Internal hot_restarting_parent_{
+      &server_, fmt::format("/envoy_hot_restarting_parent_test_{}", getpid())};
 };
 
 TEST_F(HotRestartingParentTest, ShutdownAdmin) {
@@ -145,12 +175,13 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).set(123);
     store.gauge("g2", Stats::Gauge::ImportMode::Accumulate).set(456);
     HotRestartMessage::Reply::Stats stats;
-    hot_restarting_parent_.exportStatsToChild(&stats);
-    EXPECT_EQ(1, stats.counter_deltas().at("c1"));
-    EXPECT_EQ(2, stats.counter_deltas().at("c2"));
-    EXPECT_EQ(0, stats.gauges().at("g0"));
-    EXPECT_EQ(123, stats.gauges().at("g1"));
-    EXPECT_EQ(456, stats.gauges().at("g2"));
+    hot_restarting_parent_.exportStatsToChild(HotRestartMessage::Request::Stats(), &stats);
+    const DecodedStats decoded = decodeStats(stats, store.symbolTable());
+    EXPECT_EQ(1, decoded.counter_deltas_.at("c1"));
+    EXPECT_EQ(2, decoded.counter_deltas_.at("c2"));
+    EXPECT_EQ(0, decoded.gauges_.at("g0"));
+    EXPECT_EQ(123, decoded.gauges_.at("g1"));
+    EXPECT_EQ(456, decoded.gauges_.at("g2"));
   }
   // When a counter has not changed since its last export, it should not be included in the message.
   {
@@ -158,12 +189,13 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).add(1);
     store.gauge("g2", Stats::Gauge::ImportMode::Accumulate).sub(1);
     HotRestartMessage::Reply::Stats stats;
-    hot_restarting_parent_.exportStatsToChild(&stats);
-    EXPECT_EQ(stats.counter_deltas().end(), stats.counter_deltas().find("c1"));
-    EXPECT_EQ(2, stats.counter_deltas().at("c2")); // 4 is the value, but 2 is the delta
-    EXPECT_EQ(0, stats.gauges().at("g0"));
-    EXPECT_EQ(124, stats.gauges().at("g1"));
-    EXPECT_EQ(455, stats.gauges().at("g2"));
+    hot_restarting_parent_.exportStatsToChild(HotRestartMessage::Request::Stats(), &stats);
+    const DecodedStats decoded = decodeStats(stats, store.symbolTable());
+    EXPECT_FALSE(decoded.counter_deltas_.contains("c1"));
+    EXPECT_EQ(2, decoded.counter_deltas_.at("c2")); // 4 is the value, but 2 is the delta
+    EXPECT_EQ(0, decoded.gauges_.at("g0"));
+    EXPECT_EQ(124, decoded.gauges_.at("g1"));
+    EXPECT_EQ(455, decoded.gauges_.at("g2"));
   }
 
   // When a counter and gauge are not used, they should not be included in the message.
@@ -173,11 +205,12 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
     store.gauge("unused_gauge", Stats::Gauge::ImportMode::Accumulate);
     store.gauge("used_gauge", Stats::Gauge::ImportMode::Accumulate).add(1);
     HotRestartMessage::Reply::Stats stats;
-    hot_restarting_parent_.exportStatsToChild(&stats);
-    EXPECT_EQ(stats.counter_deltas().end(), stats.counter_deltas().find("unused_counter"));
-    EXPECT_EQ(1, stats.counter_deltas().at("used_counter"));
-    EXPECT_EQ(stats.gauges().end(), stats.counter_deltas().find("unused_gauge"));
-    EXPECT_EQ(1, stats.gauges().at("used_gauge"));
+    hot_restarting_parent_.exportStatsToChild(HotRestartMessage::Request::Stats(), &stats);
+    const DecodedStats decoded = decodeStats(stats, store.symbolTable());
+    EXPECT_FALSE(decoded.counter_deltas_.contains("unused_counter"));
+    EXPECT_EQ(1, decoded.counter_deltas_.at("used_counter"));
+    EXPECT_FALSE(decoded.gauges_.contains("unused_gauge"));
+    EXPECT_EQ(1, decoded.gauges_.at("used_gauge"));
   }
 }
 
@@ -197,7 +230,7 @@ TEST_F(HotRestartingParentTest, RetainDynamicStats) {
     parent_store.counterFromStatName(dynamic.add("c2")).inc();
     parent_store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).set(123);
     parent_store.gaugeFromStatName(dynamic.add("g2"), Stats::Gauge::ImportMode::Accumulate).set(42);
-    hot_restarting_parent_.exportStatsToChild(&stats_proto);
+    hot_restarting_parent_.exportStatsToChild(HotRestartMessage::Request::Stats(), &stats_proto);
   }
 
   {
@@ -219,6 +252,52 @@ TEST_F(HotRestartingParentTest, RetainDynamicStats) {
   }
 }
 
+// When the child cannot map the region, it asks for the stats in the reply, which must then also
+// carry the counter deltas latched into that region.
+TEST_F(HotRestartingParentTest, ExportStatsToChildInReply) {
+  MockListenerManager listener_manager;
+  Stats::SymbolTableImpl parent_symbol_table;
+  Stats::TestUtil::TestStore parent_store(parent_symbol_table);
+
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(0));
+  EXPECT_CALL(server_, stats()).WillRepeatedly(ReturnRef(parent_store));
+
+  Stats::StatNameDynamicPool dynamic(parent_store.symbolTable());
+  parent_store.counter("c1").add(2);
+  parent_store.counterFromStatName(dynamic.add("c2")).inc();
+  parent_store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).set(123);
+  HotRestartMessage::Reply::Stats unmapped;
+  hot_restarting_parent_.exportStatsToChild(HotRestartMessage::Request::Stats(), &unmapped);
+  EXPECT_FALSE(unmapped.stats_shared_memory_name().empty());
+
+  parent_store.counter("c1").inc();
+  parent_store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).set(124);
+  HotRestartMessage::Request::Stats request;
+  request.set_stats_in_reply(true);
+  HotRestartMessage::Reply::Stats stats_proto;
+  hot_restarting_parent_.exportStatsToChild(request, &stats_proto);
+  EXPECT_TRUE(stats_proto.stats_shared_memory_name().empty());
+  EXPECT_EQ(3, stats_proto.counter_deltas().at("c1"));
+  EXPECT_EQ(1, stats_proto.counter_deltas().at("c2"));
+  EXPECT_EQ(124, stats_proto.gauges().at("g1"));
+  EXPECT_EQ(1, stats_proto.dynamics().count("c2"));
+  EXPECT_EQ(0, stats_proto.dynamics().count("c1"));
+
+  Stats::SymbolTableImpl child_symbol_table;
+  Stats::TestUtil::TestStore child_store(child_symbol_table);
+  Stats::StatNameDynamicPool child_dynamic(child_store.symbolTable());
+  Stats::Counter& c1 = child_store.counter("c1");
+  Stats::Counter& c2 = child_store.counterFromStatName(child_dynamic.add("c2"));
+  Stats::Gauge& g1 = child_store.gauge("g1", Stats::Gauge::ImportMode::Accumulate);
+
+  HotRestartingChild hot_restarting_child(0, 0, "@envoy_domain_socket", 0);
+  hot_restarting_child.mergeParentStats(child_store, stats_proto);
+  EXPECT_EQ(3, c1.value());
+  EXPECT_EQ(1, c2.value());
+  EXPECT_EQ(124, g1.value());
+}
+
 TEST_F(HotRestartingParentTest, DrainListeners) {
   EXPECT_CALL(server_, drainListeners());
   hot_restarting_parent_.drainListeners();
@@ -0,0 +1,209 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "source/common/common/fmt.h"
+#include "source/common/common/safe_memcpy.h"
+#include "source/common/stats/symbol_table.h"
+#include "source/server/hot_restarting_stats.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+class HotRestartingStatsTest : public testing::Test {
+protected:
+  struct DecodedStat {
+    HotRestartStatKind kind_;
+    std::string name_;
+    std::vector<Stats::DynamicSpan> dynamic_spans_;
+    uint64_t value_;
+  };
+
+  std::vector<uint8_t> encode(const HotRestartStatsWriter& writer) {
+    std::vector<uint8_t> data(writer.byteSize());
+    writer.write(absl::MakeSpan(data));
+    return data;
+  }
+
+  bool decode(absl::Span<const uint8_t> data, std::vector<DecodedStat>& decoded) {
+    return HotRestartStatsReader::read(
+        data, child_symbol_table_,
+        [this, &decoded](HotRestartStatKind kind, Stats::StatName stat_name, uint64_t value) {
+          decoded.push_back({kind, child_symbol_table_.toString(stat_name),
+                             child_symbol_table_.getDynamicSpans(stat_name), value});
+        });
+  }
+
+  Stats::SymbolTableImpl parent_symbol_table_;
+  Stats::SymbolTableImpl child_symbol_table_;
+  Stats::StatNamePool parent_pool_{parent_symbol_table_};
+  Stats::StatNameDynamicPool parent_dynamic_pool_{parent_symbol_table_};
+};
+
+TEST_F(HotRestartingStatsTest, Empty) {
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  EXPECT_EQ(0, writer.numStats());
+
+  std::vector<DecodedStat> decoded;
+  EXPECT_TRUE(decode(encode(writer), decoded));
+  EXPECT_TRUE(decoded.empty());
+}
+
+TEST_F(HotRestartingStatsTest, RoundTrip) {
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  writer.add(HotRestartStatKind::Counter, parent_pool_.add("cluster.a.upstream_rq"), 5);
+  writer.add(HotRestartStatKind::Gauge, parent_pool_.add("cluster.b.upstream_cx_active"), 7);
+  Stats::SymbolTable::StoragePtr joined = parent_symbol_table_.join(
+      {parent_pool_.add("http"), parent_dynamic_pool_.add("ingress.v2"), parent_pool_.add("rq")});
+  writer.add(HotRestartStatKind::Counter, Stats::StatName(joined.get()), 1);
+  EXPECT_EQ(3, writer.numStats());
+
+  const std::vector<uint8_t> data = encode(writer);
+  std::vector<DecodedStat> decoded;
+  ASSERT_TRUE(decode(data, decoded));
+  ASSERT_EQ(3, decoded.size());
+
+  EXPECT_EQ(HotRestartStatKind::Counter, decoded[0].kind_);
+  EXPECT_EQ("cluster.a.upstream_rq", decoded[0].name_);
+  EXPECT_TRUE(decoded[0].dynamic_spans_.empty());
+  EXPECT_EQ(5, decoded[0].value_);
+
+  EXPECT_EQ(HotRestartStatKind::Gauge, decoded[1].kind_);
+  EXPECT_EQ("cluster.b.upstream_cx_active", decoded[1].name_);
+  EXPECT_EQ(7, decoded[1].value_);
+
+  // The dynamic segment is rebuilt dynamically in the child, so that the name matches the one the
+  // child builds for the same stat.
+  EXPECT_EQ(HotRestartStatKind::Counter, decoded[2].kind_);
+  EXPECT_EQ("http.ingress.v2.rq", decoded[2].name_);
+  ASSERT_EQ(1, decoded[2].dynamic_spans_.size());
+  EXPECT_EQ(Stats::DynamicSpan(1, 2), decoded[2].dynamic_spans_[0]);
+  EXPECT_EQ(1, decoded[2].value_);
+}
+
+// Tokens shared between stat names are only stored once.
+TEST_F(HotRestartingStatsTest, SharedTokensStoredOnce) {
+  HotRestartStatsWriter one_stat(parent_symbol_table_);
+  one_stat.add(HotRestartStatKind::Counter, parent_pool_.add("cluster.a.upstream_rq"), 1);
+  HotRestartStatsWriter two_stats(parent_symbol_table_);
+  two_stats.add(HotRestartStatKind::Counter, parent_pool_.add("cluster.a.upstream_rq"), 1);
+  two_stats.add(HotRestartStatKind::Counter, parent_pool_.add("cluster.a.upstream_rq"), 2);
+
+  // The second stat only costs its value, its kind and its three token indexes.
+  EXPECT_EQ(one_stat.byteSize() + sizeof(uint64_t) + 4 * sizeof(uint32_t), two_stats.byteSize());
+}
+
+TEST_F(HotRestartingStatsTest, Truncated) {
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  writer.add(HotRestartStatKind::Counter, parent_pool_.add("a.b"), 1);
+  writer.add(HotRestartStatKind::Gauge, parent_pool_.add("a.c"), 2);
+  const std::vector<uint8_t> data = encode(writer);
+
+  for (size_t size = 0; size < data.size(); ++size) {
+    std::vector<DecodedStat> decoded;
+    EXPECT_FALSE(decode(absl::MakeConstSpan(data.data(), size), decoded)) << size;
+    EXPECT_LE(decoded.size(), 1);
+  }
+}
+
+TEST_F(HotRestartingStatsTest, TokenIndexOutOfRange) {
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  writer.add(HotRestartStatKind::Counter, parent_pool_.add("a"), 1);
+  std::vector<uint8_t> data = encode(writer);
+
+  // The only token index is the last four bytes of the encoding.
+  const uint32_t bad_entry = 1 << 1;
+  safeMemcpyUnsafeDst(data.data() + data.size() - sizeof(bad_entry), &bad_entry);
+  std::vector<DecodedStat> decoded;
+  EXPECT_FALSE(decode(data, decoded));
+  EXPECT_TRUE(decoded.empty());
+}
+
+TEST_F(HotRestartingStatsTest, SharedMemory) {
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  writer.add(HotRestartStatKind::Counter, parent_pool_.add("a.b"), 3);
+  const std::string name = fmt::format("/envoy_hot_restarting_stats_test_{}", getpid());
+
+  const absl::optional<uint64_t> size = publishStatsToSharedMemory(name, writer);
+  ASSERT_TRUE(size.has_value());
+  EXPECT_EQ(writer.byteSize(), size.value());
+
+  std::vector<DecodedStat> decoded;
+  EXPECT_TRUE(consumeStatsFromSharedMemory(name, size.value(),
+                                           [this, &decoded](absl::Span<const uint8_t> data) {
+                                             EXPECT_TRUE(decode(data, decoded));
+                                           }));
+  ASSERT_EQ(1, decoded.size());
+  EXPECT_EQ("a.b", decoded[0].name_);
+  EXPECT_EQ(3, decoded[0].value_);
+
+  // The region is unlinked once consumed.
+  EXPECT_FALSE(consumeStatsFromSharedMemory(name, size.value(), [](absl::Span<const uint8_t>) {
+    FAIL() << "region should have been unlinked";
+  }));
+}
+
+TEST_F(HotRestartingStatsTest, SharedMemorySmallerThanExpected) {
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  writer.add(HotRestartStatKind::Counter, parent_pool_.add("a.b"), 3);
+  const std::string name = fmt::format("/envoy_hot_restarting_stats_test_short_{}", getpid());
+
+  const absl::optional<uint64_t> size = publishStatsToSharedMemory(name, writer);
+  ASSERT_TRUE(size.has_value());
+  // Mapping past the end of the region would fault when read, so it is rejected up front.
+  EXPECT_FALSE(consumeStatsFromSharedMemory(name, size.value() + 4096,
+                                            [](absl::Span<const uint8_t>) {
+                                              FAIL() << "short region should not be read";
+                                            }));
+
+  // The region is left in place for the parent to read back.
+  std::vector<DecodedStat> decoded;
+  EXPECT_TRUE(consumeStatsFromSharedMemory(name, size.value(),
+                                           [this, &decoded](absl::Span<const uint8_t> data) {
+                                             EXPECT_TRUE(decode(data, decoded));
+                                           }));
+  ASSERT_EQ(1, decoded.size());
+  EXPECT_EQ(3, decoded[0].value_);
+}
+
+// A region created under the predictable name before the parent publishes, e.g. by another local
+// process, is replaced rather than written into, so whoever created it cannot change what the
+// child reads.
+TEST_F(HotRestartingStatsTest, SharedMemoryPrecreatedRegionIsReplaced) {
+  const std::string name = fmt::format("/envoy_hot_restarting_stats_test_precreated_{}", getpid());
+  const int precreated = ::shm_open(name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  ASSERT_NE(-1, precreated);
+  ASSERT_EQ(0, ::ftruncate(precreated, 4096));
+
+  HotRestartStatsWriter writer(parent_symbol_table_);
+  writer.add(HotRestartStatKind::Counter, parent_pool_.add("a.b"), 3);
+  const absl::optional<uint64_t> size = publishStatsToSharedMemory(name, writer);
+  ASSERT_TRUE(size.has_value());
+
+  // Writes through the pre-created region do not reach the published one.
+  void* mapped = ::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, precreated, 0);
+  ASSERT_NE(MAP_FAILED, mapped);
+  memset(mapped, 0xff, 4096);
+  ::munmap(mapped, 4096);
+  ::close(precreated);
+
+  std::vector<DecodedStat> decoded;
+  EXPECT_TRUE(consumeStatsFromSharedMemory(name, size.value(),
+                                           [this, &decoded](absl::Span<const uint8_t> data) {
+                                             EXPECT_TRUE(decode(data, decoded));
+                                           }));
+  ASSERT_EQ(1, decoded.size());
+  EXPECT_EQ("a.b", decoded[0].name_);
+  EXPECT_EQ(3, decoded[0].value_);
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
@@ -94,7 +94,8 @@ TEST_F(OptionsImplTest, All) {
       "--reject-unknown-dynamic-fields --base-id 5 "
       "--use-dynamic-base-id --base-id-path /foo/baz "
       "--stats-tag foo:bar --stats-tag baz:bar "
-      "--socket-path /foo/envoy_domain_socket --socket-mode 644");
+      "--socket-path /foo/envoy_domain_socket --socket-mode 644 "
+      "--config-profile-path /foo/profile.json --config-profile-snapshot-dir /foo/snapshot");
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ(2U, options->concurrency());
   EXPECT_EQ("hello", options->configPath());
@@ -122,6 +123,8 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ("/foo/envoy_domain_socket", options->socketPath());
   EXPECT_EQ(0644, options->socketMode());
   EXPECT_EQ(2U, options->statsTags().size());
+  EXPECT_EQ("/foo/profile.json", options->configProfilePath());
+  EXPECT_EQ("/foo/snapshot", options->configProfileSnapshotDir());
 
   options = createOptionsImpl("envoy --mode init_only");
   EXPECT_EQ(Server::Mode::InitOnly, options->mode());
@@ -184,6 +187,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setSocketPath("/foo/envoy_domain_socket");
   options->setSocketMode(0644);
   options->setStatsTags({{"foo", "bar"}});
+  options->setConfigProfilePath("/foo/profile.json");
 
   EXPECT_EQ(109876, options->baseId());
   EXPECT_EQ(true, options->useDynamicBaseId());
@@ -249,6 +253,9 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->socketMode(), command_line_options->socket_mode());
   EXPECT_EQ(1U, command_line_options->stats_tag().size());
   EXPECT_EQ("foo:bar", command_line_options->stats_tag(0));
+  EXPECT_EQ(options->configProfilePath(), command_line_options->config_profile_path());
+  EXPECT_EQ(options->configProfileSnapshotDir(),
+            command_line_options->config_profile_snapshot_dir());
 }
 
 TEST_F(OptionsImplTest, DefaultParams) {
@@ -29,6 +29,7 @@ using testing::AllOf;
 using testing::AnyNumber;
 using testing::ByMove;
 using testing::DoAll;
+using testing::ElementsAre;
 using testing::FloatNear;
 using testing::Invoke;
 using testing::InvokeArgument;
@@ -637,6 +638,179 @@ TEST_F(OverloadManagerImplTest, AdjustScaleFactor) {
   timer_cb_();
 }
 
+constexpr char kWorkerEventLoopConfig[] = R"YAML(
+  refresh_interval:
+    seconds: 1
+  resource_monitors:
+    - name: envoy.resource_monitors.fake_resource1
+    - name: envoy.resource_monitors.worker_event_loop_utilization
+  actions:
+    - name: envoy.overload_actions.dummy_action
+      triggers:
+        - name: envoy.resource_monitors.fake_resource1
+          threshold:
+            value: 0.9
+        - name: envoy.resource_monitors.worker_event_loop_utilization
+          threshold:
+            value: 0.9
+)YAML";
+
+Event::EventLoopTimes eventLoopTimes(uint64_t busy_ms, uint64_t polling_ms) {
+  return {std::chrono::milliseconds(busy_ms), std::chrono::milliseconds(polling_ms)};
+}
+
+TEST_F(OverloadManagerImplTest, WorkerEventLoopUtilizationSaturatesOnlyThatWorker) {
+  setDispatcherExpectation();
+  // The thread-local mock runs a single thread on its own dispatcher, which stands in for a worker.
+  Event::MockDispatcher& worker_dispatcher = thread_local_.dispatcher_;
+  // The event loop is only timed on the threads evaluating worker triggers.
+  EXPECT_CALL(worker_dispatcher, enableEventLoopTimes());
+  EXPECT_CALL(worker_dispatcher, eventLoopTimes())
+      .WillOnce(Return(eventLoopTimes(0, 0)))
+      // Busy for 950ms out of the first second.
+      .WillOnce(Return(eventLoopTimes(950, 50)))
+      // Still busy for 920ms out of the next second.
+      .WillOnce(Return(eventLoopTimes(1870, 130)))
+      // Mostly idle for the third second.
+      .WillOnce(Return(eventLoopTimes(1970, 1030)));
+
+  auto manager(createOverloadManager(kWorkerEventLoopConfig));
+  int worker_cb_count = 0;
+  bool worker_active = false;
+  manager->registerForAction("envoy.overload_actions.dummy_action", worker_dispatcher,
+                             [&](OverloadActionState state) {
+                               worker_active = state.isSaturated();
+                               worker_cb_count++;
+                             });
+  // Another worker that isn't busy never sees the action.
+  NiceMock<Event::MockDispatcher> other_worker_dispatcher;
+  manager->registerForAction("envoy.overload_actions.dummy_action", other_worker_dispatcher,
+                             [&](OverloadActionState) { EXPECT_TRUE(false); });
+  manager->start();
+
+  const OverloadActionState& action_state =
+      manager->getThreadLocalOverloadState().getState("envoy.overload_actions.dummy_action");
+  Stats::Gauge& pressure_gauge =
+      stats_.gauge("overload.envoy.resource_monitors.worker_event_loop_utilization.pressure",
+                   Stats::Gauge::ImportMode::NeverImport);
+  Stats::Gauge& active_gauge = stats_.gauge("overload.envoy.overload_actions.dummy_action.active",
+                                            Stats::Gauge::ImportMode::Accumulate);
+
+  factory1_.monitor_->setPressure(0.5);
+  timer_cb_();
+  EXPECT_TRUE(action_state.isSaturated());
+  EXPECT_TRUE(worker_active);
+  EXPECT_EQ(1, worker_cb_count);
+  EXPECT_EQ(95, pressure_gauge.value());
+  // The action isn't active process-wide.
+  EXPECT_EQ(0, active_gauge.value());
+
+  timer_cb_();
+  EXPECT_TRUE(action_state.isSaturated());
+  EXPECT_EQ(1, worker_cb_count);
+  EXPECT_EQ(92, pressure_gauge.value());
+
+  timer_cb_();
+  EXPECT_FALSE(action_state.isSaturated());
+  EXPECT_FALSE(worker_active);
+  EXPECT_EQ(2, worker_cb_count);
+  EXPECT_EQ(10, pressure_gauge.value());
+
+  manager->stop();
+}
+
+TEST_F(OverloadManagerImplTest, WorkerEventLoopUtilizationCombinesWithGlobalState) {
+  setDispatcherExpectation();
+  Event::MockDispatcher& worker_dispatcher = thread_local_.dispatcher_;
+  EXPECT_CALL(worker_dispatcher, eventLoopTimes())
+      .WillOnce(Return(eventLoopTimes(0, 0)))
+      .WillOnce(Return(eventLoopTimes(950, 50)))
+      .WillOnce(Return(eventLoopTimes(1900, 100)))
+      .WillOnce(Return(eventLoopTimes(2000, 1000)));
+
+  auto manager(createOverloadManager(kWorkerEventLoopConfig));
+  std::vector<bool> worker_states;
+  manager->registerForAction(
+      "envoy.overload_actions.dummy_action", worker_dispatcher,
+      [&](OverloadActionState state) { worker_states.push_back(state.isSaturated()); });
+  manager->start();
+
+  const OverloadActionState& action_state =
+      manager->getThreadLocalOverloadState().getState("envoy.overload_actions.dummy_action");
+
+  // The global resource saturates the action on every thread, and this worker is busy as well.
+  factory1_.monitor_->setPressure(0.95);
+  timer_cb_();
+  EXPECT_TRUE(action_state.isSaturated());
+  EXPECT_THAT(worker_states, ElementsAre(true));
+
+  // Once the global resource recovers, the busy worker keeps the action saturated.
+  factory1_.monitor_->setPressure(0.5);
+  timer_cb_();
+  EXPECT_TRUE(action_state.isSaturated());
+  EXPECT_THAT(worker_states, ElementsAre(true));
+
+  timer_cb_();
+  EXPECT_FALSE(action_state.isSaturated());
+  EXPECT_THAT(worker_states, ElementsAre(true, false));
+
+  manager->stop();
+}
+
+TEST_F(OverloadManagerImplTest, WorkerEventLoopUtilizationNotEvaluatedOnMainThread) {
+  // Use the thread-local mock's dispatcher as the main dispatcher, so that its only thread is the
+  // main thread.
+  Event::MockDispatcher& main_dispatcher = thread_local_.dispatcher_;
+  timer_ = new NiceMock<Event::MockTimer>();
+  EXPECT_CALL(main_dispatcher, createTimer_(_)).WillOnce(Invoke([&](Event::TimerCb cb) {
+    timer_cb_ = cb;
+    return timer_;
+  }));
+  EXPECT_CALL(main_dispatcher, enableEventLoopTimes()).Times(0);
+  EXPECT_CALL(main_dispatcher, eventLoopTimes()).Times(0);
+
+  auto manager = std::make_unique<TestOverloadManager>(main_dispatcher, stats_, thread_local_,
+                                                       parseConfig(kWorkerEventLoopConfig),
+                                                       validation_visitor_, *api_, options_);
+  manager->start();
+  factory1_.monitor_->setPressure(0.5);
+  timer_cb_();
+  EXPECT_FALSE(manager->getThreadLocalOverloadState()
+                   .getState("envoy.overload_actions.dummy_action")
+                   .isSaturated());
+  EXPECT_EQ(0, stats_
+                   .gauge("overload.envoy.resource_monitors.worker_event_loop_utilization.pressure",
+                          Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+
+  manager->stop();
+}
+
+TEST_F(OverloadManagerImplTest, WorkerTriggerWithoutResourceMonitor) {
+  const std::string config = R"EOF(
+    actions:
+      - name: "envoy.overload_actions.dummy_action"
+        triggers:
+          - name: "envoy.resource_monitors.worker_event_loop_utilization"
+            threshold:
+              value: 0.9
+  )EOF";
+
+  EXPECT_THROW_WITH_REGEX(createOverloadManager(config), EnvoyException,
+                          "Unknown trigger resource .*");
+}
+
+TEST_F(OverloadManagerImplTest, DuplicateWorkerResourceMonitor) {
+  const std::string config = R"EOF(
+    resource_monitors:
+      - name: "envoy.resource_monitors.worker_event_loop_utilization"
+      - name: "envoy.resource_monitors.worker_event_loop_utilization"
+  )EOF";
+
+  EXPECT_THROW_WITH_REGEX(createOverloadManager(config), EnvoyException,
+                          "Duplicate resource monitor .*");
+}
+
 TEST_F(OverloadManagerImplTest, DuplicateResourceMonitor) {
   const std::string config = R"EOF(
     resource_monitors:
@@ -111,6 +111,51 @@ TEST(ServerInstanceUtil, flushHelper) {
   InstanceUtil::flushMetricsToSinks(sinks, mock_store, time_system);
 }
 
+TEST(ServerInstanceUtil, flushChangedOnly) {
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& changed_counter = store.counter("changed_counter");
+  Stats::Counter& idle_counter = store.counter("idle_counter");
+  Stats::Gauge& changed_gauge = store.gauge("changed_gauge", Stats::Gauge::ImportMode::Accumulate);
+  store.gauge("idle_gauge", Stats::Gauge::ImportMode::Accumulate).set(1);
+  Stats::TextReadout& changed_text = store.textReadout("changed_text");
+  store.textReadout("idle_text").set("idle");
+  idle_counter.inc();
+
+  // The first flush includes everything that changed since the stats were created.
+  std::list<Stats::SinkPtr> sinks;
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, true);
+
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "changed_counter");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 2);
+
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "changed_gauge");
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 7);
+
+    ASSERT_EQ(snapshot.textReadouts().size(), 1);
+    EXPECT_EQ(snapshot.textReadouts()[0].get().name(), "changed_text");
+    EXPECT_EQ(snapshot.textReadouts()[0].get().value(), "new");
+  }));
+  changed_counter.add(2);
+  changed_gauge.set(7);
+  changed_text.set("new");
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, true);
+
+  // Nothing changed since the last flush.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+    EXPECT_TRUE(snapshot.textReadouts().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, time_system, true);
+  EXPECT_EQ(1UL, idle_counter.value());
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {
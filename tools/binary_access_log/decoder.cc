@@ -0,0 +1,139 @@
+/**
+ * Utility to decode a binary ring file access log into JSON lines, one object per record with
+ * the field names as keys.
+ *
+ * Usage:
+ *
+ * binary_access_log_decoder [--follow] <ring file path>
+ *
+ * Without --follow, all records currently in the ring are printed. With --follow, the decoder
+ * starts at the newest record and keeps printing records as they are written, like tail -f.
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "envoy/extensions/access_loggers/binary_ring/v3/binary_ring.pb.h"
+
+#include "source/extensions/access_loggers/binary_ring/record_encoder.h"
+#include "source/extensions/access_loggers/binary_ring/ring_file.h"
+
+#include "absl/strings/str_format.h"
+
+// NOLINT(namespace-envoy)
+namespace {
+
+using Envoy::Extensions::AccessLoggers::BinaryRing::DecodedField;
+using Envoy::Extensions::AccessLoggers::BinaryRing::RecordEncoder;
+using Envoy::Extensions::AccessLoggers::BinaryRing::RingFileReader;
+using BinaryRingAccessLog = envoy::extensions::access_loggers::binary_ring::v3::BinaryRingAccessLog;
+
+void appendJsonString(absl::string_view value, std::string& out) {
+  out.push_back('"');
+  for (const char c : value) {
+    switch (c) {
+    case '"':
+      out.append("\\\"");
+      break;
+    case '\\':
+      out.append("\\\\");
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        absl::StrAppendFormat(&out, "\\u%04x", static_cast<unsigned char>(c));
+      } else {
+        out.push_back(c);
+      }
+    }
+  }
+  out.push_back('"');
+}
+
+std::string toJson(const std::vector<DecodedField>& fields) {
+  std::string out = "{";
+  for (const DecodedField& field : fields) {
+    if (out.size() > 1) {
+      out.push_back(',');
+    }
+    const std::string& name =
+        BinaryRingAccessLog::Field_IsValid(field.field_)
+            ? BinaryRingAccessLog::Field_Name(static_cast<BinaryRingAccessLog::Field>(field.field_))
+            : absl::StrFormat("FIELD_%d", field.field_);
+    appendJsonString(name, out);
+    out.push_back(':');
+    if (field.is_string_) {
+      appendJsonString(field.string_value_, out);
+    } else {
+      absl::StrAppendFormat(&out, "%d", field.number_value_);
+    }
+  }
+  out.push_back('}');
+  return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const bool follow = argc == 3 && std::string(argv[1]) == "--follow";
+  if (argc != 2 && !follow) {
+    std::cerr << "Usage: " << argv[0] << " [--follow] <ring file path>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char* path = argv[argc - 1];
+
+  const int fd = ::open(path, O_RDONLY);
+  struct stat file_stat;
+  if (fd == -1 || ::fstat(fd, &file_stat) != 0) {
+    std::cerr << "Unable to open " << path << std::endl;
+    return EXIT_FAILURE;
+  }
+  const size_t size = file_stat.st_size;
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cerr << "Unable to map " << path << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const RingFileReader reader(static_cast<const uint8_t*>(mapping), size);
+    uint64_t cursor = follow ? reader.newest() : reader.oldest();
+    std::string record;
+    std::vector<DecodedField> fields;
+    while (true) {
+      switch (reader.next(cursor, record)) {
+      case RingFileReader::ReadResult::Record:
+        fields.clear();
+        if (RecordEncoder::decode(record, fields)) {
+          std::cout << toJson(fields) << "\n";
+        } else {
+          std::cerr << "Skipping malformed record" << std::endl;
+        }
+        break;
+      case RingFileReader::ReadResult::Overrun:
+        std::cerr << "Records were overwritten before they could be read" << std::endl;
+        break;
+      case RingFileReader::ReadResult::Empty:
+        if (!follow) {
+          ::munmap(mapping, size);
+          return EXIT_SUCCESS;
+        }
+        std::cout.flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        break;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    ::munmap(mapping, size);
+    return EXIT_FAILURE;
+  }
+}